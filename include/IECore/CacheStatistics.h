@@ -0,0 +1,139 @@
+//////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (c) 2026, Image Engine Design Inc. All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//
+//     * Neither the name of Image Engine Design nor the names of any
+//       other contributors to this software may be used to endorse or
+//       promote products derived from this software without specific prior
+//       written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+//  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+//  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+//  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+//  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+//  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+//  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+//  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+//  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+//  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//////////////////////////////////////////////////////////////////////////
+
+#ifndef IECORE_CACHESTATISTICS_H
+#define IECORE_CACHESTATISTICS_H
+
+#include "IECore/Export.h"
+
+#include "boost/noncopyable.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace IECore
+{
+
+/// Lightweight counters describing the usage of a cache. These are maintained
+/// by LRUCache, ComputationCache and ObjectPool, and can be used to choose
+/// sensible limits for them. All methods are threadsafe.
+///
+/// Statistics may be given a name, in which case they are registered
+/// globally and returned by `registered()` for as long as they exist.
+/// This allows a report to be made on all the named caches in a process.
+///
+/// \ingroup utilityGroup
+class IECORE_API CacheStatistics : private boost::noncopyable
+{
+
+	public :
+
+		/// A copy of the statistics at a moment in time, along with the
+		/// cost of the cache that owns them.
+		struct Snapshot
+		{
+			std::string name;
+			/// Number of requests satisfied from the cache.
+			uint64_t hits = 0;
+			/// Number of requests which required a value to be computed
+			/// or which failed to find a value.
+			uint64_t misses = 0;
+			/// Number of items discarded to keep the cache within its
+			/// maximum cost. Items with zero cost are not counted.
+			uint64_t evictions = 0;
+			/// Total time spent computing values, summed over all threads.
+			double getterSeconds = 0;
+			size_t currentCost = 0;
+			size_t maxCost = 0;
+		};
+
+		/// Called by `snapshot()` to fill in the fields that aren't
+		/// counted by the statistics themselves. Typically this is
+		/// used by the owning cache to supply its costs.
+		using SnapshotFunction = std::function<void ( Snapshot & )>;
+		/// Called by `reset()`, so that an owning cache can reset any
+		/// counters it supplies via the SnapshotFunction.
+		using ResetFunction = std::function<void ()>;
+
+		CacheStatistics( const SnapshotFunction &snapshotFunction = SnapshotFunction(), const ResetFunction &resetFunction = ResetFunction() );
+		~CacheStatistics();
+
+		/// Registers the statistics under the given name, so that they
+		/// are returned by `registered()`. Passing an empty name
+		/// unregisters them. Names need not be unique.
+		void setName( const std::string &name );
+		std::string getName() const;
+
+		/// Returns the current values of the counters.
+		Snapshot snapshot() const;
+		/// Resets all counters to zero.
+		void reset();
+
+		/// Returns snapshots of all the named statistics, sorted by name.
+		static std::vector<Snapshot> registered();
+		/// Resets the counters of all the named statistics.
+		static void resetRegistered();
+
+		/// Methods used by the owning cache to update the counters.
+		////////////////////////////////////////////////////////////
+		//@{
+		void recordHit();
+		void recordMiss();
+		void recordEviction();
+		void recordGetterTime( std::chrono::steady_clock::duration duration );
+		//@}
+
+	private :
+
+		SnapshotFunction m_snapshotFunction;
+		ResetFunction m_resetFunction;
+
+		mutable std::mutex m_nameMutex;
+		std::string m_name;
+
+		std::atomic<uint64_t> m_hits;
+		std::atomic<uint64_t> m_misses;
+		std::atomic<uint64_t> m_evictions;
+		std::atomic<uint64_t> m_getterNanoseconds;
+
+};
+
+} // namespace IECore
+
+#endif // IECORE_CACHESTATISTICS_H
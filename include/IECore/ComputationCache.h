@@ -35,6 +35,7 @@
 #ifndef IECORE_COMPUTATIONCACHE_H
 #define IECORE_COMPUTATIONCACHE_H
 
+#include "IECore/DiskObjectCache.h"
 #include "IECore/LRUCache.h"
 #include "IECore/ObjectPool.h"
 
@@ -46,6 +47,9 @@ namespace IECore
 /// LRUCache for generic computation that results on Object derived classes. It uses ObjectPool for the storage and retrieval of
 /// the computation results, and internally it only holds a map of computationHash to objectHash. The get functions will return the resulting
 /// Object, which should be copied prior to modification. The retrieve function will only query the cache and not force computation.
+/// An optional DiskObjectCache may be used to store the computation results persistently, so that they are loaded rather than
+/// recomputed by subsequent sessions. This should only be used when the hash function identifies the result completely,
+/// including any external inputs such as the contents of files.
 template< typename T >
 class ComputationCache : public RefCounted
 {
@@ -62,7 +66,10 @@ class ComputationCache : public RefCounted
 		/// \param hashFn Functor that should compute a unique hash from the templated parameters identifying the computation result.
 		/// \param maxResults Limits the number of computation results this cache will hold.
 		/// \param objectPool Allows overriding the ObjectPool instance to be used for holding the resulting computed objects.
-		ComputationCache( ComputeFn computeFn, HashFn hashFn, size_t maxResults = 10000, ObjectPoolPtr objectPool = ObjectPool::defaultObjectPool() );
+		/// \param diskCache Optional DiskObjectCache used to store computed objects persistently.
+		/// \param diskCacheNamespace Identifies the computation, so that results from different caches sharing the same
+		/// DiskObjectCache can never be confused. Must be non-empty if diskCache is specified.
+		ComputationCache( ComputeFn computeFn, HashFn hashFn, size_t maxResults = 10000, ObjectPoolPtr objectPool = ObjectPool::defaultObjectPool(), DiskObjectCachePtr diskCache = nullptr, const std::string &diskCacheNamespace = "" );
 
 		~ComputationCache() override;
 
@@ -101,6 +108,16 @@ class ComputationCache : public RefCounted
 		/// Returns the ObjectPool object used by this computation cache.
 		ObjectPool *objectPool() const;
 
+		/// Returns the DiskObjectCache used by this computation cache, which
+		/// may be null.
+		DiskObjectCache *diskCache() const;
+
+		/// Returns statistics describing the usage of the cache. A hit is
+		/// counted when `get()` finds the result in the cache, and a miss
+		/// otherwise. Getter time is the time spent in the ComputeFn.
+		CacheStatistics &statistics();
+		const CacheStatistics &statistics() const;
+
 	private :
 
 		ComputeFn m_computeFn;
@@ -110,8 +127,15 @@ class ComputationCache : public RefCounted
 		Cache m_cache;
 
 		ObjectPoolPtr m_objectPool;
+		DiskObjectCachePtr m_diskCache;
+		MurmurHash m_diskCacheNamespace;
 
 		static MurmurHash cacheGetter( const MurmurHash &h, size_t &cost );
+
+		ConstObjectPtr compute( const T &args, const MurmurHash &computationHash );
+
+		// Declared last so that it is destroyed first. See LRUCache.
+		CacheStatistics m_statistics;
 };
 
 
@@ -35,15 +35,36 @@
 #ifndef IECORE_COMPUTATIONCACHE_INL
 #define IECORE_COMPUTATIONCACHE_INL
 
+#include "IECore/Exception.h"
 #include "IECore/MessageHandler.h"
 
+#include <chrono>
+
 namespace IECore
 {
 
 template< typename T >
-ComputationCache<T>::ComputationCache( ComputeFn computeFn, HashFn hashFn, size_t maxResults, ObjectPoolPtr objectPool ) :
-	m_computeFn(computeFn), m_hashFn(hashFn), m_cache( &ComputationCache<T>::cacheGetter, maxResults), m_objectPool(objectPool)
+ComputationCache<T>::ComputationCache( ComputeFn computeFn, HashFn hashFn, size_t maxResults, ObjectPoolPtr objectPool, DiskObjectCachePtr diskCache, const std::string &diskCacheNamespace ) :
+	m_computeFn(computeFn), m_hashFn(hashFn), m_cache( &ComputationCache<T>::cacheGetter, maxResults), m_objectPool(objectPool), m_diskCache(diskCache),
+	m_statistics(
+		[this] ( CacheStatistics::Snapshot &snapshot ) {
+			snapshot.evictions = m_cache.statistics().snapshot().evictions;
+			snapshot.currentCost = m_cache.currentCost();
+			snapshot.maxCost = m_cache.getMaxCost();
+		},
+		[this] {
+			m_cache.statistics().reset();
+		}
+	)
 {
+	if( m_diskCache )
+	{
+		if( diskCacheNamespace.empty() )
+		{
+			throw InvalidArgumentException( "ComputationCache : A namespace must be provided for the disk cache" );
+		}
+		m_diskCacheNamespace.append( diskCacheNamespace );
+	}
 }
 
 template< typename T >
@@ -92,6 +113,7 @@ ConstObjectPtr ComputationCache<T>::get( const T &args, ComputationCache::Missin
 	if ( objectHash == MurmurHash() )
 	{
 		/// don't know the computation hash... check the missing behaviour
+		m_statistics.recordMiss();
 		if ( missingBehaviour == ThrowIfMissing )
 		{
 			throw Exception( "Computation not available in the cache!" );
@@ -100,7 +122,7 @@ ConstObjectPtr ComputationCache<T>::get( const T &args, ComputationCache::Missin
 		{
 			return nullptr;
 		}
-		obj = m_computeFn(args);
+		obj = compute( args, computationHash );
 		if ( obj )
 		{
 			m_cache.set( computationHash, obj->hash(), 1 );
@@ -110,8 +132,13 @@ ConstObjectPtr ComputationCache<T>::get( const T &args, ComputationCache::Missin
 	else
 	{
 		obj = m_objectPool->retrieve(objectHash);
-		if ( !obj )
+		if ( obj )
+		{
+			m_statistics.recordHit();
+		}
+		else
 		{
+			m_statistics.recordMiss();
 			/// the computation result was not in the object pool.... check the missing behavour
 			if ( missingBehaviour == ThrowIfMissing )
 			{
@@ -121,7 +148,7 @@ ConstObjectPtr ComputationCache<T>::get( const T &args, ComputationCache::Missin
 			{
 				return nullptr;
 			}
-			obj = m_computeFn(args);
+			obj = compute( args, computationHash );
 			if ( obj )
 			{
 				obj = m_objectPool->store( obj.get(), ObjectPool::StoreReference );
@@ -162,6 +189,68 @@ ObjectPool *ComputationCache<T>::objectPool() const
 	return m_objectPool.get();
 }
 
+template< typename T >
+DiskObjectCache *ComputationCache<T>::diskCache() const
+{
+	return m_diskCache.get();
+}
+
+template< typename T >
+CacheStatistics &ComputationCache<T>::statistics()
+{
+	return m_statistics;
+}
+
+template< typename T >
+const CacheStatistics &ComputationCache<T>::statistics() const
+{
+	return m_statistics;
+}
+
+template< typename T >
+ConstObjectPtr ComputationCache<T>::compute( const T &args, const MurmurHash &computationHash )
+{
+	MurmurHash diskKey;
+	if( m_diskCache )
+	{
+		diskKey = m_diskCacheNamespace;
+		diskKey.append( computationHash );
+		if( ConstObjectPtr result = m_diskCache->retrieve( diskKey ) )
+		{
+			return result;
+		}
+	}
+
+	const auto startTime = std::chrono::steady_clock::now();
+	ConstObjectPtr result;
+	try
+	{
+		result = m_computeFn( args );
+		m_statistics.recordGetterTime( std::chrono::steady_clock::now() - startTime );
+	}
+	catch( ... )
+	{
+		m_statistics.recordGetterTime( std::chrono::steady_clock::now() - startTime );
+		throw;
+	}
+
+	if( m_diskCache && result )
+	{
+		// Failing to store the result isn't fatal, as we can
+		// still return it.
+		try
+		{
+			m_diskCache->store( diskKey, result.get() );
+		}
+		catch( const std::exception &e )
+		{
+			msg( Msg::Warning, "ComputationCache::get", e.what() );
+		}
+	}
+
+	return result;
+}
+
 } // namespace IECore
 
 #endif // IECORE_COMPUTATIONCACHE_H
@@ -0,0 +1,137 @@
+//////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (c) 2026, Image Engine Design Inc. All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//
+//     * Neither the name of Image Engine Design nor the names of any
+//       other contributors to this software may be used to endorse or
+//       promote products derived from this software without specific prior
+//       written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+//  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+//  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+//  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+//  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+//  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+//  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+//  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+//  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+//  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//////////////////////////////////////////////////////////////////////////
+
+
+#ifndef IECORE_DISKOBJECTCACHE_H
+#define IECORE_DISKOBJECTCACHE_H
+
+#include "IECore/CacheStatistics.h"
+#include "IECore/Export.h"
+#include "IECore/MurmurHash.h"
+#include "IECore/Object.h"
+
+#include <memory>
+
+namespace IECore
+{
+
+IE_CORE_FORWARDDECLARE( DiskObjectCache );
+
+/// \addtogroup environmentGroup
+///
+/// <b>IECORE_DISKOBJECTCACHE_PATH</b><br>
+/// The directory used by DiskObjectCache::defaultCache(). The default cache
+/// is disabled unless this is set.
+///
+/// <b>IECORE_DISKOBJECTCACHE_SIZE</b><br>
+/// The maximum disk usage in megabytes for DiskObjectCache::defaultCache().
+/// Defaults to 10240.
+
+/// A persistent cache of Objects stored as files in a directory, intended
+/// for use on fast local storage. This allows expensive derived objects
+/// to be reused by subsequent sessions without being recomputed. Keys
+/// must be stable across sessions, and will typically be a hash of the
+/// input object combined with a hash of the operation and its parameters.
+///
+/// Each object is stored in its own file, which is written to a temporary
+/// file and then renamed into place, so a process which dies while storing
+/// an object never leaves a partial file behind. Files which can't be
+/// loaded are treated as missing and deleted.
+///
+/// The least recently used files are deleted to keep the cache within its
+/// maximum disk usage. Usage is recorded via the file modification times,
+/// so it persists from session to session. Several processes may share the
+/// same directory, but each applies the limit only to the files it knows
+/// about - those present when it was constructed, and those it has stored
+/// or retrieved since. All methods are threadsafe.
+///
+/// \ingroup utilityGroup
+class IECORE_API DiskObjectCache : public RefCounted
+{
+
+	public :
+
+		IE_CORE_DECLAREMEMBERPTR( DiskObjectCache );
+
+		/// Uses the specified directory, creating it if it doesn't already
+		/// exist. Any objects already stored in it are made available.
+		DiskObjectCache( const std::string &directory, size_t maxDiskUsage );
+		~DiskObjectCache() override;
+
+		const std::string &directory() const;
+
+		/// Sets the maximum number of bytes used by the stored files,
+		/// deleting files if necessary.
+		void setMaxDiskUsage( size_t maxDiskUsage );
+		size_t getMaxDiskUsage() const;
+		/// Returns the number of bytes used by the stored files.
+		size_t diskUsage() const;
+
+		/// Returns true if an object is stored with the given key.
+		bool contains( const MurmurHash &key ) const;
+		/// Loads the object stored with the given key, returning null
+		/// if there is none.
+		ObjectPtr retrieve( const MurmurHash &key ) const;
+		/// Stores the object with the given key, replacing any existing
+		/// object with that key. Throws if the object cannot be written.
+		void store( const MurmurHash &key, const Object *object );
+		/// Deletes the object stored with the given key, returning true if
+		/// there was one.
+		bool erase( const MurmurHash &key );
+		/// Deletes all the stored objects.
+		void clear();
+
+		/// Returns statistics describing the usage of the cache. Hits and
+		/// misses are counted by `retrieve()`. The statistics for the
+		/// default cache are registered with the name "DiskObjectCache".
+		CacheStatistics &statistics();
+		const CacheStatistics &statistics() const;
+
+		/// Returns the cache specified by the IECORE_DISKOBJECTCACHE_PATH
+		/// and IECORE_DISKOBJECTCACHE_SIZE environment variables, or null
+		/// if they don't specify one. This is not used automatically, but
+		/// may be passed to ComputationCache by clients whose hashes are
+		/// stable across sessions.
+		static DiskObjectCache *defaultCache();
+
+	private :
+
+		struct MemberData;
+		std::unique_ptr<MemberData> m_data;
+
+};
+
+} // namespace IECore
+
+#endif // IECORE_DISKOBJECTCACHE_H
@@ -58,7 +58,13 @@ class IECORE_API FileIndexedIO : public StreamIndexedIO
 		/// options CompoundData and contain the following:
 		/// 	"compressor" : String [ 'blosclz' | 'lz4' | 'lz4hc' | 'snappy' | 'zlib']
 		///		"compressionLevel" : Int [ 0 = no compression, 9 = max compression ]
-		///		"maxCompressedBlockSize" : UInt [ size of compression block ]
+		///		"maxCompressedBlockSize" : UInt [ size of compression block, defaults to 8MB. Blocks are decompressed in parallel ]
+		///		"shuffle" : String [ 'auto' = shuffle by element size | 'none' | 'byte' | 'bit' ]
+		///		"minCompressionRatio" : Float [ data is stored uncompressed unless compression reduces it by this ratio ]
+		///		"dataTypeCompression" : CompoundData [ per IndexedIO::DataType overrides for "compressor", "compressionLevel"
+		///			and "shuffle", keyed by data type name, eg. { "FloatArray" : { "shuffle" : "bit" } } ]
+		///		"memoryMapped" : Bool [ memory map the file when opened for reading ]
+		///		"asynchronousCompression" : Bool [ compress written data on background threads, committing it to the file in order ]
 		FileIndexedIO(const std::string &path, const IndexedIO::EntryIDList &root, IndexedIO::OpenMode mode, const CompoundData *options = nullptr);
 
 		~FileIndexedIO() override;
@@ -0,0 +1,216 @@
+//////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (c) 2026, Image Engine Design Inc. All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//
+//     * Neither the name of Image Engine Design nor the names of any
+//       other contributors to this software may be used to endorse or
+//       promote products derived from this software without specific prior
+//       written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+//  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+//  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+//  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+//  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+//  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+//  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+//  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+//  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+//  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//////////////////////////////////////////////////////////////////////////
+
+
+#ifndef IECORE_FROZENPATHMATCHER_H
+#define IECORE_FROZENPATHMATCHER_H
+
+#include "IECore/PathMatcher.h"
+
+#include "boost/iterator/iterator_adaptor.hpp"
+#include "boost/iterator/iterator_facade.hpp"
+
+#include <string>
+#include <vector>
+
+namespace IECore
+{
+
+/// An immutable alternative to PathMatcher, optimised for fast matching.
+/// Rather than allocating each node separately and storing children in a
+/// `std::map`, all nodes are stored contiguously in a handful of arrays,
+/// with the children of each node adjacent to one another. Nodes with many
+/// children are additionally given a hash table so that children can be
+/// found in constant time. This is intended for use when a PathMatcher is
+/// built once and then queried many times.
+///
+/// Copies are cheap, as the immutable storage is shared between them.
+class IECORE_API FrozenPathMatcher
+{
+
+	public :
+
+		/// Constructs an empty matcher.
+		FrozenPathMatcher();
+		/// Constructs a matcher containing the same paths as `pathMatcher`.
+		/// Subtrees shared internally by `pathMatcher` remain shared.
+		explicit FrozenPathMatcher( const PathMatcher &pathMatcher );
+
+		FrozenPathMatcher( const FrozenPathMatcher &other );
+		FrozenPathMatcher& operator= ( const FrozenPathMatcher &other );
+		~FrozenPathMatcher();
+
+		/// Returns an editable PathMatcher containing the same paths.
+		PathMatcher pathMatcher() const;
+
+		/// Returns a matcher for the paths below `root`, rerooted
+		/// to `/`. The storage is shared with this matcher, so this
+		/// is a constant time operation.
+		FrozenPathMatcher subTree( const std::string &root ) const;
+		FrozenPathMatcher subTree( const std::vector<IECore::InternedString> &root ) const;
+
+		bool isEmpty() const;
+		/// Returns the number of paths that have been explicitly
+		/// added. Complexity : linear in the number of stored
+		/// locations.
+		size_t size() const;
+
+		/// Fills the paths container with all the paths held
+		/// within this matcher.
+		void paths( std::vector<std::string> &paths ) const;
+
+		/// Result is a bitwise or of the relevant values from
+		/// PathMatcher::Result, and is identical to the result of
+		/// the equivalent `PathMatcher::match()` call.
+		unsigned match( const std::string &path ) const;
+		unsigned match( const std::vector<IECore::InternedString> &path ) const;
+		typedef std::vector<IECore::InternedString>::const_iterator NameIterator;
+		/// As above, but for the path formed by the names in
+		/// `[start, end)`, avoiding the need to copy them into a
+		/// separate vector when matching part of a longer path.
+		unsigned match( NameIterator start, NameIterator end ) const;
+
+		bool operator == ( const FrozenPathMatcher &other ) const;
+		bool operator != ( const FrozenPathMatcher &other ) const;
+
+		class RawIterator;
+		class Iterator;
+
+		/// Returns an iterator to the start of the
+		/// tree of paths.
+		RawIterator begin() const;
+		/// Returns an iterator to the end of the
+		/// tree of paths.
+		RawIterator end() const;
+		/// Returns an iterator to the specified path,
+		/// or end() if it does not exist.
+		RawIterator find( const std::vector<IECore::InternedString> &path ) const;
+
+	private :
+
+		IE_CORE_FORWARDDECLARE( Storage )
+
+		FrozenPathMatcher( const ConstStoragePtr &storage, uint32_t root );
+
+		uint32_t findNode( const std::vector<IECore::InternedString> &path ) const;
+		void matchWalk( uint32_t nodeIndex, const NameIterator &start, const NameIterator &end, unsigned &result ) const;
+
+		ConstStoragePtr m_storage;
+		// Index of our root node in the storage, which is
+		// non-zero for matchers returned by `subTree()`.
+		uint32_t m_root;
+
+};
+
+/// Iterates over the tree of paths in a FrozenPathMatcher, visiting both the
+/// locations explicitly added and their ancestors, exactly as for
+/// PathMatcher::RawIterator. Siblings are visited in the same order as by
+/// the PathMatcher the FrozenPathMatcher was constructed from. The
+/// FrozenPathMatcher must outlive the iterator.
+class IECORE_API FrozenPathMatcher::RawIterator : public boost::iterator_facade<RawIterator, const std::vector<IECore::InternedString>, boost::forward_traversal_tag>
+{
+
+	public :
+
+		/// Calling prune() causes the next increment to skip any recursion
+		/// that it would normally perform.
+		void prune();
+
+		/// Returns true if this path is in the matcher because it
+		/// has been explicitly added, rather than only being the
+		/// ancestor of such a path.
+		bool exactMatch() const;
+
+	private :
+
+		friend class boost::iterator_core_access;
+		friend class FrozenPathMatcher;
+		friend class Iterator;
+
+		RawIterator( const FrozenPathMatcher &matcher, bool atEnd );
+
+		void increment();
+		bool equal( const RawIterator &other ) const;
+		const std::vector<IECore::InternedString> &dereference() const;
+
+		// Returns the index of the current node, or an
+		// invalid index if we're at the end.
+		uint32_t node() const;
+
+		// Range of indices into `Storage::children` for
+		// the siblings at a particular depth.
+		struct Level
+		{
+			uint32_t it;
+			uint32_t end;
+			bool operator == ( const Level &other ) const { return it == other.it && end == other.end; }
+		};
+
+		const Storage *m_storage;
+		uint32_t m_root;
+		std::vector<Level> m_stack;
+		std::vector<IECore::InternedString> m_path;
+		// True only when we're pointing at the root, for
+		// which there is no entry in `m_stack`.
+		bool m_atRoot;
+		bool m_pruned;
+
+};
+
+/// Iterates over the tree of paths in a FrozenPathMatcher, visiting only
+/// the locations explicitly added, exactly as for PathMatcher::Iterator.
+class IECORE_API FrozenPathMatcher::Iterator : public boost::iterator_adaptor<Iterator, FrozenPathMatcher::RawIterator>
+{
+
+	public :
+
+		Iterator( const RawIterator &it );
+
+		bool operator==( const RawIterator &rhs ) const;
+		bool operator!=( const RawIterator &rhs ) const;
+
+		void prune();
+
+	private :
+
+		friend class boost::iterator_core_access;
+
+		void increment();
+		void satisfyTerminatorRequirement();
+
+};
+
+} // namespace IECore
+
+#endif // IECORE_FROZENPATHMATCHER_H
@@ -35,6 +35,8 @@
 #ifndef IECORE_LRUCACHE_H
 #define IECORE_LRUCACHE_H
 
+#include "IECore/CacheStatistics.h"
+
 #include "boost/function.hpp"
 #include "boost/noncopyable.hpp"
 #include "boost/variant.hpp"
@@ -52,11 +54,33 @@ namespace LRUCachePolicy
 template<typename LRUCache>
 class Serial;
 
+namespace Detail
+{
+
+template<typename LRUCache, typename ItemMutex>
+class BinnedParallel;
+
+class SpinMutex;
+class TaskMutex;
+
+} // namespace Detail
+
 /// Threadsafe, `get()` blocks if another thread is already
 /// computing the value. Key type must have a `hash_value`
 /// implementation as described in the boost documentation.
 template<typename LRUCache>
-class Parallel;
+using Parallel = Detail::BinnedParallel<LRUCache, Detail::SpinMutex>;
+
+/// Threadsafe. When `get()` is called for an item which another
+/// thread is already computing, the calling thread collaborates
+/// on any TBB tasks spawned by the GetterFunction rather than
+/// blocking. This policy should be preferred when the GetterFunction
+/// itself uses TBB, because blocking would waste cores, and could
+/// deadlock if a blocked thread was the one needed to complete the
+/// computation. Key type must have a `hash_value` implementation
+/// as described in the boost documentation.
+template<typename LRUCache>
+using TaskParallel = Detail::BinnedParallel<LRUCache, Detail::TaskMutex>;
 
 } // namespace LRUCachePolicy
 
@@ -136,13 +160,19 @@ class LRUCache : private boost::noncopyable
 		/// Returns the current cost of all cached items.
 		Cost currentCost() const;
 
+		/// Returns statistics describing the usage of the cache. Use
+		/// `statistics().setName()` to include them in
+		/// `CacheStatistics::registered()`.
+		CacheStatistics &statistics();
+		const CacheStatistics &statistics() const;
+
 	private :
 
 		// Data
 		//////////////////////////////////////////////////////////////////////////
 
 		// Give Policy access to CacheEntry definitions.
-		friend class Policy<LRUCache>;
+		friend Policy<LRUCache>;
 
 		// A function for computing values, and one for notifying of removals.
 		GetterFunction m_getter;
@@ -198,6 +228,11 @@ class LRUCache : private boost::noncopyable
 		void limitCost( Cost cost );
 
 		static void nullRemovalCallback( const Key &key, const Value &value );
+		static CacheStatistics::SnapshotFunction statisticsSnapshot( const LRUCache *cache );
+
+		// Declared last so that it is destroyed first, unregistering
+		// itself before the data used by its SnapshotFunction.
+		CacheStatistics m_statistics;
 
 };
 
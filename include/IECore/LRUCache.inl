@@ -46,9 +46,13 @@
 
 #include "tbb/spin_mutex.h"
 #include "tbb/spin_rw_mutex.h"
+#include "tbb/task_arena.h"
+#include "tbb/task_group.h"
 
 #include <cassert>
+#include <chrono>
 #include <iostream>
+#include <memory>
 #include <thread>
 #include <tuple>
 #include <vector>
@@ -167,6 +171,15 @@ class Serial
 				return m_it->cacheEntry;
 			}
 
+			// Executes the GetterFunction for a writable
+			// handle. Policies may use this to allow other
+			// threads to collaborate on the work.
+			template<typename F>
+			void execute( F &&f )
+			{
+				f();
+			}
+
 			void release()
 			{
 				if( m_inited )
@@ -271,11 +284,237 @@ class Serial
 
 };
 
+namespace Detail
+{
+
+// A reader-writer mutex which allows the holder of a write lock to
+// execute work in a way that lets other threads waiting for the lock
+// collaborate on any TBB tasks it spawns. The work is executed in a
+// dedicated `task_arena`, so that waiting threads only pick up tasks
+// related to the work, rather than unrelated tasks which might in turn
+// try to acquire the lock and deadlock.
+class TaskMutex : private boost::noncopyable
+{
+
+	public :
+
+		TaskMutex()
+		{
+		}
+
+		class ScopedLock : private boost::noncopyable
+		{
+
+			public :
+
+				ScopedLock()
+					:	m_mutex( nullptr ), m_writer( false )
+				{
+				}
+
+				~ScopedLock()
+				{
+					if( m_mutex )
+					{
+						release();
+					}
+				}
+
+				// Tries to acquire the lock, returning true on success.
+				// On failure, if the current holder of the lock is executing
+				// work via `execute()`, `workNotifier( true )` is called before
+				// the calling thread helps with the work, and `false` is
+				// returned when the work is complete. Otherwise `workNotifier( false )`
+				// is called and `false` is returned immediately.
+				template<typename WorkNotifier>
+				bool acquireOr( TaskMutex &mutex, bool write, WorkNotifier &&workNotifier )
+				{
+					assert( !m_mutex );
+					if( m_lock.try_acquire( mutex.m_mutex, write ) )
+					{
+						m_mutex = &mutex;
+						m_writer = write;
+						return true;
+					}
+
+					ExecutionStatePtr executionState;
+					{
+						ExecutionStateMutex::scoped_lock executionStateLock( mutex.m_executionStateMutex );
+						executionState = mutex.m_executionState;
+					}
+
+					workNotifier( static_cast<bool>( executionState ) );
+					if( executionState )
+					{
+						executionState->arena.execute(
+							[&executionState] {
+								executionState->taskGroup.wait();
+							}
+						);
+					}
+					else
+					{
+						std::this_thread::yield();
+					}
+
+					return false;
+				}
+
+				// Acquires the lock without blocking, returning true
+				// on success.
+				bool tryAcquire( TaskMutex &mutex, bool write = true )
+				{
+					assert( !m_mutex );
+					if( m_lock.try_acquire( mutex.m_mutex, write ) )
+					{
+						m_mutex = &mutex;
+						m_writer = write;
+						return true;
+					}
+					return false;
+				}
+
+				void upgradeToWriter()
+				{
+					assert( m_mutex && !m_writer );
+					m_lock.upgrade_to_writer();
+					m_writer = true;
+				}
+
+				// Executes `f` such that other threads waiting
+				// in `acquireOr()` may collaborate on any TBB tasks
+				// it spawns. Requires a write lock.
+				template<typename F>
+				void execute( F &&f )
+				{
+					assert( m_mutex && m_writer );
+
+					ExecutionStatePtr executionState = std::make_shared<ExecutionState>();
+					{
+						ExecutionStateMutex::scoped_lock executionStateLock( m_mutex->m_executionStateMutex );
+						m_mutex->m_executionState = executionState;
+					}
+
+					// Clear the execution state when we're done, even
+					// if `f` throws.
+					struct ExecutionStateReset
+					{
+						ExecutionStateReset( TaskMutex *mutex ) : m_mutex( mutex ) {}
+						~ExecutionStateReset()
+						{
+							ExecutionStateMutex::scoped_lock executionStateLock( m_mutex->m_executionStateMutex );
+							m_mutex->m_executionState.reset();
+						}
+						TaskMutex *m_mutex;
+					} executionStateReset( m_mutex );
+
+					executionState->arena.execute(
+						[&executionState, &f] {
+							executionState->taskGroup.run_and_wait( f );
+						}
+					);
+				}
+
+				void release()
+				{
+					assert( m_mutex );
+					m_lock.release();
+					m_mutex = nullptr;
+				}
+
+			private :
+
+				TaskMutex *m_mutex;
+				bool m_writer;
+				tbb::spin_rw_mutex::scoped_lock m_lock;
+
+		};
+
+	private :
+
+		tbb::spin_rw_mutex m_mutex;
+
+		struct ExecutionState
+		{
+			tbb::task_arena arena;
+			tbb::task_group taskGroup;
+		};
+		typedef std::shared_ptr<ExecutionState> ExecutionStatePtr;
+
+		typedef tbb::spin_mutex ExecutionStateMutex;
+		ExecutionStateMutex m_executionStateMutex;
+		ExecutionStatePtr m_executionState;
+
+};
+
+// Adapts `tbb::spin_rw_mutex` to the interface of TaskMutex, for
+// use by the Parallel policy. Threads failing to acquire the lock
+// just retry, and `execute()` simply calls the function.
+class SpinMutex : private boost::noncopyable
+{
+
+	public :
+
+		SpinMutex()
+		{
+		}
+
+		class ScopedLock : private boost::noncopyable
+		{
+
+			public :
+
+				template<typename WorkNotifier>
+				bool acquireOr( SpinMutex &mutex, bool write, WorkNotifier &&workNotifier )
+				{
+					if( m_lock.try_acquire( mutex.m_mutex, write ) )
+					{
+						return true;
+					}
+					workNotifier( false );
+					return false;
+				}
+
+				bool tryAcquire( SpinMutex &mutex, bool write = true )
+				{
+					return m_lock.try_acquire( mutex.m_mutex, write );
+				}
+
+				void upgradeToWriter()
+				{
+					m_lock.upgrade_to_writer();
+				}
+
+				template<typename F>
+				void execute( F &&f )
+				{
+					f();
+				}
+
+				void release()
+				{
+					m_lock.release();
+				}
+
+			private :
+
+				tbb::spin_rw_mutex::scoped_lock m_lock;
+
+		};
+
+	private :
+
+		tbb::spin_rw_mutex m_mutex;
+
+};
+
+// Implementation shared by the Parallel and TaskParallel policies.
 // Uses a binned map to allow concurrent map operations, and
 // uses a second-chance algorithm to avoid the serial operations
-// associated with managing an LRU list.
-template<typename LRUCache>
-class Parallel
+// associated with managing an LRU list. Each item is protected
+// by an ItemMutex, which must provide the interface of TaskMutex.
+template<typename LRUCache, typename ItemMutex>
+class BinnedParallel
 {
 
 	public :
@@ -292,7 +531,7 @@ class Parallel
 			Key key;
 			mutable CacheEntry cacheEntry;
 			// Mutex to protect cacheEntry.
-			typedef tbb::spin_rw_mutex Mutex;
+			typedef ItemMutex Mutex;
 			mutable Mutex mutex;
 			// Flag used in second-chance algorithm.
 			mutable std::atomic<bool> recentlyUsed;
@@ -339,7 +578,7 @@ class Parallel
 
 		typedef std::vector<Bin> Bins;
 
-		Parallel()
+		BinnedParallel()
 		{
 			m_bins.resize( std::thread::hardware_concurrency() );
 			m_popBinIndex = 0;
@@ -370,6 +609,13 @@ class Parallel
 				return m_item->cacheEntry;
 			}
 
+			template<typename F>
+			void execute( F &&f )
+			{
+				assert( m_writable );
+				m_itemLock.execute( f );
+			}
+
 			void release()
 			{
 				if( m_item )
@@ -422,7 +668,21 @@ class Parallel
 						// cached item.
 						m_writable = inserted || mode == FindWritable || mode == InsertWritable;
 
-						if( m_itemLock.try_acquire( it->mutex, /* write = */ m_writable ) )
+						// If the Item lock is held by another thread, we must
+						// release the Bin lock before retrying. This avoids
+						// deadlock when the GetterFunction holding the Item
+						// lock calls back into the cache and tries to access
+						// another item in the same Bin. If the ItemMutex allows
+						// it, we help with the other thread's computation before
+						// retrying.
+						const bool acquired = m_itemLock.acquireOr(
+							it->mutex, /* write = */ m_writable,
+							[&binLock]( bool workAvailable ) {
+								binLock.release();
+							}
+						);
+
+						if( acquired )
 						{
 							if( !m_writable && mode == Insert && it->cacheEntry.status() == LRUCache::Uncached )
 							{
@@ -432,29 +692,20 @@ class Parallel
 								// or because the item was too big to fit
 								// in the cache. Upgrade to writer status
 								// so it can be updated in get().
-								m_itemLock.upgrade_to_writer();
+								m_itemLock.upgradeToWriter();
 								m_writable = true;
 							}
 							// Success!
 							m_item = &*it;
 							return true;
 						}
-						else
-						{
-							// The Item lock is held by another thread.
-							// We must release the Bin lock and retry. This
-							// avoids deadlock when the GetterFunction holding
-							// the Item lock calls back into the cache and tries to
-							// access another item in the same Bin.
-							binLock.release();
-						}
 					}
 				}
 
-				friend class Parallel;
+				friend class BinnedParallel;
 
 				const Item *m_item;
-				typename Item::Mutex::scoped_lock m_itemLock;
+				typename Item::Mutex::ScopedLock m_itemLock;
 				bool m_writable;
 
 		};
@@ -491,27 +742,28 @@ class Parallel
 			Bin *bin = &m_bins[m_popBinIndex];
 			typename Bin::Mutex::scoped_lock binLock( bin->mutex );
 
-			typename Item::Mutex::scoped_lock itemLock;
+			typename Item::Mutex::ScopedLock itemLock;
 			while( true )
 			{
 				// If we're at the end of this bin, advance to
-				// the next non-empty one.
-				const MapIterator emptySentinel = bin->map.end();
+				// the next non-empty one. Visiting one more bin
+				// than there are means we've come full circle and
+				// all bins were empty.
+				size_t binsVisited = 0;
 				while( m_popIterator == bin->map.end() )
 				{
+					if( ++binsVisited > m_bins.size() )
+					{
+						return false;
+					}
 					binLock.release();
 					m_popBinIndex = ( m_popBinIndex + 1 ) % m_bins.size();
 					bin = &m_bins[m_popBinIndex];
 					binLock.acquire( bin->mutex );
 					m_popIterator = bin->map.begin();
-					if( m_popIterator == emptySentinel )
-					{
-						// We've come full circle and all bins were empty.
-						return false;
-					}
 				}
 
-				if( itemLock.try_acquire( m_popIterator->mutex ) )
+				if( itemLock.tryAcquire( m_popIterator->mutex ) )
 				{
 					if( !m_popIterator->recentlyUsed )
 					{
@@ -568,6 +820,8 @@ class Parallel
 
 };
 
+} // namespace Detail
+
 } // namespace LRUCachePolicy
 
 // CacheEntry
@@ -590,19 +844,19 @@ typename LRUCache<Key, Value, Policy, GetterKey>::Status LRUCache<Key, Value, Po
 
 template<typename Key, typename Value, template <typename> class Policy, typename GetterKey>
 LRUCache<Key, Value, Policy, GetterKey>::LRUCache( GetterFunction getter )
-	:	m_getter( getter ), m_removalCallback( nullRemovalCallback ), m_maxCost( 500 )
+	:	m_getter( getter ), m_removalCallback( nullRemovalCallback ), m_maxCost( 500 ), m_statistics( statisticsSnapshot( this ) )
 {
 }
 
 template<typename Key, typename Value, template <typename> class Policy, typename GetterKey>
 LRUCache<Key, Value, Policy, GetterKey>::LRUCache( GetterFunction getter, Cost maxCost )
-	:	m_getter( getter ), m_removalCallback( nullRemovalCallback ), m_maxCost( maxCost )
+	:	m_getter( getter ), m_removalCallback( nullRemovalCallback ), m_maxCost( maxCost ), m_statistics( statisticsSnapshot( this ) )
 {
 }
 
 template<typename Key, typename Value, template <typename> class Policy, typename GetterKey>
 LRUCache<Key, Value, Policy, GetterKey>::LRUCache( GetterFunction getter, RemovalCallback removalCallback, Cost maxCost )
-	:	m_getter( getter ), m_removalCallback( removalCallback ), m_maxCost( maxCost )
+	:	m_getter( getter ), m_removalCallback( removalCallback ), m_maxCost( maxCost ), m_statistics( statisticsSnapshot( this ) )
 {
 }
 
@@ -649,6 +903,18 @@ typename LRUCache<Key, Value, Policy, GetterKey>::Cost LRUCache<Key, Value, Poli
 	return m_policy.currentCost;
 }
 
+template<typename Key, typename Value, template <typename> class Policy, typename GetterKey>
+CacheStatistics &LRUCache<Key, Value, Policy, GetterKey>::statistics()
+{
+	return m_statistics;
+}
+
+template<typename Key, typename Value, template <typename> class Policy, typename GetterKey>
+const CacheStatistics &LRUCache<Key, Value, Policy, GetterKey>::statistics() const
+{
+	return m_statistics;
+}
+
 template<typename Key, typename Value, template <typename> class Policy, typename GetterKey>
 Value LRUCache<Key, Value, Policy, GetterKey>::get( const GetterKey &key )
 {
@@ -659,17 +925,26 @@ Value LRUCache<Key, Value, Policy, GetterKey>::get( const GetterKey &key )
 
 	if( status==Uncached )
 	{
+		m_statistics.recordMiss();
+
 		Value value = Value();
 		Cost cost = 0;
+		const auto startTime = std::chrono::steady_clock::now();
 		try
 		{
-			value = m_getter( key, cost );
+			handle.execute(
+				[this, &value, &key, &cost] {
+					value = m_getter( key, cost );
+				}
+			);
 		}
 		catch( ... )
 		{
+			m_statistics.recordGetterTime( std::chrono::steady_clock::now() - startTime );
 			handle.writable().state = std::current_exception();
 			throw;
 		}
+		m_statistics.recordGetterTime( std::chrono::steady_clock::now() - startTime );
 
 		assert( cacheEntry.status() != Cached ); // this would indicate that another thread somehow
 		assert( cacheEntry.status() != Failed ); // loaded the same thing as us, which is not the intention.
@@ -684,11 +959,13 @@ Value LRUCache<Key, Value, Policy, GetterKey>::get( const GetterKey &key )
 	}
 	else if( status==Cached )
 	{
+		m_statistics.recordHit();
 		m_policy.push( handle );
 		return boost::get<Value>( cacheEntry.state );
 	}
 	else
 	{
+		m_statistics.recordHit();
 		std::rethrow_exception( boost::get<std::exception_ptr>( cacheEntry.state ) );
 	}
 }
@@ -775,7 +1052,14 @@ void LRUCache<Key, Value, Policy, GetterKey>::limitCost( Cost cost )
 			break;
 		}
 
-		eraseInternal( key, cacheEntry );
+		// Zero cost items don't count as evictions, because removing
+		// them does nothing to reduce the cost. This prevents caches
+		// such as the ObjectPool, which store placeholders for missing
+		// items, from reporting misleading results.
+		if( eraseInternal( key, cacheEntry ) && cacheEntry.cost )
+		{
+			m_statistics.recordEviction();
+		}
 	}
 }
 
@@ -784,6 +1068,15 @@ void LRUCache<Key, Value, Policy, GetterKey>::nullRemovalCallback( const Key &ke
 {
 }
 
+template<typename Key, typename Value, template <typename> class Policy, typename GetterKey>
+CacheStatistics::SnapshotFunction LRUCache<Key, Value, Policy, GetterKey>::statisticsSnapshot( const LRUCache *cache )
+{
+	return [cache] ( CacheStatistics::Snapshot &snapshot ) {
+		snapshot.currentCost = cache->currentCost();
+		snapshot.maxCost = cache->getMaxCost();
+	};
+}
+
 } // namespace IECore
 
 #endif // IECORE_LRUCACHE_INL
@@ -35,9 +35,11 @@
 #ifndef IECORE_OBJECTPOOL_H
 #define IECORE_OBJECTPOOL_H
 
+#include "IECore/CacheStatistics.h"
 #include "IECore/Export.h"
 #include "IECore/MurmurHash.h"
 #include "IECore/Object.h"
+#include "IECore/SharedMemoryObjectCache.h"
 
 #include "boost/shared_ptr.hpp"
 
@@ -101,6 +103,21 @@ class IECORE_API ObjectPool : public RefCounted
 		/// prevent affecting the contents of the pool and it's memoryUsage count.
 		ConstObjectPtr store( const Object *obj, StoreMode mode );
 
+		/// Sets a SharedMemoryObjectCache to be used as a second tier for the
+		/// pool, so that objects can be shared with other processes. Objects
+		/// missing from the pool are retrieved from the cache if possible, and
+		/// stored objects are added to it. Pass null to stop using a cache.
+		/// The default pool uses SharedMemoryObjectCache::defaultCache(). This
+		/// must not be called concurrently with other methods.
+		void setSharedMemoryCache( SharedMemoryObjectCachePtr cache );
+		SharedMemoryObjectCache *getSharedMemoryCache() const;
+
+		/// Returns statistics describing the usage of the pool. Hits and
+		/// misses are counted by `retrieve()`. The statistics for the
+		/// default pool are registered with the name "ObjectPool".
+		CacheStatistics &statistics();
+		const CacheStatistics &statistics() const;
+
 		/// Returns a static ObjectPool instance to be used by anything
 		/// wishing to share IECore::Object instances.
 		/// It makes sense to use this wherever possible to conserve memory. This initially
@@ -44,12 +44,22 @@
 
 #include "boost/iterator_adaptors.hpp"
 
+#include <atomic>
 #include <map>
 #include <vector>
 
 namespace IECore
 {
 
+template<typename T>
+class TypedData;
+
+class PathMatcher;
+class FrozenPathMatcher;
+
+// Enables `MurmurHash::append( const PathMatcher & )`
+IECORE_API void murmurHashAppend( IECore::MurmurHash &h, const IECore::PathMatcher &data );
+
 /// The PathMatcher class provides an acceleration structure for matching
 /// paths against a sequence of reference paths. It provides the internal
 /// implementation for the PathFilter.
@@ -146,6 +156,12 @@ class IECORE_API PathMatcher
 
 	private :
 
+		// PathMatcherData and FrozenPathMatcher access the tree
+		// of nodes directly, rather than via the iterators.
+		friend class TypedData<PathMatcher>;
+		friend class FrozenPathMatcher;
+		friend void murmurHashAppend( IECore::MurmurHash &h, const IECore::PathMatcher &data );
+
 		IE_CORE_FORWARDDECLARE( Node )
 
 		PathMatcher( const NodePtr &root );
@@ -219,6 +235,15 @@ class IECORE_API PathMatcher
 				bool clearChildren();
 				bool isEmpty();
 
+				// Returns a hash of the subtree rooted at this node. The
+				// hash is cached, so only nodes which have been edited since
+				// the last call need to be rehashed. It is safe to call this
+				// concurrently from multiple threads.
+				MurmurHash hash() const;
+				bool hashValid() const;
+				// Must be called whenever the node is edited in place.
+				void dirtyHash();
+
 				ChildMap children;
 				bool terminator;
 
@@ -230,12 +255,23 @@ class IECORE_API PathMatcher
 				// leaf node.
 				static Node *leaf();
 
+			private :
+
+				// Stored as separate atomics rather than as a MurmurHash,
+				// so that concurrent calls to `hash()` do not race.
+				mutable std::atomic<uint64_t> m_hash1;
+				mutable std::atomic<uint64_t> m_hash2;
+				mutable std::atomic<bool> m_hashValid;
+
 		};
 
 		typedef std::vector<IECore::InternedString>::const_iterator NameIterator;
 
 		// Utility used in lazy-copy-on-write.
 		PathMatcher::Node *writable( Node *node, NodePtr &writableCopy, bool shared );
+		// Utility used to dirty the hash of `node` when a recursive walk
+		// has edited `child` in place.
+		static void propagateDirtyHash( Node *node, const Node *child, const Node *newChild, bool shared );
 
 		// Recursive method used to add a path to a Node tree. Since nodes may be shared among multiple
 		// trees, we perform lazy-copy-on-write when needing to edit a shared node. When we do this,
@@ -245,6 +281,11 @@ class IECORE_API PathMatcher
 		NodePtr addPathsWalk( Node *node, const Node *srcNode, bool shared, bool &added );
 		NodePtr addPrefixedPathsWalk( Node *node, const Node *srcNode, const NameIterator &start, const NameIterator &end, bool shared, bool &added  );
 		NodePtr removePathsWalk( Node *node, const Node *srcNode, bool shared, bool &removed );
+		// Returns the intersection of the two subtrees, or null if it is empty.
+		NodePtr intersectionWalk( Node *node, Node *srcNode ) const;
+
+		// Used by the walks to process the children of wide nodes in parallel.
+		struct ChildWalk;
 
 		void matchWalk( const Node *node, const NameIterator &start, const NameIterator &end, unsigned &result ) const;
 
@@ -348,9 +389,6 @@ class PathMatcher::Iterator : public boost::iterator_adaptor<Iterator, PathMatch
 
 };
 
-// Enables `MurmurHash::append( const PathMatcher & )`
-IECORE_API void murmurHashAppend( IECore::MurmurHash &h, const IECore::PathMatcher &data );
-
 } // namespace IECore
 
 #include "IECore/PathMatcher.inl"
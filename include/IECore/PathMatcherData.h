@@ -41,6 +41,10 @@
 namespace IECore
 {
 
+/// Files are written in a format readable by all previous versions unless
+/// the `IECORE_PATHMATCHERDATA_IOVERSION` environment variable is set to 1,
+/// in which case a more compact format is used which stores the tree
+/// directly. Both formats may be loaded.
 IECORE_DECLARE_TYPEDDATA( PathMatcherData, PathMatcher, void, SharedDataHolder )
 
 } // namespace IECore
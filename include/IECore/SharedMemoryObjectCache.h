@@ -0,0 +1,152 @@
+//////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (c) 2026, Image Engine Design Inc. All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//
+//     * Neither the name of Image Engine Design nor the names of any
+//       other contributors to this software may be used to endorse or
+//       promote products derived from this software without specific prior
+//       written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+//  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+//  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+//  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+//  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+//  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+//  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+//  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+//  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+//  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//////////////////////////////////////////////////////////////////////////
+
+
+#ifndef IECORE_SHAREDMEMORYOBJECTCACHE_H
+#define IECORE_SHAREDMEMORYOBJECTCACHE_H
+
+#include "IECore/CacheStatistics.h"
+#include "IECore/Export.h"
+#include "IECore/MurmurHash.h"
+#include "IECore/Object.h"
+
+#include <memory>
+
+namespace IECore
+{
+
+IE_CORE_FORWARDDECLARE( SharedMemoryObjectCache );
+
+/// \addtogroup environmentGroup
+///
+/// <b>IECORE_SHAREDMEMORYOBJECTCACHE_NAME</b><br>
+/// Names the shared memory segment used by SharedMemoryObjectCache::defaultCache().
+/// The default cache is disabled unless this is set.
+///
+/// <b>IECORE_SHAREDMEMORYOBJECTCACHE_MEMORY</b><br>
+/// The size in megabytes of the segment used by SharedMemoryObjectCache::defaultCache(),
+/// applied only by the process which creates it. Defaults to 1024.
+
+/// A cache of serialised Objects stored in a named POSIX shared memory segment,
+/// so that they can be shared between all the processes run by the same user
+/// on a machine. The segment is created with permissions for its owner only,
+/// so that other users can neither read the cached objects nor inject their own.
+/// This allows sibling processes to load an object from memory instead of
+/// reading and decompressing it from disk again. Objects are stored in their
+/// uncompressed MemoryIndexedIO form, so each process still holds its own
+/// decoded copy, but the cost of loading is only that of copying and
+/// unpacking it.
+///
+/// The segment is used as a ring buffer, so the oldest objects are discarded
+/// to make room for new ones. Keys must be stable across processes - an
+/// Object's own hash is suitable, as is a hash of a file name, modification
+/// time and location within the file.
+///
+/// Storage is coordinated by a process-shared mutex and retrieval takes the
+/// mutex only briefly, to look the object up in the index. A process which
+/// dies while holding the mutex does not prevent others from using the
+/// cache. All methods are threadsafe.
+///
+/// The segment persists until it is removed with `remove()` or the machine
+/// is restarted. It is only available on platforms supporting POSIX shared
+/// memory - elsewhere the constructor throws and `defaultCache()` returns
+/// null.
+///
+/// \ingroup utilityGroup
+class IECORE_API SharedMemoryObjectCache : public RefCounted
+{
+
+	public :
+
+		IE_CORE_DECLAREMEMBERPTR( SharedMemoryObjectCache );
+
+		/// Opens the shared memory segment with the given name, creating it
+		/// with the given size in bytes if it doesn't exist already. The
+		/// name should be a simple identifier without slashes, and all
+		/// cooperating processes must use the same one. Throws if the
+		/// segment cannot be opened or was created by an incompatible
+		/// version of Cortex.
+		SharedMemoryObjectCache( const std::string &name, size_t size );
+		~SharedMemoryObjectCache() override;
+
+		const std::string &name() const;
+
+		/// Returns the number of bytes available for storing objects. This
+		/// is determined by the process which created the segment.
+		size_t getMaxMemoryUsage() const;
+		/// Returns the number of bytes currently used for storing objects.
+		size_t memoryUsage() const;
+
+		/// Returns true if an object is stored with the given key. Note that
+		/// this doesn't guarantee that `retrieve()` will find it, as it may
+		/// be discarded by another process in the meantime.
+		bool contains( const MurmurHash &key ) const;
+		/// Returns a new copy of the object stored with the given key, or
+		/// null if there is none.
+		ObjectPtr retrieve( const MurmurHash &key ) const;
+		/// Stores a copy of the object with the given key, replacing any
+		/// existing object with that key. Returns false if the object is too
+		/// large to be stored.
+		bool store( const MurmurHash &key, const Object *object );
+		/// Discards all the stored objects, for all processes.
+		void clear();
+
+		/// Returns statistics describing the usage of the cache by this
+		/// process. Hits and misses are counted by `retrieve()`. The statistics
+		/// for the default cache are registered with the name
+		/// "SharedMemoryObjectCache".
+		CacheStatistics &statistics();
+		const CacheStatistics &statistics() const;
+
+		/// Removes the named segment, so that subsequent constructions create
+		/// it afresh. Processes which already have the segment open continue
+		/// to use it until they destroy their SharedMemoryObjectCache.
+		static void remove( const std::string &name );
+
+		/// Returns the cache specified by the IECORE_SHAREDMEMORYOBJECTCACHE_NAME
+		/// and IECORE_SHAREDMEMORYOBJECTCACHE_MEMORY environment variables, or
+		/// null if they don't specify one. This is used automatically by
+		/// ObjectPool::defaultObjectPool() and by SceneCache.
+		static SharedMemoryObjectCache *defaultCache();
+
+	private :
+
+		struct MemberData;
+		std::unique_ptr<MemberData> m_data;
+
+};
+
+} // namespace IECore
+
+#endif // IECORE_SHAREDMEMORYOBJECTCACHE_H
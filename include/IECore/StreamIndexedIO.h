@@ -177,6 +177,11 @@ class IECORE_API StreamIndexedIO : public IndexedIO
 				/// see 'setInput'
 				void read( char *buffer, size_t size, size_t pos);
 
+				/// Returns a pointer to 'size' bytes at 'pos' offset in the file when the
+				/// file is memory mapped, and nullptr otherwise. The pointer remains valid
+				/// for the lifetime of the StreamFile.
+				const char *mappedData( size_t size, size_t pos ) const;
+
 				void seekg( size_t pos, std::ios_base::seekdir dir );
 				void seekp( size_t pos, std::ios_base::seekdir dir );
 				void read( char *buffer, size_t size );
@@ -204,8 +209,16 @@ class IECORE_API StreamIndexedIO : public IndexedIO
 				StreamFile( IndexedIO::OpenMode mode );
 
 				/// Called during construction of derived classes. Assigns a stream and tells if the stream is empty.
-				/// Optionally provide a filename to use for lock free reading
-				void setInput( std::iostream *stream, bool emptyFile, const std::string& fileName );
+				/// Optionally provide a filename to use for lock free reading, and request that
+				/// the file be memory mapped. Memory mapping is only used for files opened in Read
+				/// mode, and may be forced on or off with the IECORE_STREAMINDEXEDIO_MMAP environment
+				/// variable.
+				void setInput( std::iostream *stream, bool emptyFile, const std::string& fileName, bool memoryMapped = false );
+
+				/// Called during construction of derived classes opened in Read mode, when the
+				/// stream is backed by a memory buffer which remains valid and unmodified for the
+				/// lifetime of the StreamFile. Reads then access the buffer directly and without locking.
+				void setInput( std::iostream *stream, const char *buffer, size_t size );
 
 				IndexedIO::OpenMode m_openmode;
 				std::iostream *m_stream;
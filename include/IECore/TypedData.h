@@ -97,6 +97,16 @@ class IECORE_EXPORT TypedData : public Data
 		/// modified behind the scenes, it may not be called while
 		/// other threads are operating on the same instance.
 		T &writable();
+		/// Gives read-write access to the internal data structure, for
+		/// modification via a pointer held by external code such as a
+		/// writable Python buffer. The data is first made unique, and
+		/// `exportToken` is set to an object which keeps it alive. While
+		/// the token exists, copies of this instance copy the data
+		/// immediately rather than sharing it, so that they are unaffected
+		/// by writes via the pointer. The pointer must be held together
+		/// with the token and this instance, and is invalidated if the
+		/// data is resized.
+		T &exportWritable( RefCountedPtr &exportToken );
 
 		/// Base type used in the internal data structure.
 		typedef typename TypedDataTraits<T>::BaseType BaseType;
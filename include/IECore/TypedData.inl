@@ -194,6 +194,12 @@ T & TypedData<T>::writable()
 	return m_data.writable();
 }
 
+template<class T>
+T & TypedData<T>::exportWritable( RefCountedPtr &exportToken )
+{
+	return m_data.exportWritable( exportToken );
+}
+
 template<class T>
 void TypedData<T>::memoryUsage( Object::MemoryAccumulator &accumulator ) const
 {
@@ -36,6 +36,9 @@
 #define IECORE_TYPEDDATAINTERNALS_H
 
 #include "IECore/MurmurHash.h"
+#include "IECore/RefCounted.h"
+
+#include <atomic>
 
 namespace IECore
 {
@@ -66,6 +69,14 @@ class IECORE_EXPORT SimpleDataHolder
 			return m_data;
 		}
 
+		T &exportWritable( RefCountedPtr &exportToken )
+		{
+			// Our data is never shared, so the TypedData
+			// itself is all that needs to be kept alive.
+			exportToken = nullptr;
+			return m_data;
+		}
+
 		bool operator == ( const SimpleDataHolder<T> &other ) const
 		{
 			return m_data == other.m_data;
@@ -98,6 +109,20 @@ class IECORE_EXPORT SharedDataHolder
 		{
 		}
 
+		SharedDataHolder( const SharedDataHolder<T> &other )
+			: m_data( other.share() )
+		{
+		}
+
+		SharedDataHolder<T> &operator = ( const SharedDataHolder<T> &other )
+		{
+			if( this != &other )
+			{
+				m_data = other.share();
+			}
+			return *this;
+		}
+
 		const T &readable() const
 		{
 			assert( m_data );
@@ -107,7 +132,9 @@ class IECORE_EXPORT SharedDataHolder
 		T &writable()
 		{
 			assert( m_data );
-			if( m_data->refCount() > 1 )
+			// References held by export tokens don't count, because
+			// the data is deliberately shared with the exported pointer.
+			if( m_data->refCount() > 1 + (RefCounted::RefCount)m_data->exports )
 			{
 				// duplicate the data
 				m_data = new Shareable( m_data->data );
@@ -116,6 +143,13 @@ class IECORE_EXPORT SharedDataHolder
 			return m_data->data;
 		}
 
+		T &exportWritable( RefCountedPtr &exportToken )
+		{
+			T &result = writable();
+			exportToken = new ExportToken( m_data.get() );
+			return result;
+		}
+
 		bool operator == ( const SharedDataHolder<T> &other ) const
 		{
 			if( m_data==other.m_data )
@@ -134,6 +168,13 @@ class IECORE_EXPORT SharedDataHolder
 		// datatype has special needs.
 		void hash( MurmurHash &h ) const
 		{
+			if( m_data->exports )
+			{
+				// The data may be modified via the exported
+				// pointer at any time, so we can't cache the hash.
+				h.append( hash() );
+				return;
+			}
 			if( !m_data->hashValid )
 			{
 				m_data->hash = hash();
@@ -160,18 +201,54 @@ class IECORE_EXPORT SharedDataHolder
 		{
 			public :
 
-				Shareable() : data(), hashValid( false ) {}
-				Shareable( const T &initData ) : data( initData ), hashValid( false ) {}
+				Shareable() : data(), hashValid( false ), exports( 0 ) {}
+				Shareable( const T &initData ) : data( initData ), hashValid( false ), exports( 0 ) {}
 
 				T data;
 				MurmurHash hash;
 				volatile bool hashValid;
+				// The number of live ExportTokens.
+				std::atomic<int> exports;
 
 		};
 
 		IE_CORE_DECLAREPTR( Shareable )
 		ShareablePtr m_data;
 
+		// Keeps exported data alive, and prevents it
+		// from being shared with other holders.
+		class ExportToken : public RefCounted
+		{
+			public :
+
+				ExportToken( Shareable *shareable )
+					:	m_shareable( shareable )
+				{
+					m_shareable->exports++;
+				}
+
+				~ExportToken() override
+				{
+					m_shareable->exports--;
+				}
+
+			private :
+
+				ShareablePtr m_shareable;
+
+		};
+
+		ShareablePtr share() const
+		{
+			if( m_data->exports )
+			{
+				// The data may be modified via the exported pointer
+				// at any time, so must be copied rather than shared.
+				return new Shareable( m_data->data );
+			}
+			return m_data;
+		}
+
 };
 
 template <class T>
@@ -0,0 +1,146 @@
+//////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (c) 2026, Image Engine Design Inc. All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//
+//     * Neither the name of Image Engine Design nor the names of any
+//       other contributors to this software may be used to endorse or
+//       promote products derived from this software without specific prior
+//       written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+//  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+//  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+//  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+//  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+//  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+//  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+//  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+//  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+//  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//////////////////////////////////////////////////////////////////////////
+
+
+#ifndef IECOREPYTHON_BUFFERBINDING_H
+#define IECOREPYTHON_BUFFERBINDING_H
+
+#include "boost/python.hpp"
+
+#include "IECorePython/Export.h"
+
+#include "IECore/Data.h"
+#include "IECore/Export.h"
+
+IECORE_PUSH_DEFAULT_VISIBILITY
+#include "OpenEXR/ImathBox.h"
+#include "OpenEXR/ImathMatrix.h"
+#include "OpenEXR/half.h"
+IECORE_POP_DEFAULT_VISIBILITY
+
+#include <vector>
+
+namespace IECorePython
+{
+
+IECOREPYTHON_API void bindBuffer();
+
+/// Returns a new `IECore.Buffer` object, which exposes the memory at `data` to
+/// Python via the buffer protocol, for zero-copy access from NumPy and `memoryview`.
+/// The memory must be owned by `owner`, which is kept alive for as long as the buffer
+/// exists, along with `exportToken`, as returned by `TypedData::exportWritable()`.
+/// `shape` gives the size of each dimension in elements of type `itemSize`,
+/// and `format` is a `struct` module format string describing each element.
+IECOREPYTHON_API boost::python::object makeBuffer( IECore::ConstDataPtr owner, IECore::ConstRefCountedPtr exportToken, const void *data, bool writable, const char *format, Py_ssize_t itemSize, const std::vector<Py_ssize_t> &shape );
+
+/// Returns true if a writable buffer created by `makeBuffer()` currently references
+/// the memory owned by `owner`. While this is the case, bindings must not resize
+/// the data, because that would leave the buffer dangling. Must be called with the
+/// GIL held.
+IECOREPYTHON_API bool hasWritableBuffer( const IECore::Data *owner );
+
+/// Provides the `struct` module format character for
+/// the base type of a TypedData class.
+template<typename T>
+struct BufferFormat;
+
+#define IECOREPYTHON_DEFINEBUFFERFORMAT( TYPE, FORMAT ) \
+	template<> \
+	struct BufferFormat<TYPE> \
+	{ \
+		static const char *value() { return FORMAT; } \
+	};
+
+IECOREPYTHON_DEFINEBUFFERFORMAT( half, "e" )
+IECOREPYTHON_DEFINEBUFFERFORMAT( float, "f" )
+IECOREPYTHON_DEFINEBUFFERFORMAT( double, "d" )
+IECOREPYTHON_DEFINEBUFFERFORMAT( int, "i" )
+IECOREPYTHON_DEFINEBUFFERFORMAT( unsigned int, "I" )
+IECOREPYTHON_DEFINEBUFFERFORMAT( char, "b" )
+IECOREPYTHON_DEFINEBUFFERFORMAT( unsigned char, "B" )
+IECOREPYTHON_DEFINEBUFFERFORMAT( short, "h" )
+IECOREPYTHON_DEFINEBUFFERFORMAT( unsigned short, "H" )
+IECOREPYTHON_DEFINEBUFFERFORMAT( int64_t, "q" )
+IECOREPYTHON_DEFINEBUFFERFORMAT( uint64_t, "Q" )
+
+#undef IECOREPYTHON_DEFINEBUFFERFORMAT
+
+/// Appends the dimensions of a single element of type T, measured
+/// in units of its base type. Scalars have no dimensions, vectors and
+/// colors have one, and matrices and boxes have two.
+template<typename T, typename BaseType>
+struct BufferElementShape
+{
+	static void append( std::vector<Py_ssize_t> &shape )
+	{
+		if( sizeof( T ) != sizeof( BaseType ) )
+		{
+			shape.push_back( sizeof( T ) / sizeof( BaseType ) );
+		}
+	}
+};
+
+template<typename T, typename BaseType>
+struct BufferElementShape<Imath::Matrix33<T>, BaseType>
+{
+	static void append( std::vector<Py_ssize_t> &shape )
+	{
+		shape.push_back( 3 );
+		shape.push_back( 3 );
+	}
+};
+
+template<typename T, typename BaseType>
+struct BufferElementShape<Imath::Matrix44<T>, BaseType>
+{
+	static void append( std::vector<Py_ssize_t> &shape )
+	{
+		shape.push_back( 4 );
+		shape.push_back( 4 );
+	}
+};
+
+template<typename T, typename BaseType>
+struct BufferElementShape<Imath::Box<T>, BaseType>
+{
+	static void append( std::vector<Py_ssize_t> &shape )
+	{
+		shape.push_back( 2 );
+		BufferElementShape<T, BaseType>::append( shape );
+	}
+};
+
+} // namespace IECorePython
+
+#endif // IECOREPYTHON_BUFFERBINDING_H
@@ -256,6 +256,8 @@ class GeometricVectorTypedDataFunctions : ThisBinder
 				.def("__itruediv__", &ThisGeometricBinder::idiv, "inplace division (s /= v) : accepts another vector of the same type or a single " Tname) \
 				.def("__cmp__", &ThisBinder::invalidOperator, "Raises an exception. This vector type does not support comparison operators.") \
 				.def("toString", &ThisBinder::toString, "Returns a string with a copy of the bytes in the vector.") \
+				.def("asReadOnlyBuffer", &ThisBinder::asReadOnlyBuffer, "Returns a read-only IECore.Buffer providing zero-copy access to the vector via the Python buffer protocol.") \
+				.def("asWritableBuffer", &ThisBinder::asWritableBuffer, "Returns a writable IECore.Buffer providing zero-copy access to the vector via the Python buffer protocol.") \
 				/* geometric methods */ \
 				.def("__init__", make_constructor(&ThisGeometricBinder::dataListOrSizeConstructorAndInterpretation), \
 					 "Accepts another vector of the same class or a python list containing " Tname \
@@ -37,6 +37,7 @@
 
 #include "boost/python.hpp"
 
+#include "IECorePython/BufferBinding.h"
 #include "IECorePython/IECoreBinding.h"
 #include "IECorePython/RunTimeTypedBinding.h"
 
@@ -145,6 +146,8 @@ class VectorTypedDataFunctions
 		/// set a range of items with a specified value or group of values
 		static void setSlice( ThisClass &x, PySliceObject *i, boost::python::object v )
 		{
+			checkResizable( x );
+
 			int64_t from, to;
 			convertSlice( x, i, from, to );
 
@@ -194,6 +197,7 @@ class VectorTypedDataFunctions
 		/// binding for append function
 		static void append( ThisClass &x, PyObject* v )
 		{
+			checkResizable( x );
 			Container &xData = x.writable();
 			boost::python::extract<data_type&> elem( v );
 			xData.push_back( convertValue( v ) );
@@ -207,6 +211,7 @@ class VectorTypedDataFunctions
 				delSlice( x, reinterpret_cast<PySliceObject*>( i ) );
 				return;
 			}
+			checkResizable( x );
 			Container &xData = x.writable();
 			index_type index = convertIndex( x, i );
 			xData.erase( xData.begin()+index );
@@ -217,6 +222,7 @@ class VectorTypedDataFunctions
 		{
 			int64_t from, to;
 			convertSlice( x, i, from, to );
+			checkResizable( x );
 			Container &xData = x.writable();
 			xData.erase( xData.begin()+from, xData.begin()+to );
 		}
@@ -236,11 +242,13 @@ class VectorTypedDataFunctions
 
 		static void resize( ThisClass &x, size_t s )
 		{
+			checkResizable( x );
 			x.writable().resize( s );
 		}
 
 		static void resizeWithValue( ThisClass &x, size_t s, const data_type &v )
 		{
+			checkResizable( x );
 			x.writable().resize( s, v );
 		}
 
@@ -286,6 +294,7 @@ class VectorTypedDataFunctions
 				}
 			}
 			// now concatenate the given list to the object
+			checkResizable( x );
 			Container &xData = x.writable();
 			const_iterator iterV = vData->begin();
 			for ( ; iterV != vData->end(); iterV++ )
@@ -344,6 +353,7 @@ class VectorTypedDataFunctions
 		/// binding for insert function
 		static void insert( ThisClass &x, PyObject *i, PyObject *v )
 		{
+			checkResizable( x );
 			Container &xData = x.writable();
 			typename Container::iterator iterX = xData.begin() + convertIndex( x, i, true );
 			xData.insert( iterX, convertValue( v ) );
@@ -540,8 +550,48 @@ class VectorTypedDataFunctions
 			);
 		}
 
+		/// Returns a read-only `IECore.Buffer` referencing the elements of `x`.
+		/// The buffer holds a copy of `x`, so it is unaffected by any
+		/// subsequent modifications to `x`, which will trigger copy-on-write.
+		static boost::python::object asReadOnlyBuffer( ThisClass &x )
+		{
+			typename ThisClass::ConstPtr copy = x.copy();
+			return buffer( copy, nullptr, copy->readable().data(), copy->readable().size(), false );
+		}
+
+		/// Returns a writable `IECore.Buffer` referencing the elements of `x`,
+		/// first making a unique copy of the elements if they are shared with
+		/// any other object. Writes to the buffer therefore modify `x` alone,
+		/// because copies made while the buffer exists don't share its
+		/// elements. The buffer keeps the elements alive even if `x` is
+		/// subsequently reassigned, and the bindings refuse to resize `x`
+		/// while the buffer exists.
+		static boost::python::object asWritableBuffer( ThisClass &x )
+		{
+			IECore::RefCountedPtr exportToken;
+			Container &data = x.exportWritable( exportToken );
+			return buffer( &x, exportToken, data.data(), data.size(), true );
+		}
 
 	protected:
+
+		static void checkResizable( const ThisClass &x )
+		{
+			if( hasWritableBuffer( &x ) )
+			{
+				PyErr_SetString( PyExc_BufferError, "Cannot resize vector while it is referenced by a writable buffer" );
+				boost::python::throw_error_already_set();
+			}
+		}
+
+		static boost::python::object buffer( IECore::ConstDataPtr owner, IECore::ConstRefCountedPtr exportToken, const data_type *data, size_t size, bool writable )
+		{
+			typedef typename ThisClass::BaseType BaseType;
+			std::vector<Py_ssize_t> shape( 1, size );
+			BufferElementShape<data_type, BaseType>::append( shape );
+			return makeBuffer( owner, exportToken, data, writable, BufferFormat<BaseType>::value(), sizeof( BaseType ), shape );
+		}
+
 		/*
 		 * Utility functions
 		 */
@@ -735,6 +785,17 @@ std::string str<IECore::TypedData<std::vector<TYPE> > >( IECore::TypedData<std::
 			;																						\
 		}
 
+// bind a VectorTypedData class that does not support Math operators, but
+// which can be accessed via the buffer protocol
+#define BIND_BUFFERED_VECTOR_TYPEDDATA(T, Tname)													\
+		{																							\
+			BASIC_VECTOR_BINDING(IECore::TypedData< std::vector< T > >, Tname)																	\
+				.def("__cmp__", &ThisBinder::invalidOperator, "Raises an exception. This vector type does not support comparison operators.")		\
+				.def("asReadOnlyBuffer", &ThisBinder::asReadOnlyBuffer, "Returns a read-only IECore.Buffer providing zero-copy access to the vector via the Python buffer protocol.")\
+				.def("asWritableBuffer", &ThisBinder::asWritableBuffer, "Returns a writable IECore.Buffer providing zero-copy access to the vector via the Python buffer protocol.")\
+			;																						\
+		}
+
 // bind a VectorTypedData class that supports simple Math operators (+=, -= and *=)
 #define BIND_SIMPLE_OPERATED_VECTOR_TYPEDDATA(T, Tname)									\
 		{																							\
@@ -748,6 +809,8 @@ std::string str<IECore::TypedData<std::vector<TYPE> > >( IECore::TypedData<std::
 				.def("__imul__", &ThisBinder::imul, "inplace multiplication (s *= v) : accepts another vector of the same type or a single " Tname)		\
 				.def("__cmp__", &ThisBinder::invalidOperator, "Raises an exception. This vector type does not support comparison operators.")		\
 				.def("toString", &ThisBinder::toString, "Returns a string with a copy of the bytes in the vector.")\
+				.def("asReadOnlyBuffer", &ThisBinder::asReadOnlyBuffer, "Returns a read-only IECore.Buffer providing zero-copy access to the vector via the Python buffer protocol.")\
+				.def("asWritableBuffer", &ThisBinder::asWritableBuffer, "Returns a writable IECore.Buffer providing zero-copy access to the vector via the Python buffer protocol.")\
 			;																						\
 		}
 
@@ -768,6 +831,8 @@ std::string str<IECore::TypedData<std::vector<TYPE> > >( IECore::TypedData<std::
 				.def("__itruediv__", &ThisBinder::idiv, "inplace division (s /= v) : accepts another vector of the same type or a single " Tname)			\
 				.def("__cmp__", &ThisBinder::invalidOperator, "Raises an exception. This vector type does not support comparison operators.")		\
 				.def("toString", &ThisBinder::toString, "Returns a string with a copy of the bytes in the vector.")\
+				.def("asReadOnlyBuffer", &ThisBinder::asReadOnlyBuffer, "Returns a read-only IECore.Buffer providing zero-copy access to the vector via the Python buffer protocol.")\
+				.def("asWritableBuffer", &ThisBinder::asWritableBuffer, "Returns a writable IECore.Buffer providing zero-copy access to the vector via the Python buffer protocol.")\
 			;																						\
 		}
 
@@ -792,6 +857,8 @@ std::string str<IECore::TypedData<std::vector<TYPE> > >( IECore::TypedData<std::
 				.def("__gt__", &ThisBinder::gt, "The comparison is element-wise, like a string comparison. \n")	\
 				.def("__ge__", &ThisBinder::ge, "The comparison is element-wise, like a string comparison. \n")	\
 				.def("toString", &ThisBinder::toString, "Returns a string with a copy of the bytes in the vector.")\
+				.def("asReadOnlyBuffer", &ThisBinder::asReadOnlyBuffer, "Returns a read-only IECore.Buffer providing zero-copy access to the vector via the Python buffer protocol.")\
+				.def("asWritableBuffer", &ThisBinder::asWritableBuffer, "Returns a writable IECore.Buffer providing zero-copy access to the vector via the Python buffer protocol.")\
 			; \
 		}
 
@@ -40,6 +40,7 @@
 
 #include "IECore/BoundedKDTree.h"
 
+#include <atomic>
 #include <mutex>
 
 namespace IECoreScene
@@ -178,14 +179,14 @@ class IECORESCENE_API CurvesPrimitiveEvaluator : public PrimitiveEvaluator
 
 		float integrateCurve( unsigned curveIndex, float vStart, float vEnd, int samples, Result& typedResult ) const;
 
-		CurvesPrimitivePtr m_curvesPrimitive;
+		ConstCurvesPrimitivePtr m_curvesPrimitive;
 		const std::vector<int> &m_verticesPerCurve;
 		std::vector<int> m_vertexDataOffsets; // one value per curve
 		std::vector<int> m_varyingDataOffsets; // one value per curve
 		PrimitiveVariable m_p;
 
 		void buildTree();
-		bool m_haveTree;
+		std::atomic<bool> m_haveTree;
 		typedef std::mutex TreeMutex;
 		TreeMutex m_treeMutex;
 		IECore::Box3fTree m_tree;
@@ -79,6 +79,11 @@ IECORESCENE_API std::pair<PrimitiveVariable, PrimitiveVariable> calculateDistort
 
 IECORESCENE_API void resamplePrimitiveVariable( const MeshPrimitive *mesh, PrimitiveVariable& primitiveVariable, PrimitiveVariable::Interpolation interpolation, const IECore::Canceller *canceller = nullptr );
 
+/// Resamples all the primitive variables in `primitiveVariables` to the specified interpolation,
+/// in parallel. Typically `primitiveVariables` will be a subset of `mesh->variables`, or
+/// `mesh->variables` itself.
+IECORESCENE_API void resamplePrimitiveVariables( const MeshPrimitive *mesh, PrimitiveVariableMap &primitiveVariables, PrimitiveVariable::Interpolation interpolation, const IECore::Canceller *canceller = nullptr );
+
 /// create a new MeshPrimitive deleting faces from the input MeshPrimitive based on the facesToDelete uniform (int|float|bool) PrimitiveVariable
 /// When invert is set then zeros in facesToDelete indicate which faces should be deleted
 IECORESCENE_API MeshPrimitivePtr deleteFaces( const MeshPrimitive *meshPrimitive, const PrimitiveVariable &facesToDelete, bool invert = false, const IECore::Canceller *canceller = nullptr );
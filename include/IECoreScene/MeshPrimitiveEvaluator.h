@@ -41,6 +41,7 @@
 
 #include "IECore/BoundedKDTree.h"
 
+#include <atomic>
 #include <mutex>
 #include <vector>
 
@@ -180,11 +181,19 @@ class IECORESCENE_API MeshPrimitiveEvaluator : public PrimitiveEvaluator
 		IECore::ConstV3fVectorDataPtr m_verts;
 		const std::vector<int> *m_meshVertexIds;
 
-		TriangleBoundVector m_triangles;
-		TriangleBoundTree *m_tree;
+		/// Builds the triangle bounds and trees if they haven't been built already.
+		/// This is deferred until the first query that needs them, and is threadsafe.
+		void buildTrees() const;
 
-		UVBoundVector m_uvTriangles;
-		UVBoundTree *m_uvTree;
+		mutable TriangleBoundVector m_triangles;
+		mutable TriangleBoundTree *m_tree;
+
+		mutable UVBoundVector m_uvTriangles;
+		mutable UVBoundTree *m_uvTree;
+
+		typedef std::mutex TreeMutex;
+		mutable TreeMutex m_treeMutex;
+		mutable std::atomic<bool> m_haveTrees;
 
 		bool pointAtUVWalk( UVBoundTree::NodeIndex nodeIndex, const Imath::V2f &targetUV, Result *result ) const;
 		void closestPointWalk( TriangleBoundTree::NodeIndex nodeIndex, const Imath::V3f &p, float &closestDistanceSqrd, Result *result ) const;
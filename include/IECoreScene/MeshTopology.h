@@ -0,0 +1,166 @@
+//////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (c) 2026, Image Engine Design Inc. All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//
+//     * Neither the name of Image Engine Design nor the names of any
+//       other contributors to this software may be used to endorse or
+//       promote products derived from this software without specific prior
+//       written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+//  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+//  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+//  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+//  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+//  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+//  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+//  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+//  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+//  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//////////////////////////////////////////////////////////////////////////
+
+
+#ifndef IECORESCENE_MESHTOPOLOGY_H
+#define IECORESCENE_MESHTOPOLOGY_H
+
+#include "IECoreScene/Export.h"
+#include "IECoreScene/MeshPrimitive.h"
+
+#include "IECore/Canceller.h"
+#include "IECore/Export.h"
+#include "IECore/RefCounted.h"
+
+IECORE_PUSH_DEFAULT_VISIBILITY
+#include "OpenEXR/ImathVec.h"
+IECORE_POP_DEFAULT_VISIBILITY
+
+#include <memory>
+#include <vector>
+
+namespace IECoreScene
+{
+
+IE_CORE_FORWARDDECLARE( MeshTopology );
+
+/// Adjacency information for the faces, face-vertices and vertices of a
+/// MeshPrimitive, for use by algorithms which need to find the faces
+/// around a vertex, the neighbours of a vertex and so on. Computing this
+/// is linear in the size of the mesh, so MeshTopology is usually acquired
+/// via `MeshTopology::get()`, which caches it for reuse by subsequent calls
+/// for meshes with the same topology. A MeshTopology is not modified after
+/// construction, apart from computing some of its members on first access,
+/// and may be shared freely between threads.
+/// \ingroup geometryProcessingGroup
+class IECORESCENE_API MeshTopology : public IECore::RefCounted
+{
+
+	public :
+
+		IE_CORE_DECLAREMEMBERPTR( MeshTopology );
+
+		/// A one-to-many relationship, stored in compressed row form. The
+		/// items related to item `i` are `values[offsets[i]]` to
+		/// `values[offsets[i+1]-1]`.
+		struct Adjacency
+		{
+			std::vector<int> offsets;
+			std::vector<int> values;
+
+			size_t size( size_t i ) const { return offsets[i+1] - offsets[i]; }
+			const int *begin( size_t i ) const { return values.data() + offsets[i]; }
+			const int *end( size_t i ) const { return values.data() + offsets[i+1]; }
+		};
+
+		/// Computes the topology for `mesh`. Prefer `get()`, which
+		/// reuses previous results.
+		MeshTopology( const MeshPrimitive *mesh, const IECore::Canceller *canceller = nullptr );
+		~MeshTopology() override;
+
+		/// Returns the topology for `mesh`, computing it only if it is not
+		/// already in the cache. Meshes with identical `verticesPerFace()`
+		/// and `vertexIds()` share the same MeshTopology, regardless of their
+		/// primitive variables.
+		static ConstMeshTopologyPtr get( const MeshPrimitive *mesh, const IECore::Canceller *canceller = nullptr );
+
+		size_t numFaces() const;
+		size_t numVertices() const;
+		size_t numFaceVertices() const;
+
+		//! @name Faces
+		////////////////////////////////////////////////////////////
+		//@{
+		/// The index of the first face-vertex of each face, followed
+		/// by `numFaceVertices()`.
+		const std::vector<int> &faceVertexOffsets() const;
+		/// The face that each face-vertex belongs to.
+		const std::vector<int> &faceVertexFaces() const;
+		/// The face-vertex following `faceVertex` in its face, wrapping
+		/// around to the first face-vertex at the end.
+		int nextFaceVertex( int faceVertex ) const;
+		//@}
+
+		//! @name Vertices
+		////////////////////////////////////////////////////////////
+		//@{
+		/// The face-vertices referencing each vertex, in ascending order.
+		const Adjacency &vertexFaceVertices() const;
+		/// The faces using each vertex, in ascending order and without
+		/// duplicates. Computed on first access.
+		const Adjacency &vertexFaces( const IECore::Canceller *canceller = nullptr ) const;
+		/// The vertices sharing an edge with each vertex, in ascending order
+		/// and without duplicates. Computed on first access.
+		const Adjacency &vertexNeighbours( const IECore::Canceller *canceller = nullptr ) const;
+		//@}
+
+		//! @name Edges
+		////////////////////////////////////////////////////////////
+		//@{
+		/// The unique edges of the mesh, each given as a pair of vertex
+		/// ids with the lowest first, in ascending order. Computed on
+		/// first access.
+		const std::vector<Imath::V2i> &edges( const IECore::Canceller *canceller = nullptr ) const;
+		/// The index in `edges()` of the edge from each face-vertex to the
+		/// next one in its face. Computed on first access.
+		const std::vector<int> &faceVertexEdges( const IECore::Canceller *canceller = nullptr ) const;
+		//@}
+
+		/// Returns the memory used by this MeshTopology, including members
+		/// which have not been computed yet.
+		size_t memoryUsage() const;
+
+		//! @name Cache
+		/// The cache used by `get()` is limited by the memory used by the
+		/// MeshTopologies it holds. The limit defaults to 500MB, and may be
+		/// set using the `IECORE_MESHTOPOLOGY_MEMORY` environment variable
+		/// (in megabytes) or `setMaxCacheMemoryUsage()`.
+		////////////////////////////////////////////////////////////
+		//@{
+		static void setMaxCacheMemoryUsage( size_t maxMemory );
+		static size_t getMaxCacheMemoryUsage();
+		static size_t cacheMemoryUsage();
+		static void clearCache();
+		//@}
+
+	private :
+
+		class MemberData;
+		std::unique_ptr<MemberData> m_data;
+
+};
+
+} // namespace IECoreScene
+
+#endif // IECORESCENE_MESHTOPOLOGY_H
@@ -40,6 +40,7 @@
 
 #include "IECore/KDTree.h"
 
+#include <atomic>
 #include <mutex>
 
 namespace IECoreScene
@@ -141,12 +142,12 @@ class IECORESCENE_API PointsPrimitiveEvaluator : public PrimitiveEvaluator
 
 		friend class Result;
 
-		PointsPrimitivePtr m_pointsPrimitive;
+		ConstPointsPrimitivePtr m_pointsPrimitive;
 		PrimitiveVariable m_p;
 		const std::vector<Imath::V3f> *m_pVector;
 
 		void buildTree();
-		bool m_haveTree;
+		std::atomic<bool> m_haveTree;
 		typedef std::mutex TreeMutex;
 		TreeMutex m_treeMutex;
 		IECore::V3fTree m_tree;
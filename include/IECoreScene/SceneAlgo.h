@@ -64,8 +64,13 @@ typedef std::map<std::string, size_t> SceneStats;
 
 IECORESCENE_API SceneStats parallelReadAll( const SceneInterface *src, int startFrame, int endFrame, float frameRate, unsigned int flags );
 
-/// copy from one scene to another.
+/// copy from one scene to another. Locations are read from `src` in parallel, and written
+/// to `dst` serially in a depth first order, so `dst` need not support concurrent writes.
 IECORESCENE_API void copy( const SceneInterface *src, SceneInterface *dst, int startFrame, int endFrame, float frameRate, unsigned int flags );
+/// As for copy(), but returning statistics. In addition to the counts returned by
+/// parallelReadAll(), these contain the time in microseconds spent in each stage :
+/// "traversalTime", "readTime" (summed over all threads), "writeTime" and "totalTime".
+IECORESCENE_API SceneStats copyWithStats( const SceneInterface *src, SceneInterface *dst, int startFrame, int endFrame, float frameRate, unsigned int flags );
 
 } // SceneAlgo
 
@@ -35,6 +35,7 @@
 #ifndef IECORESCENE_SCENECACHE_H
 #define IECORESCENE_SCENECACHE_H
 
+#include "IECore/CacheStatistics.h"
 #include "IECore/PathMatcherData.h"
 
 #include "IECoreScene/Export.h"
@@ -45,12 +46,21 @@ namespace IECoreScene
 
 IE_CORE_FORWARDDECLARE( SceneCache );
 
+/// \addtogroup environmentGroup
+///
+/// <b>IECORE_SCENECACHE_MEMORY</b><br>
+/// Specifies the memory limit, in megabytes, for the cache of objects read
+/// from SceneCaches. Defaults to 500. See SceneCache::setMaxCacheMemoryUsage().
+
 /// A simple means of saving and loading hierarchical descriptions of animated scene, with
 /// the ability to traverse the scene and perform partial loading on demand.
 /// When saving, it's important to keep the initial root SceneCache object alive until the very end.
 /// The destruction of the root scene will trigger the recursive computation of the bounding boxes for all the
 /// locations that no bounds were written. It will also store (without duplication) all the
 /// sample times used by objects, transforms, bounds and attributes.
+/// When saving, different threads may create and write to different locations
+/// concurrently, provided that each location is only written by one thread at a
+/// time, and that all writing has finished before the root is destroyed.
 /// \ingroup ioGroup
 class IECORESCENE_API SceneCache : public SampledSceneInterface
 {
@@ -68,7 +78,11 @@ class IECORESCENE_API SceneCache : public SampledSceneInterface
 		/// open mode is Read, only the const methods may be used and
 		/// when the open mode is Write, the non-const methods
 		/// may be used in addition. Append mode is currently not supported.
-		SceneCache( const std::string &fileName, IECore::IndexedIO::OpenMode mode );
+		/// The options are passed to IndexedIO::create(), and may be used to
+		/// control compression when writing - see FileIndexedIO for details.
+		/// Unless specified otherwise, "asynchronousCompression" is enabled
+		/// when writing.
+		SceneCache( const std::string &fileName, IECore::IndexedIO::OpenMode mode, const IECore::CompoundData *options = nullptr );
 		/// Constructor which uses an already-opened IndexedIO, this
 		/// can be used if you wish to use an alternative IndexedIO
 		/// implementation for the backend. The given IndexedIO should be
@@ -144,6 +158,19 @@ class IECORESCENE_API SceneCache : public SampledSceneInterface
 		static const Name &animatedObjectTopologyAttribute;
 		static const Name &animatedObjectPrimVarsAttribute;
 
+		/// Objects, attributes and transforms read from SceneCaches are
+		/// stored in a cache shared by all open files, limited by the
+		/// memory usage of the cached objects. The limit is specified in
+		/// bytes, and defaults to the value of the IECORE_SCENECACHE_MEMORY
+		/// environment variable, in megabytes.
+		static void setMaxCacheMemoryUsage( size_t maxMemory );
+		static size_t getMaxCacheMemoryUsage();
+		/// Returns the current memory usage of the cache.
+		static size_t cacheMemoryUsage();
+		/// Returns statistics for the cache. These are also registered
+		/// with the name "SceneCache".
+		static const IECore::CacheStatistics &cacheStatistics();
+
 	protected:
 
 		IE_CORE_FORWARDDECLARE( Implementation );
@@ -38,6 +38,8 @@
 #include "IECoreScene/Export.h"
 #include "IECoreScene/SceneInterface.h"
 
+#include "IECore/CacheStatistics.h"
+
 namespace IECoreScene
 {
 
@@ -62,6 +64,9 @@ class IECORESCENE_API SharedSceneInterfaces
 		static size_t getMaxScenes();
 		/// Returns the number of scene interfaces currently in the cache.
 		static size_t numScenes();
+		/// Returns statistics for the cache. These are also registered
+		/// with the name "SharedSceneInterfaces".
+		static const IECore::CacheStatistics &statistics();
 
 };
 
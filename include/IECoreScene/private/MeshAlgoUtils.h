@@ -0,0 +1,155 @@
+//////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (c) 2026, Image Engine Design Inc. All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//
+//     * Neither the name of Image Engine Design nor the names of any
+//       other contributors to this software may be used to endorse or
+//       promote products derived from this software without specific prior
+//       written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+//  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+//  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+//  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+//  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+//  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+//  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+//  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+//  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+//  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//////////////////////////////////////////////////////////////////////////
+
+
+#ifndef IECORESCENE_MESHALGOUTILS_H
+#define IECORESCENE_MESHALGOUTILS_H
+
+#include "IECoreScene/MeshTopology.h"
+
+#include "IECore/Canceller.h"
+
+#include "tbb/blocked_range.h"
+#include "tbb/parallel_for.h"
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <vector>
+
+namespace IECoreScene
+{
+
+namespace Detail
+{
+
+/// Calls `f( i )` for each `i` in `[0, size)`, in parallel.
+template<typename F>
+void parallelForEach( size_t size, const IECore::Canceller *canceller, F &&f )
+{
+	tbb::task_group_context taskGroupContext( tbb::task_group_context::isolated );
+	tbb::parallel_for(
+		tbb::blocked_range<size_t>( 0, size ),
+		[&f, canceller]( const tbb::blocked_range<size_t> &r )
+		{
+			IECore::Canceller::check( canceller );
+			for( size_t i = r.begin(); i != r.end(); ++i )
+			{
+				f( i );
+			}
+		},
+		taskGroupContext
+	);
+}
+
+/// Groups face-vertices by the element `target( faceVertex )` that they
+/// contribute to, so that each element may then be computed independently
+/// by gathering from its face-vertices, instead of by scattering from each
+/// face in turn. The face-vertices for each element are in ascending order,
+/// so gathering from them performs the same operations in the same order as
+/// a serial loop over the faces.
+template<typename TargetFn>
+MeshTopology::Adjacency groupFaceVertices( size_t numFaceVertices, size_t numElements, TargetFn &&target, const IECore::Canceller *canceller )
+{
+	MeshTopology::Adjacency result;
+	result.offsets.resize( numElements + 1, 0 );
+	result.values.resize( numFaceVertices );
+
+	// Count the face-vertices for each element.
+
+	std::unique_ptr<std::atomic<int>[]> counts( new std::atomic<int>[numElements]() );
+
+	tbb::task_group_context taskGroupContext( tbb::task_group_context::isolated );
+	tbb::parallel_for(
+		tbb::blocked_range<size_t>( 0, numFaceVertices ),
+		[&counts, &target, canceller]( const tbb::blocked_range<size_t> &r )
+		{
+			IECore::Canceller::check( canceller );
+			for( size_t i = r.begin(); i != r.end(); ++i )
+			{
+				counts[target( i )].fetch_add( 1, std::memory_order_relaxed );
+			}
+		},
+		taskGroupContext
+	);
+
+	// Turn the counts into offsets, reusing them as the position to
+	// insert the next face-vertex at.
+
+	IECore::Canceller::check( canceller );
+	std::vector<int> &offsets = result.offsets;
+	for( size_t i = 0; i < numElements; ++i )
+	{
+		offsets[i+1] = offsets[i] + counts[i].load( std::memory_order_relaxed );
+		counts[i].store( offsets[i], std::memory_order_relaxed );
+	}
+
+	std::vector<int> &faceVertices = result.values;
+	tbb::parallel_for(
+		tbb::blocked_range<size_t>( 0, numFaceVertices ),
+		[&faceVertices, &counts, &target, canceller]( const tbb::blocked_range<size_t> &r )
+		{
+			IECore::Canceller::check( canceller );
+			for( size_t i = r.begin(); i != r.end(); ++i )
+			{
+				faceVertices[counts[target( i )].fetch_add( 1, std::memory_order_relaxed )] = i;
+			}
+		},
+		taskGroupContext
+	);
+
+	// Face-vertices were inserted in arbitrary order by the loop above,
+	// so sort them to restore the serial order.
+
+	tbb::parallel_for(
+		tbb::blocked_range<size_t>( 0, numElements ),
+		[&faceVertices, &offsets, canceller]( const tbb::blocked_range<size_t> &r )
+		{
+			IECore::Canceller::check( canceller );
+			for( size_t i = r.begin(); i != r.end(); ++i )
+			{
+				std::sort( faceVertices.begin() + offsets[i], faceVertices.begin() + offsets[i+1] );
+			}
+		},
+		taskGroupContext
+	);
+
+	return result;
+}
+
+} // namespace Detail
+
+} // namespace IECoreScene
+
+#endif // IECORESCENE_MESHALGOUTILS_H
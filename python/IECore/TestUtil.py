@@ -34,6 +34,9 @@
 
 import os
 import sys
+import threading
+import time
+import timeit
 
 class TestUtil:
 	@staticmethod
@@ -58,3 +61,57 @@ class TestUtil:
 	@staticmethod
 	def inWindowsCI():
 		return TestUtil.platformWindows() and TestUtil.inCI()
+
+	## Returns True if calling `f()` releases the GIL for a substantial
+	# proportion of its duration, allowing other Python threads to run.
+	# This is measured by running a Python thread alongside the call, and
+	# seeing how much of the call's duration it was able to make progress
+	# during. For a meaningful result, `f()` should make a single call to
+	# C++ which takes tens of milliseconds or more.
+	@staticmethod
+	def releasesGIL( f ) :
+
+		ticks = []
+		done = threading.Event()
+		started = threading.Event()
+
+		if sys.version_info[0] >= 3 :
+			timer = time.perf_counter
+			getSwitchInterval, setSwitchInterval = sys.getswitchinterval, sys.setswitchinterval
+			minSwitchInterval = 1e-5
+		else :
+			# Python 2 switches threads after a number of bytecode
+			# instructions rather than a period of time.
+			timer = timeit.default_timer
+			getSwitchInterval, setSwitchInterval = sys.getcheckinterval, sys.setcheckinterval
+			minSwitchInterval = 1
+
+		def tick() :
+			started.set()
+			while not done.is_set() :
+				ticks.append( timer() )
+
+		# Reduce the switch interval so that the Python code either
+		# side of the C++ call can only hand the GIL to our thread
+		# for negligible periods.
+		switchInterval = getSwitchInterval()
+		setSwitchInterval( minSwitchInterval )
+		try :
+			thread = threading.Thread( target = tick )
+			thread.start()
+			started.wait()
+			start = timer()
+			f()
+			end = timer()
+			done.set()
+			thread.join()
+		finally :
+			setSwitchInterval( switchInterval )
+
+		# Count the milliseconds during which our
+		# thread ran at least once.
+		activeMilliseconds = set(
+			int( ( t - start ) * 1000 ) for t in ticks if start <= t <= end
+		)
+
+		return len( activeMilliseconds ) > 0.1 * ( end - start ) * 1000
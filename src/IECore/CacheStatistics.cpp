@@ -0,0 +1,187 @@
+//////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (c) 2026, Image Engine Design Inc. All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//
+//     * Neither the name of Image Engine Design nor the names of any
+//       other contributors to this software may be used to endorse or
+//       promote products derived from this software without specific prior
+//       written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+//  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+//  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+//  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+//  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+//  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+//  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+//  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+//  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+//  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//////////////////////////////////////////////////////////////////////////
+
+#include "IECore/CacheStatistics.h"
+
+#include <algorithm>
+#include <unordered_set>
+
+using namespace IECore;
+
+//////////////////////////////////////////////////////////////////////////
+// Registry
+//////////////////////////////////////////////////////////////////////////
+
+namespace
+{
+
+struct Registry
+{
+	std::mutex mutex;
+	std::unordered_set<CacheStatistics *> statistics;
+};
+
+Registry &registry()
+{
+	// Deliberately leaked, so that statistics owned by other static
+	// objects can still unregister themselves during shutdown.
+	static Registry *r = new Registry;
+	return *r;
+}
+
+} // namespace
+
+//////////////////////////////////////////////////////////////////////////
+// CacheStatistics
+//////////////////////////////////////////////////////////////////////////
+
+CacheStatistics::CacheStatistics( const SnapshotFunction &snapshotFunction, const ResetFunction &resetFunction )
+	:	m_snapshotFunction( snapshotFunction ), m_resetFunction( resetFunction ), m_hits( 0 ), m_misses( 0 ), m_evictions( 0 ), m_getterNanoseconds( 0 )
+{
+}
+
+CacheStatistics::~CacheStatistics()
+{
+	setName( "" );
+}
+
+void CacheStatistics::setName( const std::string &name )
+{
+	Registry &r = registry();
+	std::lock_guard<std::mutex> registryLock( r.mutex );
+	{
+		std::lock_guard<std::mutex> nameLock( m_nameMutex );
+		m_name = name;
+	}
+	if( name.empty() )
+	{
+		r.statistics.erase( this );
+	}
+	else
+	{
+		r.statistics.insert( this );
+	}
+}
+
+std::string CacheStatistics::getName() const
+{
+	std::lock_guard<std::mutex> lock( m_nameMutex );
+	return m_name;
+}
+
+CacheStatistics::Snapshot CacheStatistics::snapshot() const
+{
+	Snapshot result;
+	result.name = getName();
+	result.hits = m_hits.load( std::memory_order_relaxed );
+	result.misses = m_misses.load( std::memory_order_relaxed );
+	result.evictions = m_evictions.load( std::memory_order_relaxed );
+	result.getterSeconds = (double)m_getterNanoseconds.load( std::memory_order_relaxed ) / 1e9;
+	if( m_snapshotFunction )
+	{
+		m_snapshotFunction( result );
+	}
+	return result;
+}
+
+void CacheStatistics::reset()
+{
+	m_hits = 0;
+	m_misses = 0;
+	m_evictions = 0;
+	m_getterNanoseconds = 0;
+	if( m_resetFunction )
+	{
+		m_resetFunction();
+	}
+}
+
+std::vector<CacheStatistics::Snapshot> CacheStatistics::registered()
+{
+	std::vector<Snapshot> result;
+
+	Registry &r = registry();
+	{
+		// Holding the lock prevents statistics from being destroyed
+		// while we take their snapshot.
+		std::lock_guard<std::mutex> lock( r.mutex );
+		result.reserve( r.statistics.size() );
+		for( const auto &s : r.statistics )
+		{
+			result.push_back( s->snapshot() );
+		}
+	}
+
+	std::sort(
+		result.begin(), result.end(),
+		[] ( const Snapshot &a, const Snapshot &b ) {
+			return a.name < b.name;
+		}
+	);
+
+	return result;
+}
+
+void CacheStatistics::resetRegistered()
+{
+	Registry &r = registry();
+	std::lock_guard<std::mutex> lock( r.mutex );
+	for( const auto &s : r.statistics )
+	{
+		s->reset();
+	}
+}
+
+void CacheStatistics::recordHit()
+{
+	m_hits.fetch_add( 1, std::memory_order_relaxed );
+}
+
+void CacheStatistics::recordMiss()
+{
+	m_misses.fetch_add( 1, std::memory_order_relaxed );
+}
+
+void CacheStatistics::recordEviction()
+{
+	m_evictions.fetch_add( 1, std::memory_order_relaxed );
+}
+
+void CacheStatistics::recordGetterTime( std::chrono::steady_clock::duration duration )
+{
+	m_getterNanoseconds.fetch_add(
+		std::chrono::duration_cast<std::chrono::nanoseconds>( duration ).count(),
+		std::memory_order_relaxed
+	);
+}
@@ -0,0 +1,427 @@
+//////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (c) 2026, Image Engine Design Inc. All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//
+//     * Neither the name of Image Engine Design nor the names of any
+//       other contributors to this software may be used to endorse or
+//       promote products derived from this software without specific prior
+//       written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+//  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+//  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+//  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+//  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+//  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+//  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+//  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+//  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+//  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//////////////////////////////////////////////////////////////////////////
+
+
+#include "IECore/DiskObjectCache.h"
+
+#include "IECore/Exception.h"
+#include "IECore/FileIndexedIO.h"
+#include "IECore/MessageHandler.h"
+
+#include "boost/filesystem/operations.hpp"
+#include "boost/format.hpp"
+#include "boost/lexical_cast.hpp"
+#include "boost/unordered_map.hpp"
+
+#include <algorithm>
+#include <ctime>
+#include <list>
+#include <mutex>
+#include <vector>
+
+using namespace IECore;
+
+namespace
+{
+
+const std::string g_extension( ".cob" );
+const std::string g_temporaryExtension( ".tmp" );
+
+// Temporary files older than this are assumed to have been left
+// behind by a process which died while storing an object.
+const std::time_t g_staleTemporaryFileAge = 60 * 60;
+
+} // namespace
+
+//////////////////////////////////////////////////////////////////////////
+// MemberData
+//////////////////////////////////////////////////////////////////////////
+
+struct DiskObjectCache::MemberData
+{
+
+	MemberData( const std::string &directory, size_t maxDiskUsage )
+		:	directory( directory ), maxDiskUsage( maxDiskUsage ), diskUsage( 0 ),
+			statistics(
+				[this] ( CacheStatistics::Snapshot &snapshot ) {
+					std::lock_guard<std::mutex> lock( mutex );
+					snapshot.currentCost = diskUsage;
+					snapshot.maxCost = this->maxDiskUsage;
+				}
+			)
+	{
+		try
+		{
+			boost::filesystem::create_directories( directory );
+		}
+		catch( const std::exception &e )
+		{
+			throw IOException( boost::str( boost::format( "DiskObjectCache : Failed to create directory \"%1%\" (%2%)" ) % directory % e.what() ) );
+		}
+
+		scan();
+	}
+
+	// Objects are stored in subdirectories named after the first two
+	// characters of the key, to avoid any one directory becoming too large.
+	boost::filesystem::path path( const MurmurHash &key ) const
+	{
+		const std::string s = key.toString();
+		return boost::filesystem::path( directory ) / s.substr( 0, 2 ) / ( s + g_extension );
+	}
+
+	// Populates the index with the files already in the directory,
+	// ordered by their modification times.
+	void scan()
+	{
+		struct File
+		{
+			std::time_t time;
+			MurmurHash key;
+			uint64_t size;
+		};
+		std::vector<File> files;
+
+		const std::time_t staleTime = std::time( nullptr ) - g_staleTemporaryFileAge;
+		boost::system::error_code ec;
+		for( boost::filesystem::recursive_directory_iterator it( directory, ec ), eIt; !ec && it != eIt; it.increment( ec ) )
+		{
+			const boost::filesystem::path &p = it->path();
+			if( !boost::filesystem::is_regular_file( it->status() ) )
+			{
+				continue;
+			}
+
+			const std::time_t time = boost::filesystem::last_write_time( p, ec );
+			if( ec )
+			{
+				ec.clear();
+				continue;
+			}
+
+			if( p.extension() == g_temporaryExtension )
+			{
+				// Recent temporary files may still be being written by
+				// another process, so we only remove old ones.
+				if( time < staleTime )
+				{
+					boost::filesystem::remove( p, ec );
+					ec.clear();
+				}
+				continue;
+			}
+
+			const std::string stem = p.stem().string();
+			if( p.extension() != g_extension || stem.size() != 32 )
+			{
+				continue;
+			}
+
+			const MurmurHash key( stem );
+			const uintmax_t size = boost::filesystem::file_size( p, ec );
+			if( ec || this->path( key ) != p )
+			{
+				ec.clear();
+				continue;
+			}
+
+			files.push_back( { time, key, size } );
+		}
+
+		std::sort( files.begin(), files.end(), [] ( const File &a, const File &b ) { return a.time < b.time; } );
+
+		std::lock_guard<std::mutex> lock( mutex );
+		for( const auto &f : files )
+		{
+			insert( f.key, f.size );
+		}
+		evict();
+	}
+
+	// Index methods. These must be called with the mutex held.
+	//////////////////////////////////////////////////////////
+
+	// Adds the key to the index as the most recently used,
+	// or updates it if it is already present.
+	void insert( const MurmurHash &key, uint64_t size )
+	{
+		remove( key );
+		items.push_back( Item( key, size ) );
+		map[key] = std::prev( items.end() );
+		diskUsage += size;
+	}
+
+	// Removes the key from the index, returning true if it was present.
+	bool remove( const MurmurHash &key )
+	{
+		auto it = map.find( key );
+		if( it == map.end() )
+		{
+			return false;
+		}
+		diskUsage -= it->second->second;
+		items.erase( it->second );
+		map.erase( it );
+		return true;
+	}
+
+	// Deletes the least recently used files until we are within
+	// the maximum disk usage.
+	void evict()
+	{
+		while( diskUsage > maxDiskUsage && !items.empty() )
+		{
+			const MurmurHash key = items.front().first;
+			boost::system::error_code ec;
+			boost::filesystem::remove( path( key ), ec );
+			remove( key );
+			statistics.recordEviction();
+		}
+	}
+
+	const std::string directory;
+
+	// Pairs of key and file size, ordered from least
+	// to most recently used.
+	using Item = std::pair<MurmurHash, uint64_t>;
+	using Items = std::list<Item>;
+
+	mutable std::mutex mutex;
+	Items items;
+	boost::unordered_map<MurmurHash, Items::iterator> map;
+	uint64_t maxDiskUsage;
+	uint64_t diskUsage;
+
+	CacheStatistics statistics;
+
+};
+
+//////////////////////////////////////////////////////////////////////////
+// DiskObjectCache
+//////////////////////////////////////////////////////////////////////////
+
+DiskObjectCache::DiskObjectCache( const std::string &directory, size_t maxDiskUsage )
+	:	m_data( new MemberData( directory, maxDiskUsage ) )
+{
+}
+
+DiskObjectCache::~DiskObjectCache()
+{
+}
+
+const std::string &DiskObjectCache::directory() const
+{
+	return m_data->directory;
+}
+
+void DiskObjectCache::setMaxDiskUsage( size_t maxDiskUsage )
+{
+	std::lock_guard<std::mutex> lock( m_data->mutex );
+	m_data->maxDiskUsage = maxDiskUsage;
+	m_data->evict();
+}
+
+size_t DiskObjectCache::getMaxDiskUsage() const
+{
+	std::lock_guard<std::mutex> lock( m_data->mutex );
+	return m_data->maxDiskUsage;
+}
+
+size_t DiskObjectCache::diskUsage() const
+{
+	std::lock_guard<std::mutex> lock( m_data->mutex );
+	return m_data->diskUsage;
+}
+
+bool DiskObjectCache::contains( const MurmurHash &key ) const
+{
+	boost::system::error_code ec;
+	return boost::filesystem::is_regular_file( m_data->path( key ), ec );
+}
+
+ObjectPtr DiskObjectCache::retrieve( const MurmurHash &key ) const
+{
+	const boost::filesystem::path path = m_data->path( key );
+
+	ObjectPtr result;
+	uint64_t size = 0;
+	boost::system::error_code ec;
+	if( boost::filesystem::is_regular_file( path, ec ) )
+	{
+		try
+		{
+			IndexedIOPtr io = new FileIndexedIO( path.string(), IndexedIO::rootPath, IndexedIO::Shared | IndexedIO::Read );
+			result = Object::load( io, "object" );
+			size = boost::filesystem::file_size( path );
+		}
+		catch( const std::exception &e )
+		{
+			// The file may have been deleted by another process since we
+			// checked for it. Otherwise it is unreadable, perhaps because
+			// the machine crashed before the file was flushed to disk, so
+			// we remove it.
+			result = nullptr;
+			if( boost::filesystem::exists( path, ec ) )
+			{
+				msg( Msg::Warning, "DiskObjectCache::retrieve", boost::format( "Removing unreadable file \"%1%\" (%2%)" ) % path.string() % e.what() );
+				boost::filesystem::remove( path, ec );
+			}
+		}
+	}
+
+	if( result )
+	{
+		// Record the use in the file itself, so that it
+		// is used for the ordering in future sessions.
+		boost::filesystem::last_write_time( path, std::time( nullptr ), ec );
+	}
+
+	std::lock_guard<std::mutex> lock( m_data->mutex );
+	if( !result )
+	{
+		m_data->remove( key );
+		m_data->statistics.recordMiss();
+		return nullptr;
+	}
+
+	m_data->insert( key, size );
+	m_data->evict();
+	m_data->statistics.recordHit();
+	return result;
+}
+
+void DiskObjectCache::store( const MurmurHash &key, const Object *object )
+{
+	const boost::filesystem::path path = m_data->path( key );
+	const boost::filesystem::path temporaryPath = path.parent_path() / boost::filesystem::unique_path(
+		path.filename().string() + ".%%%%-%%%%-%%%%-%%%%" + g_temporaryExtension
+	);
+
+	uint64_t size = 0;
+	try
+	{
+		boost::filesystem::create_directories( path.parent_path() );
+		{
+			IndexedIOPtr io = new FileIndexedIO( temporaryPath.string(), IndexedIO::rootPath, IndexedIO::Exclusive | IndexedIO::Write );
+			object->save( io, "object" );
+		}
+		size = boost::filesystem::file_size( temporaryPath );
+		// Renaming is atomic, so other readers will only ever see
+		// the complete file.
+		boost::filesystem::rename( temporaryPath, path );
+	}
+	catch( const std::exception &e )
+	{
+		boost::system::error_code ec;
+		boost::filesystem::remove( temporaryPath, ec );
+		throw IOException( boost::str( boost::format( "DiskObjectCache : Failed to store \"%1%\" (%2%)" ) % path.string() % e.what() ) );
+	}
+
+	std::lock_guard<std::mutex> lock( m_data->mutex );
+	m_data->insert( key, size );
+	m_data->evict();
+}
+
+bool DiskObjectCache::erase( const MurmurHash &key )
+{
+	std::lock_guard<std::mutex> lock( m_data->mutex );
+	m_data->remove( key );
+	boost::system::error_code ec;
+	return boost::filesystem::remove( m_data->path( key ), ec );
+}
+
+void DiskObjectCache::clear()
+{
+	std::lock_guard<std::mutex> lock( m_data->mutex );
+
+	// Remove everything in the directory, not just the
+	// files we know about, so that we include objects
+	// stored by other processes.
+	std::vector<boost::filesystem::path> toRemove;
+	boost::system::error_code ec;
+	for( boost::filesystem::recursive_directory_iterator it( m_data->directory, ec ), eIt; !ec && it != eIt; it.increment( ec ) )
+	{
+		if( it->path().extension() == g_extension && boost::filesystem::is_regular_file( it->status() ) )
+		{
+			toRemove.push_back( it->path() );
+		}
+	}
+
+	for( const auto &p : toRemove )
+	{
+		boost::filesystem::remove( p, ec );
+	}
+
+	m_data->items.clear();
+	m_data->map.clear();
+	m_data->diskUsage = 0;
+}
+
+CacheStatistics &DiskObjectCache::statistics()
+{
+	return m_data->statistics;
+}
+
+const CacheStatistics &DiskObjectCache::statistics() const
+{
+	return m_data->statistics;
+}
+
+DiskObjectCache *DiskObjectCache::defaultCache()
+{
+	// Deliberately leaked, to avoid destruction order problems at exit.
+	static DiskObjectCache *c = [] () -> DiskObjectCache * {
+		const char *directory = getenv( "IECORE_DISKOBJECTCACHE_PATH" );
+		if( !directory || !*directory )
+		{
+			return nullptr;
+		}
+
+		const char *m = getenv( "IECORE_DISKOBJECTCACHE_SIZE" );
+		size_t mi = m ? boost::lexical_cast<size_t>( m ) : 10240;
+		try
+		{
+			DiskObjectCache *result = new DiskObjectCache( directory, 1024 * 1024 * mi );
+			result->addRef();
+			result->statistics().setName( "DiskObjectCache" );
+			return result;
+		}
+		catch( const std::exception &e )
+		{
+			msg( Msg::Warning, "DiskObjectCache::defaultCache", e.what() );
+			return nullptr;
+		}
+	}();
+	return c;
+}
@@ -0,0 +1,726 @@
+//////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (c) 2026, Image Engine Design Inc. All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//
+//     * Neither the name of Image Engine Design nor the names of any
+//       other contributors to this software may be used to endorse or
+//       promote products derived from this software without specific prior
+//       written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+//  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+//  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+//  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+//  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+//  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+//  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+//  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+//  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+//  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//////////////////////////////////////////////////////////////////////////
+
+
+#include "IECore/FrozenPathMatcher.h"
+
+#include "IECore/Exception.h"
+#include "IECore/StringAlgo.h"
+
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <unordered_map>
+
+using namespace std;
+using namespace IECore;
+
+namespace
+{
+
+IECore::InternedString g_ellipsis( "..." );
+
+const uint32_t g_invalid = std::numeric_limits<uint32_t>::max();
+
+// Nodes with at least this many plain children get a hash table
+// for finding children, rather than using a binary search.
+const size_t g_minHashedChildren = 16;
+
+inline size_t hashName( const InternedString &name )
+{
+	// InternedStrings are unique, so we can hash the address of the
+	// string rather than its contents. Note that taking the address
+	// doesn't touch the string itself, avoiding a cache miss.
+	return ( reinterpret_cast<uintptr_t>( &name.string() ) * 0x9E3779B97F4A7C15ull ) >> 32;
+}
+
+} // namespace
+
+//////////////////////////////////////////////////////////////////////////
+// Storage
+//////////////////////////////////////////////////////////////////////////
+
+class FrozenPathMatcher::Storage : public IECore::RefCounted
+{
+
+	public :
+
+		Storage()
+		{
+			nodes.push_back( Node() );
+		}
+
+		struct Node
+		{
+			// The children of each node are stored contiguously in
+			// `children`, with the plain children in `[childrenBegin, wildcardsBegin)`
+			// sorted for binary search, followed by the wildcarded children.
+			uint32_t childrenBegin = 0;
+			uint32_t wildcardsBegin = 0;
+			uint32_t childrenEnd = 0;
+			// Index of the "..." child in `children`.
+			uint32_t ellipsis = g_invalid;
+			// Open addressing hash table for the plain children, stored
+			// in `hashTable`. Only used when `hashTableMask` is non-zero.
+			uint32_t hashTableBegin = 0;
+			uint32_t hashTableMask = 0;
+			bool terminator = false;
+		};
+
+		struct Child
+		{
+			InternedString name;
+			// Index into `nodes`.
+			uint32_t node;
+			bool operator < ( const InternedString &other ) const { return name < other; }
+		};
+
+		// Returns the index in `nodes` of the plain child called `name`,
+		// or `g_invalid` if it doesn't exist.
+		uint32_t findPlainChild( const Node &node, const InternedString &name ) const
+		{
+			if( node.hashTableMask )
+			{
+				// The table holds copies of the children, so that a
+				// successful lookup touches only one cache line.
+				const Child *table = hashTable.data() + node.hashTableBegin;
+				for( size_t i = hashName( name ) & node.hashTableMask; ; i = ( i + 1 ) & node.hashTableMask )
+				{
+					const Child &child = table[i];
+					if( child.node == g_invalid || child.name == name )
+					{
+						return child.node;
+					}
+				}
+			}
+
+			const uint32_t child = findChild( node, name, /* plainOnly = */ true );
+			return child != g_invalid ? children[child].node : g_invalid;
+		}
+
+		// Returns the index in `children` of the child called `name`,
+		// or `g_invalid` if it doesn't exist. Wildcarded children are
+		// found by their literal name, as for `PathMatcher::find()`.
+		uint32_t findChild( const Node &node, const InternedString &name, bool plainOnly = false ) const
+		{
+			auto begin = children.begin() + node.childrenBegin;
+			auto end = children.begin() + node.wildcardsBegin;
+			auto it = std::lower_bound( begin, end, name );
+			if( it != end && it->name == name )
+			{
+				return it - children.begin();
+			}
+
+			if( !plainOnly )
+			{
+				for( uint32_t child = node.wildcardsBegin; child < node.childrenEnd; ++child )
+				{
+					if( children[child].name == name )
+					{
+						return child;
+					}
+				}
+			}
+
+			return g_invalid;
+		}
+
+		void buildHashTable( Node &node )
+		{
+			const size_t numPlainChildren = node.wildcardsBegin - node.childrenBegin;
+			if( numPlainChildren < g_minHashedChildren )
+			{
+				return;
+			}
+
+			// Keep the load factor at or below 0.5.
+			size_t size = 1;
+			while( size < numPlainChildren * 2 )
+			{
+				size *= 2;
+			}
+
+			node.hashTableBegin = hashTable.size();
+			node.hashTableMask = size - 1;
+			hashTable.resize( hashTable.size() + size, Child{ InternedString(), g_invalid } );
+
+			Child *table = hashTable.data() + node.hashTableBegin;
+			for( uint32_t child = node.childrenBegin; child < node.wildcardsBegin; ++child )
+			{
+				size_t i = hashName( children[child].name ) & node.hashTableMask;
+				while( table[i].node != g_invalid )
+				{
+					i = ( i + 1 ) & node.hashTableMask;
+				}
+				table[i] = children[child];
+			}
+		}
+
+		std::vector<Node> nodes;
+		std::vector<Child> children;
+		std::vector<Child> hashTable;
+
+};
+
+//////////////////////////////////////////////////////////////////////////
+// FrozenPathMatcher
+//////////////////////////////////////////////////////////////////////////
+
+FrozenPathMatcher::FrozenPathMatcher()
+	:	m_storage( new Storage ), m_root( 0 )
+{
+}
+
+FrozenPathMatcher::FrozenPathMatcher( const PathMatcher &pathMatcher )
+	:	m_root( 0 )
+{
+	StoragePtr storage = new Storage;
+
+	// Nodes are numbered in breadth first order, so that the nodes for
+	// siblings are adjacent in memory. Nodes shared by several parents
+	// in the source (including the shared leaf node) are numbered only
+	// once, and are shared in the result.
+
+	std::vector<const PathMatcher::Node *> sources = { pathMatcher.m_root.get() };
+	std::unordered_map<const PathMatcher::Node *, uint32_t> sourceIndices = { { pathMatcher.m_root.get(), 0 } };
+
+	for( size_t i = 0; i < sources.size(); ++i )
+	{
+		const PathMatcher::Node *source = sources[i];
+
+		if( storage->children.size() + source->children.size() >= g_invalid )
+		{
+			throw IECore::Exception( "FrozenPathMatcher : Too many paths" );
+		}
+
+		Storage::Node node;
+		node.terminator = source->terminator;
+		node.childrenBegin = storage->children.size();
+		node.wildcardsBegin = g_invalid;
+
+		// ChildMap is sorted first by wildcard type and then by
+		// InternedString, which is exactly the order we need.
+		for( const auto &child : source->children )
+		{
+			const uint32_t childIndex = storage->children.size();
+			if( child.first.type != PathMatcher::Name::Plain && node.wildcardsBegin == g_invalid )
+			{
+				node.wildcardsBegin = childIndex;
+			}
+			if( child.first.name == g_ellipsis )
+			{
+				node.ellipsis = childIndex;
+			}
+
+			const auto inserted = sourceIndices.insert( { child.second.get(), sources.size() } );
+			if( inserted.second )
+			{
+				sources.push_back( child.second.get() );
+			}
+
+			storage->children.push_back( { child.first.name, inserted.first->second } );
+		}
+
+		node.childrenEnd = storage->children.size();
+		if( node.wildcardsBegin == g_invalid )
+		{
+			node.wildcardsBegin = node.childrenEnd;
+		}
+
+		storage->buildHashTable( node );
+
+		if( i == 0 )
+		{
+			storage->nodes[0] = node;
+		}
+		else
+		{
+			storage->nodes.push_back( node );
+		}
+	}
+
+	storage->nodes.shrink_to_fit();
+	storage->children.shrink_to_fit();
+	storage->hashTable.shrink_to_fit();
+
+	m_storage = storage;
+}
+
+FrozenPathMatcher::FrozenPathMatcher( const ConstStoragePtr &storage, uint32_t root )
+	:	m_storage( storage ), m_root( root )
+{
+}
+
+FrozenPathMatcher::FrozenPathMatcher( const FrozenPathMatcher &other ) = default;
+FrozenPathMatcher &FrozenPathMatcher::operator= ( const FrozenPathMatcher &other ) = default;
+FrozenPathMatcher::~FrozenPathMatcher() = default;
+
+PathMatcher FrozenPathMatcher::pathMatcher() const
+{
+	// Recreate the nodes directly, preserving any sharing.
+	std::vector<PathMatcher::NodePtr> nodes( m_storage->nodes.size() );
+	std::function<PathMatcher::Node *( uint32_t )> thaw = [&] ( uint32_t nodeIndex ) {
+
+		PathMatcher::NodePtr &result = nodes[nodeIndex];
+		if( result )
+		{
+			return result.get();
+		}
+
+		const Storage::Node &node = m_storage->nodes[nodeIndex];
+		if( nodeIndex != m_root && node.terminator && node.childrenBegin == node.childrenEnd )
+		{
+			result = PathMatcher::Node::leaf();
+			return result.get();
+		}
+
+		result = new PathMatcher::Node( node.terminator );
+		for( uint32_t child = node.childrenBegin; child < node.childrenEnd; ++child )
+		{
+			result->children.emplace(
+				PathMatcher::Name(
+					m_storage->children[child].name,
+					child < node.wildcardsBegin ? PathMatcher::Name::Plain : PathMatcher::Name::Wildcarded
+				),
+				thaw( m_storage->children[child].node )
+			);
+		}
+		return result.get();
+
+	};
+
+	return PathMatcher( thaw( m_root ) );
+}
+
+FrozenPathMatcher FrozenPathMatcher::subTree( const std::string &root ) const
+{
+	if( root.empty() )
+	{
+		return FrozenPathMatcher();
+	}
+	std::vector<IECore::InternedString> tokenizedRoot;
+	StringAlgo::tokenize( root, '/', tokenizedRoot );
+	return subTree( tokenizedRoot );
+}
+
+FrozenPathMatcher FrozenPathMatcher::subTree( const std::vector<IECore::InternedString> &root ) const
+{
+	const uint32_t node = findNode( root );
+	if( node == g_invalid )
+	{
+		return FrozenPathMatcher();
+	}
+	return FrozenPathMatcher( m_storage, node );
+}
+
+bool FrozenPathMatcher::isEmpty() const
+{
+	const Storage::Node &root = m_storage->nodes[m_root];
+	return !root.terminator && root.childrenBegin == root.childrenEnd;
+}
+
+size_t FrozenPathMatcher::size() const
+{
+	size_t result = 0;
+	std::vector<uint32_t> toVisit = { m_root };
+	while( !toVisit.empty() )
+	{
+		const Storage::Node &node = m_storage->nodes[toVisit.back()];
+		toVisit.pop_back();
+		if( node.terminator )
+		{
+			result++;
+		}
+		for( uint32_t child = node.childrenBegin; child < node.childrenEnd; ++child )
+		{
+			toVisit.push_back( m_storage->children[child].node );
+		}
+	}
+	return result;
+}
+
+void FrozenPathMatcher::paths( std::vector<std::string> &paths ) const
+{
+	std::vector<std::pair<uint32_t, std::string>> toVisit = { { m_root, "" } };
+	while( !toVisit.empty() )
+	{
+		const Storage::Node &node = m_storage->nodes[toVisit.back().first];
+		const std::string path = std::move( toVisit.back().second );
+		toVisit.pop_back();
+
+		if( node.terminator )
+		{
+			paths.push_back( path.empty() ? "/" : path );
+		}
+
+		for( uint32_t child = node.childrenBegin; child < node.childrenEnd; ++child )
+		{
+			const Storage::Child &c = m_storage->children[child];
+			toVisit.push_back( { c.node, path + "/" + c.name.string() } );
+		}
+	}
+}
+
+unsigned FrozenPathMatcher::match( const std::string &path ) const
+{
+	if( path.empty() )
+	{
+		return PathMatcher::NoMatch;
+	}
+	std::vector<IECore::InternedString> tokenizedPath;
+	StringAlgo::tokenize( path, '/', tokenizedPath );
+	return match( tokenizedPath );
+}
+
+unsigned FrozenPathMatcher::match( const std::vector<IECore::InternedString> &path ) const
+{
+	return match( path.begin(), path.end() );
+}
+
+unsigned FrozenPathMatcher::match( NameIterator start, NameIterator end ) const
+{
+	unsigned result = PathMatcher::NoMatch;
+	matchWalk( m_root, start, end, result );
+	return result;
+}
+
+uint32_t FrozenPathMatcher::findNode( const std::vector<IECore::InternedString> &path ) const
+{
+	if( path.empty() && isEmpty() )
+	{
+		// Consistent with `PathMatcher::find()`, for
+		// which the root of an empty matcher doesn't exist.
+		return g_invalid;
+	}
+
+	uint32_t result = m_root;
+	for( const auto &name : path )
+	{
+		const uint32_t child = m_storage->findChild( m_storage->nodes[result], name );
+		if( child == g_invalid )
+		{
+			return g_invalid;
+		}
+		result = m_storage->children[child].node;
+	}
+	return result;
+}
+
+void FrozenPathMatcher::matchWalk( uint32_t nodeIndex, const NameIterator &start, const NameIterator &end, unsigned &result ) const
+{
+	// This mirrors `PathMatcher::matchWalk()` exactly, and the comments
+	// there apply here too.
+
+	const Storage &storage = *m_storage;
+	const Storage::Node &node = storage.nodes[nodeIndex];
+
+	if( start == end )
+	{
+		if( node.terminator )
+		{
+			result |= PathMatcher::ExactMatch;
+		}
+		if( node.childrenBegin != node.childrenEnd )
+		{
+			result |= PathMatcher::DescendantMatch;
+		}
+		if( node.ellipsis != g_invalid )
+		{
+			result |= PathMatcher::DescendantMatch;
+			if( storage.nodes[storage.children[node.ellipsis].node].terminator )
+			{
+				result |= PathMatcher::ExactMatch;
+			}
+		}
+		return;
+	}
+
+	if( node.terminator )
+	{
+		result |= PathMatcher::AncestorMatch;
+	}
+
+	const uint32_t plainChild = storage.findPlainChild( node, *start );
+	if( plainChild != g_invalid )
+	{
+		matchWalk( plainChild, start + 1, end, result );
+		if( result == PathMatcher::EveryMatch )
+		{
+			return;
+		}
+	}
+
+	for( uint32_t child = node.wildcardsBegin; child < node.childrenEnd; ++child )
+	{
+		if( child == node.ellipsis )
+		{
+			continue;
+		}
+
+		if( StringAlgo::match( start->c_str(), storage.children[child].name.c_str() ) )
+		{
+			matchWalk( storage.children[child].node, start + 1, end, result );
+			if( result == PathMatcher::EveryMatch )
+			{
+				return;
+			}
+		}
+	}
+
+	if( node.ellipsis != g_invalid )
+	{
+		const uint32_t ellipsis = storage.children[node.ellipsis].node;
+		result |= PathMatcher::DescendantMatch;
+		if( storage.nodes[ellipsis].terminator )
+		{
+			result |= PathMatcher::ExactMatch;
+		}
+
+		NameIterator newStart = start;
+		while( newStart != end )
+		{
+			matchWalk( ellipsis, newStart, end, result );
+			if( result == PathMatcher::EveryMatch )
+			{
+				return;
+			}
+			newStart++;
+		}
+	}
+}
+
+bool FrozenPathMatcher::operator == ( const FrozenPathMatcher &other ) const
+{
+	if( m_storage == other.m_storage && m_root == other.m_root )
+	{
+		return true;
+	}
+
+	// Children are stored in the same order for the same names, so we can
+	// compare them pairwise.
+	const Storage &storage = *m_storage;
+	const Storage &otherStorage = *other.m_storage;
+	std::vector<std::pair<uint32_t, uint32_t>> toVisit = { { m_root, other.m_root } };
+	while( !toVisit.empty() )
+	{
+		const Storage::Node &node = storage.nodes[toVisit.back().first];
+		const Storage::Node &otherNode = otherStorage.nodes[toVisit.back().second];
+		toVisit.pop_back();
+
+		if(
+			node.terminator != otherNode.terminator ||
+			node.childrenEnd - node.childrenBegin != otherNode.childrenEnd - otherNode.childrenBegin ||
+			node.wildcardsBegin - node.childrenBegin != otherNode.wildcardsBegin - otherNode.childrenBegin
+		)
+		{
+			return false;
+		}
+
+		for( uint32_t child = node.childrenBegin, otherChild = otherNode.childrenBegin; child < node.childrenEnd; ++child, ++otherChild )
+		{
+			if( storage.children[child].name != otherStorage.children[otherChild].name )
+			{
+				return false;
+			}
+			toVisit.push_back( { storage.children[child].node, otherStorage.children[otherChild].node } );
+		}
+	}
+
+	return true;
+}
+
+bool FrozenPathMatcher::operator != ( const FrozenPathMatcher &other ) const
+{
+	return !( *this == other );
+}
+
+FrozenPathMatcher::RawIterator FrozenPathMatcher::begin() const
+{
+	return RawIterator( *this, false );
+}
+
+FrozenPathMatcher::RawIterator FrozenPathMatcher::end() const
+{
+	return RawIterator( *this, true );
+}
+
+FrozenPathMatcher::RawIterator FrozenPathMatcher::find( const std::vector<IECore::InternedString> &path ) const
+{
+	if( path.empty() )
+	{
+		return begin();
+	}
+
+	RawIterator result = end();
+	result.m_stack.clear();
+
+	uint32_t node = m_root;
+	for( const auto &name : path )
+	{
+		const Storage::Node &n = m_storage->nodes[node];
+		const uint32_t child = m_storage->findChild( n, name );
+		if( child == g_invalid )
+		{
+			return end();
+		}
+		result.m_stack.push_back( { child, n.childrenEnd } );
+		node = m_storage->children[child].node;
+	}
+	result.m_path = path;
+
+	return result;
+}
+
+//////////////////////////////////////////////////////////////////////////
+// RawIterator
+//////////////////////////////////////////////////////////////////////////
+
+FrozenPathMatcher::RawIterator::RawIterator( const FrozenPathMatcher &matcher, bool atEnd )
+	:	m_storage( matcher.m_storage.get() ), m_root( matcher.m_root ), m_atRoot( false ), m_pruned( false )
+{
+	const Storage::Node &root = m_storage->nodes[m_root];
+	m_stack.push_back( { atEnd ? root.childrenEnd : root.childrenBegin, root.childrenEnd } );
+	m_atRoot = !atEnd && !matcher.isEmpty();
+}
+
+void FrozenPathMatcher::RawIterator::prune()
+{
+	m_pruned = true;
+}
+
+bool FrozenPathMatcher::RawIterator::exactMatch() const
+{
+	const uint32_t n = node();
+	return n != g_invalid && m_storage->nodes[n].terminator;
+}
+
+void FrozenPathMatcher::RawIterator::increment()
+{
+	if( m_atRoot )
+	{
+		// The root may have no children, if it is
+		// the only path in the matcher.
+		if( m_stack.back().it != m_stack.back().end )
+		{
+			m_path.push_back( m_storage->children[m_stack.back().it].name );
+		}
+		m_atRoot = false;
+		return;
+	}
+
+	const Storage::Node &node = m_storage->nodes[m_storage->children[m_stack.back().it].node];
+	if( !m_pruned && node.childrenBegin != node.childrenEnd )
+	{
+		m_stack.push_back( { node.childrenBegin, node.childrenEnd } );
+		m_path.push_back( m_storage->children[node.childrenBegin].name );
+	}
+	else
+	{
+		++(m_stack.back().it);
+		while( m_stack.size() > 1 && m_stack.back().it == m_stack.back().end )
+		{
+			m_stack.pop_back();
+			m_path.pop_back();
+			++(m_stack.back().it);
+		}
+
+		if( m_stack.back().it != m_stack.back().end )
+		{
+			m_path.back() = m_storage->children[m_stack.back().it].name;
+		}
+	}
+	m_pruned = false;
+}
+
+bool FrozenPathMatcher::RawIterator::equal( const RawIterator &other ) const
+{
+	return m_storage == other.m_storage && m_stack == other.m_stack && m_atRoot == other.m_atRoot;
+}
+
+const std::vector<IECore::InternedString> &FrozenPathMatcher::RawIterator::dereference() const
+{
+	return m_path;
+}
+
+uint32_t FrozenPathMatcher::RawIterator::node() const
+{
+	if( m_atRoot )
+	{
+		return m_root;
+	}
+	else if( m_stack.back().it != m_stack.back().end )
+	{
+		return m_storage->children[m_stack.back().it].node;
+	}
+	return g_invalid;
+}
+
+//////////////////////////////////////////////////////////////////////////
+// Iterator
+//////////////////////////////////////////////////////////////////////////
+
+FrozenPathMatcher::Iterator::Iterator( const RawIterator &it )
+	:	boost::iterator_adaptor<Iterator, FrozenPathMatcher::RawIterator>( it )
+{
+	satisfyTerminatorRequirement();
+}
+
+bool FrozenPathMatcher::Iterator::operator==( const RawIterator &rhs ) const
+{
+	return base() == rhs;
+}
+
+bool FrozenPathMatcher::Iterator::operator!=( const RawIterator &rhs ) const
+{
+	return base() != rhs;
+}
+
+void FrozenPathMatcher::Iterator::prune()
+{
+	base_reference().prune();
+}
+
+void FrozenPathMatcher::Iterator::increment()
+{
+	++base_reference();
+	satisfyTerminatorRequirement();
+}
+
+void FrozenPathMatcher::Iterator::satisfyTerminatorRequirement()
+{
+	while( base().node() != g_invalid && !base().exactMatch() )
+	{
+		++base_reference();
+	}
+}
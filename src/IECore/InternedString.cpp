@@ -35,164 +35,221 @@
 #include "IECore/InternedString.h"
 
 #include "boost/lexical_cast.hpp"
-#include "boost/multi_index/hashed_index.hpp"
-#include "boost/multi_index_container.hpp"
 
 #include "tbb/concurrent_hash_map.h"
-#include "tbb/spin_rw_mutex.h"
+#include "tbb/spin_mutex.h"
+
+#include <atomic>
+#include <memory>
+#include <vector>
 
 #include <string.h>
 
 namespace IECore
 {
 
-namespace Detail
+namespace
 {
 
-// Simple type for specifying a range of characters, to
-// represent non-null-terminated strings.
-typedef std::pair<const char *, const char *> CharRange;
+// Interned strings are stored in a table which is split into a fixed
+// number of independent shards. Each shard is an open-addressed hash
+// table using linear probing, where slots are written at most once
+// and strings are never removed. This allows lookups to proceed without
+// taking any lock at all : a reader either sees a fully published value
+// or an empty slot, and in the latter case falls back to the locked
+// insertion path, which repeats the search before inserting. Growing a
+// shard builds a new table and publishes it atomically, leaving the old
+// one intact for any readers still using it.
+//
+// Since there is no lock on the read path, we must never free anything
+// that a reader may be accessing. We therefore keep all tables (and all
+// strings) alive for the lifetime of the process, which costs at most as
+// much again as the current tables, since each table is double the size of
+// the last.
 
-// Hash for strings of various types.
-// By overloading it for multiple types, we are able to do
-// lookups into HashSet using any type as a key, and without
-// needing to construct a temporary std::string when the type
-// is a raw c string.
-struct Hash
+struct Value
 {
 
-	// Dan Bernstein's original string hash
-	size_t operator()( const char *s ) const
+	Value( uint64_t hash, const char *value, size_t length )
+		:	hash( hash ), string( value, length )
 	{
-		size_t hash = 5381;
-		while( *s )
+	}
+
+	const uint64_t hash;
+	const std::string string;
+
+};
+
+using Slot = std::atomic<const Value *>;
+
+struct Table
+{
+
+	Table( size_t capacity )
+		:	mask( capacity - 1 ), slots( new Slot[capacity] )
+	{
+		for( size_t i = 0; i < capacity; ++i )
 		{
-			hash = ( ( hash << 5 ) + hash ) + *s++;
+			slots[i].store( nullptr, std::memory_order_relaxed );
 		}
-
-		return hash;
 	}
 
-	size_t operator()( const std::string &s ) const
+	const size_t mask;
+	std::unique_ptr<Slot[]> slots;
+
+	const Value *find( uint64_t hash, const char *value, size_t length ) const
 	{
-		return (*this)( s.c_str() );
+		for( size_t i = hash & mask; ; i = ( i + 1 ) & mask )
+		{
+			const Value *v = slots[i].load( std::memory_order_acquire );
+			if( !v )
+			{
+				return nullptr;
+			}
+			if(
+				v->hash == hash && v->string.size() == length &&
+				memcmp( v->string.c_str(), value, length ) == 0
+			)
+			{
+				return v;
+			}
+		}
 	}
 
-	size_t operator()( const CharRange &range ) const
+	// Must only be called by the writer holding the shard lock,
+	// with `value` known not to be present already.
+	void insert( const Value *value )
 	{
-		size_t hash = 5381;
-		for( const char *s = range.first; s != range.second; ++s )
+		size_t i = value->hash & mask;
+		while( slots[i].load( std::memory_order_relaxed ) )
 		{
-			hash = ( ( hash << 5 ) + hash ) + *s;
+			i = ( i + 1 ) & mask;
 		}
-
-		return hash;
+		slots[i].store( value, std::memory_order_release );
 	}
 
 };
 
-// Equality operator between strings of various types.
-// As above, this allows HashSet lookups to be performed
-// using any type, without the overhead of constructing
-// temporary std::strings.
-struct Equal
+// Aligned to avoid false sharing between the shards.
+struct alignas( 64 ) Shard
 {
 
-	bool operator()( const std::string &s1, const std::string &s2 ) const
+	Shard()
+		:	size( 0 )
 	{
-		return s1 == s2;
+		tables.emplace_back( new Table( 64 ) );
+		table.store( tables.back().get(), std::memory_order_relaxed );
 	}
 
-	bool operator()( const char *c, const std::string &s ) const
-	{
-		return strcmp( c, s.c_str() )==0;
-	}
+	std::atomic<const Table *> table;
+	std::atomic<size_t> size;
 
-	bool operator()( const std::string &s, const char *c ) const
-	{
-		return strcmp( c, s.c_str() )==0;
-	}
+	// Protects everything below, and is only
+	// ever taken when inserting a new string.
+	tbb::spin_mutex mutex;
+	std::vector<std::unique_ptr<Table>> tables;
 
-	bool operator()( const CharRange &c, const std::string &s ) const
+	const Value *findOrInsert( uint64_t hash, const char *value, size_t length )
 	{
-		return s.compare( 0, std::string::npos, c.first, c.second - c.first )==0;
-	}
+		if( const Value *v = table.load( std::memory_order_acquire )->find( hash, value, length ) )
+		{
+			return v;
+		}
 
-	bool operator()( const std::string &s, const CharRange &c ) const
-	{
-		return s.compare( 0, std::string::npos, c.first, c.second - c.first )==0;
+		tbb::spin_mutex::scoped_lock lock( mutex );
+
+		Table *current = tables.back().get();
+		if( const Value *v = current->find( hash, value, length ) )
+		{
+			// Inserted by another thread since we looked.
+			return v;
+		}
+
+		const size_t newSize = size.load( std::memory_order_relaxed ) + 1;
+		if( newSize * 2 > current->mask + 1 )
+		{
+			// Keep the load factor at or below 0.5, so
+			// that probe sequences remain short.
+			Table *grown = new Table( ( current->mask + 1 ) * 2 );
+			for( size_t i = 0; i <= current->mask; ++i )
+			{
+				if( const Value *v = current->slots[i].load( std::memory_order_relaxed ) )
+				{
+					grown->insert( v );
+				}
+			}
+			tables.emplace_back( grown );
+			table.store( grown, std::memory_order_release );
+			current = grown;
+		}
+
+		const Value *result = new Value( hash, value, length );
+		current->insert( result );
+		size.store( newSize, std::memory_order_relaxed );
+		return result;
 	}
 
 };
 
-typedef boost::multi_index::multi_index_container<
-	std::string,
-	boost::multi_index::indexed_by<
-		boost::multi_index::hashed_unique<
-			boost::multi_index::identity<std::string>,
-			Hash,
-			Equal
-		>
-	>
-> HashSet;
-
-typedef HashSet::nth_index<0>::type Index;
-typedef HashSet::nth_index_const_iterator<0>::type ConstIterator;
-typedef tbb::spin_rw_mutex Mutex;
-
-static HashSet *hashSet()
+const unsigned g_shardBits = 6;
+const size_t g_numShards = 1 << g_shardBits;
+
+// We deliberately leak the shards, so that InternedStrings
+// remain valid during static destruction of other objects.
+Shard *shards()
 {
-	static HashSet g_hashSet;
-	return &g_hashSet;
+	static Shard *g_shards = new Shard[g_numShards];
+	return g_shards;
 }
 
-static Mutex *mutex()
+// Dan Bernstein's original string hash, followed by the
+// MurmurHash3 finalizer so that all bits are well mixed.
+// We use the high bits to choose the shard and the low
+// bits to choose the slot within it.
+uint64_t hash( const char *value, size_t length )
 {
-	static Detail::Mutex g_mutex;
-	return &g_mutex;
+	uint64_t h = 5381;
+	for( const char *s = value, *e = value + length; s != e; ++s )
+	{
+		h = ( ( h << 5 ) + h ) + *s;
+	}
+
+	h ^= h >> 33;
+	h *= 0xff51afd7ed558ccdULL;
+	h ^= h >> 33;
+	h *= 0xc4ceb9fe1a85ec53ULL;
+	h ^= h >> 33;
+	return h;
+}
+
+const std::string *intern( const char *value, size_t length )
+{
+	const uint64_t h = hash( value, length );
+	Shard &shard = shards()[h >> ( 64 - g_shardBits )];
+	return &shard.findOrInsert( h, value, length )->string;
 }
 
-} // namespace Detail
+} // namespace
 
 const std::string *InternedString::internedString( const char *value )
 {
-	Detail::HashSet *hashSet = Detail::hashSet();
-	Detail::Index &hashIndex = hashSet->get<0>();
-	Detail::Mutex::scoped_lock lock( *Detail::mutex(), false ); // read-only lock
-	Detail::HashSet::const_iterator it = hashIndex.find( value );
-	if( it!=hashIndex.end() )
-	{
-		return &(*it);
-	}
-	else
-	{
-		lock.upgrade_to_writer();
-		return &(*(hashSet->insert( std::string( value ) ).first ) );
-	}
+	return intern( value, strlen( value ) );
 }
 
 const std::string *InternedString::internedString( const char *value, size_t length )
 {
-	Detail::HashSet *hashSet = Detail::hashSet();
-	Detail::Index &hashIndex = hashSet->get<0>();
-	Detail::Mutex::scoped_lock lock( *Detail::mutex(), false ); // read-only lock
-	Detail::HashSet::const_iterator it = hashIndex.find( Detail::CharRange( value, value + length ) );
-	if( it!=hashIndex.end() )
-	{
-		return &(*it);
-	}
-	else
-	{
-		lock.upgrade_to_writer();
-		return &(*(hashSet->insert( std::string( value, length ) ).first ) );
-	}
+	return intern( value, length );
 }
 
 size_t InternedString::numUniqueStrings()
 {
-	Detail::Mutex::scoped_lock lock( *Detail::mutex(), false ); // read-only lock
-	Detail::HashSet *hashSet = Detail::hashSet();
-	return hashSet->size();
+	const Shard *s = shards();
+	size_t result = 0;
+	for( size_t i = 0; i < g_numShards; ++i )
+	{
+		result += s[i].size.load( std::memory_order_relaxed );
+	}
+	return result;
 }
 
 static InternedString g_emptyString("");
@@ -213,6 +270,15 @@ const InternedString &InternedString::numberString( int64_t number )
 	{
 		g_numbers = new NumbersMap;
 	}
+	{
+		// Try a lookup with a read lock first, to avoid contention
+		// between threads constructing the same numbers.
+		NumbersMap::const_accessor it;
+		if( g_numbers->find( it, number ) )
+		{
+			return it->second;
+		}
+	}
 	NumbersMap::accessor it;
 	if ( g_numbers->insert( it, number ) )
 	{
@@ -34,10 +34,15 @@
 
 #include "IECore/MemoryIndexedIO.h"
 
+#include "IECore/Exception.h"
 #include "IECore/FileIndexedIO.h"
 #include "IECore/VectorTypedData.h"
 
+#include "boost/iostreams/device/array.hpp"
+#include "boost/iostreams/stream.hpp"
+
 using namespace IECore;
+namespace io = boost::iostreams;
 
 IE_CORE_DEFINERUNTIMETYPEDDESCRIPTION( MemoryIndexedIO )
 
@@ -50,7 +55,7 @@ IE_CORE_DEFINERUNTIMETYPEDDESCRIPTION( MemoryIndexedIO )
 class MemoryIndexedIO::StreamFile : public StreamIndexedIO::StreamFile
 {
 	public:
-		StreamFile( const char *buf, size_t size, IndexedIO::OpenMode mode );
+		StreamFile( ConstCharVectorDataPtr buf, IndexedIO::OpenMode mode );
 
 		CharVectorDataPtr buffer();
 
@@ -61,10 +66,22 @@ class MemoryIndexedIO::StreamFile : public StreamIndexedIO::StreamFile
 	private:
 
 		size_t m_endPosition;
+
+		// Only used in Read mode, where we read directly from the
+		// buffer rather than from a copy of it.
+		ConstCharVectorDataPtr m_buffer;
 };
 
-MemoryIndexedIO::StreamFile::StreamFile( const char *buf, size_t size, IndexedIO::OpenMode mode ) : StreamIndexedIO::StreamFile(mode), m_endPosition(0)
+MemoryIndexedIO::StreamFile::StreamFile( ConstCharVectorDataPtr buf, IndexedIO::OpenMode mode ) : StreamIndexedIO::StreamFile(mode), m_endPosition(0)
 {
+	const char *bufPtr = nullptr;
+	size_t size = 0;
+	if ( buf )
+	{
+		bufPtr = buf->readable().data();
+		size = buf->readable().size();
+	}
+
 	if (mode & IndexedIO::Write)
 	{
 		std::stringstream *f = new std::stringstream( std::ios::trunc | std::ios::binary | std::ios::in | std::ios::out );
@@ -72,7 +89,7 @@ MemoryIndexedIO::StreamFile::StreamFile( const char *buf, size_t size, IndexedIO
 	}
 	else if (mode & IndexedIO::Append)
 	{
-		if ( !buf || !size )
+		if ( !bufPtr || !size )
 		{
 			/// Create new file
 			std::stringstream *f = new std::stringstream(  std::ios::trunc | std::ios::binary | std::ios::in | std::ios::out );
@@ -81,19 +98,22 @@ MemoryIndexedIO::StreamFile::StreamFile( const char *buf, size_t size, IndexedIO
 		else
 		{
 			/// Read existing file
-			assert( buf );
-
-			/// Read existing file
-			std::stringstream *f = new std::stringstream( std::string(buf, size), std::ios::binary | std::ios::in | std::ios::out );
+			std::stringstream *f = new std::stringstream( std::string(bufPtr, size), std::ios::binary | std::ios::in | std::ios::out );
 			setInput( f, false, "" );
 		}
 	}
 	else
 	{
-		assert( buf );
 		assert( mode & IndexedIO::Read );
-		std::stringstream *f = new std::stringstream( std::string(buf, size), std::ios::binary | std::ios::in | std::ios::out );
-		setInput( f, false, "" );
+		if( !buf )
+		{
+			throw IECore::Exception( "MemoryIndexedIO : No buffer given for Read mode" );
+		}
+		// Take a lazy copy of the buffer, so that we share its storage
+		// but remain unaffected if the caller subsequently modifies it.
+		m_buffer = buf->copy();
+		char *data = const_cast<char *>( m_buffer->readable().data() );
+		setInput( new io::stream<io::array>( data, size ), data, size );
 	}
 }
 
@@ -104,6 +124,14 @@ void MemoryIndexedIO::StreamFile::flush( size_t endPosition )
 
 CharVectorDataPtr MemoryIndexedIO::StreamFile::buffer()
 {
+	if( m_buffer )
+	{
+		// Read mode, where `m_stream` reads directly from `m_buffer`
+		// rather than being a stringstream. Return a lazy copy, so the
+		// caller can't modify the data we are reading.
+		return m_buffer->copy();
+	}
+
 	std::stringstream *s = static_cast< std::stringstream *>( m_stream );
 	assert( s );
 
@@ -129,14 +157,7 @@ MemoryIndexedIO::StreamFile::~StreamFile()
 
 MemoryIndexedIO::MemoryIndexedIO( ConstCharVectorDataPtr buf, const IndexedIO::EntryIDList &root, IndexedIO::OpenMode mode)
 {
-	const char *bufPtr = nullptr;
-	size_t size = 0;
-	if ( buf )
-	{
-		bufPtr = &(buf->readable()[0]);
-		size = buf->readable().size();
-	}
-	open( new StreamFile( bufPtr, size, mode ), root );
+	open( new StreamFile( buf, mode ), root );
 }
 
 MemoryIndexedIO::MemoryIndexedIO( StreamIndexedIO::Node &rootNode ) : StreamIndexedIO( rootNode )
@@ -47,11 +47,27 @@ using namespace IECore;
 struct ObjectPool::MemberData
 {
 
-	MemberData( size_t maxMemory ) : cache( getter, maxMemory )
+	MemberData( size_t maxMemory )
+		:	cache( getter, maxMemory ),
+			statistics(
+				[this] ( CacheStatistics::Snapshot &snapshot ) {
+					snapshot.evictions = cache.statistics().snapshot().evictions;
+					snapshot.currentCost = cache.currentCost();
+					snapshot.maxCost = cache.getMaxCost();
+				},
+				[this] {
+					cache.statistics().reset();
+				}
+			)
 	{
 	}
 
 	LRUCache< MurmurHash, ConstObjectPtr > cache;
+	SharedMemoryObjectCachePtr sharedMemoryCache;
+	// We don't expose the statistics of `cache` directly, because
+	// its getter "caches" null results, so they would count failed
+	// retrievals as hits. We do use its eviction count though.
+	CacheStatistics statistics;
 
 	/// our getter always returns NULL
 	static ConstObjectPtr getter( const MurmurHash &h, size_t &cost )
@@ -76,7 +92,25 @@ ObjectPool::~ObjectPool()
 
 ConstObjectPtr ObjectPool::retrieve( const MurmurHash &hash ) const
 {
-	return m_data->cache.get(hash);
+	ConstObjectPtr result = m_data->cache.get(hash);
+	if( !result && m_data->sharedMemoryCache )
+	{
+		result = m_data->sharedMemoryCache->retrieve( hash );
+		if( result )
+		{
+			m_data->cache.set( hash, result, result->memoryUsage() );
+		}
+	}
+
+	if( result )
+	{
+		m_data->statistics.recordHit();
+	}
+	else
+	{
+		m_data->statistics.recordMiss();
+	}
+	return result;
 }
 
 ConstObjectPtr ObjectPool::store( const Object *obj, StoreMode mode )
@@ -93,18 +127,24 @@ ConstObjectPtr ObjectPool::store( const Object *obj, StoreMode mode )
 	if ( mode == StoreCopy )
 	{
 		cachedObj = obj->copy();
-		m_data->cache.set( h, cachedObj, obj->memoryUsage() );
-		return cachedObj;
 	}
 	else if ( mode == StoreReference )
 	{
-		m_data->cache.set( h, obj, obj->memoryUsage() );
-		return obj;
+		cachedObj = obj;
 	}
 	else
 	{
 		throw Exception( "Invalid store mode!" );
 	}
+
+	m_data->cache.set( h, cachedObj, obj->memoryUsage() );
+
+	if( m_data->sharedMemoryCache && !m_data->sharedMemoryCache->contains( h ) )
+	{
+		m_data->sharedMemoryCache->store( h, obj );
+	}
+
+	return cachedObj;
 }
 
 bool ObjectPool::contains( const MurmurHash &hash ) const
@@ -137,6 +177,26 @@ size_t ObjectPool::memoryUsage() const
 	return m_data->cache.currentCost();
 }
 
+void ObjectPool::setSharedMemoryCache( SharedMemoryObjectCachePtr cache )
+{
+	m_data->sharedMemoryCache = cache;
+}
+
+SharedMemoryObjectCache *ObjectPool::getSharedMemoryCache() const
+{
+	return m_data->sharedMemoryCache.get();
+}
+
+CacheStatistics &ObjectPool::statistics()
+{
+	return m_data->statistics;
+}
+
+const CacheStatistics &ObjectPool::statistics() const
+{
+	return m_data->statistics;
+}
+
 ObjectPool *ObjectPool::defaultObjectPool()
 {
 	static ObjectPoolPtr c = nullptr;
@@ -145,6 +205,8 @@ ObjectPool *ObjectPool::defaultObjectPool()
 		const char *m = getenv( "IECORE_OBJECTPOOL_MEMORY" );
 		size_t mi = m ? boost::lexical_cast<size_t>( m ) : 500;
 		c = new ObjectPool(1024 * 1024 * mi);
+		c->statistics().setName( "ObjectPool" );
+		c->setSharedMemoryCache( SharedMemoryObjectCache::defaultCache() );
 	}
 	return c.get();
 }
@@ -39,28 +39,97 @@
 
 #include "IECore/StringAlgo.h"
 
-#include <stack>
+#include "tbb/parallel_for.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
 
 using namespace std;
 using namespace IECore;
 
 static IECore::InternedString g_ellipsis( "..." );
 
+namespace
+{
+
+// Nodes with at least this many children are processed in
+// parallel by the set operations.
+const size_t g_minParallelChildren = 16;
+
+// Calls `f( i )` for each `i` in `[0, size)`, using parallel
+// tasks if there are enough iterations to make it worthwhile.
+template<typename F>
+void parallelForChildren( size_t size, F &&f )
+{
+	if( size < g_minParallelChildren )
+	{
+		for( size_t i = 0; i < size; ++i )
+		{
+			f( i );
+		}
+		return;
+	}
+
+	tbb::task_group_context taskGroupContext( tbb::task_group_context::isolated );
+	tbb::parallel_for(
+		tbb::blocked_range<size_t>( 0, size ),
+		[&f] ( const tbb::blocked_range<size_t> &range ) {
+			for( size_t i = range.begin(); i != range.end(); ++i )
+			{
+				f( i );
+			}
+		},
+		taskGroupContext
+	);
+}
+
+} // namespace
+
+//////////////////////////////////////////////////////////////////////////
+// ChildWalk implementation
+//////////////////////////////////////////////////////////////////////////
+
+// When a node has many children, the set operations first gather the
+// children that need walking into a list of ChildWalks. The walks are
+// then performed in parallel, and the results are used to edit the node
+// serially afterwards. This is safe because a child edited in place is
+// never shared, so no other task can be visiting it, and shared children
+// are copied rather than edited.
+struct PathMatcher::ChildWalk
+{
+
+	ChildWalk( const Name &name, Node *child, Node *srcChild )
+		:	name( name ), child( child ), srcChild( srcChild )
+	{
+	}
+
+	const Name name;
+	Node *child;
+	Node *srcChild;
+	NodePtr newChild;
+
+};
+
 //////////////////////////////////////////////////////////////////////////
 // Name implementation
 //////////////////////////////////////////////////////////////////////////
 
-inline PathMatcher::Name::Name( IECore::InternedString name )
+// These are not declared inline, because they are also used by
+// PathMatcherData and FrozenPathMatcher. The compiler is still free
+// to inline them here.
+
+PathMatcher::Name::Name( IECore::InternedString name )
 	: name( name ), type( name == g_ellipsis || StringAlgo::hasWildcards( name.c_str() ) ? Wildcarded : Plain )
 {
 }
 
-inline PathMatcher::Name::Name( IECore::InternedString name, Type type )
+PathMatcher::Name::Name( IECore::InternedString name, Type type )
 	: name( name ), type( type )
 {
 }
 
-inline bool PathMatcher::Name::operator < ( const Name &other ) const
+bool PathMatcher::Name::operator < ( const Name &other ) const
 {
 	return type < other.type || ( ( type == other.type ) && name < other.name );
 }
@@ -70,12 +139,12 @@ inline bool PathMatcher::Name::operator < ( const Name &other ) const
 //////////////////////////////////////////////////////////////////////////
 
 PathMatcher::Node::Node( bool terminator )
-	:	terminator( terminator )
+	:	terminator( terminator ), m_hash1( 0 ), m_hash2( 0 ), m_hashValid( false )
 {
 }
 
 PathMatcher::Node::Node( const Node &other )
-	:	children( other.children ), terminator( other.terminator )
+	:	children( other.children ), terminator( other.terminator ), m_hash1( 0 ), m_hash2( 0 ), m_hashValid( false )
 {
 }
 
@@ -155,6 +224,56 @@ bool PathMatcher::Node::isEmpty()
 	return !terminator && children.empty();
 }
 
+MurmurHash PathMatcher::Node::hash() const
+{
+	if( m_hashValid.load( std::memory_order_acquire ) )
+	{
+		return MurmurHash( m_hash1.load( std::memory_order_relaxed ), m_hash2.load( std::memory_order_relaxed ) );
+	}
+
+	MurmurHash result;
+	result.append( terminator );
+	result.append( (uint64_t)children.size() );
+	if( children.size() )
+	{
+		// The ChildMap is ordered by InternedString address, which
+		// varies from process to process. Sort by string value so
+		// that the hash is stable.
+		std::vector<const ChildMapValue *> sortedChildren;
+		sortedChildren.reserve( children.size() );
+		for( const auto &child : children )
+		{
+			sortedChildren.push_back( &child );
+		}
+		std::sort(
+			sortedChildren.begin(), sortedChildren.end(),
+			[] ( const ChildMapValue *a, const ChildMapValue *b ) {
+				return strcmp( a->first.name.c_str(), b->first.name.c_str() ) < 0;
+			}
+		);
+		for( const auto &child : sortedChildren )
+		{
+			result.append( child->first.name.c_str() );
+			result.append( child->second->hash() );
+		}
+	}
+
+	m_hash1.store( result.h1(), std::memory_order_relaxed );
+	m_hash2.store( result.h2(), std::memory_order_relaxed );
+	m_hashValid.store( true, std::memory_order_release );
+	return result;
+}
+
+inline bool PathMatcher::Node::hashValid() const
+{
+	return m_hashValid.load( std::memory_order_acquire );
+}
+
+inline void PathMatcher::Node::dirtyHash()
+{
+	m_hashValid.store( false, std::memory_order_relaxed );
+}
+
 PathMatcher::Node *PathMatcher::Node::leaf()
 {
 	static NodePtr g_leaf = new Node( true );
@@ -435,20 +554,8 @@ bool PathMatcher::removePaths( const PathMatcher &paths )
 
 PathMatcher PathMatcher::intersection( const PathMatcher &paths ) const
 {
-	PathMatcher result = PathMatcher();
-	for( Iterator it = (*this).begin(); it != (*this).end(); ++it )
-	{
-		RawIterator rit = paths.find( *it );
-		if( rit == paths.end() )
-		{
-			it.prune();
-		}
-		else if( rit.exactMatch() )
-		{
-			result.addPath( *it );
-		}
-	}
-	return result;
+	NodePtr root = intersectionWalk( m_root.get(), paths.m_root.get() );
+	return root ? PathMatcher( root ) : PathMatcher();
 }
 
 bool PathMatcher::prune( const std::string &path )
@@ -516,6 +623,7 @@ PathMatcher::Node *PathMatcher::writable( Node *node, NodePtr &writableCopy, boo
 {
 	if( !shared )
 	{
+		node->dirtyHash();
 		return node;
 	}
 
@@ -526,6 +634,19 @@ PathMatcher::Node *PathMatcher::writable( Node *node, NodePtr &writableCopy, boo
 	return writableCopy.get();
 }
 
+void PathMatcher::propagateDirtyHash( Node *node, const Node *child, const Node *newChild, bool shared )
+{
+	// If the child was edited in place then its hash will have been
+	// dirtied, and since our hash depends on it, ours must be dirtied
+	// too. Computing our hash always computes the child hash, so if the
+	// child hash is invalid then either ours is already invalid or the
+	// child has been edited.
+	if( !shared && !newChild && !child->hashValid() )
+	{
+		node->dirtyHash();
+	}
+}
+
 PathMatcher::NodePtr PathMatcher::addWalk( Node *node, const NameIterator &start, const NameIterator &end, bool shared, bool &added )
 {
 	shared = shared || node->refCount() > 1;
@@ -557,6 +678,7 @@ PathMatcher::NodePtr PathMatcher::addWalk( Node *node, const NameIterator &start
 		// child with a new one in the event that it is duplicated in order to be
 		// written to.
 		newChild = addWalk( child, childStart, end, shared, added );
+		propagateDirtyHash( node, child, newChild.get(), shared );
 	}
 	else
 	{
@@ -624,6 +746,7 @@ PathMatcher::NodePtr PathMatcher::removeWalk( Node *node, const NameIterator &st
 
 	NameIterator childStart = start; childStart++;
 	NodePtr newChild = removeWalk( childIt->second.get(), childStart, end, shared, prune, removed );
+	propagateDirtyHash( node, childNode, newChild.get(), shared );
 
 	if( newChild && !newChild->isEmpty() )
 	{
@@ -648,6 +771,53 @@ PathMatcher::NodePtr PathMatcher::addPathsWalk( Node *node, const Node *srcNode,
 		writable( node, result, shared )->terminator = true;
 	}
 
+	if( srcNode->children.size() >= g_minParallelChildren )
+	{
+		// Add the children which only exist in the source immediately,
+		// and then walk the children which exist in both in parallel.
+		std::vector<ChildWalk> walks;
+		for( const auto &srcChild : srcNode->children )
+		{
+			if( Node *child = node->child( srcChild.first ) )
+			{
+				if( child != srcChild.second.get() )
+				{
+					walks.emplace_back( srcChild.first, child, srcChild.second.get() );
+				}
+			}
+			else
+			{
+				writable( node, result, shared )->children[srcChild.first] = srcChild.second;
+				added = true; // source node can only exist if it or a descendant is a terminator
+			}
+		}
+
+		std::atomic<bool> walksAdded( false );
+		parallelForChildren(
+			walks.size(),
+			[&] ( size_t i ) {
+				bool walkAdded = false;
+				walks[i].newChild = addPathsWalk( walks[i].child, walks[i].srcChild, shared, walkAdded );
+				if( walkAdded )
+				{
+					walksAdded = true;
+				}
+			}
+		);
+		added = added || walksAdded;
+
+		for( const auto &walk : walks )
+		{
+			propagateDirtyHash( node, walk.child, walk.newChild.get(), shared );
+			if( walk.newChild )
+			{
+				writable( node, result, shared )->children[walk.name] = walk.newChild;
+			}
+		}
+
+		return result;
+	}
+
 	for( Node::ChildMap::const_iterator it = srcNode->children.begin(), eIt = srcNode->children.end(); it != eIt; ++it )
 	{
 		Node *srcChild = it->second.get();
@@ -657,6 +827,7 @@ PathMatcher::NodePtr PathMatcher::addPathsWalk( Node *node, const Node *srcNode,
 			if( child != srcChild )
 			{
 				newChild = addPathsWalk( child, srcChild, shared, added );
+				propagateDirtyHash( node, child, newChild.get(), shared );
 			}
 		}
 		else
@@ -696,6 +867,7 @@ PathMatcher::NodePtr PathMatcher::addPrefixedPathsWalk( Node *node, const Node *
 		// child with a new one in the event that it is duplicated in order to be
 		// written to.
 		newChild = addPrefixedPathsWalk( child, srcNode, childStart, end, shared, added );
+		propagateDirtyHash( node, child, newChild.get(), shared );
 	}
 	else
 	{
@@ -727,6 +899,49 @@ PathMatcher::NodePtr PathMatcher::removePathsWalk( Node *node, const Node *srcNo
 		removed = true;
 	}
 
+	if( srcNode->children.size() >= g_minParallelChildren )
+	{
+		// Walk the children which exist in both trees in parallel,
+		// and then replace or erase them serially.
+		std::vector<ChildWalk> walks;
+		for( const auto &srcChild : srcNode->children )
+		{
+			if( Node *child = node->child( srcChild.first ) )
+			{
+				walks.emplace_back( srcChild.first, child, srcChild.second.get() );
+			}
+		}
+
+		std::atomic<bool> walksRemoved( false );
+		parallelForChildren(
+			walks.size(),
+			[&] ( size_t i ) {
+				bool walkRemoved = false;
+				walks[i].newChild = removePathsWalk( walks[i].child, walks[i].srcChild, shared, walkRemoved );
+				if( walkRemoved )
+				{
+					walksRemoved = true;
+				}
+			}
+		);
+		removed = removed || walksRemoved;
+
+		for( const auto &walk : walks )
+		{
+			propagateDirtyHash( node, walk.child, walk.newChild.get(), shared );
+			if( walk.newChild && !walk.newChild->isEmpty() )
+			{
+				writable( node, result, shared )->children[walk.name] = walk.newChild;
+			}
+			else if( walk.child->isEmpty() || ( walk.newChild && walk.newChild->isEmpty() ) )
+			{
+				writable( node, result, shared )->children.erase( walk.name );
+			}
+		}
+
+		return result;
+	}
+
 	for( Node::ChildMap::const_iterator it = srcNode->children.begin(), eIt = srcNode->children.end(); it != eIt; ++it )
 	{
 		const Node::ChildMapIterator childIt = node->children.find( it->first );
@@ -734,6 +949,7 @@ PathMatcher::NodePtr PathMatcher::removePathsWalk( Node *node, const Node *srcNo
 		{
 			Node *child = childIt->second.get();
 			NodePtr newChild = removePathsWalk( child, it->second.get(), shared, removed );
+			propagateDirtyHash( node, child, newChild.get(), shared );
 
 			if( newChild && !newChild->isEmpty() )
 			{
@@ -749,82 +965,68 @@ PathMatcher::NodePtr PathMatcher::removePathsWalk( Node *node, const Node *srcNo
 	return result;
 }
 
-namespace
-{
-
-//////////////////////////////////////////////////////////////////////////
-// Support code for murmurHashAppend for PathMatcher
-//////////////////////////////////////////////////////////////////////////
-
-struct HashNode
+PathMatcher::NodePtr PathMatcher::intersectionWalk( Node *node, Node *srcNode ) const
 {
-
-	HashNode( const char *name, unsigned char exactMatch )
-		:   name( name ), exactMatch( exactMatch )
+	if( node == srcNode )
 	{
+		// The intersection of a subtree with itself is just
+		// the subtree, so we can share it.
+		return node;
 	}
 
-	bool operator < ( const HashNode &rhs ) const
+	// Find the children common to both nodes, by searching the larger
+	// child map for each child in the smaller one.
+	const Node *smaller = node->children.size() <= srcNode->children.size() ? node : srcNode;
+	const Node *larger = smaller == node ? srcNode : node;
+
+	std::vector<ChildWalk> walks;
+	for( const auto &child : smaller->children )
 	{
-		return strcmp( name, rhs.name ) < 0;
+		Node::ConstChildMapIterator it = larger->children.find( child.first );
+		if( it != larger->children.end() )
+		{
+			walks.emplace_back( child.first, child.second.get(), it->second.get() );
+		}
 	}
 
-	const char *name;
-	unsigned char exactMatch;
-
-};
-
-typedef std::vector<HashNode> HashNodes;
-typedef std::stack<HashNodes> HashStack;
+	parallelForChildren(
+		walks.size(),
+		[&] ( size_t i ) {
+			walks[i].newChild = intersectionWalk( walks[i].child, walks[i].srcChild );
+		}
+	);
 
-void popHashNodes( HashStack &stack, size_t size, IECore::MurmurHash &h )
-{
-	while( stack.size() > size )
+	const bool terminator = node->terminator && srcNode->terminator;
+	NodePtr result;
+	for( const auto &walk : walks )
 	{
-		h.append( (uint64_t)stack.top().size() );
-		std::sort( stack.top().begin(), stack.top().end() );
-		for( HashNodes::const_iterator nIt = stack.top().begin(), nEIt = stack.top().end(); nIt != nEIt; ++nIt )
+		if( walk.newChild )
 		{
-			h.append( nIt->name );
-			h.append( nIt->exactMatch );
+			if( !result )
+			{
+				result = new Node( terminator );
+			}
+			// Walks are in the same order as the child map,
+			// so we can always insert at the end.
+			result->children.emplace_hint( result->children.end(), walk.name, walk.newChild );
 		}
-		stack.pop();
 	}
-}
 
+	if( !result && terminator )
+	{
+		result = Node::leaf();
+	}
+
+	return result;
 }
 
-// Our hash is complicated by the fact that PathMatcher::Iterator doesn't
-// guarantee the order of visiting child nodes in its tree (because it
-// sorts using InternedString addresses for the fastest possible match()
-// implementation). We therefore have to use a stack to keep track of
-// our traversal through the tree, and output all the children at each
-// level only after sorting them alphabetically.
+//////////////////////////////////////////////////////////////////////////
+// murmurHashAppend
+//////////////////////////////////////////////////////////////////////////
+
+// Each node caches the hash of its subtree, so after editing a large
+// PathMatcher only the nodes on the paths to the edits need rehashing.
 void IECore::murmurHashAppend( IECore::MurmurHash &h, const IECore::PathMatcher &data )
 {
-	HashStack stack;
-	for( PathMatcher::RawIterator it = data.begin(), eIt = data.end(); it != eIt; ++it )
-	{
-		// The iterator is recursive, so we use a stack to keep
-		// track of where we are. Resize the stack to match our
-		// current depth. The required size has the +1 because
-		// we need a stack entry for the root item.
-		size_t requiredStackSize = it->size() + 1;
-		if( requiredStackSize > stack.size() )
-		{
-			// Going a level deeper.
-			stack.push( HashNodes() );
-			assert( stack.size() == requiredStackSize );
-		}
-		else if( requiredStackSize < stack.size() )
-		{
-			// Returning from recursion to the child nodes.
-			// Output the hashes for the children we visited
-			// and stored on the stack previously.
-			popHashNodes( stack, requiredStackSize, h );
-		}
-
-		stack.top().push_back( HashNode( it->size() ? it->back().c_str() : "", it.exactMatch() ) );
-	}
-	popHashNodes( stack, 0, h );
+	h.append( data.m_root->hash() );
 }
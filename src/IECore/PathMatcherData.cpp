@@ -34,15 +34,66 @@
 
 #include "IECore/PathMatcherData.h"
 
+#include "IECore/Exception.h"
 #include "IECore/MessageHandler.h"
 #include "IECore/TypedData.inl"
 
+#include "boost/format.hpp"
+#include "boost/lexical_cast.hpp"
+
+#include <cstdlib>
+#include <unordered_map>
+
 using namespace IECore;
 
 namespace
 {
 
-static const unsigned int g_ioVersion = 0;
+// Version 0 : Paths stored as a flat list, and reconstructed using `addPath()`.
+// Version 1 : Node tree stored directly, as a pre-order traversal referencing
+//             a table of unique names.
+static const unsigned int g_ioVersion = 1;
+
+// Version 1 files can't be read by previous releases, so we only write them
+// when explicitly requested via the environment.
+unsigned int saveVersion()
+{
+	static const unsigned int g_saveVersion = [] () -> unsigned int {
+		const char *v = getenv( "IECORE_PATHMATCHERDATA_IOVERSION" );
+		if( !v || !*v )
+		{
+			return 0;
+		}
+
+		try
+		{
+			const unsigned int result = boost::lexical_cast<unsigned int>( v );
+			if( result <= g_ioVersion )
+			{
+				return result;
+			}
+		}
+		catch( const boost::bad_lexical_cast & )
+		{
+		}
+
+		msg( Msg::Warning, "PathMatcherData", boost::format( "Unsupported IECORE_PATHMATCHERDATA_IOVERSION \"%s\"" ) % v );
+		return 0;
+	}();
+	return g_saveVersion;
+}
+
+template<typename T>
+void readArray( const IndexedIO *container, const IndexedIO::EntryID &name, std::vector<T> &values )
+{
+	const IndexedIO::Entry entry = container->entry( name );
+	values.resize( entry.arrayLength() );
+	if( values.size() )
+	{
+		T *valuesPtr = values.data();
+		container->read( name, valuesPtr, values.size() );
+	}
+}
 
 } // namespace
 
@@ -55,25 +106,84 @@ template<>
 void PathMatcherData::save( SaveContext *context ) const
 {
 	Data::save( context );
-	IndexedIOPtr container = context->container( staticTypeName(), g_ioVersion );
+	const unsigned int version = saveVersion();
+	IndexedIOPtr container = context->container( staticTypeName(), version );
+
+	if( version < 1 )
+	{
+		std::vector<InternedString> strings;
+		std::vector<unsigned int> pathLengths;
+		std::vector<unsigned char> exactMatches;
+
+		for( PathMatcher::RawIterator it = readable().begin(), eIt = readable().end(); it != eIt; ++it )
+		{
+			pathLengths.push_back( it->size() );
+			if( it->size() )
+			{
+				strings.push_back( it->back() );
+			}
+			exactMatches.push_back( it.exactMatch() );
+		}
+
+		container->write( "strings", strings.data(), strings.size() );
+		container->write( "pathLengths", pathLengths.data(), pathLengths.size() );
+		container->write( "exactMatches", exactMatches.data(), exactMatches.size() );
+		return;
+	}
 
-	std::vector<InternedString> strings;
-	std::vector<unsigned int> pathLengths;
-	std::vector<unsigned char> exactMatches;
+	// We store each node in a pre-order traversal of the tree, recording
+	// the number of children it has and whether or not it is a terminator.
+	// This allows the tree to be rebuilt on loading without having to search
+	// for each path. Node names are stored as indices into a table of unique
+	// names, since the same names tend to occur many times in a typical
+	// hierarchy.
 
-	for( PathMatcher::RawIterator it = readable().begin(), eIt = readable().end(); it != eIt; ++it )
+	std::vector<InternedString> names;
+	std::unordered_map<const char *, unsigned int> nameIndices;
+	std::vector<unsigned int> nodeNames;
+	std::vector<unsigned int> childCounts;
+	std::vector<unsigned char> terminators;
+
+	using Node = PathMatcher::Node;
+	std::vector<std::pair<const PathMatcher::Name *, const Node *>> toVisit = { { nullptr, readable().m_root.get() } };
+	size_t numNodes = 0;
+	while( !toVisit.empty() )
 	{
-		pathLengths.push_back( it->size() );
-		if( it->size() )
+		const PathMatcher::Name *name = toVisit.back().first;
+		const Node *node = toVisit.back().second;
+		toVisit.pop_back();
+
+		if( name )
+		{
+			const auto inserted = nameIndices.insert( { name->name.c_str(), (unsigned int)names.size() } );
+			if( inserted.second )
+			{
+				names.push_back( name->name );
+			}
+			nodeNames.push_back( inserted.first->second );
+		}
+
+		childCounts.push_back( node->children.size() );
+		if( numNodes % 8 == 0 )
+		{
+			terminators.push_back( 0 );
+		}
+		if( node->terminator )
 		{
-			strings.push_back( it->back() );
+			terminators.back() |= 1 << ( numNodes % 8 );
+		}
+		numNodes++;
+
+		for( const auto &child : node->children )
+		{
+			toVisit.push_back( { &child.first, child.second.get() } );
 		}
-		exactMatches.push_back( it.exactMatch() );
 	}
 
-	container->write( "strings", strings.data(), strings.size() );
-	container->write( "pathLengths", pathLengths.data(), pathLengths.size() );
-	container->write( "exactMatches", exactMatches.data(), exactMatches.size() );
+	container->write( "names", names.data(), names.size() );
+	container->write( "nodeNames", nodeNames.data(), nodeNames.size() );
+	container->write( "childCounts", childCounts.data(), childCounts.size() );
+	container->write( "terminators", terminators.data(), terminators.size() );
 }
 
 template<>
@@ -83,37 +193,109 @@ void PathMatcherData::load( LoadContextPtr context )
 	unsigned int v = g_ioVersion;
 	ConstIndexedIOPtr container = context->container( staticTypeName(), v );
 
-	const IndexedIO::Entry stringsEntry = container->entry( "strings" );
-	std::vector<InternedString> strings;
-	strings.resize( stringsEntry.arrayLength() );
-	InternedString *stringsPtr = strings.data();
-	container->read( "strings", stringsPtr, stringsEntry.arrayLength() );
-
-	const IndexedIO::Entry pathLengthsEntry = container->entry( "pathLengths" );
-	std::vector<unsigned int> pathLengths;
-	pathLengths.resize( pathLengthsEntry.arrayLength() );
-	unsigned int *pathLengthsPtr = pathLengths.data();
-	container->read( "pathLengths", pathLengthsPtr, pathLengthsEntry.arrayLength() );
-
-	const IndexedIO::Entry exactMatchesEntry = container->entry( "exactMatches" );
-	std::vector<unsigned char> exactMatches;
-	exactMatches.resize( exactMatchesEntry.arrayLength() );
-	unsigned char *exactMatchesPtr = exactMatches.data();
-	container->read( "exactMatches", exactMatchesPtr, exactMatchesEntry.arrayLength() );
-
-	std::vector<InternedString> path;
-	for( size_t i = 0, e = pathLengths.size(); i < e; ++i )
+	if( v < 1 )
+	{
+		std::vector<InternedString> strings;
+		readArray( container.get(), "strings", strings );
+		std::vector<unsigned int> pathLengths;
+		readArray( container.get(), "pathLengths", pathLengths );
+		std::vector<unsigned char> exactMatches;
+		readArray( container.get(), "exactMatches", exactMatches );
+
+		const InternedString *stringsPtr = strings.data();
+		std::vector<InternedString> path;
+		for( size_t i = 0, e = pathLengths.size(); i < e; ++i )
+		{
+			path.resize( pathLengths[i] );
+			if( pathLengths[i] )
+			{
+				path.back() = *stringsPtr++;
+			}
+			if( exactMatches[i] )
+			{
+				writable().addPath( path );
+			}
+		}
+		return;
+	}
+
+	std::vector<InternedString> names;
+	readArray( container.get(), "names", names );
+	std::vector<unsigned int> nodeNames;
+	readArray( container.get(), "nodeNames", nodeNames );
+	std::vector<unsigned int> childCounts;
+	readArray( container.get(), "childCounts", childCounts );
+	std::vector<unsigned char> terminators;
+	readArray( container.get(), "terminators", terminators );
+
+	const size_t numNodes = childCounts.size();
+	if( !numNodes || nodeNames.size() != numNodes - 1 || terminators.size() != ( numNodes + 7 ) / 8 )
+	{
+		throw IOException( "PathMatcherData::load : Inconsistent array sizes" );
+	}
+
+	// Classifying names as wildcarded or not is relatively expensive,
+	// so we do it once per unique name rather than once per node.
+	using Name = PathMatcher::Name;
+	using Node = PathMatcher::Node;
+	std::vector<Name> typedNames;
+	typedNames.reserve( names.size() );
+	for( const auto &name : names )
+	{
+		typedNames.emplace_back( name );
+	}
+
+	auto terminator = [&terminators] ( size_t i ) {
+		return terminators[i / 8] & ( 1 << ( i % 8 ) );
+	};
+
+	PathMatcher::NodePtr root = new Node( terminator( 0 ) );
+
+	// Stack of nodes still waiting for children, along with
+	// the number of children remaining to be read.
+	std::vector<std::pair<Node *, unsigned int>> toFill;
+	if( childCounts[0] )
+	{
+		toFill.push_back( { root.get(), childCounts[0] } );
+	}
+
+	for( size_t i = 1; i < numNodes; ++i )
 	{
-		path.resize( pathLengths[i] );
-		if( pathLengths[i] )
+		if( toFill.empty() )
+		{
+			throw IOException( "PathMatcherData::load : Unexpected node" );
+		}
+
+		const unsigned int nameIndex = nodeNames[i-1];
+		if( nameIndex >= typedNames.size() )
+		{
+			throw IOException( "PathMatcherData::load : Name index out of range" );
+		}
+
+		// Share a single instance for all leaf nodes, exactly as
+		// `PathMatcher::addPath()` does.
+		const bool isTerminator = terminator( i );
+		PathMatcher::NodePtr node = isTerminator && !childCounts[i] ? Node::leaf() : new Node( isTerminator );
+
+		Node *parent = toFill.back().first;
+		if( --toFill.back().second == 0 )
 		{
-			path.back() = *stringsPtr++;
+			toFill.pop_back();
 		}
-		if( exactMatches[i] )
+
+		parent->children.emplace( typedNames[nameIndex], node );
+		if( childCounts[i] )
 		{
-			writable().addPath( path );
+			toFill.push_back( { node.get(), childCounts[i] } );
 		}
 	}
+
+	if( !toFill.empty() )
+	{
+		throw IOException( "PathMatcherData::load : Missing nodes" );
+	}
+
+	writable() = PathMatcher( root );
 }
 
 template class TypedData<PathMatcher>;
@@ -0,0 +1,629 @@
+//////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (c) 2026, Image Engine Design Inc. All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//
+//     * Neither the name of Image Engine Design nor the names of any
+//       other contributors to this software may be used to endorse or
+//       promote products derived from this software without specific prior
+//       written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+//  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+//  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+//  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+//  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+//  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+//  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+//  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+//  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+//  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//////////////////////////////////////////////////////////////////////////
+
+
+#include "IECore/SharedMemoryObjectCache.h"
+
+#include "IECore/Exception.h"
+#include "IECore/MemoryIndexedIO.h"
+#include "IECore/MessageHandler.h"
+#include "IECore/VectorTypedData.h"
+
+#include "boost/format.hpp"
+#include "boost/lexical_cast.hpp"
+#include "boost/noncopyable.hpp"
+
+#ifndef _MSC_VER
+#include <fcntl.h>
+#include <pthread.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <thread>
+
+using namespace IECore;
+
+#ifndef _MSC_VER
+
+//////////////////////////////////////////////////////////////////////////
+// Segment layout
+//////////////////////////////////////////////////////////////////////////
+
+namespace
+{
+
+// The segment contains a Header, followed by an index of Slots, followed
+// by the storage for the records themselves. The storage is used as a ring
+// buffer, with each record being written contiguously, prefixed with a
+// RecordHeader.
+
+const uint64_t g_magic = 0x434f4d4853434549; // "IECSHMOC"
+const uint32_t g_version = 1;
+const size_t g_alignment = 64;
+const size_t g_minimumSize = 1024 * 1024;
+// The index is set associative, with this many slots per bucket.
+const size_t g_slotsPerBucket = 8;
+// We provide one slot per this many bytes of storage, which is
+// plenty given that the objects worth sharing are generally large.
+const size_t g_bytesPerSlot = 16 * 1024;
+
+static_assert( std::atomic<uint64_t>::is_always_lock_free, "Atomics must be address free to be shared between processes" );
+
+struct Slot
+{
+	uint64_t h1;
+	uint64_t h2;
+	// Position of the record in the ring buffer, measured as the
+	// total number of bytes written since the segment was created.
+	uint64_t position;
+	// Size of the serialised object, or 0 if the slot is unused.
+	uint64_t size;
+};
+
+struct RecordHeader
+{
+	uint64_t h1;
+	uint64_t h2;
+	uint64_t size;
+};
+
+struct Header
+{
+	std::atomic<uint64_t> magic;
+	uint32_t version;
+	uint64_t segmentSize;
+	uint64_t numBuckets;
+	uint64_t storageOffset;
+	uint64_t storageSize;
+	pthread_mutex_t mutex;
+	// Position at which the next record will be written. This is advanced
+	// before each record is written, so a reader can detect that a record
+	// was overwritten while it was being copied, by checking that the record
+	// still begins within `storageSize` bytes of this position.
+	std::atomic<uint64_t> writePosition;
+	// Value of `writePosition` after the last call to `clear()`.
+	uint64_t clearPosition;
+};
+
+size_t roundUp( size_t x, size_t multiple )
+{
+	return ( ( x + multiple - 1 ) / multiple ) * multiple;
+}
+
+std::string segmentName( const std::string &name )
+{
+	return "/" + name;
+}
+
+class ScopedLock : boost::noncopyable
+{
+
+	public :
+
+		ScopedLock( pthread_mutex_t *mutex )
+			:	m_mutex( mutex )
+		{
+			int result = pthread_mutex_lock( m_mutex );
+#ifdef __linux__
+			if( result == EOWNERDEAD )
+			{
+				// Another process died while holding the lock. Records are
+				// only published after they have been written in full, and are
+				// validated again on retrieval, so it is safe to carry on.
+				pthread_mutex_consistent( m_mutex );
+				result = 0;
+			}
+#endif
+			if( result != 0 )
+			{
+				throw Exception( boost::str( boost::format( "SharedMemoryObjectCache : Failed to lock mutex (%1%)" ) % strerror( result ) ) );
+			}
+		}
+
+		~ScopedLock()
+		{
+			pthread_mutex_unlock( m_mutex );
+		}
+
+	private :
+
+		pthread_mutex_t *m_mutex;
+
+};
+
+} // namespace
+
+//////////////////////////////////////////////////////////////////////////
+// MemberData
+//////////////////////////////////////////////////////////////////////////
+
+struct SharedMemoryObjectCache::MemberData
+{
+
+	MemberData( const std::string &name, size_t size )
+		:	name( name ),
+			statistics(
+				[this] ( CacheStatistics::Snapshot &snapshot ) {
+					snapshot.currentCost = memoryUsage();
+					snapshot.maxCost = header->storageSize;
+				}
+			)
+	{
+		const std::string shmName = segmentName( name );
+		int fd = shm_open( shmName.c_str(), O_RDWR | O_CREAT | O_EXCL, 0600 );
+		const bool creator = fd >= 0;
+		if( !creator )
+		{
+			if( errno == EEXIST )
+			{
+				fd = shm_open( shmName.c_str(), O_RDWR, 0 );
+			}
+			if( fd < 0 )
+			{
+				throw IOException( boost::str( boost::format( "SharedMemoryObjectCache : Failed to open \"%1%\" (%2%)" ) % name % strerror( errno ) ) );
+			}
+		}
+
+		try
+		{
+			if( creator )
+			{
+				mappedSize = roundUp( std::max( size, g_minimumSize ), g_alignment );
+				if( ftruncate( fd, mappedSize ) != 0 )
+				{
+					throw IOException( boost::str( boost::format( "SharedMemoryObjectCache : Failed to allocate %1% bytes for \"%2%\" (%3%)" ) % mappedSize % name % strerror( errno ) ) );
+				}
+			}
+			else
+			{
+				// The creator may not have sized the segment yet.
+				mappedSize = waitFor( [fd] { struct stat s; return fstat( fd, &s ) == 0 ? (size_t)s.st_size : 0; } );
+			}
+
+			void *mapped = mmap( nullptr, mappedSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0 );
+			if( mapped == MAP_FAILED )
+			{
+				throw IOException( boost::str( boost::format( "SharedMemoryObjectCache : Failed to map \"%1%\" (%2%)" ) % name % strerror( errno ) ) );
+			}
+			header = static_cast<Header *>( mapped );
+		}
+		catch( ... )
+		{
+			::close( fd );
+			if( creator )
+			{
+				shm_unlink( shmName.c_str() );
+			}
+			throw;
+		}
+
+		// The mapping keeps its own reference to the segment.
+		::close( fd );
+
+		if( creator )
+		{
+			initialise();
+		}
+		else
+		{
+			waitFor( [this] { return header->magic.load( std::memory_order_acquire ) == g_magic; } );
+			if( header->version != g_version || header->segmentSize != mappedSize )
+			{
+				munmap( header, mappedSize );
+				throw IOException( boost::str( boost::format( "SharedMemoryObjectCache : \"%1%\" is incompatible with this version of Cortex" ) % name ) );
+			}
+		}
+	}
+
+	~MemberData()
+	{
+		munmap( header, mappedSize );
+	}
+
+	void initialise()
+	{
+		// The segment is zero filled by `ftruncate()`, which is a valid
+		// initial state for everything except the fields set here.
+		header->version = g_version;
+		header->segmentSize = mappedSize;
+		header->numBuckets = std::max<size_t>( mappedSize / ( g_bytesPerSlot * g_slotsPerBucket ), 1 );
+		header->storageOffset = roundUp( roundUp( sizeof( Header ), g_alignment ) + header->numBuckets * g_slotsPerBucket * sizeof( Slot ), g_alignment );
+		header->storageSize = ( ( mappedSize - header->storageOffset ) / g_alignment ) * g_alignment;
+
+		pthread_mutexattr_t attributes;
+		pthread_mutexattr_init( &attributes );
+		pthread_mutexattr_setpshared( &attributes, PTHREAD_PROCESS_SHARED );
+#ifdef __linux__
+		pthread_mutexattr_setrobust( &attributes, PTHREAD_MUTEX_ROBUST );
+#endif
+		pthread_mutex_init( &header->mutex, &attributes );
+		pthread_mutexattr_destroy( &attributes );
+
+		header->magic.store( g_magic, std::memory_order_release );
+	}
+
+	// Polls `f` until it returns a non-zero value, throwing if that takes
+	// unreasonably long. Used to wait for another process to finish creating
+	// the segment.
+	template<typename F>
+	auto waitFor( F &&f ) -> decltype( f() )
+	{
+		const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds( 10 );
+		while( true )
+		{
+			if( auto result = f() )
+			{
+				return result;
+			}
+			if( std::chrono::steady_clock::now() > deadline )
+			{
+				throw IOException( boost::str( boost::format( "SharedMemoryObjectCache : Timed out waiting for \"%1%\" to be initialised" ) % name ) );
+			}
+			std::this_thread::sleep_for( std::chrono::milliseconds( 1 ) );
+		}
+	}
+
+	Slot *bucket( const MurmurHash &key ) const
+	{
+		Slot *slots = reinterpret_cast<Slot *>( reinterpret_cast<char *>( header ) + roundUp( sizeof( Header ), g_alignment ) );
+		return slots + ( key.h1() % header->numBuckets ) * g_slotsPerBucket;
+	}
+
+	char *storage( uint64_t position ) const
+	{
+		return reinterpret_cast<char *>( header ) + header->storageOffset + position % header->storageSize;
+	}
+
+	bool valid( const Slot &slot ) const
+	{
+		return
+			slot.size &&
+			slot.position % header->storageSize + sizeof( RecordHeader ) + slot.size <= header->storageSize &&
+			header->writePosition.load( std::memory_order_relaxed ) - slot.position <= header->storageSize
+		;
+	}
+
+	// Orders slots for replacement, with unused slots first
+	// and then the oldest records.
+	uint64_t replacementRank( const Slot &slot ) const
+	{
+		return valid( slot ) ? slot.position + 1 : 0;
+	}
+
+	// Must be called with the mutex held.
+	const Slot *find( const MurmurHash &key ) const
+	{
+		const Slot *b = bucket( key );
+		for( size_t i = 0; i < g_slotsPerBucket; ++i )
+		{
+			if( b[i].h1 == key.h1() && b[i].h2 == key.h2() && valid( b[i] ) )
+			{
+				return b + i;
+			}
+		}
+		return nullptr;
+	}
+
+	// Must be called with the mutex held. Returns the position for
+	// a new record of the given size, invalidating any records it
+	// will overwrite.
+	uint64_t reserve( uint64_t size )
+	{
+		uint64_t position = header->writePosition.load( std::memory_order_relaxed );
+		const uint64_t offset = position % header->storageSize;
+		if( offset + size > header->storageSize )
+		{
+			// Records are contiguous, so skip to the start of the buffer.
+			position += header->storageSize - offset;
+		}
+		header->writePosition.store( position + size, std::memory_order_relaxed );
+		// Make sure the new write position is visible before anything we
+		// write to the record.
+		std::atomic_thread_fence( std::memory_order_release );
+		return position;
+	}
+
+	size_t memoryUsage() const
+	{
+		ScopedLock lock( &header->mutex );
+		return std::min( header->writePosition.load( std::memory_order_relaxed ) - header->clearPosition, header->storageSize );
+	}
+
+	const std::string name;
+	Header *header;
+	size_t mappedSize;
+	CacheStatistics statistics;
+
+};
+
+//////////////////////////////////////////////////////////////////////////
+// SharedMemoryObjectCache
+//////////////////////////////////////////////////////////////////////////
+
+SharedMemoryObjectCache::SharedMemoryObjectCache( const std::string &name, size_t size )
+	:	m_data( new MemberData( name, size ) )
+{
+}
+
+SharedMemoryObjectCache::~SharedMemoryObjectCache()
+{
+}
+
+const std::string &SharedMemoryObjectCache::name() const
+{
+	return m_data->name;
+}
+
+size_t SharedMemoryObjectCache::getMaxMemoryUsage() const
+{
+	return m_data->header->storageSize;
+}
+
+size_t SharedMemoryObjectCache::memoryUsage() const
+{
+	return m_data->memoryUsage();
+}
+
+bool SharedMemoryObjectCache::contains( const MurmurHash &key ) const
+{
+	ScopedLock lock( &m_data->header->mutex );
+	return m_data->find( key );
+}
+
+ObjectPtr SharedMemoryObjectCache::retrieve( const MurmurHash &key ) const
+{
+	Slot slot;
+	{
+		ScopedLock lock( &m_data->header->mutex );
+		const Slot *s = m_data->find( key );
+		if( !s )
+		{
+			m_data->statistics.recordMiss();
+			return nullptr;
+		}
+		slot = *s;
+	}
+
+	// Copy the record without holding the lock, so that other processes
+	// aren't held up while we do so. Then check that it wasn't overwritten
+	// while we were copying.
+
+	RecordHeader recordHeader;
+	CharVectorDataPtr buffer = new CharVectorData;
+	buffer->writable().resize( slot.size );
+	const char *record = m_data->storage( slot.position );
+	memcpy( &recordHeader, record, sizeof( RecordHeader ) );
+	memcpy( buffer->writable().data(), record + sizeof( RecordHeader ), slot.size );
+	std::atomic_thread_fence( std::memory_order_acquire );
+
+	if(
+		!m_data->valid( slot ) ||
+		recordHeader.h1 != key.h1() || recordHeader.h2 != key.h2() || recordHeader.size != slot.size
+	)
+	{
+		m_data->statistics.recordMiss();
+		return nullptr;
+	}
+
+	MemoryIndexedIOPtr io = new MemoryIndexedIO( buffer, IndexedIO::rootPath, IndexedIO::Exclusive | IndexedIO::Read );
+	ObjectPtr result = Object::load( io, "object" );
+	m_data->statistics.recordHit();
+	return result;
+}
+
+bool SharedMemoryObjectCache::store( const MurmurHash &key, const Object *object )
+{
+	MemoryIndexedIOPtr io = new MemoryIndexedIO( ConstCharVectorDataPtr(), IndexedIO::rootPath, IndexedIO::Exclusive | IndexedIO::Write );
+	object->save( io, "object" );
+	ConstCharVectorDataPtr buffer = io->buffer();
+	const std::vector<char> &data = buffer->readable();
+
+	const uint64_t recordSize = roundUp( sizeof( RecordHeader ) + data.size(), g_alignment );
+	if( recordSize > m_data->header->storageSize )
+	{
+		return false;
+	}
+
+	ScopedLock lock( &m_data->header->mutex );
+
+	// Choose a slot, preferring one already holding this key, then
+	// an unused one, and otherwise replacing the oldest record.
+
+	Slot *bucket = m_data->bucket( key );
+	Slot *slot = bucket;
+	for( size_t i = 0; i < g_slotsPerBucket; ++i )
+	{
+		if( bucket[i].h1 == key.h1() && bucket[i].h2 == key.h2() )
+		{
+			slot = bucket + i;
+			break;
+		}
+		else if( m_data->replacementRank( bucket[i] ) < m_data->replacementRank( *slot ) )
+		{
+			slot = bucket + i;
+		}
+	}
+
+	// Write the record.
+
+	const uint64_t position = m_data->reserve( recordSize );
+	const RecordHeader recordHeader = { key.h1(), key.h2(), data.size() };
+	char *record = m_data->storage( position );
+	memcpy( record, &recordHeader, sizeof( RecordHeader ) );
+	memcpy( record + sizeof( RecordHeader ), data.data(), data.size() );
+
+	// And publish it.
+
+	slot->size = 0;
+	slot->h1 = key.h1();
+	slot->h2 = key.h2();
+	slot->position = position;
+	slot->size = data.size();
+
+	return true;
+}
+
+void SharedMemoryObjectCache::clear()
+{
+	Header *header = m_data->header;
+	ScopedLock lock( &header->mutex );
+	// Advancing the write position by the full size of the
+	// buffer invalidates every record.
+	const uint64_t position = header->writePosition.load( std::memory_order_relaxed ) + header->storageSize;
+	header->writePosition.store( position, std::memory_order_relaxed );
+	header->clearPosition = position;
+}
+
+CacheStatistics &SharedMemoryObjectCache::statistics()
+{
+	return m_data->statistics;
+}
+
+const CacheStatistics &SharedMemoryObjectCache::statistics() const
+{
+	return m_data->statistics;
+}
+
+void SharedMemoryObjectCache::remove( const std::string &name )
+{
+	if( shm_unlink( segmentName( name ).c_str() ) != 0 && errno != ENOENT )
+	{
+		throw IOException( boost::str( boost::format( "SharedMemoryObjectCache : Failed to remove \"%1%\" (%2%)" ) % name % strerror( errno ) ) );
+	}
+}
+
+#else
+
+// Shared memory isn't supported on Windows yet, so construction
+// always fails, and the remaining methods are unreachable.
+
+struct SharedMemoryObjectCache::MemberData
+{
+	std::string name;
+	CacheStatistics statistics;
+};
+
+SharedMemoryObjectCache::SharedMemoryObjectCache( const std::string &name, size_t size )
+{
+	throw Exception( "SharedMemoryObjectCache : Shared memory is not supported on this platform" );
+}
+
+SharedMemoryObjectCache::~SharedMemoryObjectCache()
+{
+}
+
+const std::string &SharedMemoryObjectCache::name() const
+{
+	return m_data->name;
+}
+
+size_t SharedMemoryObjectCache::getMaxMemoryUsage() const
+{
+	return 0;
+}
+
+size_t SharedMemoryObjectCache::memoryUsage() const
+{
+	return 0;
+}
+
+bool SharedMemoryObjectCache::contains( const MurmurHash &key ) const
+{
+	return false;
+}
+
+ObjectPtr SharedMemoryObjectCache::retrieve( const MurmurHash &key ) const
+{
+	return nullptr;
+}
+
+bool SharedMemoryObjectCache::store( const MurmurHash &key, const Object *object )
+{
+	return false;
+}
+
+void SharedMemoryObjectCache::clear()
+{
+}
+
+CacheStatistics &SharedMemoryObjectCache::statistics()
+{
+	return m_data->statistics;
+}
+
+const CacheStatistics &SharedMemoryObjectCache::statistics() const
+{
+	return m_data->statistics;
+}
+
+void SharedMemoryObjectCache::remove( const std::string &name )
+{
+}
+
+#endif
+
+SharedMemoryObjectCache *SharedMemoryObjectCache::defaultCache()
+{
+	// Deliberately leaked, to avoid destruction order problems at exit.
+	static SharedMemoryObjectCache *c = [] () -> SharedMemoryObjectCache * {
+		const char *name = getenv( "IECORE_SHAREDMEMORYOBJECTCACHE_NAME" );
+		if( !name || !*name )
+		{
+			return nullptr;
+		}
+
+		const char *m = getenv( "IECORE_SHAREDMEMORYOBJECTCACHE_MEMORY" );
+		size_t mi = m ? boost::lexical_cast<size_t>( m ) : 1024;
+		try
+		{
+			SharedMemoryObjectCache *result = new SharedMemoryObjectCache( name, 1024 * 1024 * mi );
+			result->addRef();
+			result->statistics().setName( "SharedMemoryObjectCache" );
+			return result;
+		}
+		catch( const std::exception &e )
+		{
+			msg( Msg::Warning, "SharedMemoryObjectCache::defaultCache", e.what() );
+			return nullptr;
+		}
+	}();
+	return c;
+}
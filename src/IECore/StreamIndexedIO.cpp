@@ -45,7 +45,11 @@
 
 #include "blosc.h"
 
+#include "tbb/blocked_range.h"
+#include "tbb/parallel_for.h"
 #include "tbb/spin_rw_mutex.h"
+#include "tbb/task_arena.h"
+#include "tbb/task_group.h"
 
 #include "boost/format.hpp"
 #include "boost/iostreams/device/file.hpp"
@@ -57,14 +61,23 @@
 #include "boost/tokenizer.hpp"
 
 #include <algorithm>
+#include <atomic>
 #include <cassert>
+#include <cstring>
+#include <deque>
+#include <exception>
 #include <iostream>
 #include <list>
 #include <map>
+#include <memory>
 #include <set>
+#include <thread>
+#include <unordered_map>
 
 #include <fcntl.h>
 #ifndef _MSC_VER
+	#include <sys/mman.h>
+	#include <sys/stat.h>
 	#include <unistd.h>
 #endif
 #include <stdint.h>
@@ -162,7 +175,10 @@ class StreamIndexedIO::PlatformReader
 	public:
 		virtual ~PlatformReader();
 		virtual bool read( char *buffer, size_t size, size_t pos ) = 0;
-		static std::unique_ptr<PlatformReader> create( const std::string &fileName );
+		/// Returns a pointer to 'size' bytes at 'pos' offset in the file if they
+		/// are directly addressable in memory, or nullptr otherwise.
+		virtual const char *data( size_t size, size_t pos );
+		static std::unique_ptr<PlatformReader> create( const std::string &fileName, bool memoryMapped = false );
 };
 
 #ifndef _MSC_VER
@@ -200,15 +216,140 @@ bool PosixPlatformReader::read( char *buffer, size_t size, size_t pos )
 	return (size_t) result == size;
 }
 
+/// Memory mapped Reader for Linux & OSX. The whole file is mapped read only
+/// and shared, so that processes reading the same file share the page cache,
+/// and data blocks can be accessed without an intermediate copy.
+class MmapPlatformReader : public StreamIndexedIO::PlatformReader
+{
+	public:
+		~MmapPlatformReader();
+		MmapPlatformReader( const std::string &fileName );
+		/// Returns false if the file could not be mapped.
+		bool valid() const;
+		bool read( char *buffer, size_t size, size_t pos ) override;
+		const char *data( size_t size, size_t pos ) override;
+	private:
+		char *m_data;
+		size_t m_size;
+};
+
+MmapPlatformReader::MmapPlatformReader( const std::string &fileName ) : m_data( nullptr ), m_size( 0 )
+{
+	int fileHandle = ::open( fileName.c_str(), O_RDONLY );
+	if( fileHandle < 0 )
+	{
+		return;
+	}
+
+	struct stat fileStat;
+	if( fstat( fileHandle, &fileStat ) == 0 && fileStat.st_size > 0 )
+	{
+		void *mapped = mmap( nullptr, fileStat.st_size, PROT_READ, MAP_SHARED, fileHandle, 0 );
+		if( mapped != MAP_FAILED )
+		{
+			m_data = static_cast<char *>( mapped );
+			m_size = fileStat.st_size;
+		}
+	}
+
+	// the mapping keeps its own reference to the file
+	::close( fileHandle );
+}
+
+MmapPlatformReader::~MmapPlatformReader()
+{
+	if( m_data )
+	{
+		munmap( m_data, m_size );
+	}
+}
+
+bool MmapPlatformReader::valid() const
+{
+	return m_data != nullptr;
+}
+
+bool MmapPlatformReader::read( char *buffer, size_t size, size_t pos )
+{
+	const char *src = data( size, pos );
+	if( !src )
+	{
+		return false;
+	}
+
+	memcpy( buffer, src, size );
+	return true;
+}
+
+const char *MmapPlatformReader::data( size_t size, size_t pos )
+{
+	if( !m_data || pos > m_size || size > m_size - pos )
+	{
+		return nullptr;
+	}
+	return m_data + pos;
+}
+
 #endif
 
+/// Reader for files held in an immutable memory buffer.
+class BufferPlatformReader : public StreamIndexedIO::PlatformReader
+{
+	public:
+		BufferPlatformReader( const char *buffer, size_t size );
+		bool read( char *buffer, size_t size, size_t pos ) override;
+		const char *data( size_t size, size_t pos ) override;
+	private:
+		const char *m_buffer;
+		size_t m_size;
+};
+
+BufferPlatformReader::BufferPlatformReader( const char *buffer, size_t size ) : m_buffer( buffer ), m_size( size )
+{
+}
+
+bool BufferPlatformReader::read( char *buffer, size_t size, size_t pos )
+{
+	const char *src = data( size, pos );
+	if( !src )
+	{
+		return false;
+	}
+
+	memcpy( buffer, src, size );
+	return true;
+}
+
+const char *BufferPlatformReader::data( size_t size, size_t pos )
+{
+	if( pos > m_size || size > m_size - pos )
+	{
+		return nullptr;
+	}
+	return m_buffer + pos;
+}
+
 StreamIndexedIO::PlatformReader::~PlatformReader()
 {
 }
 
-std::unique_ptr<StreamIndexedIO::PlatformReader> StreamIndexedIO::PlatformReader::create(const std::string& fileName)
+const char *StreamIndexedIO::PlatformReader::data( size_t size, size_t pos )
+{
+	return nullptr;
+}
+
+std::unique_ptr<StreamIndexedIO::PlatformReader> StreamIndexedIO::PlatformReader::create( const std::string& fileName, bool memoryMapped )
 {
 #ifndef _MSC_VER
+	if( memoryMapped )
+	{
+		std::unique_ptr<MmapPlatformReader> m( new MmapPlatformReader( fileName ) );
+		if( m->valid() )
+		{
+			return std::move( m );
+		}
+	}
+
 	PlatformReader* p = new PosixPlatformReader(fileName);
 	return std::unique_ptr<StreamIndexedIO::PlatformReader>(p);
 #else
@@ -375,6 +516,10 @@ namespace
 const char* indexCompressor = "lz4";
 const int indexCompressionLevel = 9;
 
+/// Large data is split into independently compressed blocks of at most this size,
+/// so that the blocks can be decompressed in parallel.
+const size_t defaultMaxCompressedBlockSize = 8 * 1024 * 1024;
+
 const static std::map<std::string, int> nameCodeMapping = {{"blosclz", 0}, {"lz4", 1}, {"lz4hc", 2}, {"snappy", 3}, {"zlib", 4}};
 
 //! map blosc compressor name to a int which we can serialise into
@@ -402,8 +547,89 @@ std::string getCompressor( int code )
 	return "unknown";
 }
 
+const static std::map<std::string, int> nameShuffleMapping = {{"none", BLOSC_NOSHUFFLE}, {"byte", BLOSC_SHUFFLE}, {"bit", BLOSC_BITSHUFFLE}};
+
+//! map a shuffle name to the blosc shuffle mode, returning -1 for "auto"
+//! and -2 for unknown names.
+int getShuffle( const std::string &shuffle )
+{
+	if( shuffle == "auto" )
+	{
+		return -1;
+	}
+
+	const auto it = nameShuffleMapping.find( shuffle );
+	if( it != nameShuffleMapping.end() )
+	{
+		return it->second;
+	}
+	return -2;
+}
+
+const static std::map<std::string, IndexedIO::DataType> nameDataTypeMapping = {
+	{"Float", IndexedIO::Float}, {"FloatArray", IndexedIO::FloatArray},
+	{"Double", IndexedIO::Double}, {"DoubleArray", IndexedIO::DoubleArray},
+	{"Int", IndexedIO::Int}, {"IntArray", IndexedIO::IntArray},
+	{"String", IndexedIO::String}, {"StringArray", IndexedIO::StringArray},
+	{"UInt", IndexedIO::UInt}, {"UIntArray", IndexedIO::UIntArray},
+	{"Char", IndexedIO::Char}, {"CharArray", IndexedIO::CharArray},
+	{"UChar", IndexedIO::UChar}, {"UCharArray", IndexedIO::UCharArray},
+	{"Half", IndexedIO::Half}, {"HalfArray", IndexedIO::HalfArray},
+	{"Short", IndexedIO::Short}, {"ShortArray", IndexedIO::ShortArray},
+	{"UShort", IndexedIO::UShort}, {"UShortArray", IndexedIO::UShortArray},
+	{"Int64", IndexedIO::Int64}, {"Int64Array", IndexedIO::Int64Array},
+	{"UInt64", IndexedIO::UInt64}, {"UInt64Array", IndexedIO::UInt64Array},
+	{"InternedStringArray", IndexedIO::InternedStringArray}
+};
+
+//! returns the size in bytes of the elements stored for the given data type,
+//! which is used as the blosc typesize so that shuffling groups equivalent bytes.
+size_t elementSize( IndexedIO::DataType dataType )
+{
+	switch( dataType )
+	{
+		case IndexedIO::Half :
+		case IndexedIO::HalfArray :
+		case IndexedIO::Short :
+		case IndexedIO::ShortArray :
+		case IndexedIO::UShort :
+		case IndexedIO::UShortArray :
+			return 2;
+		case IndexedIO::Float :
+		case IndexedIO::FloatArray :
+		case IndexedIO::Int :
+		case IndexedIO::IntArray :
+		case IndexedIO::UInt :
+		case IndexedIO::UIntArray :
+		case IndexedIO::Long :
+		case IndexedIO::LongArray :
+			return 4;
+		case IndexedIO::Double :
+		case IndexedIO::DoubleArray :
+		case IndexedIO::Int64 :
+		case IndexedIO::Int64Array :
+		case IndexedIO::UInt64 :
+		case IndexedIO::UInt64Array :
+		case IndexedIO::InternedStringArray :
+			return 8;
+		default :
+			return 1;
+	}
+}
+
+/// Size of the leading sample used to decide whether large data
+/// is worth compressing at all.
+const size_t compressionProbeSize = 64 * 1024;
+
+/// Data smaller than this is never compressed, so isn't worth writing asynchronously.
+const size_t minCompressedBlockSize = 1024;
+
+/// Maximum amount of uncompressed data queued for asynchronous compression
+/// before the writing thread waits for the oldest writes to be committed.
+const size_t maxPendingWriteSize = 256 * 1024 * 1024;
+
 /// compress 'size' bytes at 'data' into 'outputBuffer'
-/// compressionLevel, compressor & threadCount are passed directly to blosc ( see blosc.h )
+/// compressionLevel, compressor, threadCount, shuffle & typeSize are passed directly to blosc ( see blosc.h )
 /// if  'size' is greater than the max buffer blosc can handle we split into a number of independently compressed blocks.
 /// returns the number of compression blocks
 /// 'outputBuffer' contains the compressed block data and is resized in this function.
@@ -416,10 +642,12 @@ size_t compress(
 	const std::string &compressor,
 	int threadCount,
 	boost::optional<size_t> maxBlockSize = boost::optional<size_t>(),
-	size_t minCompressedBlockSize = 1024U
+	size_t minCompressedBlockSize = 1024U,
+	int shuffle = BLOSC_SHUFFLE,
+	size_t typeSize = 4
 )
 {
-	size_t maxCompressedBlockSize = maxBlockSize ? maxBlockSize.get() : BLOSC_MAX_BUFFERSIZE;
+	size_t maxCompressedBlockSize = maxBlockSize ? maxBlockSize.get() : defaultMaxCompressedBlockSize;
 
 	if( size < minCompressedBlockSize )
 	{
@@ -446,13 +674,17 @@ size_t compress(
 		if( writerBufferBytes < compressedBufferMaxSize )
 		{
 			size_t additionalBytes = (size_t) ( compressedBufferMaxSize - writerBufferBytes );
+			// resizing may reallocate, so we must reacquire our write pointer
+			size_t writeOffset = writePtr - outputBuffer.data();
 			outputBuffer.resize( outputBuffer.size() + additionalBytes );
+			writePtr = outputBuffer.data() + writeOffset;
+			writerBufferBytes += additionalBytes;
 		}
 
 		int compressedSize = blosc_compress_ctx(
 			compressionLevel,
-			true,
-			4,
+			shuffle,
+			typeSize,
 			currentBlockUncompressedSize,
 			currentBlockCompressed,
 			writePtr,
@@ -485,12 +717,79 @@ size_t compress(
 	return numBlocks;
 }
 
+/// decompress 'numBlocks' consecutive blosc compressed blocks from 'data' into 'outputBuffer', which
+/// must be large enough to store the decompressed data. Blocks are decompressed in parallel using TBB
+/// tasks in the calling thread's arena, so that we cooperate with any outer parallelism. threadCount is
+/// passed to blosc only when there is a single block, since otherwise the parallelism comes from TBB.
+void decompressBlocks( const char *data, size_t numBlocks, char *outputBuffer, int threadCount )
+{
+	struct Block
+	{
+		const char *source;
+		char *destination;
+		size_t decompressedSize;
+	};
+
+	std::vector<Block> blocks;
+	blocks.reserve( numBlocks );
+
+	const char *readPtr = data;
+	char *writePtr = outputBuffer;
+	for( size_t i = 0; i < numBlocks; ++i )
+	{
+		/// read the blosc header so we can locate the next block
+		size_t compressedNumBytes = 0, decompressedNumBytes = 0, blockSize = 0;
+		blosc_cbuffer_sizes( readPtr, &decompressedNumBytes, &compressedNumBytes, &blockSize );
+
+		blocks.push_back( { readPtr, writePtr, decompressedNumBytes } );
+
+		readPtr += compressedNumBytes;
+		writePtr += decompressedNumBytes;
+	}
+
+	const int bloscThreadCount = blocks.size() == 1 ? threadCount : 1;
+	auto decompressBlock = [bloscThreadCount] ( const Block &block ) {
+		int bloscResult = blosc_decompress_ctx( block.source, block.destination, block.decompressedSize, bloscThreadCount );
+		if( bloscResult <= 0 )
+		{
+			throw IECore::IOException( "StreamIndexedIO (decompress) - Corrupted compressed archive" );
+		}
+	};
+
+	if( blocks.size() == 1 )
+	{
+		decompressBlock( blocks[0] );
+		return;
+	}
+
+	// We may be called while a lock is held, so we isolate the work to stop
+	// this thread stealing unrelated tasks which might need the same lock
+	// while waiting for the blocks. The isolated context additionally
+	// prevents cancellation of any outer task group from leaving the
+	// output partially decompressed.
+	tbb::this_task_arena::isolate(
+		[&blocks, &decompressBlock] {
+			tbb::task_group_context taskGroupContext( tbb::task_group_context::isolated );
+			tbb::parallel_for(
+				tbb::blocked_range<size_t>( 0, blocks.size(), 1 ),
+				[&blocks, &decompressBlock] ( const tbb::blocked_range<size_t> &range ) {
+					for( size_t i = range.begin(); i != range.end(); ++i )
+					{
+						decompressBlock( blocks[i] );
+					}
+				},
+				taskGroupContext
+			);
+		}
+	);
+}
+
 /// decompress a memory buffer which is formed by a number of blosc compressed blocks
 /// returns the number of compression blocks
 /// 'outputBuffer' contains the decompressed data and is resized in this function if not large enough.
 size_t decompress( const char *data, size_t size, std::vector<char> &outputBuffer, int threadCount )
 {
-	std::vector<std::pair<size_t, size_t>> blockSizes;
+	size_t numBlocks = 0;
 	size_t totalDecompressedSize = 0;
 	size_t compressedBytesRead = 0;
 
@@ -499,9 +798,9 @@ size_t decompress( const char *data, size_t size, std::vector<char> &outputBuffe
 		size_t compressedNumBytes = 0, decompressedNumBytes = 0, blockSize = 0;
 		blosc_cbuffer_sizes( &data[compressedBytesRead], &decompressedNumBytes, &compressedNumBytes, &blockSize );
 
-		blockSizes.push_back( std::make_pair( compressedNumBytes, decompressedNumBytes ) );
 		totalDecompressedSize += decompressedNumBytes;
 		compressedBytesRead += compressedNumBytes;
+		numBlocks++;
 	}
 
 	if( outputBuffer.size() < totalDecompressedSize )
@@ -510,22 +809,9 @@ size_t decompress( const char *data, size_t size, std::vector<char> &outputBuffe
 		outputBuffer.swap( b );
 	}
 
-	compressedBytesRead = 0;
-	size_t decompressedBytesWritten = 0;
-	for( const auto &blockSize : blockSizes )
-	{
-		int bloscResult = blosc_decompress_ctx( &data[compressedBytesRead], &outputBuffer[decompressedBytesWritten], blockSize.second, threadCount );
-
-		if( bloscResult <= 0 )
-		{
-			throw IECore::IOException( "StreamIndexedIO (decompress) - Corrupted compressed archive" );
-		}
-
-		compressedBytesRead += blockSize.first;
-		decompressedBytesWritten += blockSize.second;
-	}
+	decompressBlocks( data, numBlocks, outputBuffer.data(), threadCount );
 
-	return blockSizes.size();
+	return numBlocks;
 }
 
 } // namespace
@@ -614,6 +900,12 @@ class SmallDataNode : public NodeBase
 			return m_offset;
 		}
 
+		/// Used to complete nodes whose data was written asynchronously.
+		inline void setOffset( uint64_t offset )
+		{
+			m_offset = offset;
+		}
+
 		/// SmallDataNodes are never compressed so we just return the size
 		inline uint64_t decompressedSize() const
 		{
@@ -640,7 +932,7 @@ class SmallDataNode : public NodeBase
 		const Size m_size;
 
 		/// The offset in the file to this node's data
-		const uint64_t m_offset;
+		uint64_t m_offset;
 };
 
 /// Class that represents Data nodes
@@ -710,6 +1002,14 @@ class DataNode : public NodeBase
 			m_numCompressedBlocks = other->m_numCompressedBlocks;
 		}
 
+		/// Used to complete nodes whose data was written asynchronously.
+		void setData( uint64_t offset, uint64_t size, unsigned short numCompressedBlocks )
+		{
+			m_offset = offset;
+			m_size = size;
+			m_numCompressedBlocks = numCompressedBlocks;
+		}
+
 	protected :
 
 		/// data fields from IndexedIO::Entry
@@ -900,14 +1200,17 @@ class StreamIndexedIO::Node
 		bool dataChildInfo( const IndexedIO::EntryID &name, Info &info ) const;
 
 		DirectoryNode* addChild( const IndexedIO::EntryID & childName );
-		void addDataChild(
+		/// Returns the new node. If allowSmallData is false, a DataNode is always created
+		/// so that the compression results can be filled in later.
+		NodeBase *addDataChild(
 			const IndexedIO::EntryID &childName,
 			IndexedIO::DataType dataType,
 			size_t arrayLen,
 			size_t offset,
 			size_t size,
 			size_t decompressedSize,
-			size_t numCompressedBlocks
+			size_t numCompressedBlocks,
+			bool allowSmallData = true
 		);
 
 		void removeChild( const IndexedIO::EntryID &childName, bool throwException = true );
@@ -923,46 +1226,44 @@ class StreamIndexedIO::Reader
 	public:
 
 		//! If an outputBuffer is supplied then it has to be large enough to store info.decompressedSize bytes of data
-		//! and if one isn't supplied then a suitably sized buffer is created and freed on destruction.
+		//! and if one isn't supplied then a suitably sized buffer is created and freed on destruction. When the file
+		//! is memory mapped and no outputBuffer is supplied, uncompressed data is accessed directly from the mapping.
 		Reader( StreamIndexedIO::StreamFile &f, const Node::Info &info, int threadCount = 1, char *outputBuffer = nullptr )
 			: m_data( nullptr ),
 			m_decompressedData( outputBuffer ),
+			m_mappedData( nullptr ),
 			m_size( info.size ),
 			m_decompressedSize( info.decompressedSize ),
 			m_ownDecompressedData( outputBuffer == nullptr )
 		{
-			if( m_ownDecompressedData )
-			{
-				m_decompressedData = new char[m_decompressedSize];
-			}
-
 			if( info.numCompressedBlocks > 0 )
 			{
-				m_data = new char[info.size];
-				f.read( m_data, info.size, info.offset );
-
-				const char* readPtr = m_data;
-				char* writePtr = m_decompressedData;
-
-				for ( size_t block = 0; block < info.numCompressedBlocks; ++block )
+				if( m_ownDecompressedData )
 				{
-					/// read the blosc header so we can decompress this block
-					size_t compresedNumBytes = 0, decompressedNumBytes = 0, blockSize = 0;
-					blosc_cbuffer_sizes( readPtr, &decompressedNumBytes , &compresedNumBytes, &blockSize );
-
-					int bloscResult = blosc_decompress_ctx( readPtr, writePtr, decompressedNumBytes, threadCount );
-
-					if( bloscResult <= 0 )
-					{
-						throw IECore::IOException( "StreamIndexedIO::Reader - Corrupted compressed archive" );
-					}
+					m_decompressedData = new char[m_decompressedSize];
+				}
 
-					readPtr += compresedNumBytes;
-					writePtr += decompressedNumBytes;
+				const char* readPtr = f.mappedData( info.size, info.offset );
+				if( !readPtr )
+				{
+					m_data = new char[info.size];
+					f.read( m_data, info.size, info.offset );
+					readPtr = m_data;
 				}
+
+				decompressBlocks( readPtr, info.numCompressedBlocks, m_decompressedData, threadCount );
 			}
 			else
 			{
+				if( m_ownDecompressedData )
+				{
+					m_mappedData = f.mappedData( info.size, info.offset );
+					if( m_mappedData )
+					{
+						return;
+					}
+					m_decompressedData = new char[m_decompressedSize];
+				}
 				f.read( m_decompressedData, info.size, info.offset );
 			}
 		}
@@ -980,9 +1281,13 @@ class StreamIndexedIO::Reader
 			}
 		}
 
-		char *data() const
+		const char *data() const
 		{
-			if( m_decompressedData )
+			if( m_mappedData )
+			{
+				return m_mappedData;
+			}
+			else if( m_decompressedData )
 			{
 				return m_decompressedData;
 			}
@@ -1000,6 +1305,7 @@ class StreamIndexedIO::Reader
 	private:
 		char *m_data;
 		char *m_decompressedData;
+		const char *m_mappedData;
 		uint64_t m_size;
 		uint64_t m_decompressedSize;
 		bool m_ownDecompressedData;
@@ -1014,7 +1320,10 @@ class StreamIndexedIO::Index : public RefCounted
 
 		/// Construct an index from reading a file stream.
 		Index( StreamIndexedIO::StreamFilePtr stream, const CompoundData *options = nullptr );
-		~Index() override;
+		/// Any error flushing pending writes is reported via `msg()` rather
+		/// than thrown. Declared noexcept explicitly because the destructor of
+		/// `tbb::task_group` is not.
+		~Index() noexcept override;
 
 		/// function called right after construction
 		void openStream();
@@ -1039,6 +1348,8 @@ class StreamIndexedIO::Index : public RefCounted
 		/// Returns the offset after saving the data to file or the offset for a previously saved data (with matching hash)
 		/// \param prefixSize If true than it will prepend to the block, the size of it
 		uint64_t writeUniqueData( const char *data, size_t size, bool prefixSize = false );
+		/// As above, but using a hash of the data which has already been computed.
+		uint64_t writeUniqueData( const char *data, size_t size, const MurmurHash &hash, bool prefixSize = false );
 
 		struct WriteInfo
 		{
@@ -1055,7 +1366,18 @@ class StreamIndexedIO::Index : public RefCounted
 			size_t numCompressedBlocks;
 		};
 
-		WriteInfo writeUniqueDataCompressed( const char *data, size_t size, bool prefixSize = false );
+		/// Compresses the data according to the compression policy for 'dataType', falling back to
+		/// storing it uncompressed if compression doesn't achieve the minimum compression ratio.
+		WriteInfo writeUniqueDataCompressed( const char *data, size_t size, IndexedIO::DataType dataType, bool prefixSize = false );
+
+		/// Writes the data for a new data child of 'node'. When asynchronous compression is enabled,
+		/// the data is compressed and hashed on a TBB task while the caller continues, and is
+		/// committed to the stream later, in the same order that the writes were made.
+		void writeDataChild( Node &node, const IndexedIO::EntryID &name, IndexedIO::DataType dataType, size_t arrayLength, const char *data, size_t size );
+
+		/// Commits asynchronous writes to the stream, in order, until no more than
+		/// 'maxPendingSize' bytes of data remain queued.
+		void commitPendingWrites( size_t maxPendingSize = 0 );
 
 		/// flushes the children of the given directory node to a subindex in the file
 		void commitNodeToSubIndex( DirectoryNode *n );
@@ -1126,6 +1448,72 @@ class StreamIndexedIO::Index : public RefCounted
 		int m_decompressionThreadCount;
 		boost::optional<size_t> m_maxCompressedBlockSize;
 		std::string m_compressor;
+		// blosc shuffle mode, or -1 to choose automatically based on the data type
+		int m_shuffle;
+		float m_minCompressionRatio;
+
+		/// Overrides for the compression settings above, applied to specific data types.
+		struct CompressionPolicy
+		{
+			int compressionLevel;
+			std::string compressor;
+			int shuffle;
+		};
+
+		typedef std::map<IndexedIO::DataType, CompressionPolicy> CompressionPolicies;
+		CompressionPolicies m_compressionPolicies;
+
+		const CompressionPolicy compressionPolicy( IndexedIO::DataType dataType ) const;
+
+		/// Compresses the data according to the compression policy for 'dataType', returning the
+		/// number of compressed blocks in 'compressedBuffer', or 0 if the data should be stored uncompressed.
+		/// This doesn't modify the Index, so it is safe to call concurrently.
+		size_t compressData( const char *data, size_t size, IndexedIO::DataType dataType, std::vector<char> &compressedBuffer ) const;
+
+		/// A write whose data is being compressed asynchronously.
+		struct PendingWrite
+		{
+			PendingWrite( NodeBase *node, const char *data, size_t size, IndexedIO::DataType dataType )
+				: node( node ), size( size ), dataType( dataType ), data( data, data + size ), numCompressedBlocks( 0 ), claimed( false ), done( false )
+			{
+			}
+
+			/// The SmallDataNode or DataNode which will be completed when the data is committed.
+			/// Reset to null by `cancelPendingWrite()` if the node is removed first, in which
+			/// case the data is discarded.
+			NodeBase *node;
+			/// The uncompressed size of the data.
+			size_t size;
+			IndexedIO::DataType dataType;
+			std::vector<char> data;
+			std::vector<char> compressedData;
+			size_t numCompressedBlocks;
+			MurmurHash hash;
+			std::exception_ptr exception;
+			/// Set by whichever of the compression task and the committing thread
+			/// gets to the data first. The committing thread never waits for a task
+			/// which hasn't started, so it is safe to commit while holding a lock
+			/// which the TBB workers might also be waiting for.
+			std::atomic<bool> claimed;
+			std::atomic<bool> done;
+		};
+
+		typedef std::shared_ptr<PendingWrite> PendingWritePtr;
+		typedef std::deque<PendingWritePtr> PendingWrites;
+		typedef std::unordered_map<const NodeBase *, PendingWritePtr> PendingWritesByNode;
+
+		/// Compresses and hashes the data for a pending write.
+		void processPendingWrite( PendingWrite &pendingWrite ) const;
+		/// Discards any pending write for 'node', which is being removed from the index.
+		void cancelPendingWrite( const NodeBase *node );
+
+		bool m_asynchronousCompression;
+		PendingWrites m_pendingWrites;
+		/// Indexes `m_pendingWrites` by node, so that removing a subtree
+		/// needn't search the whole queue for every node.
+		PendingWritesByNode m_pendingWritesByNode;
+		size_t m_pendingWriteSize;
+		tbb::task_group m_compressionTasks;
 
 		struct FreePage
 		{
@@ -1374,6 +1762,9 @@ DirectoryNode* StreamIndexedIO::Node::directoryChild( const IndexedIO::EntryID &
 
 bool StreamIndexedIO::Node::dataChildInfo( const IndexedIO::EntryID &name, Info &info ) const
 {
+	// data nodes are only complete once their asynchronous writes have been committed
+	m_idx->commitPendingWrites();
+
 	Index::MutexLock lock;
 	m_idx->lockDirectory( lock, m_node );
 
@@ -1430,14 +1821,15 @@ DirectoryNode* StreamIndexedIO::Node::addChild( const IndexedIO::EntryID &childN
 	return child;
 }
 
-void StreamIndexedIO::Node::addDataChild(
+NodeBase *StreamIndexedIO::Node::addDataChild(
 	const IndexedIO::EntryID &childName,
 	IndexedIO::DataType dataType,
 	size_t arrayLen,
 	size_t offset,
 	size_t size,
 	size_t decompressedSize,
-	size_t numCompressedBlocks
+	size_t numCompressedBlocks,
+	bool allowSmallData
 )
 {
 	if ( m_node->subindex() )
@@ -1452,8 +1844,10 @@ void StreamIndexedIO::Node::addDataChild(
 
 	m_idx->m_stringCache.add( childName );
 
+	NodeBase *result = nullptr;
+
 	// SmallDataNodes should not be compressed.
-	if( arrayLen <= SmallDataNode::maxArrayLength && size <= SmallDataNode::maxSize && ( size == decompressedSize ) && (numCompressedBlocks == 0) )
+	if( allowSmallData && arrayLen <= SmallDataNode::maxArrayLength && size <= SmallDataNode::maxSize && ( size == decompressedSize ) && (numCompressedBlocks == 0) )
 	{
 		SmallDataNode* child = new SmallDataNode(childName, dataType, arrayLen, size, offset);
 		if ( !child )
@@ -1461,6 +1855,7 @@ void StreamIndexedIO::Node::addDataChild(
 			throw Exception( "Failed to allocate node!" );
 		}
 		m_node->registerChild( child );
+		result = child;
 	}
 	else
 	{
@@ -1480,8 +1875,11 @@ void StreamIndexedIO::Node::addDataChild(
 			throw Exception( "Failed to allocate node!" );
 		}
 		m_node->registerChild( child );
+		result = child;
 	}
 	m_idx->m_hasChanged = true;
+
+	return result;
 }
 
 const IndexedIO::EntryID &StreamIndexedIO::Node::name() const
@@ -1563,7 +1961,9 @@ StreamIndexedIO::Index::Index( StreamIndexedIO::StreamFilePtr stream, const Comp
 	m_next( 0 ),
 	m_stream( stream ), m_compressionLevel( 0 ),
 	m_compressionThreadCount(1),
-	m_decompressionThreadCount(1), m_compressor( "lz4" )
+	m_decompressionThreadCount(1), m_compressor( "lz4" ),
+	m_shuffle( -1 ), m_minCompressionRatio( 1.0f ),
+	m_asynchronousCompression( false ), m_pendingWriteSize( 0 )
 
 {
 	m_stringCache.add(IndexedIO::rootName);
@@ -1604,23 +2004,101 @@ StreamIndexedIO::Index::Index( StreamIndexedIO::StreamFilePtr stream, const Comp
 		{
 			m_maxCompressedBlockSize = maxCompressedBlockSize->readable();
 		}
+
+		if ( const StringData* shuffle = options->member<StringData>("shuffle", false) )
+		{
+			m_shuffle = getShuffle( shuffle->readable() );
+			if ( m_shuffle == -2 )
+			{
+				msg( Msg::Warning, "StreamIndexedIO", boost::format( "Ignoring unknown shuffle \"%s\"" ) % shuffle->readable() );
+				m_shuffle = -1;
+			}
+		}
+
+		if ( const FloatData* minCompressionRatio = options->member<FloatData>("minCompressionRatio", false) )
+		{
+			m_minCompressionRatio = minCompressionRatio->readable();
+		}
+
+		if ( const BoolData* asynchronousCompression = options->member<BoolData>("asynchronousCompression", false) )
+		{
+			m_asynchronousCompression = asynchronousCompression->readable();
+		}
 	}
 
 	// validate our parameters
-	m_compressionLevel = std::min( std::max( 0, m_compressionLevel ), 9 ); // todo replace with std::clamp in C++17
-	m_compressionThreadCount = std::min( std::max( 1, m_compressionThreadCount ), 32 );
-	m_decompressionThreadCount = std::min( std::max( 1, m_decompressionThreadCount ), 32 );
+	m_compressionLevel = std::clamp( m_compressionLevel, 0, 9 );
+	m_compressionThreadCount = std::clamp( m_compressionThreadCount, 1, 32 );
+	m_decompressionThreadCount = std::clamp( m_decompressionThreadCount, 1, 32 );
+	m_minCompressionRatio = std::max( 1.0f, m_minCompressionRatio );
 
 	if ( getCompressionCode( m_compressor ) == -1)
 	{
 		m_compressor = "lz4";
 	}
 
+	const CompoundData *dataTypeCompression = options ? options->member<CompoundData>( "dataTypeCompression", false ) : nullptr;
+	if ( dataTypeCompression )
+	{
+		for ( const auto &it : dataTypeCompression->readable() )
+		{
+			const auto dataType = nameDataTypeMapping.find( it.first.string() );
+			const CompoundData *settings = runTimeCast<const CompoundData>( it.second.get() );
+			if ( dataType == nameDataTypeMapping.end() || !settings )
+			{
+				msg( Msg::Warning, "StreamIndexedIO", boost::format( "Ignoring invalid compression policy for \"%s\"" ) % it.first.string() );
+				continue;
+			}
+
+			CompressionPolicy policy = { m_compressionLevel, m_compressor, m_shuffle };
+			if ( const StringData* compressor = settings->member<StringData>("compressor", false) )
+			{
+				if ( getCompressionCode( compressor->readable() ) != -1 )
+				{
+					policy.compressor = compressor->readable();
+				}
+			}
+
+			if ( const IntData* compressionLevel = settings->member<IntData>("compressionLevel", false) )
+			{
+				policy.compressionLevel = std::clamp( compressionLevel->readable(), 0, 9 );
+			}
+
+			if ( const StringData* shuffle = settings->member<StringData>("shuffle", false) )
+			{
+				const int s = getShuffle( shuffle->readable() );
+				if ( s == -2 )
+				{
+					msg( Msg::Warning, "StreamIndexedIO", boost::format( "Ignoring unknown shuffle \"%s\" for \"%s\"" ) % shuffle->readable() % it.first.string() );
+				}
+				policy.shuffle = s == -2 ? m_shuffle : s;
+			}
+
+			m_compressionPolicies[dataType->second] = policy;
+		}
+	}
+
 }
 
-StreamIndexedIO::Index::~Index()
+StreamIndexedIO::Index::~Index() noexcept
 {
-	flush();
+	try
+	{
+		flush();
+	}
+	catch( const std::exception &e )
+	{
+		msg( Msg::Error, "StreamIndexedIO::Index::~Index", e.what() );
+	}
+	catch( ... )
+	{
+		msg( Msg::Error, "StreamIndexedIO::Index::~Index", "Unknown exception" );
+	}
+
+	// All pending writes have been committed by now, unless flushing failed, in which
+	// case the remaining ones are discarded. Either way, we must wait for any tasks
+	// that are still running before destroying the data they use.
+	m_compressionTasks.wait();
 
 	assert( m_freePagesOffset.size() == m_freePagesSize.size() );
 
@@ -1642,6 +2120,8 @@ StreamIndexedIO::Index::~Index()
 
 void StreamIndexedIO::Index::flush()
 {
+	commitPendingWrites();
+
 	if ( m_hasChanged )
 	{
 		uint64_t end = write();
@@ -2499,16 +2979,21 @@ void StreamIndexedIO::Index::addFreePage(  uint64_t offset, uint64_t sz )
 }
 
 uint64_t StreamIndexedIO::Index::writeUniqueData( const char *data, size_t size, bool prefixSize )
+{
+	// compute hash for the data
+	MurmurHash hash;
+	hash.append( data, size );
+
+	return writeUniqueData( data, size, hash, prefixSize );
+}
+
+uint64_t StreamIndexedIO::Index::writeUniqueData( const char *data, size_t size, const MurmurHash &hash, bool prefixSize )
 {
 	m_hasChanged = true;
 
 	/// Find next writable location
 	uint64_t loc;
 
-	// compute hash for the data
-	MurmurHash hash;
-	hash.append( data, size );
-
 	if ( size >= UINT32_MAX )
 	{
 		throw IOException( "StreamIndexedIO: Data size too long!" );
@@ -2547,21 +3032,68 @@ uint64_t StreamIndexedIO::Index::writeUniqueData( const char *data, size_t size,
 	return loc;
 }
 
-StreamIndexedIO::Index::WriteInfo StreamIndexedIO::Index::writeUniqueDataCompressed( const char *data, size_t size, bool prefixSize )
+const StreamIndexedIO::Index::CompressionPolicy StreamIndexedIO::Index::compressionPolicy( IndexedIO::DataType dataType ) const
 {
-	WriteInfo writeInfo;
+	const auto it = m_compressionPolicies.find( dataType );
+	if( it != m_compressionPolicies.end() )
+	{
+		return it->second;
+	}
+	return { m_compressionLevel, m_compressor, m_shuffle };
+}
 
-	std::vector<char> compressedBuffer;
-	size_t numBlocks = 0;
+size_t StreamIndexedIO::Index::compressData( const char *data, size_t size, IndexedIO::DataType dataType, std::vector<char> &compressedBuffer ) const
+{
+	const CompressionPolicy policy = compressionPolicy( dataType );
+	if ( !policy.compressionLevel )
+	{
+		return 0;
+	}
+
+	const size_t typeSize = elementSize( dataType );
+	// shuffling is only beneficial when there are multiple bytes per element
+	int shuffle = policy.shuffle;
+	if( shuffle == -1 )
+	{
+		shuffle = typeSize > 1 ? BLOSC_SHUFFLE : BLOSC_NOSHUFFLE;
+	}
 
-	if ( m_compressionLevel )
+	// For large data, compress a small sample first, so we don't waste time
+	// compressing data which won't achieve the minimum compression ratio.
+	// With the default ratio any saving is worth having, so we don't probe.
+	if( m_minCompressionRatio > 1.0f && size > 4 * compressionProbeSize )
 	{
-		numBlocks = compress( data, size, compressedBuffer, m_compressionLevel, m_compressor, m_compressionThreadCount, m_maxCompressedBlockSize );
+		std::vector<char> probeBuffer;
+		if( compress( data, compressionProbeSize, probeBuffer, policy.compressionLevel, policy.compressor, 1, boost::optional<size_t>(), minCompressedBlockSize, shuffle, typeSize ) )
+		{
+			if( (float)compressionProbeSize < m_minCompressionRatio * (float)probeBuffer.size() )
+			{
+				return 0;
+			}
+		}
 	}
 
-	//! if compression fails or produces a buffer larger than the original
-	//! write the original source data uncompressed
-	if( numBlocks && !compressedBuffer.empty() && ( compressedBuffer.size() < size ) )
+	size_t numBlocks = compress( data, size, compressedBuffer, policy.compressionLevel, policy.compressor, m_compressionThreadCount, m_maxCompressedBlockSize, minCompressedBlockSize, shuffle, typeSize );
+
+	//! if compression fails or doesn't achieve the minimum compression ratio,
+	//! the original source data should be written uncompressed
+	if( numBlocks && !compressedBuffer.empty() && ( compressedBuffer.size() < size ) && ( (float)size >= m_minCompressionRatio * (float)compressedBuffer.size() ) )
+	{
+		return numBlocks;
+	}
+
+	compressedBuffer.clear();
+	return 0;
+}
+
+StreamIndexedIO::Index::WriteInfo StreamIndexedIO::Index::writeUniqueDataCompressed( const char *data, size_t size, IndexedIO::DataType dataType, bool prefixSize )
+{
+	WriteInfo writeInfo;
+
+	std::vector<char> compressedBuffer;
+	size_t numBlocks = compressData( data, size, dataType, compressedBuffer );
+
+	if( numBlocks )
 	{
 		writeInfo.offset = writeUniqueData( compressedBuffer.data(), compressedBuffer.size(), prefixSize );
 		writeInfo.size = compressedBuffer.size();
@@ -2574,10 +3106,155 @@ StreamIndexedIO::Index::WriteInfo StreamIndexedIO::Index::writeUniqueDataCompres
 		writeInfo.numCompressedBlocks = 0;
 	}
 
-
 	return writeInfo;
 }
 
+void StreamIndexedIO::Index::writeDataChild( Node &node, const IndexedIO::EntryID &name, IndexedIO::DataType dataType, size_t arrayLength, const char *data, size_t size )
+{
+	const bool compressible = compressionPolicy( dataType ).compressionLevel && size >= minCompressedBlockSize;
+
+	if( !m_asynchronousCompression || ( !compressible && m_pendingWrites.empty() ) )
+	{
+		WriteInfo info = writeUniqueDataCompressed( data, size, dataType );
+		node.addDataChild( name, dataType, arrayLength, info.offset, info.size, size, info.numCompressedBlocks );
+		return;
+	}
+
+	// We don't know the compressed size yet, so compressible data always gets a DataNode, which is
+	// completed when the write is committed. Other data is queued too, so that commits to the stream
+	// happen in the same order as the writes, keeping the file layout deterministic.
+	NodeBase *child = node.addDataChild( name, dataType, arrayLength, 0, size, size, 0, /* allowSmallData = */ !compressible );
+
+	PendingWritePtr pendingWrite = std::make_shared<PendingWrite>( child, data, size, dataType );
+	m_pendingWrites.push_back( pendingWrite );
+	m_pendingWritesByNode[child] = pendingWrite;
+	m_pendingWriteSize += size;
+
+	if( compressible )
+	{
+		m_compressionTasks.run(
+			[this, pendingWrite] {
+				if( !pendingWrite->claimed.exchange( true ) )
+				{
+					processPendingWrite( *pendingWrite );
+				}
+			}
+		);
+	}
+	else
+	{
+		pendingWrite->claimed = true;
+		pendingWrite->hash.append( data, size );
+		pendingWrite->done = true;
+	}
+
+	commitPendingWrites( maxPendingWriteSize );
+}
+
+void StreamIndexedIO::Index::processPendingWrite( PendingWrite &pendingWrite ) const
+{
+	try
+	{
+		pendingWrite.numCompressedBlocks = compressData( pendingWrite.data.data(), pendingWrite.data.size(), pendingWrite.dataType, pendingWrite.compressedData );
+		if( pendingWrite.numCompressedBlocks )
+		{
+			pendingWrite.hash.append( pendingWrite.compressedData.data(), pendingWrite.compressedData.size() );
+			// release the uncompressed copy as early as possible
+			std::vector<char>().swap( pendingWrite.data );
+		}
+		else
+		{
+			pendingWrite.hash.append( pendingWrite.data.data(), pendingWrite.data.size() );
+		}
+	}
+	catch( ... )
+	{
+		pendingWrite.exception = std::current_exception();
+	}
+	pendingWrite.done = true;
+}
+
+void StreamIndexedIO::Index::commitPendingWrites( size_t maxPendingSize )
+{
+	while( !m_pendingWrites.empty() && m_pendingWriteSize > maxPendingSize )
+	{
+		PendingWritePtr pendingWrite = m_pendingWrites.front();
+		m_pendingWrites.pop_front();
+		m_pendingWriteSize -= pendingWrite->size;
+		if( pendingWrite->node )
+		{
+			m_pendingWritesByNode.erase( pendingWrite->node );
+		}
+
+		if( !pendingWrite->claimed.exchange( true ) )
+		{
+			// the task hasn't started yet, so do the work ourselves
+			processPendingWrite( *pendingWrite );
+		}
+		else
+		{
+			while( !pendingWrite->done )
+			{
+				std::this_thread::yield();
+			}
+		}
+
+		if( !pendingWrite->node )
+		{
+			// cancelled
+			continue;
+		}
+
+		if( pendingWrite->exception )
+		{
+			std::rethrow_exception( pendingWrite->exception );
+		}
+
+		if( pendingWrite->numCompressedBlocks > std::numeric_limits<unsigned short>::max() )
+		{
+			throw IECore::Exception(
+				boost::str(
+					boost::format( "StreamIndexedIO::Index::commitPendingWrites - Unable to store file with more than %1% compressed blocks " ) %
+						std::numeric_limits<unsigned short>::max()
+				)
+			);
+		}
+
+		if( pendingWrite->node->nodeType() == NodeBase::Data )
+		{
+			DataNode *dataNode = static_cast<DataNode *>( pendingWrite->node );
+			const std::vector<char> &buffer = pendingWrite->numCompressedBlocks ? pendingWrite->compressedData : pendingWrite->data;
+			uint64_t offset = writeUniqueData( buffer.data(), buffer.size(), pendingWrite->hash );
+			dataNode->setData( offset, buffer.size(), pendingWrite->numCompressedBlocks );
+		}
+		else
+		{
+			SmallDataNode *smallDataNode = static_cast<SmallDataNode *>( pendingWrite->node );
+			smallDataNode->setOffset( writeUniqueData( pendingWrite->data.data(), pendingWrite->data.size(), pendingWrite->hash ) );
+		}
+	}
+}
+
+void StreamIndexedIO::Index::cancelPendingWrite( const NodeBase *node )
+{
+	// There is at most one pending write per node.
+	auto it = m_pendingWritesByNode.find( node );
+	if( it == m_pendingWritesByNode.end() )
+	{
+		return;
+	}
+
+	PendingWrite &pendingWrite = *it->second;
+	m_pendingWritesByNode.erase( it );
+
+	pendingWrite.node = nullptr;
+	if( !pendingWrite.claimed.exchange( true ) )
+	{
+		// the task hasn't started yet, so it need never do the work
+		pendingWrite.done = true;
+	}
+}
+
 void StreamIndexedIO::Index::deallocateWalk( NodeBase* n )
 {
 	assert(n);
@@ -2599,7 +3276,12 @@ void StreamIndexedIO::Index::deallocateWalk( NodeBase* n )
 	else
 	{
 		// We don't deallocate data node blocks because they could be referred by other nodes.
-		// As a result, editing files will usually increase file size.
+		// As a result, editing files will usually increase file size. But we don't need to
+		// write the data at all if its asynchronous write is still pending.
+		if( !m_pendingWrites.empty() )
+		{
+			cancelPendingWrite( n );
+		}
 	}
 
 }
@@ -2613,6 +3295,9 @@ void StreamIndexedIO::Index::commitNodeToSubIndex( DirectoryNode *n )
 
 	if ( n->subindex() == DirectoryNode::NoSubIndex )
 	{
+		// the child nodes are destroyed once they're in the subindex, so they must be complete
+		commitPendingWrites();
+
 		MemoryStreamSink sink;
 		io::filtering_ostream outIndexStream;
 		outIndexStream.push( sink );
@@ -2750,7 +3435,7 @@ IndexedIO::OpenMode StreamIndexedIO::StreamFile::openMode() const
 	return m_openmode;
 }
 
-void StreamIndexedIO::StreamFile::setInput( std::iostream *stream, bool emptyFile, const std::string& fileName )
+void StreamIndexedIO::StreamFile::setInput( std::iostream *stream, bool emptyFile, const std::string& fileName, bool memoryMapped )
 {
 	m_stream = stream;
 	if ( m_openmode & IndexedIO::Append && emptyFile )
@@ -2760,10 +3445,27 @@ void StreamIndexedIO::StreamFile::setInput( std::iostream *stream, bool emptyFil
 
 	if ( fileName != "" && getenv("IECORE_OFFSETREAD_DISABLED") == nullptr )
 	{
-		m_platformReader = PlatformReader::create( fileName );
+		// Memory mapping is only safe when nothing else can modify the file.
+		if( !( m_openmode & IndexedIO::Read ) )
+		{
+			memoryMapped = false;
+		}
+		else if( const char *mmapEnvVar = getenv( "IECORE_STREAMINDEXEDIO_MMAP" ) )
+		{
+			memoryMapped = strcmp( mmapEnvVar, "0" ) != 0;
+		}
+
+		m_platformReader = PlatformReader::create( fileName, memoryMapped );
 	}
 }
 
+void StreamIndexedIO::StreamFile::setInput( std::iostream *stream, const char *buffer, size_t size )
+{
+	assert( m_openmode & IndexedIO::Read );
+	m_stream = stream;
+	m_platformReader.reset( new BufferPlatformReader( buffer, size ) );
+}
+
 char *StreamIndexedIO::StreamFile::ioBuffer( size_t size )
 {
 	if ( !m_ioBuffer )
@@ -2821,6 +3523,11 @@ void StreamIndexedIO::StreamFile::read( char *buffer, size_t size, size_t pos )
 	}
 }
 
+const char *StreamIndexedIO::StreamFile::mappedData( size_t size, size_t pos ) const
+{
+	return m_platformReader ? m_platformReader->data( size, pos ) : nullptr;
+}
+
 void StreamIndexedIO::StreamFile::seekg( size_t pos, std::ios_base::seekdir dir )
 {
 	m_stream->seekg( pos, dir );
@@ -3221,8 +3928,7 @@ void StreamIndexedIO::write(const IndexedIO::EntryID &name, const InternedString
 
 	IndexedIO::DataFlattenTraits<uint64_t*>::flatten(constIds, arrayLength, data);
 
-	Index::WriteInfo info = index->writeUniqueDataCompressed( data, size );
-	m_node->addDataChild( name, dataType, arrayLength, info.offset, info.size, size, info.numCompressedBlocks );
+	index->writeDataChild( *m_node, name, dataType, arrayLength, data, size );
 
 	delete [] ids;
 }
@@ -3282,8 +3988,7 @@ void StreamIndexedIO::write(const IndexedIO::EntryID &name, const T *x, size_t a
 	assert(data);
 	IndexedIO::DataFlattenTraits<T*>::flatten(x, arrayLength, data);
 
-	Index::WriteInfo info = m_node->m_idx->writeUniqueDataCompressed( data, size );
-	m_node->addDataChild( name, dataType, arrayLength, info.offset, info.size, size, info.numCompressedBlocks );
+	m_node->m_idx->writeDataChild( *m_node, name, dataType, arrayLength, data, size );
 }
 
 template<typename T>
@@ -3295,8 +4000,7 @@ void StreamIndexedIO::rawWrite(const IndexedIO::EntryID &name, const T *x, size_
 	size_t size = IndexedIO::DataSizeTraits<T*>::size(x, arrayLength);
 	IndexedIO::DataType dataType = IndexedIO::DataTypeTraits<T*>::type();
 
-	Index::WriteInfo info = m_node->m_idx->writeUniqueDataCompressed( (char *) x, size );
-	m_node->addDataChild( name, dataType, arrayLength, info.offset, info.size, size, info.numCompressedBlocks );
+	m_node->m_idx->writeDataChild( *m_node, name, dataType, arrayLength, (const char *) x, size );
 }
 
 template<typename T>
@@ -3312,8 +4016,7 @@ void StreamIndexedIO::write(const IndexedIO::EntryID &name, const T &x)
 	assert(data);
 	IndexedIO::DataFlattenTraits<T>::flatten(x, data);
 
-	Index::WriteInfo info = m_node->m_idx->writeUniqueDataCompressed( data, size );
-	m_node->addDataChild( name, dataType, 0, info.offset, info.size, size, info.numCompressedBlocks );
+	m_node->m_idx->writeDataChild( *m_node, name, dataType, 0, data, size );
 }
 
 template<typename T>
@@ -3325,8 +4028,7 @@ void StreamIndexedIO::rawWrite(const IndexedIO::EntryID &name, const T &x)
 	size_t size = IndexedIO::DataSizeTraits<T>::size(x);
 	IndexedIO::DataType dataType = IndexedIO::DataTypeTraits<T>::type();
 
-	Index::WriteInfo info = m_node->m_idx->writeUniqueDataCompressed( (char *) &x, size );
-	m_node->addDataChild( name, dataType, 0, info.offset, info.size, size, info.numCompressedBlocks );
+	m_node->m_idx->writeDataChild( *m_node, name, dataType, 0, (const char *) &x, size );
 }
 
 template<typename T>
@@ -36,6 +36,7 @@
 
 #include "IECore/VectorTypedData.h"
 #include "IECorePython/ReaderBinding.h"
+#include "IECorePython/ScopedGILRelease.h"
 
 #include "IECoreImage/ImageReader.h"
 #include "IECoreImageBindings/ImageReaderBinding.h"
@@ -50,13 +51,47 @@ using namespace IECoreImage;
 namespace
 {
 
-static StringVectorDataPtr channelNames( ImageReader &that )
+// All of the query methods may need to open the file and
+// read its header, so we release the GIL while they run.
+
+bool canRead( const std::string &fileName )
+{
+	ScopedGILRelease gilRelease;
+	return ImageReader::canRead( fileName );
+}
+
+bool isComplete( ImageReader &that )
 {
+	ScopedGILRelease gilRelease;
+	return that.isComplete();
+}
+
+StringVectorDataPtr channelNames( ImageReader &that )
+{
+	ScopedGILRelease gilRelease;
 	StringVectorDataPtr result( new StringVectorData );
 	that.channelNames( result->writable() );
 	return result;
 }
 
+Imath::Box2i dataWindow( ImageReader &that )
+{
+	ScopedGILRelease gilRelease;
+	return that.dataWindow();
+}
+
+Imath::Box2i displayWindow( ImageReader &that )
+{
+	ScopedGILRelease gilRelease;
+	return that.displayWindow();
+}
+
+DataPtr readChannel( ImageReader &that, const std::string &name, bool raw )
+{
+	ScopedGILRelease gilRelease;
+	return that.readChannel( name, raw );
+}
+
 } // namespace
 
 namespace IECoreImageBindings
@@ -68,12 +103,12 @@ void bindImageReader()
 	ReaderClass<ImageReader>()
 		.def( init<>() )
 		.def( init<const std::string &>() )
-		.def( "canRead", &ImageReader::canRead ).staticmethod( "canRead" )
-		.def( "isComplete", &ImageReader::isComplete )
+		.def( "canRead", &canRead ).staticmethod( "canRead" )
+		.def( "isComplete", &isComplete )
 		.def( "channelNames", &channelNames )
-		.def( "dataWindow", &ImageReader::dataWindow )
-		.def( "displayWindow", &ImageReader::displayWindow )
-		.def( "readChannel", (DataPtr (ImageReader::*)( const std::string &, bool ))&ImageReader::readChannel, ( arg_("name"), arg_( "raw" ) = false ) )
+		.def( "dataWindow", &dataWindow )
+		.def( "displayWindow", &displayWindow )
+		.def( "readChannel", &readChannel, ( arg_("name"), arg_( "raw" ) = false ) )
 	;
 
 }
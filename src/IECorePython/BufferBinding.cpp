@@ -0,0 +1,206 @@
+//////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (c) 2026, Image Engine Design Inc. All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//
+//     * Neither the name of Image Engine Design nor the names of any
+//       other contributors to this software may be used to endorse or
+//       promote products derived from this software without specific prior
+//       written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+//  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+//  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+//  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+//  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+//  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+//  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+//  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+//  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+//  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//////////////////////////////////////////////////////////////////////////
+
+
+#include "boost/python.hpp"
+
+#include "IECorePython/BufferBinding.h"
+
+#include <new>
+#include <unordered_map>
+
+using namespace boost::python;
+using namespace IECore;
+using namespace IECorePython;
+
+namespace
+{
+
+// The maximum number of dimensions we need :
+// one for the elements, and two within each element
+// for matrices and boxes.
+const int g_maxDimensions = 3;
+
+struct BufferObject
+{
+	PyObject_HEAD
+	ConstDataPtr owner;
+	ConstRefCountedPtr exportToken;
+	void *data;
+	bool writable;
+	const char *format;
+	Py_ssize_t itemSize;
+	Py_ssize_t length;
+	int numDimensions;
+	Py_ssize_t shape[g_maxDimensions];
+	Py_ssize_t strides[g_maxDimensions];
+};
+
+PyTypeObject g_bufferType = {
+	PyVarObject_HEAD_INIT( nullptr, 0 )
+};
+
+// Number of live writable buffers for each owner. Only
+// accessed with the GIL held, so needs no further locking.
+using WritableBufferCounts = std::unordered_map<const Data *, size_t>;
+WritableBufferCounts &writableBufferCounts()
+{
+	static WritableBufferCounts *g_counts = new WritableBufferCounts;
+	return *g_counts;
+}
+
+void bufferDealloc( PyObject *self )
+{
+	BufferObject *buffer = reinterpret_cast<BufferObject *>( self );
+	if( buffer->writable )
+	{
+		WritableBufferCounts &counts = writableBufferCounts();
+		WritableBufferCounts::iterator it = counts.find( buffer->owner.get() );
+		if( !--it->second )
+		{
+			counts.erase( it );
+		}
+	}
+	buffer->exportToken.~ConstRefCountedPtr();
+	buffer->owner.~ConstDataPtr();
+	Py_TYPE( self )->tp_free( self );
+}
+
+int bufferGetBuffer( PyObject *self, Py_buffer *view, int flags )
+{
+	const BufferObject *buffer = reinterpret_cast<const BufferObject *>( self );
+	if( ( flags & PyBUF_WRITABLE ) && !buffer->writable )
+	{
+		view->obj = nullptr;
+		PyErr_SetString( PyExc_BufferError, "Buffer is read-only" );
+		return -1;
+	}
+
+	view->obj = self;
+	Py_INCREF( self );
+	view->buf = buffer->data;
+	view->len = buffer->length;
+	view->readonly = !buffer->writable;
+	view->itemsize = buffer->itemSize;
+	view->format = ( flags & PyBUF_FORMAT ) ? const_cast<char *>( buffer->format ) : nullptr;
+	view->ndim = buffer->numDimensions;
+	// Our memory is always C-contiguous, so we can satisfy any request.
+	// When the consumer doesn't ask for shape or strides, it will treat
+	// the buffer as a flat array of bytes.
+	view->shape = ( flags & PyBUF_ND ) == PyBUF_ND ? const_cast<Py_ssize_t *>( buffer->shape ) : nullptr;
+	view->strides = ( flags & PyBUF_STRIDES ) == PyBUF_STRIDES ? const_cast<Py_ssize_t *>( buffer->strides ) : nullptr;
+	view->suboffsets = nullptr;
+	view->internal = nullptr;
+	return 0;
+}
+
+PyBufferProcs g_bufferProcs = {
+#if PY_MAJOR_VERSION < 3
+	nullptr, nullptr, nullptr, nullptr,
+#endif
+	bufferGetBuffer,
+	nullptr
+};
+
+} // namespace
+
+object IECorePython::makeBuffer( ConstDataPtr owner, ConstRefCountedPtr exportToken, const void *data, bool writable, const char *format, Py_ssize_t itemSize, const std::vector<Py_ssize_t> &shape )
+{
+	if( shape.empty() || shape.size() > (size_t)g_maxDimensions )
+	{
+		PyErr_SetString( PyExc_ValueError, "Unsupported number of buffer dimensions" );
+		throw_error_already_set();
+	}
+
+	PyObject *result = g_bufferType.tp_alloc( &g_bufferType, 0 );
+	if( !result )
+	{
+		throw_error_already_set();
+	}
+
+	BufferObject *buffer = reinterpret_cast<BufferObject *>( result );
+	new( &buffer->owner ) ConstDataPtr( owner );
+	new( &buffer->exportToken ) ConstRefCountedPtr( exportToken );
+	buffer->data = const_cast<void *>( data );
+	buffer->writable = writable;
+	buffer->format = format;
+	buffer->itemSize = itemSize;
+	buffer->numDimensions = shape.size();
+
+	Py_ssize_t stride = itemSize;
+	for( int i = buffer->numDimensions - 1; i >= 0; --i )
+	{
+		buffer->shape[i] = shape[i];
+		buffer->strides[i] = stride;
+		stride *= shape[i];
+	}
+	buffer->length = stride;
+
+	if( writable )
+	{
+		writableBufferCounts()[owner.get()]++;
+	}
+
+	return object( handle<>( result ) );
+}
+
+bool IECorePython::hasWritableBuffer( const IECore::Data *owner )
+{
+	const WritableBufferCounts &counts = writableBufferCounts();
+	return counts.find( owner ) != counts.end();
+}
+
+void IECorePython::bindBuffer()
+{
+	g_bufferType.tp_name = "IECore.Buffer";
+	g_bufferType.tp_basicsize = sizeof( BufferObject );
+	g_bufferType.tp_dealloc = bufferDealloc;
+	g_bufferType.tp_as_buffer = &g_bufferProcs;
+	g_bufferType.tp_flags = Py_TPFLAGS_DEFAULT;
+#if PY_MAJOR_VERSION < 3
+	g_bufferType.tp_flags |= Py_TPFLAGS_HAVE_NEWBUFFER;
+#endif
+	g_bufferType.tp_doc =
+		"Provides zero-copy access to the contents of a Data object via the Python\n"
+		"buffer protocol, for use with `memoryview` and NumPy. Buffers are created\n"
+		"by the `asReadOnlyBuffer()` and `asWritableBuffer()` methods of VectorTypedData."
+	;
+
+	if( PyType_Ready( &g_bufferType ) < 0 )
+	{
+		throw_error_already_set();
+	}
+
+	scope().attr( "Buffer" ) = object( handle<>( borrowed( reinterpret_cast<PyObject *>( &g_bufferType ) ) ) );
+}
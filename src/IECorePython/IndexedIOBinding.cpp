@@ -40,6 +40,7 @@
 
 #include "IECorePython/IECoreBinding.h"
 #include "IECorePython/RunTimeTypedBinding.h"
+#include "IECorePython/ScopedGILRelease.h"
 
 #include "IECore/CompoundData.h"
 #include "IECore/FileIndexedIO.h"
@@ -53,6 +54,7 @@
 
 using namespace boost::python;
 using namespace IECore;
+using namespace IECorePython;
 
 void bindIndexedIOBase();
 void bindStreamIndexedIO();
@@ -96,6 +98,7 @@ struct IndexedIOHelper
 	template< typename T, typename P >
 	static typename T::Ptr constructorAtRoot( P firstParam, IndexedIO::OpenMode mode )
 	{
+		ScopedGILRelease gilRelease;
 		return new T( firstParam, IndexedIO::rootPath, mode );
 	}
 
@@ -104,11 +107,13 @@ struct IndexedIOHelper
 	{
 		IndexedIO::EntryIDList rootPath;
 		IndexedIOHelper::listToEntryIds( root, rootPath );
+		ScopedGILRelease gilRelease;
 		return new T( firstParam, rootPath, mode );
 	}
 
 	static IndexedIOPtr createAtRoot( const std::string &path, IndexedIO::OpenMode mode, IECore::CompoundDataPtr options )
 	{
+		ScopedGILRelease gilRelease;
 		return IndexedIO::create( path, IndexedIO::rootPath, mode, options.get() );
 	}
 
@@ -117,6 +122,7 @@ struct IndexedIOHelper
 		IndexedIO::EntryIDList rootPath;
 		IndexedIOHelper::listToEntryIds( root, rootPath );
 
+		ScopedGILRelease gilRelease;
 		return IndexedIO::create( path, rootPath, mode, options.get() );
 	}
 
@@ -138,7 +144,10 @@ struct IndexedIOHelper
 	{
 		assert(p);
 		IndexedIO::EntryIDList l;
-		p->entryIds(l);
+		{
+			ScopedGILRelease gilRelease;
+			p->entryIds(l);
+		}
 		return IndexedIOHelper::entryIDsToList( l );
 	}
 
@@ -146,7 +155,10 @@ struct IndexedIOHelper
 	{
 		assert(p);
 		IndexedIO::EntryIDList l;
-		p->entryIds(l, type);
+		{
+			ScopedGILRelease gilRelease;
+			p->entryIds(l, type);
+		}
 		return IndexedIOHelper::entryIDsToList( l );
 	}
 
@@ -169,10 +181,20 @@ struct IndexedIOHelper
 	{
 		assert(p);
 
-		const typename T::value_type *data = &(x->readable())[0];
+		ScopedGILRelease gilRelease;
+		const typename T::value_type *data = x->readable().data();
 		p->write( name, data, x->readable().size() );
 	}
 
+	template<typename T>
+	static void writeSingle( IndexedIOPtr p, const IndexedIO::EntryID &name, const T &x )
+	{
+		assert(p);
+
+		ScopedGILRelease gilRelease;
+		p->write( name, x );
+	}
+
 	template<typename T>
 	static typename TypedData<T>::Ptr readSingle(IndexedIOPtr p, const IndexedIO::EntryID &name, const IndexedIO::Entry &entry)
 	{
@@ -187,70 +209,71 @@ struct IndexedIOHelper
 		size_t count = entry.arrayLength();
 		typename TypedData<std::vector<T> >::Ptr x = new TypedData<std::vector<T> > ();
 		x->writable().resize( entry.arrayLength() );
-		T *data = &(x->writable()[0]);
+		T *data = x->writable().data();
 		p->read(name, data, count);
 
 		return x;
 	}
 
-	static object read(IndexedIOPtr p, const IndexedIO::EntryID &name)
+	static DataPtr read(IndexedIOPtr p, const IndexedIO::EntryID &name)
 	{
 		assert(p);
 
+		ScopedGILRelease gilRelease;
 		IndexedIO::Entry entry = p->entry(name);
 
 		switch( entry.dataType() )
 		{
 			case IndexedIO::Float:
-				return object( readSingle<float>(p, name, entry) );
+				return readSingle<float>(p, name, entry);
 			case IndexedIO::Double:
-				return object( readSingle<double>(p, name, entry) );
+				return readSingle<double>(p, name, entry);
 			case IndexedIO::Int:
-				return object( readSingle<int>(p, name, entry) );
+				return readSingle<int>(p, name, entry);
 			case IndexedIO::Long:
-				return object( readSingle<int>(p, name, entry) );
+				return readSingle<int>(p, name, entry);
 			case IndexedIO::String:
-				return object( readSingle<std::string>(p, name, entry) );
+				return readSingle<std::string>(p, name, entry);
 			case IndexedIO::StringArray:
-				return object( readArray<std::string>(p, name, entry) );
+				return readArray<std::string>(p, name, entry);
 			case IndexedIO::FloatArray:
-				return object( readArray<float>(p, name, entry) );
+				return readArray<float>(p, name, entry);
 			case IndexedIO::DoubleArray:
-				return object( readArray<double>(p, name, entry) );
+				return readArray<double>(p, name, entry);
 			case IndexedIO::IntArray:
-				return object( readArray<int>(p, name, entry) );
+				return readArray<int>(p, name, entry);
 			case IndexedIO::LongArray:
-				return object( readArray<int>(p, name, entry) );
+				return readArray<int>(p, name, entry);
 			case IndexedIO::UInt:
-				return object( readSingle<unsigned int>(p, name, entry) );
+				return readSingle<unsigned int>(p, name, entry);
 			case IndexedIO::UIntArray:
-				return object( readArray<unsigned int>(p, name, entry) );
+				return readArray<unsigned int>(p, name, entry);
 			case IndexedIO::Char:
-				return object( readSingle<char>(p, name, entry) );
+				return readSingle<char>(p, name, entry);
 			case IndexedIO::CharArray:
-				return object( readArray<char>(p, name, entry) );
+				return readArray<char>(p, name, entry);
 			case IndexedIO::UChar:
-				return object( readSingle<unsigned char>(p, name, entry) );
+				return readSingle<unsigned char>(p, name, entry);
 			case IndexedIO::UCharArray:
-				return object( readArray<unsigned char>(p, name, entry) );
+				return readArray<unsigned char>(p, name, entry);
 			case IndexedIO::Short:
-				return object( readSingle<short>(p, name, entry) );
+				return readSingle<short>(p, name, entry);
 			case IndexedIO::ShortArray:
-				return object( readArray<short>(p, name, entry) );
+				return readArray<short>(p, name, entry);
 			case IndexedIO::UShort:
-				return object( readSingle<unsigned short>(p, name, entry) );
+				return readSingle<unsigned short>(p, name, entry);
 			case IndexedIO::UShortArray:
-				return object( readArray<unsigned short>(p, name, entry) );
+				return readArray<unsigned short>(p, name, entry);
 			case IndexedIO::Int64:
-				return object( readSingle<int64_t>(p, name, entry) );
+				return readSingle<int64_t>(p, name, entry);
 			case IndexedIO::Int64Array:
-				return object( readArray<int64_t>(p, name, entry) );
+				return readArray<int64_t>(p, name, entry);
 			case IndexedIO::UInt64:
-				return object( readSingle<uint64_t>(p, name, entry) );
+				return readSingle<uint64_t>(p, name, entry);
 			case IndexedIO::UInt64Array:
-				return object( readArray<uint64_t>(p, name, entry) );
+				return readArray<uint64_t>(p, name, entry);
 			case IndexedIO::InternedStringArray:
-				return object( readArray<InternedString>(p, name, entry) );
+				return readArray<InternedString>(p, name, entry);
 			default:
 				throw IOException(name);
 		}
@@ -260,6 +283,7 @@ struct IndexedIOHelper
 	{
 		assert(p);
 
+		ScopedGILRelease gilRelease;
 		std::string x;
 		p->read(name, x);
 		return x;
@@ -283,10 +307,6 @@ void bindIndexedIOBase()
 {
 	IndexedIOPtr (IndexedIO::*nonConstParentDirectory)() = &IndexedIO::parentDirectory;
 	IndexedIOPtr (IndexedIO::*nonConstSubdirectory)(const IndexedIO::EntryID &, IndexedIO::MissingBehaviour) = &IndexedIO::subdirectory;
-	void (IndexedIO::*writeFloat)(const IndexedIO::EntryID &, const float &) = &IndexedIO::write;
-	void (IndexedIO::*writeDouble)(const IndexedIO::EntryID &, const double &) = &IndexedIO::write;
-	void (IndexedIO::*writeInt)(const IndexedIO::EntryID &, const int &) = &IndexedIO::write;
-	void (IndexedIO::*writeString)(const IndexedIO::EntryID &, const std::string &) = &IndexedIO::write;
 
 #if 0
 	void (IndexedIO::*writeUInt)(const IndexedIO::EntryID &, const unsigned int &) = &IndexedIO::write;
@@ -389,10 +409,10 @@ void bindIndexedIOBase()
 		.def("write", &IndexedIOHelper::writeVector<std::vector<int> >)
 		.def("write", &IndexedIOHelper::writeVector<std::vector<std::string> >)
 		.def("write", &IndexedIOHelper::writeVector<std::vector<InternedString> >)
-		.def("write", writeFloat)
-		.def("write", writeDouble)
-		.def("write", writeInt)
-		.def("write", writeString)
+		.def("write", &IndexedIOHelper::writeSingle<float>)
+		.def("write", &IndexedIOHelper::writeSingle<double>)
+		.def("write", &IndexedIOHelper::writeSingle<int>)
+		.def("write", &IndexedIOHelper::writeSingle<std::string>)
 #if 0
 		// We dont really want to bind these because they don't represent natural Python datatypes
 		.def("write", writeUInt)
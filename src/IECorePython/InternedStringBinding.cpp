@@ -36,10 +36,17 @@
 
 #include "IECorePython/InternedStringBinding.h"
 
+#include "IECore/Exception.h"
 #include "IECore/InternedString.h"
 
 #include "boost/functional/hash.hpp"
 
+#include "tbb/parallel_for.h"
+#include "tbb/task_arena.h"
+
+#include <atomic>
+#include <chrono>
+
 using namespace std;
 using namespace boost;
 using namespace boost::python;
@@ -108,6 +115,76 @@ static size_t len( const InternedString &str )
 	return str.string().length();
 }
 
+// Constructs `numIterations` InternedStrings for each of `numStrings`
+// distinct values, in parallel using `numThreads` threads, and
+// returns the time taken in seconds. Also verifies that all threads
+// agree on the interned value for each string.
+static double testInternedStringConcurrentConstruction( const std::string &prefix, size_t numStrings, size_t numIterations, int numThreads )
+{
+	vector<string> strings;
+	strings.reserve( numStrings );
+	for( size_t i = 0; i < numStrings; ++i )
+	{
+		strings.push_back( prefix + std::to_string( i ) );
+	}
+
+	std::unique_ptr<std::atomic<const char *>[]> interned( new std::atomic<const char *>[numStrings] );
+	for( size_t i = 0; i < numStrings; ++i )
+	{
+		interned[i].store( nullptr, std::memory_order_relaxed );
+	}
+
+	std::atomic<bool> failed( false );
+	tbb::task_arena arena( numThreads > 0 ? numThreads : tbb::task_arena::automatic );
+
+	const auto start = std::chrono::steady_clock::now();
+	arena.execute(
+		[&] {
+			tbb::task_group_context taskGroupContext( tbb::task_group_context::isolated );
+			tbb::parallel_for(
+				tbb::blocked_range<size_t>( 0, numStrings * numIterations ),
+				[&]( const tbb::blocked_range<size_t> &range ) {
+					for( size_t i = range.begin(); i != range.end(); ++i )
+					{
+						// Stride through the strings so that each
+						// task sees a mix of new and existing values.
+						const size_t index = ( i * 7919 ) % numStrings;
+						const InternedString s( strings[index] );
+						// Load before attempting the exchange, so that we
+						// don't add write contention of our own to the timing.
+						const char *expected = interned[index].load( std::memory_order_relaxed );
+						if( !expected && interned[index].compare_exchange_strong( expected, s.c_str() ) )
+						{
+							continue;
+						}
+						if( expected != s.c_str() )
+						{
+							failed = true;
+						}
+					}
+				},
+				taskGroupContext
+			);
+		}
+	);
+	const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+	if( failed )
+	{
+		throw IECore::Exception( "InternedString construction produced inconsistent values" );
+	}
+
+	for( size_t i = 0; i < numStrings; ++i )
+	{
+		if( InternedString( strings[i] ).string() != strings[i] )
+		{
+			throw IECore::Exception( "InternedString construction produced incorrect value" );
+		}
+	}
+
+	return elapsed.count();
+}
+
 void bindInternedString()
 {
 
@@ -128,6 +205,8 @@ void bindInternedString()
 
 	InternedStringFromPython();
 
+	def( "testInternedStringConcurrentConstruction", &testInternedStringConcurrentConstruction );
+
 }
 
 } // namespace IECorePython
@@ -47,6 +47,7 @@
 
 #include "tbb/parallel_for.h"
 
+#include <atomic>
 #include <mutex>
 
 using namespace boost::python;
@@ -239,6 +240,7 @@ void testLRUCacheThreading( int numIterations, int numValues, int maxCost, int c
 
 typedef LRUCache<int, int, LRUCachePolicy::Serial> SerialTestCache;
 typedef LRUCache<int, int, LRUCachePolicy::Parallel> ParallelTestCache;
+typedef LRUCache<int, int, LRUCachePolicy::TaskParallel> TaskParallelTestCache;
 
 template<typename Cache>
 Cache &recursiveCache();
@@ -267,11 +269,12 @@ Cache &recursiveCache()
 	return c;
 }
 
+template<typename Cache>
 struct GetFromParallelRecursiveCache
 {
 	public :
 
-		GetFromParallelRecursiveCache( ParallelTestCache &cache, size_t numValues )
+		GetFromParallelRecursiveCache( Cache &cache, size_t numValues )
 			:	m_cache( cache ), m_numValues( numValues )
 		{
 		}
@@ -286,7 +289,7 @@ struct GetFromParallelRecursiveCache
 
 	private :
 
-		ParallelTestCache &m_cache;
+		Cache &m_cache;
 		size_t m_numValues;
 
 };
@@ -302,13 +305,74 @@ void testSerialLRUCacheRecursion( int maxCost )
 	}
 }
 
-void testParallelLRUCacheRecursion( int numIterations, size_t numValues, int maxCost )
+template<typename Cache>
+void testParallelLRUCacheRecursionWalk( int numIterations, size_t numValues, int maxCost )
 {
-	ParallelTestCache &cache = recursiveCache<ParallelTestCache>();
+	Cache &cache = recursiveCache<Cache>();
 	cache.clear();
 	cache.setMaxCost( maxCost );
 	tbb::task_group_context taskGroupContext( tbb::task_group_context::isolated );
-	parallel_for( blocked_range<size_t>( 0, numIterations ), GetFromParallelRecursiveCache( cache, numValues ), taskGroupContext );
+	parallel_for( blocked_range<size_t>( 0, numIterations ), GetFromParallelRecursiveCache<Cache>( cache, numValues ), taskGroupContext );
+}
+
+void testParallelLRUCacheRecursion( int numIterations, size_t numValues, int maxCost )
+{
+	testParallelLRUCacheRecursionWalk<ParallelTestCache>( numIterations, numValues, maxCost );
+}
+
+void testTaskParallelLRUCacheRecursion( int numIterations, size_t numValues, int maxCost )
+{
+	testParallelLRUCacheRecursionWalk<TaskParallelTestCache>( numIterations, numValues, maxCost );
+}
+
+// Many threads request a handful of keys whose getters are themselves
+// parallel. Checks that the results are correct, that each value is
+// computed exactly once, and that threads waiting on a getter don't
+// deadlock when they join in with its work.
+void testTaskParallelLRUCacheContention( int numIterations, int numValues, int workSize )
+{
+	std::atomic<int> numGetterCalls( 0 );
+	TaskParallelTestCache cache(
+		[&numGetterCalls, workSize] ( int key, size_t &cost ) {
+			numGetterCalls++;
+			std::atomic<int> sum( 0 );
+			tbb::parallel_for(
+				blocked_range<int>( 0, workSize ),
+				[&sum, key] ( const blocked_range<int> &r ) {
+					int s = 0;
+					for( int i = r.begin(); i != r.end(); ++i )
+					{
+						s += key;
+					}
+					sum += s;
+				}
+			);
+			cost = 1;
+			return sum.load();
+		},
+		numValues
+	);
+
+	tbb::task_group_context taskGroupContext( tbb::task_group_context::isolated );
+	parallel_for(
+		blocked_range<int>( 0, numIterations ),
+		[&cache, numValues, workSize] ( const blocked_range<int> &r ) {
+			for( int i = r.begin(); i != r.end(); ++i )
+			{
+				const int key = i % numValues;
+				if( cache.get( key ) != key * workSize )
+				{
+					throw Exception( "Unexpected result" );
+				}
+			}
+		},
+		taskGroupContext
+	);
+
+	if( numGetterCalls != numValues )
+	{
+		throw Exception( boost::str( boost::format( "Expected %d getter calls but got %d" ) % numValues % numGetterCalls.load() ) );
+	}
 }
 
 } // namespace
@@ -327,6 +391,7 @@ void IECorePython::bindLRUCache()
 		.def( "get", &PythonLRUCache::get )
 		.def( "set", &PythonLRUCache::set )
 		.def( "cached", &PythonLRUCache::cached )
+		.def( "statistics", (CacheStatistics &(PythonLRUCache::*)())&PythonLRUCache::statistics, return_internal_reference<1>() )
 	;
 
 	/// \todo If we create an IECoreTest module, move these into it.
@@ -343,5 +408,7 @@ void IECorePython::bindLRUCache()
 
 	def( "testSerialLRUCacheRecursion", testSerialLRUCacheRecursion );
 	def( "testParallelLRUCacheRecursion", testParallelLRUCacheRecursion );
+	def( "testTaskParallelLRUCacheRecursion", testTaskParallelLRUCacheRecursion );
+	def( "testTaskParallelLRUCacheContention", testTaskParallelLRUCacheContention );
 
 }
@@ -38,6 +38,7 @@
 
 #include "IECorePython/RunTimeTypedBinding.h"
 #include "IECorePython/ScopedGILLock.h"
+#include "IECorePython/ScopedGILRelease.h"
 
 #include "IECore/MurmurHash.h"
 #include "IECore/Object.h"
@@ -75,6 +76,12 @@ ObjectPtr loadWrapper( ConstIndexedIOPtr ioInterface, const IndexedIO::EntryID &
 	return Object::load( ioInterface, name, canceller );
 }
 
+void saveWrapper( const Object &object, IndexedIOPtr ioInterface, const IndexedIO::EntryID &name )
+{
+	IECorePython::ScopedGILRelease gilRelease;
+	object.save( ioInterface, name );
+}
+
 } // namespace
 
 namespace IECorePython
@@ -99,7 +106,7 @@ void bindObject()
 		.staticmethod( "create" )
 		.def( "load", loadWrapper, ( arg( "ioInterface" ), arg( "name" ), arg( "canceller" ) = object() ) )
 		.staticmethod( "load" )
-		.def( "save", (void (Object::*)( IndexedIOPtr, const IndexedIO::EntryID & )const )&Object::save )
+		.def( "save", &saveWrapper )
 		.def( "memoryUsage", (size_t (Object::*)()const )&Object::memoryUsage, "Returns the number of bytes this instance occupies in memory" )
 		.def( "hash", (MurmurHash (Object::*)() const)&Object::hash )
 		.def( "hash", (void (Object::*)( MurmurHash & ) const)&Object::hash )
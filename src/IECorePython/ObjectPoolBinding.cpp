@@ -95,6 +95,9 @@ void bindObjectPool()
 		.def( "memoryUsage", &ObjectPool::memoryUsage )
 		.def( "getMaxMemoryUsage", &ObjectPool::getMaxMemoryUsage)
 		.def( "setMaxMemoryUsage", &ObjectPool::setMaxMemoryUsage )
+		.def( "setSharedMemoryCache", &ObjectPool::setSharedMemoryCache )
+		.def( "getSharedMemoryCache", &ObjectPool::getSharedMemoryCache, return_value_policy<CastToIntrusivePtr>() )
+		.def( "statistics", (CacheStatistics &(ObjectPool::*)())&ObjectPool::statistics, return_internal_reference<1>() )
 		.def( "defaultObjectPool", &ObjectPool::defaultObjectPool, return_value_policy<CastToIntrusivePtr>() )
 		.staticmethod( "defaultObjectPool" )
 	;
@@ -37,6 +37,7 @@
 #include "IECorePython/ObjectReaderBinding.h"
 
 #include "IECorePython/ReaderBinding.h"
+#include "IECorePython/ScopedGILRelease.h"
 
 #include "IECore/CompoundParameter.h"
 #include "IECore/FileNameParameter.h"
@@ -47,6 +48,17 @@ using namespace boost;
 using namespace boost::python;
 using namespace IECore;
 
+namespace
+{
+
+bool canRead( const std::string &fileName )
+{
+	IECorePython::ScopedGILRelease gilRelease;
+	return ObjectReader::canRead( fileName );
+}
+
+} // namespace
+
 namespace IECorePython
 {
 
@@ -55,7 +67,7 @@ void bindObjectReader()
 	ReaderClass<ObjectReader>()
 		.def( init<>() )
 		.def( init<const std::string &>() )
-		.def( "canRead", &ObjectReader::canRead ).staticmethod( "canRead" )
+		.def( "canRead", &canRead ).staticmethod( "canRead" )
 	;
 }
 
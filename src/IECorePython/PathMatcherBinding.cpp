@@ -41,14 +41,18 @@
 
 #include "IECorePython/RunTimeTypedBinding.h"
 
+#include "IECore/FrozenPathMatcher.h"
 #include "IECore/PathMatcher.h"
 #include "IECore/PathMatcherData.h"
+#include "IECore/StringAlgo.h"
 #include "IECore/VectorTypedData.h"
 
 #include "boost/format.hpp"
 #include "boost/python/suite/indexing/container_utils.hpp"
 #include "boost/tokenizer.hpp"
 
+#include <chrono>
+
 using namespace std;
 using namespace boost::python;
 using namespace IECore;
@@ -176,6 +180,76 @@ void testPathMatcherFind()
 
 }
 
+// Checks that iterating a FrozenPathMatcher visits exactly the same
+// locations as iterating the PathMatcher `m` it is constructed from.
+void testFrozenPathMatcherIteration( const PathMatcher &m )
+{
+	const FrozenPathMatcher f( m );
+
+	FrozenPathMatcher::RawIterator fIt = f.begin();
+	for( PathMatcher::RawIterator it = m.begin(); it != m.end(); ++it, ++fIt )
+	{
+		IECORETEST_ASSERT( fIt != f.end() );
+		IECORETEST_ASSERT( *fIt == *it );
+		IECORETEST_ASSERT( fIt.exactMatch() == it.exactMatch() );
+
+		FrozenPathMatcher::RawIterator fFindIt = f.find( *it );
+		IECORETEST_ASSERT( fFindIt == fIt );
+		IECORETEST_ASSERT( f.match( it->begin(), it->end() ) == m.match( *it ) );
+	}
+	IECORETEST_ASSERT( fIt == f.end() );
+
+	FrozenPathMatcher::Iterator fTerminatorIt = f.begin();
+	for( PathMatcher::Iterator it = m.begin(); it != m.end(); ++it, ++fTerminatorIt )
+	{
+		IECORETEST_ASSERT( fTerminatorIt != f.end() );
+		IECORETEST_ASSERT( *fTerminatorIt == *it );
+	}
+	IECORETEST_ASSERT( fTerminatorIt == f.end() );
+
+	// Prune everything below the first level.
+	fIt = f.begin();
+	for( PathMatcher::RawIterator it = m.begin(); it != m.end(); ++it, ++fIt )
+	{
+		IECORETEST_ASSERT( fIt != f.end() );
+		IECORETEST_ASSERT( *fIt == *it );
+		if( it->size() == 1 )
+		{
+			it.prune();
+			fIt.prune();
+		}
+	}
+	IECORETEST_ASSERT( fIt == f.end() );
+}
+
+// Returns the time in seconds taken to match every path `iterations` times,
+// excluding the time taken to tokenize the paths.
+template<typename Matcher>
+double testPathMatcherMatchPerformance( const Matcher &matcher, const StringVectorData *paths, int iterations )
+{
+	vector<vector<InternedString>> tokenizedPaths;
+	tokenizedPaths.reserve( paths->readable().size() );
+	for( const auto &path : paths->readable() )
+	{
+		tokenizedPaths.push_back( vector<InternedString>() );
+		StringAlgo::tokenize( path, '/', tokenizedPaths.back() );
+	}
+
+	unsigned result = 0;
+	const auto start = std::chrono::steady_clock::now();
+	for( int i = 0; i < iterations; ++i )
+	{
+		for( const auto &path : tokenizedPaths )
+		{
+			result |= matcher.match( path );
+		}
+	}
+	const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+	// Use the result so the matching can't be optimised away.
+	return result == PathMatcher::NoMatch ? -elapsed.count() : elapsed.count();
+}
+
 // PathMatcher paths are just std::vector<InternedString>,
 // which doesn't exist in Python. So we register a conversion from
 // InternedStringVectorData which contains just such a vector.
@@ -311,6 +385,24 @@ std::string pathMatcherRepr( object p )
 	return "IECore.PathMatcher( " + paths + " )";
 }
 
+boost::python::list frozenPaths( const FrozenPathMatcher &p )
+{
+	std::vector<std::string> paths;
+	p.paths( paths );
+	boost::python::list result;
+	for( const auto &path : paths )
+	{
+		result.append( path );
+	}
+	return result;
+}
+
+std::string frozenPathMatcherRepr( object p )
+{
+	std::string paths = extract<std::string>( p.attr( "paths" )().attr( "__repr__" )() );
+	return "IECore.FrozenPathMatcher( IECore.PathMatcher( " + paths + " ) )";
+}
+
 std::string pathMatcherDataRepr( object d )
 {
 	std::string p = extract<std::string>( d.attr( "value" ).attr( "__repr__" )() );
@@ -329,6 +421,9 @@ void IECorePython::bindPathMatcher()
 	def( "testPathMatcherRawIterator", &testPathMatcherRawIterator );
 	def( "testPathMatcherIteratorPrune", &testPathMatcherIteratorPrune );
 	def( "testPathMatcherFind", &testPathMatcherFind );
+	def( "testFrozenPathMatcherIteration", &testFrozenPathMatcherIteration );
+	def( "testPathMatcherMatchPerformance", &testPathMatcherMatchPerformance<PathMatcher> );
+	def( "testPathMatcherMatchPerformance", &testPathMatcherMatchPerformance<FrozenPathMatcher> );
 
 	IECorePython::RunTimeTypedClass<PathMatcherData>()
 		.def( init<>() )
@@ -338,6 +433,22 @@ void IECorePython::bindPathMatcher()
 		.def( "__repr__", &pathMatcherDataRepr )
 	;
 
+	class_<FrozenPathMatcher>( "FrozenPathMatcher" )
+		.def( init<const PathMatcher &>() )
+		.def( init<const FrozenPathMatcher &>() )
+		.def( "pathMatcher", &FrozenPathMatcher::pathMatcher )
+		.def( "subTree", (FrozenPathMatcher ( FrozenPathMatcher::*)( const std::vector<IECore::InternedString> & ) const)&FrozenPathMatcher::subTree )
+		.def( "subTree", (FrozenPathMatcher ( FrozenPathMatcher::*)( const std::string & ) const)&FrozenPathMatcher::subTree )
+		.def( "isEmpty", &FrozenPathMatcher::isEmpty )
+		.def( "size", &FrozenPathMatcher::size )
+		.def( "paths", &frozenPaths )
+		.def( "match", (unsigned (FrozenPathMatcher::*)( const std::vector<IECore::InternedString> & ) const)&FrozenPathMatcher::match )
+		.def( "match", (unsigned (FrozenPathMatcher::*)( const std::string & ) const)&FrozenPathMatcher::match )
+		.def( "__repr__", &frozenPathMatcherRepr )
+		.def( self == self )
+		.def( self != self )
+	;
+
 	scope s = class_<PathMatcher>( "PathMatcher" )
 		.def( "__init__", make_constructor( constructFromObject ) )
 		.def( "__init__", make_constructor( constructFromVectorData ) )
@@ -52,6 +52,7 @@
 #include "IECorePython/GeometricTypedDataBinding.h"
 #include "IECorePython/SimpleTypedDataBinding.h"
 #include "IECorePython/VectorTypedDataBinding.h"
+#include "IECorePython/BufferBinding.h"
 #include "IECorePython/ObjectBinding.h"
 #include "IECorePython/TypeIdBinding.h"
 #include "IECorePython/CompoundDataBinding.h"
@@ -138,6 +139,7 @@
 #include "IECorePython/LookupBinding.h"
 #include "IECorePython/CamelCaseBinding.h"
 #include "IECorePython/LRUCacheBinding.h"
+#include "IECorePython/CacheStatisticsBinding.h"
 #include "IECorePython/DataInterleaveOpBinding.h"
 #include "IECorePython/DataConvertOpBinding.h"
 #include "IECorePython/MurmurHashBinding.h"
@@ -145,7 +147,9 @@
 #include "IECorePython/TimeCodeDataBinding.h"
 #include "IECorePython/LensModelBinding.h"
 #include "IECorePython/StandardRadialLensModelBinding.h"
+#include "IECorePython/SharedMemoryObjectCacheBinding.h"
 #include "IECorePython/ObjectPoolBinding.h"
+#include "IECorePython/DiskObjectCacheBinding.h"
 #include "IECorePython/DataAlgoBinding.h"
 #include "IECorePython/BoxAlgoBinding.h"
 #include "IECorePython/RandomAlgoBinding.h"
@@ -201,6 +205,7 @@ BOOST_PYTHON_MODULE(_IECore)
 	bindData();
 	bindGeometricTypedData();
 	bindAllSimpleTypedData();
+	bindBuffer();
 	bindAllVectorTypedData();
 	bindCompoundData();
 	bindIndexedIO();
@@ -285,6 +290,7 @@ BOOST_PYTHON_MODULE(_IECore)
 	bindHexConversion();
 	bindLookup();
 	bindCamelCase();
+	bindCacheStatistics();
 	bindLRUCache();
 	bindDataInterleaveOp();
 	bindDataConvertOp();
@@ -293,7 +299,9 @@ BOOST_PYTHON_MODULE(_IECore)
 	bindTimeCodeData();
 	bindLensModel();
 	bindStandardRadialLensModel();
+	bindSharedMemoryObjectCache();
 	bindObjectPool();
+	bindDiskObjectCache();
 	bindDataAlgo();
 	bindBoxAlgo();
 	bindRandomAlgo();
@@ -39,7 +39,12 @@
 #include "IECore/NullObject.h"
 #include "IECore/TypeTraits.h"
 
+#include "tbb/blocked_range.h"
+#include "tbb/parallel_for.h"
+
 #include <algorithm>
+#include <numeric>
+#include <set>
 
 using namespace IECore;
 using namespace IECoreScene;
@@ -77,8 +82,8 @@ struct CurvesMergeOp::AppendPrimVars
 {
 	typedef void ReturnType;
 
-	AppendPrimVars( const CurvesPrimitive * curves2, const std::string &name )
-		:	m_curves2( curves2 ), m_name( name )
+	AppendPrimVars( const CurvesPrimitive * curves2, const std::string &name, IntVectorData *indices )
+		:	m_curves2( curves2 ), m_name( name ), m_indices( indices )
 	{
 	}
 
@@ -87,20 +92,64 @@ struct CurvesMergeOp::AppendPrimVars
 	{
 
 		PrimitiveVariableMap::const_iterator it = m_curves2->variables.find( m_name );
-		if( it!=m_curves2->variables.end() )
+		if( it==m_curves2->variables.end() )
+		{
+			return;
+		}
+
+		const T *data2 = runTimeCast<const T>( it->second.data.get() );
+		if( !data2 )
+		{
+			return;
+		}
+
+		auto &values = data->writable();
+		const auto &values2 = data2->readable();
+		const int offset = values.size();
+
+		if( m_indices )
 		{
-			const T *data2 = runTimeCast<const T>( it->second.data.get() );
-			if( data2 )
+			// Append the data and re-index to fit on the end of it.
+			values.insert( values.end(), values2.begin(), values2.end() );
+			auto &indices = m_indices->writable();
+			if( it->second.indices )
+			{
+				const auto &indices2 = it->second.indices->readable();
+				indices.reserve( indices.size() + indices2.size() );
+				for( auto index : indices2 )
+				{
+					indices.push_back( index + offset );
+				}
+			}
+			else
 			{
-				data->writable().insert( data->writable().end(), data2->readable().begin(), data2->readable().end() );
+				indices.resize( indices.size() + values2.size() );
+				std::iota( indices.end() - values2.size(), indices.end(), offset );
 			}
 		}
+		else if( it->second.indices )
+		{
+			// The input curves dictate whether the primitive variable
+			// is indexed, so we must expand the indices from the
+			// second curves.
+			const auto &indices2 = it->second.indices->readable();
+			values.reserve( values.size() + indices2.size() );
+			for( auto index : indices2 )
+			{
+				values.push_back( values2[index] );
+			}
+		}
+		else
+		{
+			values.insert( values.end(), values2.begin(), values2.end() );
+		}
 	}
 
 	private :
 
 		const CurvesPrimitive * m_curves2;
 		std::string m_name;
+		IntVectorData *m_indices;
 
 };
 
@@ -120,13 +169,38 @@ void CurvesMergeOp::modifyTypedPrimitive( CurvesPrimitive * curves, const Compou
 
 	curves->setTopology( verticesPerCurveData, curves->basis(), curves->periodic() );
 
-	PrimitiveVariableMap::iterator pvIt;
-	for( pvIt=curves->variables.begin(); pvIt!=curves->variables.end(); pvIt++ )
+	// Find the data to append to. Variables may share data, in which
+	// case it must only be appended to once.
+	std::vector<PrimitiveVariableMap::iterator> toAppend;
+	std::set<const Data *> visitedData;
+	std::set<const IntVectorData *> visitedIndices;
+	for( PrimitiveVariableMap::iterator pvIt=curves->variables.begin(); pvIt!=curves->variables.end(); pvIt++ )
 	{
-		if( pvIt->second.interpolation!=PrimitiveVariable::Constant )
+		if( pvIt->second.interpolation!=PrimitiveVariable::Constant && visitedData.insert( pvIt->second.data.get() ).second )
 		{
-			AppendPrimVars f( curves2, pvIt->first );
-			despatchTypedData<AppendPrimVars, TypeTraits::IsVectorTypedData, DespatchTypedDataIgnoreError>( pvIt->second.data.get(), f );
+			if( pvIt->second.indices && !visitedIndices.insert( pvIt->second.indices.get() ).second )
+			{
+				// Indices shared with a variable with different data
+				// need appending to separately.
+				pvIt->second.indices = pvIt->second.indices->copy();
+			}
+			toAppend.push_back( pvIt );
 		}
 	}
+
+	// Each variable is independent, so they can be appended to in parallel.
+	tbb::task_group_context taskGroupContext( tbb::task_group_context::isolated );
+	tbb::parallel_for(
+		tbb::blocked_range<size_t>( 0, toAppend.size() ),
+		[&toAppend, curves2]( const tbb::blocked_range<size_t> &r )
+		{
+			for( size_t i = r.begin(); i != r.end(); ++i )
+			{
+				PrimitiveVariableMap::iterator pvIt = toAppend[i];
+				AppendPrimVars f( curves2, pvIt->first, pvIt->second.indices.get() );
+				despatchTypedData<AppendPrimVars, TypeTraits::IsVectorTypedData, DespatchTypedDataIgnoreError>( pvIt->second.data.get(), f );
+			}
+		},
+		taskGroupContext
+	);
 }
@@ -33,6 +33,9 @@
 //////////////////////////////////////////////////////////////////////////
 
 #include "IECoreScene/MeshAlgo.h"
+#include "IECoreScene/MeshTopology.h"
+
+#include <algorithm>
 
 using namespace std;
 using namespace IECore;
@@ -40,60 +43,23 @@ using namespace IECoreScene;
 
 pair<IntVectorDataPtr, IntVectorDataPtr> MeshAlgo::connectedVertices( const MeshPrimitive *mesh, const Canceller *canceller )
 {
-	size_t numVertices = mesh->variableData< V3fVectorData >( "P", PrimitiveVariable::Vertex )->readable().size();
-	const vector<int> &numVerticesPerFace = mesh->verticesPerFace()->readable();
-	const vector<int> &vertexIds = mesh->vertexIds()->readable();
-
-	vector< set<int> > neighbors( numVertices );
+	const size_t numVertices = mesh->variableData< V3fVectorData >( "P", PrimitiveVariable::Vertex )->readable().size();
+	ConstMeshTopologyPtr topology = MeshTopology::get( mesh, canceller );
+	const MeshTopology::Adjacency &neighbours = topology->vertexNeighbours( canceller );
 
-	int currentVertOffset = 0;
-	for ( auto &vertsPerFace : numVerticesPerFace )
-	{
-		Canceller::check( canceller );
+	// The topology stores the start of each vertex's neighbours, but we
+	// return the end, for compatibility. Vertices beyond those referenced
+	// by the topology have no neighbours.
 
-		for ( int i = 0; i < vertsPerFace; ++i)
-		{
-			const int &faceVert = vertexIds[ currentVertOffset + i ];
-			const int &faceVertNext = vertexIds[ currentVertOffset + ( i + 1 ) % vertsPerFace ];
-			neighbors[ faceVert ].insert( faceVertNext );
-			neighbors[ faceVertNext ].insert( faceVert );
-		}
-		currentVertOffset += vertsPerFace;
-	}
-
-	int neighborCount = 0;
-	int cancelTestCounter = 0;
-	for ( auto &n : neighbors )
-	{
-		if( cancelTestCounter++ == 1000 )
-		{
-			Canceller::check( canceller );
-			cancelTestCounter = 0;
-		}
-		neighborCount += n.size();
-	}
+	const size_t numConnectedVertices = std::min( numVertices, topology->numVertices() );
 
 	IntVectorDataPtr offsets = new IntVectorData();
-	IntVectorDataPtr neighborList = new IntVectorData();
 	vector<int> &offsetsW = offsets->writable();
-	vector<int> &neighborListW = neighborList->writable();
-
-	neighborListW.resize( neighborCount, -1 );
-	offsetsW.resize( neighbors.size(), -1 );
+	offsetsW.resize( numVertices, neighbours.offsets[numConnectedVertices] );
+	std::copy( neighbours.offsets.begin() + 1, neighbours.offsets.begin() + 1 + numConnectedVertices, offsetsW.begin() );
 
-	int ix = 0;
-	for ( size_t i = 0; i < neighbors.size(); ++i )
-	{
-		if( i % 1000 == 0 )
-		{
-			Canceller::check( canceller );
-		}
-		for ( auto &n : neighbors[ i ] )
-		{
-			neighborListW[ ix++ ] = n;
-		}
-		offsetsW[ i ] = ix;
-	}
+	Canceller::check( canceller );
+	IntVectorDataPtr neighborList = new IntVectorData( vector<int>( neighbours.values.begin(), neighbours.values.begin() + neighbours.offsets[numConnectedVertices] ) );
 
 	return pair<IntVectorDataPtr, IntVectorDataPtr>( neighborList, offsets );
 }
@@ -40,7 +40,12 @@
 
 #include "boost/format.hpp"
 
+#include "tbb/blocked_range.h"
+#include "tbb/parallel_for.h"
+
 #include <algorithm>
+#include <numeric>
+#include <tuple>
 
 using namespace Imath;
 using namespace IECore;
@@ -76,292 +81,272 @@ struct DefaultValue<Imath::Vec2<T> >
 	}
 };
 
-struct AppendPrimVars
+// Returns the offset of each mesh's contribution to an array in the
+// merged mesh, followed by the total size of the array.
+template<typename F>
+std::vector<size_t> offsets( const std::vector<const MeshPrimitive *> &meshes, F &&size )
 {
-		typedef void ReturnType;
+	std::vector<size_t> result( meshes.size() + 1, 0 );
+	for( size_t i = 0; i < meshes.size(); ++i )
+	{
+		result[i+1] = result[i] + size( meshes[i] );
+	}
+	return result;
+}
 
-		AppendPrimVars( MeshPrimitive *mesh, const MeshPrimitive *mesh2, const std::string &name, const PrimitiveVariable::Interpolation interpolation, IntVectorData *indices, std::set<DataPtr> &visitedData, const Canceller *canceller )
-			:	m_mesh2( mesh2 ), m_name( name ), m_interpolation( interpolation ), m_indices( indices ), m_visitedData( visitedData ), m_canceller( canceller )
+// Calls `f( i )` for each mesh index. Each call must only write to
+// the range of the output arrays belonging to its mesh.
+template<typename F>
+void forEachMesh( size_t numMeshes, bool parallel, const Canceller *canceller, F &&f )
+{
+	auto rangeFunctor = [&f, canceller]( const tbb::blocked_range<size_t> &r )
+	{
+		for( size_t i = r.begin(); i != r.end(); ++i )
+		{
+			Canceller::check( canceller );
+			f( i );
+		}
+	};
+
+	if( parallel )
+	{
+		tbb::task_group_context taskGroupContext( tbb::task_group_context::isolated );
+		tbb::parallel_for( tbb::blocked_range<size_t>( 0, numMeshes ), rangeFunctor, taskGroupContext );
+	}
+	else
+	{
+		rangeFunctor( tbb::blocked_range<size_t>( 0, numMeshes ) );
+	}
+}
+
+template<typename T>
+void offsetCopy( const std::vector<T> &source, T offset, typename std::vector<T>::iterator destination )
+{
+	std::transform( source.begin(), source.end(), destination, [offset]( T i ) { return i + offset; } );
+}
+
+/// Merges the primitive variable `name` from all the meshes, in a single
+/// allocation. The variable is taken from the meshes starting with
+/// `firstMesh`, which provides its type and interpolation. Meshes before
+/// `firstMesh`, or with a mismatched variable, contribute default values.
+struct MergePrimitiveVariable
+{
+		typedef PrimitiveVariable ReturnType;
+
+		MergePrimitiveVariable( const std::vector<const MeshPrimitive *> &meshes, const std::string &name, PrimitiveVariable::Interpolation interpolation, size_t firstMesh, bool indexed, const Canceller *canceller )
+			:	m_meshes( meshes ), m_name( name ), m_interpolation( interpolation ), m_firstMesh( firstMesh ), m_indexed( indexed ), m_canceller( canceller )
 		{
 		}
 
 		template<typename T>
-		ReturnType operator()( T *data )
+		ReturnType operator()( const T *data )
 		{
-			if ( m_visitedData.find( data ) != m_visitedData.end() )
-			{
-				return;
-			}
-			m_visitedData.insert( data );
+			typedef typename T::ValueType::value_type ValueType;
+
+			// Size everything up front, so that each mesh can be copied
+			// straight into its final position.
 
-			PrimitiveVariableMap::const_iterator it = m_mesh2->variables.find( m_name );
-			if( it != m_mesh2->variables.end() && it->second.data->isInstanceOf( data->staticTypeId() ) && it->second.interpolation == m_interpolation )
+			const size_t numMeshes = m_meshes.size();
+			std::vector<const PrimitiveVariable *> sources( numMeshes, nullptr );
+			std::vector<size_t> dataOffsets( numMeshes + 1, 0 );
+			std::vector<size_t> indexOffsets( numMeshes + 1, 0 );
+			for( size_t i = 0; i < numMeshes; ++i )
 			{
-				if( m_indices )
+				if( i >= m_firstMesh )
 				{
-					const int offset = data->readable().size();
-
-					Canceller::check( m_canceller );
-					const T *data2 = runTimeCast<const T>( it->second.data.get() );
-					data->writable().insert( data->writable().end(), data2->readable().begin(), data2->readable().end() );
+					PrimitiveVariableMap::const_iterator it = m_meshes[i]->variables.find( m_name );
+					if( it != m_meshes[i]->variables.end() && it->second.interpolation == m_interpolation && runTimeCast<const T>( it->second.data.get() ) )
+					{
+						sources[i] = &it->second;
+					}
+				}
 
-					if( it->second.indices )
+				const size_t size = m_meshes[i]->variableSize( m_interpolation );
+				size_t dataSize = size;
+				size_t indexSize = 0;
+				if( sources[i] )
+				{
+					const size_t sourceDataSize = static_cast<const T *>( sources[i]->data.get() )->readable().size();
+					const size_t sourceIndexSize = sources[i]->indices ? sources[i]->indices->readable().size() : sourceDataSize;
+					if( m_indexed )
 					{
-						/// Re-index to fit on the end of the existing data
-						/// \todo: the data would be more compact if we search
-						/// existing values rather than blindly insert.
-						std::vector<int> &indices = m_indices->writable();
-						const std::vector<int> &indices2 = it->second.indices->readable();
-						Canceller::check( m_canceller );
-						indices.reserve( indices.size() + indices2.size() );
-						Canceller::check( m_canceller );
-						for( const auto &index : indices2 )
-						{
-							indices.push_back( offset + index );
-						}
+						dataSize = sourceDataSize;
+						indexSize = sourceIndexSize;
 					}
 					else
 					{
-						/// Append new indices for the second mesh
-						/// \todo: the data would be more compact if we search
-						/// existing values rather than blindly insert.
-						std::vector<int> &indices = m_indices->writable();
-						const size_t data2Size = data2->readable().size();
-						for( size_t i = 0; i < data2Size; ++i )
-						{
-							if( i % 1000 == 0 )
-							{
-								Canceller::check( m_canceller );
-							}
-
-							indices.push_back( offset + i );
-						}
+						/// The first mesh dictates whether the PrimitiveVariable should
+						/// be indexed. If other meshes have indices, we must expand them.
+						dataSize = sourceIndexSize;
 					}
 				}
-				else
+				else if( m_indexed )
 				{
-					/// The first mesh dictates whether the PrimitiveVariable should
-					/// be indexed. If the second mesh has indices, we must expand them.
-					Canceller::check( m_canceller );
-					typename T::Ptr expandedData2 = runTimeCast<T>( it->second.expandedData() );
-					data->writable().insert( data->writable().end(), expandedData2->readable().begin(), expandedData2->readable().end() );
-				}
-			}
-			else
-			{
-				typedef typename T::ValueType::value_type ValueType;
-				ValueType defaultValue = DefaultValue<ValueType>()();
-				size_t size = m_mesh2->variableSize( m_interpolation );
-				if( !size )
-				{
-					/// mesh2 may have an empty variableSize if it contains
-					/// no topology, so early out rather than appending.
-					return;
+					/// \todo: the data would be more compact if we search for the
+					/// default value in the existing data rather than blindly insert.
+					dataSize = size ? 1 : 0;
+					indexSize = size;
 				}
 
-				Canceller::check( m_canceller );
-				if( m_indices )
-				{
-					/// \todo: the data would be more compact if we search for defaultValue
-					/// in the existing data rather than blindly insert.
-					m_indices->writable().insert( m_indices->writable().end(), size, data->writable().size() );
-					data->writable().push_back( defaultValue );
-				}
-				else
-				{
-					data->writable().insert( data->writable().end(), size, defaultValue );
-				}
+				dataOffsets[i+1] = dataOffsets[i] + dataSize;
+				indexOffsets[i+1] = indexOffsets[i] + indexSize;
 			}
-		}
-
-	private :
-
-		const MeshPrimitive *m_mesh2;
-		const std::string m_name;
-		const PrimitiveVariable::Interpolation m_interpolation;
-		IntVectorData *m_indices;
-		std::set<DataPtr> &m_visitedData;
-		const Canceller *m_canceller;
 
-};
+			Canceller::check( m_canceller );
+			typename T::Ptr resultData = new T;
+			setGeometricInterpretation( resultData.get(), getGeometricInterpretation( data ) );
+			auto &resultValues = resultData->writable();
+			resultValues.resize( dataOffsets.back() );
 
-struct PrependPrimVars
-{
-		typedef void ReturnType;
-
-		PrependPrimVars( MeshPrimitive *mesh, const std::string &name, const PrimitiveVariable &primVar, std::map<ConstDataPtr, DataPtr> &visitedData, const Canceller *canceller )
-			:	m_mesh( mesh ), m_name( name ), m_primVar( primVar ), m_visitedData( visitedData ), m_canceller( canceller )
-		{
-		}
-
-		template<typename T>
-		ReturnType operator()( const T *data )
-		{
-			PrimitiveVariableMap::iterator it = m_mesh->variables.find( m_name );
-			if( it == m_mesh->variables.end() )
+			IntVectorDataPtr resultIndicesData = nullptr;
+			if( m_indexed )
 			{
-				typename T::Ptr data2 = nullptr;
+				resultIndicesData = new IntVectorData;
+				resultIndicesData->writable().resize( indexOffsets.back() );
+			}
 
-				std::map<ConstDataPtr, DataPtr>::iterator dataIt = m_visitedData.find( data );
-				if ( dataIt != m_visitedData.end() )
-				{
-					data2 = runTimeCast<T>( dataIt->second );
-				}
+			// Neighbouring elements of `std::vector<bool>` share storage,
+			// so can't be written concurrently.
+			const bool parallel = !std::is_same<ValueType, bool>::value;
 
-				if ( !data2 )
+			forEachMesh(
+				numMeshes, parallel, m_canceller,
+				[&]( size_t i )
 				{
-					typedef typename T::ValueType::value_type ValueType;
-					ValueType defaultValue = DefaultValue<ValueType>()();
-
-					Canceller::check( m_canceller );
-					typename T::Ptr expandedData = runTimeCast<T>( m_primVar.expandedData() );
-					size_t size = m_mesh->variableSize( m_primVar.interpolation ) - expandedData->readable().size();
-					data2 = new T();
-					data2->writable().insert( data2->writable().end(), size, defaultValue );
-
-					Canceller::check( m_canceller );
-					/// The first mesh dictates whether the PrimitiveVariable should
-					/// be indexed. If the second mesh has indices, we must expand them.
-					data2->writable().insert( data2->writable().end(), expandedData->readable().begin(), expandedData->readable().end() );
-				}
+					const PrimitiveVariable *source = sources[i];
+					auto valuesBegin = resultValues.begin() + dataOffsets[i];
+					auto valuesEnd = resultValues.begin() + dataOffsets[i+1];
+					const int offset = dataOffsets[i];
 
-				Canceller::check( m_canceller );
-				m_mesh->variables[m_name] = PrimitiveVariable( m_primVar.interpolation, data2 );
+					if( !source )
+					{
+						std::fill( valuesBegin, valuesEnd, DefaultValue<ValueType>()() );
+						if( m_indexed )
+						{
+							auto &resultIndices = resultIndicesData->writable();
+							std::fill( resultIndices.begin() + indexOffsets[i], resultIndices.begin() + indexOffsets[i+1], offset );
+						}
+						return;
+					}
 
-				m_visitedData[data] = data2;
-			}
+					const auto &sourceValues = static_cast<const T *>( source->data.get() )->readable();
+					if( m_indexed )
+					{
+						/// Re-index to fit on the end of the preceding data
+						/// \todo: the data would be more compact if we search
+						/// existing values rather than blindly insert.
+						std::copy( sourceValues.begin(), sourceValues.end(), valuesBegin );
+						auto indicesBegin = resultIndicesData->writable().begin() + indexOffsets[i];
+						if( source->indices )
+						{
+							offsetCopy( source->indices->readable(), offset, indicesBegin );
+						}
+						else
+						{
+							std::iota( indicesBegin, indicesBegin + sourceValues.size(), offset );
+						}
+					}
+					else if( source->indices )
+					{
+						for( auto index : source->indices->readable() )
+						{
+							*valuesBegin++ = sourceValues[index];
+						}
+					}
+					else
+					{
+						std::copy( sourceValues.begin(), sourceValues.end(), valuesBegin );
+					}
+				}
+			);
+
+			return PrimitiveVariable( m_interpolation, resultData, resultIndicesData );
 		}
 
 	private :
 
-		MeshPrimitive *m_mesh;
-		const std::string m_name;
-		const PrimitiveVariable &m_primVar;
-		std::map<ConstDataPtr, DataPtr> &m_visitedData;
+		const std::vector<const MeshPrimitive *> &m_meshes;
+		const std::string &m_name;
+		const PrimitiveVariable::Interpolation m_interpolation;
+		const size_t m_firstMesh;
+		const bool m_indexed;
 		const Canceller *m_canceller;
 
 };
 
-void merge( MeshPrimitive *a, const MeshPrimitive *b, const Canceller *canceller )
+void mergeTopology( const std::vector<const MeshPrimitive *> &meshes, MeshPrimitive *result, const Canceller *canceller )
 {
-	const auto &vertexIdsA = a->vertexIds()->readable();
-	const auto &verticesPerFaceA = a->verticesPerFace()->readable();
+	const std::vector<size_t> vertexOffsets = offsets( meshes, []( const MeshPrimitive *m ) { return m->variableSize( PrimitiveVariable::Vertex ); } );
+	const std::vector<size_t> faceOffsets = offsets( meshes, []( const MeshPrimitive *m ) { return m->verticesPerFace()->readable().size(); } );
+	const std::vector<size_t> vertexIdOffsets = offsets( meshes, []( const MeshPrimitive *m ) { return m->vertexIds()->readable().size(); } );
+	const std::vector<size_t> cornerOffsets = offsets( meshes, []( const MeshPrimitive *m ) { return m->cornerIds()->readable().size(); } );
+	const std::vector<size_t> creaseOffsets = offsets( meshes, []( const MeshPrimitive *m ) { return m->creaseLengths()->readable().size(); } );
+	const std::vector<size_t> creaseIdOffsets = offsets( meshes, []( const MeshPrimitive *m ) { return m->creaseIds()->readable().size(); } );
 
-	const auto &vertexIdsB = b->vertexIds()->readable();
-	const auto &verticesPerFaceB = b->verticesPerFace()->readable();
+	Canceller::check( canceller );
 
 	IntVectorDataPtr verticesPerFaceData = new IntVectorData;
 	auto &verticesPerFace = verticesPerFaceData->writable();
-	Canceller::check( canceller );
-	verticesPerFace.resize( verticesPerFaceA.size() + verticesPerFaceB.size() );
-	Canceller::check( canceller );
-	auto it = std::copy( verticesPerFaceA.begin(), verticesPerFaceA.end(), verticesPerFace.begin() );
-	Canceller::check( canceller );
-	std::copy( verticesPerFaceB.begin(), verticesPerFaceB.end(), it );
+	verticesPerFace.resize( faceOffsets.back() );
 
 	IntVectorDataPtr vertexIdsData = new IntVectorData;
 	auto &vertexIds = vertexIdsData->writable();
-	Canceller::check( canceller );
-	vertexIds.resize( vertexIdsA.size() + vertexIdsB.size() );
-	Canceller::check( canceller );
-	it = std::copy( vertexIdsA.begin(), vertexIdsA.end(), vertexIds.begin() );
-	int vertexIdOffset = a->variableSize( PrimitiveVariable::Vertex );
-	auto idShift = [vertexIdOffset]( int id ){ return id + vertexIdOffset; };
-	Canceller::check( canceller );
-	std::transform( vertexIdsB.begin(), vertexIdsB.end(), it, idShift );
+	vertexIds.resize( vertexIdOffsets.back() );
 
-	Canceller::check( canceller );
-	a->setTopologyUnchecked( verticesPerFaceData, vertexIdsData, a->variableSize( PrimitiveVariable::Vertex ) + b->variableSize( PrimitiveVariable::Vertex ), a->interpolation() );
+	IntVectorDataPtr cornerIdsData = new IntVectorData;
+	auto &cornerIds = cornerIdsData->writable();
+	cornerIds.resize( cornerOffsets.back() );
 
-	const auto &bCornerIds = b->cornerIds()->readable();
-	if( !bCornerIds.empty() )
-	{
-		const auto &aCornerIds = a->cornerIds()->readable();
-		IntVectorDataPtr idData = new IntVectorData;
-		auto &ids = idData->writable();
-		Canceller::check( canceller );
-		ids.resize( aCornerIds.size() + bCornerIds.size() );
-		Canceller::check( canceller );
-		it = std::copy( aCornerIds.begin(), aCornerIds.end(), ids.begin() );
-		Canceller::check( canceller );
-		std::transform( bCornerIds.begin(), bCornerIds.end(), it, idShift );
-
-		const auto &aSharpnesses = a->cornerSharpnesses()->readable();
-		const auto &bSharpnesses = b->cornerSharpnesses()->readable();
-		FloatVectorDataPtr sharpnessData = new FloatVectorData;
-		auto &sharpnesses = sharpnessData->writable();
-		Canceller::check( canceller );
-		sharpnesses.resize( aSharpnesses.size() + bSharpnesses.size() );
-		Canceller::check( canceller );
-		auto fIt = std::copy( aSharpnesses.begin(), aSharpnesses.end(), sharpnesses.begin() );
-		Canceller::check( canceller );
-		std::copy( bSharpnesses.begin(), bSharpnesses.end(), fIt );
-
-		a->setCorners( idData.get(), sharpnessData.get() );
-	}
+	FloatVectorDataPtr cornerSharpnessesData = new FloatVectorData;
+	auto &cornerSharpnesses = cornerSharpnessesData->writable();
+	cornerSharpnesses.resize( cornerOffsets.back() );
 
-	const auto &bCreaseIds = b->creaseIds()->readable();
-	if( !bCreaseIds.empty() )
-	{
-		const auto &aLengths = a->creaseLengths()->readable();
-		const auto &bLengths = b->creaseLengths()->readable();
-		IntVectorDataPtr lengthData = new IntVectorData;
-		auto &lengths = lengthData->writable();
-		Canceller::check( canceller );
-		lengths.resize( aLengths.size() + bLengths.size() );
-		Canceller::check( canceller );
-		it = std::copy( aLengths.begin(), aLengths.end(), lengths.begin() );
-		Canceller::check( canceller );
-		std::copy( bLengths.begin(), bLengths.end(), it );
-
-		const auto &aCreaseIds = a->creaseIds()->readable();
-		IntVectorDataPtr idData = new IntVectorData;
-		auto &ids = idData->writable();
-		Canceller::check( canceller );
-		ids.resize( aCreaseIds.size() + bCreaseIds.size() );
-		Canceller::check( canceller );
-		it = std::copy( aCreaseIds.begin(), aCreaseIds.end(), ids.begin() );
-		Canceller::check( canceller );
-		std::transform( bCreaseIds.begin(), bCreaseIds.end(), it, idShift );
-
-		const auto &aSharpnesses = a->creaseSharpnesses()->readable();
-		const auto &bSharpnesses = b->creaseSharpnesses()->readable();
-		FloatVectorDataPtr sharpnessData = new FloatVectorData;
-		auto &sharpnesses = sharpnessData->writable();
-		Canceller::check( canceller );
-		sharpnesses.resize( aSharpnesses.size() + bSharpnesses.size() );
-		Canceller::check( canceller );
-		auto fIt = std::copy( aSharpnesses.begin(), aSharpnesses.end(), sharpnesses.begin() );
-		Canceller::check( canceller );
-		std::copy( bSharpnesses.begin(), bSharpnesses.end(), fIt );
-
-		a->setCreases( lengthData.get(), idData.get(), sharpnessData.get() );
-	}
+	IntVectorDataPtr creaseLengthsData = new IntVectorData;
+	auto &creaseLengths = creaseLengthsData->writable();
+	creaseLengths.resize( creaseOffsets.back() );
 
+	IntVectorDataPtr creaseIdsData = new IntVectorData;
+	auto &creaseIds = creaseIdsData->writable();
+	creaseIds.resize( creaseIdOffsets.back() );
 
-	/// \todo: can this be parallelized?
-	std::set<DataPtr> visitedData;
-	for( auto &pv : a->variables )
-	{
-		Canceller::check( canceller );
-		if( pv.second.interpolation != PrimitiveVariable::Constant )
+	FloatVectorDataPtr creaseSharpnessesData = new FloatVectorData;
+	auto &creaseSharpnesses = creaseSharpnessesData->writable();
+	creaseSharpnesses.resize( creaseOffsets.back() );
+
+	forEachMesh(
+		meshes.size(), /* parallel = */ true, canceller,
+		[&]( size_t i )
 		{
-			IntVectorData *indices = pv.second.indices ? pv.second.indices.get() : nullptr;
-			AppendPrimVars f( a, b, pv.first, pv.second.interpolation, indices, visitedData, canceller );
-			despatchTypedData<AppendPrimVars, TypeTraits::IsVectorTypedData, DespatchTypedDataIgnoreError>( pv.second.data.get(), f );
+			const MeshPrimitive *mesh = meshes[i];
+			const int vertexOffset = vertexOffsets[i];
+
+			const auto &meshVerticesPerFace = mesh->verticesPerFace()->readable();
+			std::copy( meshVerticesPerFace.begin(), meshVerticesPerFace.end(), verticesPerFace.begin() + faceOffsets[i] );
+			offsetCopy( mesh->vertexIds()->readable(), vertexOffset, vertexIds.begin() + vertexIdOffsets[i] );
+
+			offsetCopy( mesh->cornerIds()->readable(), vertexOffset, cornerIds.begin() + cornerOffsets[i] );
+			const auto &meshCornerSharpnesses = mesh->cornerSharpnesses()->readable();
+			std::copy( meshCornerSharpnesses.begin(), meshCornerSharpnesses.end(), cornerSharpnesses.begin() + cornerOffsets[i] );
+
+			const auto &meshCreaseLengths = mesh->creaseLengths()->readable();
+			std::copy( meshCreaseLengths.begin(), meshCreaseLengths.end(), creaseLengths.begin() + creaseOffsets[i] );
+			offsetCopy( mesh->creaseIds()->readable(), vertexOffset, creaseIds.begin() + creaseIdOffsets[i] );
+			const auto &meshCreaseSharpnesses = mesh->creaseSharpnesses()->readable();
+			std::copy( meshCreaseSharpnesses.begin(), meshCreaseSharpnesses.end(), creaseSharpnesses.begin() + creaseOffsets[i] );
 		}
+	);
+
+	Canceller::check( canceller );
+	result->setTopologyUnchecked( verticesPerFaceData, vertexIdsData, vertexOffsets.back(), meshes[0]->interpolation() );
+
+	if( !cornerIds.empty() )
+	{
+		result->setCorners( cornerIdsData.get(), cornerSharpnessesData.get() );
 	}
 
-	/// \todo: can this be parallelized?
-	std::map<ConstDataPtr, DataPtr> visitedData2;
-	for( auto &pv : b->variables )
+	if( !creaseIds.empty() )
 	{
-		Canceller::check( canceller );
-		if( pv.second.interpolation != PrimitiveVariable::Constant )
-		{
-			PrependPrimVars f( a, pv.first, pv.second, visitedData2, canceller );
-			despatchTypedData<PrependPrimVars, TypeTraits::IsVectorTypedData, DespatchTypedDataIgnoreError>( pv.second.data.get(), f );
-		}
+		result->setCreases( creaseLengthsData.get(), creaseIdsData.get(), creaseSharpnessesData.get() );
 	}
 }
 
@@ -374,16 +359,92 @@ MeshPrimitivePtr IECoreScene::MeshAlgo::merge( const std::vector<const MeshPrimi
 		throw IECore::InvalidArgumentException( "IECoreScene::MeshAlgo::merge : No Mesh Primitives were provided." );
 	}
 
-	/// \todo: This scales poorly with increasing numbers of meshes.
-	/// Rather than allocating enough memory for everything and filling
-	/// it once, we're re-allocating and re-copying from the start for
-	/// each mesh. Improve the algorithm.
-	MeshPrimitivePtr result = meshes[0]->copy();
-	auto it = meshes.begin() + 1;
-	for( ; it != meshes.end(); ++it )
+	// Rather than merging the meshes one at a time, which would copy the
+	// accumulated result again for each mesh, we size every array in the
+	// result up front and fill it with a single parallel pass over the meshes.
+
+	MeshPrimitivePtr result = new MeshPrimitive;
+	mergeTopology( meshes, result.get(), canceller );
+
+	// Find the mesh that defines each primitive variable. This is the first
+	// mesh that has it, except that constant variables are only taken from
+	// the first mesh.
+
+	std::map<std::string, size_t> firstMeshes;
+	for( size_t i = 0; i < meshes.size(); ++i )
+	{
+		for( const auto &pv : meshes[i]->variables )
+		{
+			if( i == 0 || pv.second.interpolation != PrimitiveVariable::Constant )
+			{
+				firstMeshes.insert( { pv.first, i } );
+			}
+		}
+	}
+
+	// Variables which were sharing data in their first mesh continue
+	// to share data in the result, so we only need to merge one of them.
+
+	struct Merge
+	{
+		const std::string *name;
+		size_t firstMesh;
+		const PrimitiveVariable *primitiveVariable;
+		PrimitiveVariable result;
+	};
+
+	std::vector<Merge> merges;
+	std::map<std::string, size_t> mergeIndices;
+	std::map<std::tuple<size_t, const Data *, const IntVectorData *>, size_t> visitedData;
+	for( const auto &f : firstMeshes )
+	{
+		const PrimitiveVariable &pv = meshes[f.second]->variables.find( f.first )->second;
+		if( pv.interpolation == PrimitiveVariable::Constant )
+		{
+			Canceller::check( canceller );
+			result->variables[f.first] = PrimitiveVariable( pv, /* deepCopy = */ true );
+			continue;
+		}
+
+		const auto key = std::make_tuple( f.second, pv.data.get(), f.second == 0 ? pv.indices.get() : nullptr );
+		const auto inserted = visitedData.insert( { key, merges.size() } );
+		if( inserted.second )
+		{
+			merges.push_back( { &f.first, f.second, &pv, PrimitiveVariable() } );
+		}
+		mergeIndices[f.first] = inserted.first->second;
+	}
+
+	tbb::task_group_context taskGroupContext( tbb::task_group_context::isolated );
+	tbb::parallel_for(
+		tbb::blocked_range<size_t>( 0, merges.size() ),
+		[&meshes, &merges, canceller]( const tbb::blocked_range<size_t> &r )
+		{
+			for( size_t i = r.begin(); i != r.end(); ++i )
+			{
+				Canceller::check( canceller );
+				Merge &m = merges[i];
+				/// Only variables in the first mesh may be indexed in the result.
+				MergePrimitiveVariable f( meshes, *m.name, m.primitiveVariable->interpolation, m.firstMesh, m.firstMesh == 0 && m.primitiveVariable->indices, canceller );
+				m.result = despatchTypedData<MergePrimitiveVariable, TypeTraits::IsVectorTypedData, DespatchTypedDataIgnoreError>( m.primitiveVariable->data.get(), f );
+				if( !m.result.data && m.firstMesh == 0 )
+				{
+					// Not vector data, so we can't merge it. Keep the
+					// variable from the first mesh as is.
+					m.result = PrimitiveVariable( *m.primitiveVariable, /* deepCopy = */ true );
+				}
+			}
+		},
+		taskGroupContext
+	);
+
+	for( const auto &m : mergeIndices )
 	{
-		Canceller::check( canceller );
-		::merge( result.get(), *it, canceller );
+		const PrimitiveVariable &pv = merges[m.second].result;
+		if( pv.data )
+		{
+			result->variables[m.first] = pv;
+		}
 	}
 
 	return result;
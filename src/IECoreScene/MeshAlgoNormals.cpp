@@ -33,6 +33,7 @@
 //////////////////////////////////////////////////////////////////////////
 
 #include "IECoreScene/MeshAlgo.h"
+#include "IECoreScene/MeshTopology.h"
 #include "IECoreScene/PolygonIterator.h"
 
 #include "IECore/PolygonAlgo.h"
@@ -42,6 +43,11 @@
 #include "boost/iterator/zip_iterator.hpp"
 #include "boost/tuple/tuple.hpp"
 
+#include "tbb/blocked_range.h"
+#include "tbb/parallel_for.h"
+
+#include <algorithm>
+
 using namespace Imath;
 using namespace IECore;
 using namespace IECoreScene;
@@ -60,64 +66,79 @@ PrimitiveVariable MeshAlgo::calculateNormals( const MeshPrimitive *mesh, Primiti
 		throw InvalidArgumentException( "MeshAlgo::calculateNormals : \"interpolation\" must be Vertex or Uniform" );
 	}
 
+	ConstMeshTopologyPtr topology = MeshTopology::get( mesh, canceller );
+	const std::vector<int> &faceVertexOffsets = topology->faceVertexOffsets();
+	const size_t numFaces = topology->numFaces();
+	const auto &vertIds = mesh->vertexIds()->readable();
+
+	// Calculate the face normals in parallel.
+
+	Canceller::check( canceller );
+	std::vector<V3f> faceNormals( numFaces );
+
+	tbb::task_group_context taskGroupContext( tbb::task_group_context::isolated );
+	tbb::parallel_for(
+		tbb::blocked_range<size_t>( 0, numFaces ),
+		[&]( const tbb::blocked_range<size_t> &r )
+		{
+			Canceller::check( canceller );
+			for( size_t f = r.begin(); f != r.end(); ++f )
+			{
+				// calculate the face normal. note that this method is very naive, and doesn't
+				// cope with colinear vertices or concave faces - we could use polygonNormal() from
+				// PolygonAlgo.h to deal with that, but currently we'd prefer to avoid the overhead.
+				const int *vertId = &(vertIds[faceVertexOffsets[f]]);
+				const V3f &p0 = points[*vertId];
+				const V3f &p1 = points[*(vertId+1)];
+				const V3f &p2 = points[*(vertId+2)];
+
+				V3f normal = ( p2 - p1 ).cross( p0 - p1 );
+				normal.normalize();
+				faceNormals[f] = normal;
+			}
+		},
+		taskGroupContext
+	);
+
 	V3fVectorDataPtr normalsData = new V3fVectorData;
 	normalsData->setInterpretation( GeometricData::Normal );
 	auto &normals = normalsData->writable();
 
-	const auto &verticesPerFace = mesh->verticesPerFace()->readable();
 	if( interpolation == PrimitiveVariable::Uniform )
 	{
-		normals.reserve( verticesPerFace.size() );
-	}
-	else
-	{
-		normals.resize( points.size(), Imath::V3f( 0 ) );
+		normals.swap( faceNormals );
+		return PrimitiveVariable( interpolation, normalsData );
 	}
 
-	const auto &vertIds = mesh->vertexIds()->readable();
-	const int *vertId = &(vertIds[0]);
-	for( auto numVerts : verticesPerFace )
-	{
-		Canceller::check( canceller );
-		// calculate the face normal. note that this method is very naive, and doesn't
-		// cope with colinear vertices or concave faces - we could use polygonNormal() from
-		// PolygonAlgo.h to deal with that, but currently we'd prefer to avoid the overhead.
-		const V3f &p0 = points[*vertId];
-		const V3f &p1 = points[*(vertId+1)];
-		const V3f &p2 = points[*(vertId+2)];
-
-		V3f normal = ( p2 - p1 ).cross( p0 - p1 );
-		normal.normalize();
-
-		if( interpolation == PrimitiveVariable::Uniform )
-		{
-			normals.push_back( normal );
-			vertId += numVerts;
-		}
-		else
-		{
-			// accumulate the face normal onto each of the vertices for this face.
-			for( int i=0; i < numVerts; ++i )
-			{
-				normals[*vertId] += normal;
-				++vertId;
-			}
-		}
-	}
+	// Accumulate the face normals onto each vertex in parallel. Each vertex
+	// gathers from its faces in face order, so the sums are identical to
+	// those made by a serial loop over the faces.
 
-	// normalize each of the vertex normals
-	if( interpolation == PrimitiveVariable::Vertex )
-	{
-		for( size_t i = 0; i < normals.size(); i++ )
+	const std::vector<int> &faceVertexFaces = topology->faceVertexFaces();
+	const MeshTopology::Adjacency &vertexFaceVertices = topology->vertexFaceVertices();
+
+	// Points not used by any face are given a zero normal.
+	Canceller::check( canceller );
+	normals.resize( points.size(), V3f( 0 ) );
+
+	tbb::parallel_for(
+		tbb::blocked_range<size_t>( 0, std::min( normals.size(), topology->numVertices() ) ),
+		[&]( const tbb::blocked_range<size_t> &r )
 		{
-			if( i % 1000 )
+			Canceller::check( canceller );
+			for( size_t i = r.begin(); i != r.end(); ++i )
 			{
-				Canceller::check( canceller );
+				V3f normal( 0 );
+				for( const int *fv = vertexFaceVertices.begin( i ), *e = vertexFaceVertices.end( i ); fv != e; ++fv )
+				{
+					normal += faceNormals[faceVertexFaces[*fv]];
+				}
+				normal.normalize();
+				normals[i] = normal;
 			}
-
-			normals[i].normalize();
-		}
-	}
+		},
+		taskGroupContext
+	);
 
 	return PrimitiveVariable( interpolation, normalsData );
 }
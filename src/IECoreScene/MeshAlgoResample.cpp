@@ -32,14 +32,21 @@
 //
 //////////////////////////////////////////////////////////////////////////
 
-#include "IECoreScene/FaceVaryingPromotionOp.h"
 #include "IECoreScene/MeshAlgo.h"
+#include "IECoreScene/MeshTopology.h"
+#include "IECoreScene/private/MeshAlgoUtils.h"
 #include "IECoreScene/private/PrimitiveAlgoUtils.h"
 #include "IECoreScene/private/PrimitiveVariableAlgos.h"
 
 #include "IECore/DataAlgo.h"
 #include "IECore/DespatchTypedData.h"
 
+#include "tbb/blocked_range.h"
+#include "tbb/parallel_for.h"
+
+#include <algorithm>
+#include <vector>
+
 using namespace Imath;
 using namespace IECore;
 using namespace IECoreScene;
@@ -51,237 +58,189 @@ using namespace IECoreScene;
 namespace
 {
 
-struct MeshVertexToUniform
+// Base class for the resampling functors. Each functor computes every
+// output element independently, so the elements are computed in parallel.
+// When downsampling, the source data may be indexed, in which case it is
+// read through the indices rather than being expanded first.
+struct MeshResampler
 {
 	typedef DataPtr ReturnType;
 
-	MeshVertexToUniform( const MeshPrimitive *mesh, const Canceller *canceller )	:	m_mesh( mesh ), m_canceller( canceller )
+	MeshResampler( const MeshPrimitive *mesh, const MeshTopology *topology, const std::vector<int> *indices, const Canceller *canceller )
+		:	m_mesh( mesh ), m_topology( topology ), m_indices( indices ), m_canceller( canceller )
 	{
 	}
 
-	template<typename From> ReturnType operator()( const From* data )
-	{
-		typename From::Ptr result = static_cast< From* >( Object::create( data->typeId() ).get() );
-		typename From::ValueType &trg = result->writable();
-		const typename From::ValueType &src = data->readable();
-
-		// TODO sipmlify this code by using polygon face & vertex iterators
-		trg.reserve( m_mesh->numFaces() );
+	protected :
 
-		std::vector<int>::const_iterator vId = m_mesh->vertexIds()->readable().begin();
-		const std::vector<int> &verticesPerFace = m_mesh->verticesPerFace()->readable();
-		for( std::vector<int>::const_iterator it = verticesPerFace.begin(); it < verticesPerFace.end(); ++it )
+		template<typename From>
+		typename From::Ptr createResult( const From *data ) const
 		{
-			Canceller::check( m_canceller );
-
-			// initialize with the first value to avoid
-			// ambiguitity during default construction
-			typename From::ValueType::value_type total = src[ *vId ];
-			++vId;
-
-			for( int j = 1; j < *it; ++j, ++vId )
-			{
-				total += src[ *vId ];
-			}
+			typename From::Ptr result = static_cast< From* >( Object::create( data->typeId() ).get() );
+			IECoreScene::PrimitiveVariableAlgos::GeometricInterpretationCopier<From> copier;
+			copier( data, result.get() );
+			return result;
+		}
 
-			trg.push_back( total / *it );
+		template<typename From>
+		PrimitiveVariable::IndexedView<typename From::ValueType::value_type> source( const From *data ) const
+		{
+			return PrimitiveVariable::IndexedView<typename From::ValueType::value_type>( data->readable(), m_indices );
 		}
 
-		IECoreScene::PrimitiveVariableAlgos::GeometricInterpretationCopier<From> copier;
-		copier( data, result.get() );
+		// Averages `src[index( faceVertex )]` over the face-vertices of each face.
+		template<typename View, typename Container, typename IndexFn>
+		void averageToFaces( const View &src, IndexFn &&index, Container &trg ) const
+		{
+			const std::vector<int> &faceVertexOffsets = m_topology->faceVertexOffsets();
+			trg.resize( m_topology->numFaces() );
+
+			IECoreScene::Detail::parallelForEach(
+				trg.size(), m_canceller,
+				[&] ( size_t f ) {
+					const int begin = faceVertexOffsets[f];
+					const int end = faceVertexOffsets[f+1];
+
+					// initialize with the first value to avoid
+					// ambiguity during default construction
+					typename Container::value_type total = src[index( begin )];
+					for( int fv = begin + 1; fv < end; ++fv )
+					{
+						total += src[index( fv )];
+					}
+
+					trg[f] = total / ( end - begin );
+				}
+			);
+		}
 
-		return result;
-	}
+		// Averages `src[index( faceVertex )]` over the face-vertices of each
+		// vertex. Vertices gather from their face-vertices in ascending order,
+		// so the sums are the same as those made by a loop over the faces.
+		// Unused vertices, which have no face-vertices, are given zero values.
+		template<typename View, typename Container, typename IndexFn>
+		void averageToVertices( const View &src, IndexFn &&index, Container &trg ) const
+		{
+			const MeshTopology::Adjacency &vertexFaceVertices = m_topology->vertexFaceVertices();
+			const size_t numVertices = m_mesh->variableSize( PrimitiveVariable::Vertex );
+			const size_t numTopologyVertices = std::min( numVertices, m_topology->numVertices() );
+			trg.resize( numVertices, typename Container::value_type( 0.0f ) );
+
+			IECoreScene::Detail::parallelForEach(
+				numTopologyVertices, m_canceller,
+				[&] ( size_t v ) {
+					const int *fv = vertexFaceVertices.begin( v );
+					const int *e = vertexFaceVertices.end( v );
+					if( fv == e )
+					{
+						return;
+					}
+
+					typename Container::value_type total( 0.0f );
+					for( ; fv != e; ++fv )
+					{
+						total += src[index( *fv )];
+					}
+					total /= (int)vertexFaceVertices.size( v );
+					trg[v] = total;
+				}
+			);
+		}
 
-	const MeshPrimitive *m_mesh;
-	const Canceller *m_canceller;
+		const MeshPrimitive *m_mesh;
+		const MeshTopology *m_topology;
+		const std::vector<int> *m_indices;
+		const Canceller *m_canceller;
 };
 
-struct MeshUniformToVertex
+struct MeshVertexToUniform : public MeshResampler
 {
-	typedef DataPtr ReturnType;
-
-	MeshUniformToVertex( const MeshPrimitive *mesh, const Canceller *canceller )	:	m_mesh( mesh ), m_canceller( canceller )
-	{
-	}
+	using MeshResampler::MeshResampler;
 
 	template<typename From> ReturnType operator()( const From* data )
 	{
-		typename From::Ptr result = static_cast< From* >( Object::create( data->typeId() ).get() );
-		typename From::ValueType &trg = result->writable();
-		const typename From::ValueType &src = data->readable();
-
-		size_t numVerts = m_mesh->variableSize( PrimitiveVariable::Vertex );
-		std::vector<int> count( numVerts, 0 );
-		trg.resize( numVerts, typename From::ValueType::value_type( 0.0f ) );
-
-		typename From::ValueType::const_iterator srcIt = src.begin();
-		std::vector<int>::const_iterator vId = m_mesh->vertexIds()->readable().begin();
-		const std::vector<int> &verticesPerFace = m_mesh->verticesPerFace()->readable();
-		for( std::vector<int>::const_iterator it = verticesPerFace.begin(); it < verticesPerFace.end(); ++it, ++srcIt )
-		{
-			Canceller::check( m_canceller );
-
-			for( int j = 0; j < *it; ++j, ++vId )
-			{
-				trg[ *vId ] += *srcIt;
-				++count[ *vId ];
-			}
-		}
-
-		std::vector<int>::const_iterator cIt = count.begin();
-		typename From::ValueType::iterator trgIt = trg.begin(), trgEnd = trg.end();
-		for( trgIt = trg.begin(); trgIt != trgEnd ; ++trgIt, ++cIt )
-		{
-			*trgIt /= *cIt;
-		}
-
-		IECoreScene::PrimitiveVariableAlgos::GeometricInterpretationCopier<From> copier;
-		copier( data, result.get() );
-
+		typename From::Ptr result = createResult( data );
+		const std::vector<int> &vertexIds = m_mesh->vertexIds()->readable();
+		averageToFaces( source( data ), [&vertexIds] ( int fv ) { return vertexIds[fv]; }, result->writable() );
 		return result;
 	}
-
-	const MeshPrimitive *m_mesh;
-	const Canceller *m_canceller;
 };
 
-struct MeshFaceVaryingToVertex
+struct MeshFaceVaryingToUniform : public MeshResampler
 {
-	typedef DataPtr ReturnType;
-
-	MeshFaceVaryingToVertex( const MeshPrimitive *mesh, const Canceller *canceller )	:	m_mesh( mesh ), m_canceller( canceller )
-	{
-	}
+	using MeshResampler::MeshResampler;
 
 	template<typename From> ReturnType operator()( const From* data )
 	{
-		typename From::Ptr result = static_cast< From* >( Object::create( data->typeId() ).get() );
-		typename From::ValueType &trg = result->writable();
-		const typename From::ValueType &src = data->readable();
-
-		size_t numVerts = m_mesh->variableSize( PrimitiveVariable::Vertex );
-		std::vector<int> count( numVerts, 0 );
-		trg.resize( numVerts, typename From::ValueType::value_type( 0.0f ) );
-
-		const std::vector<int>& vertexIds = m_mesh->vertexIds()->readable();
-		std::vector<int>::const_iterator vertexIdIt = vertexIds.begin();
-		typename From::ValueType::const_iterator srcIt = src.begin(), srcEnd = src.end();
-
-		int cancelTestCounter = 0;
-		for( ; srcIt != srcEnd ; ++srcIt, ++vertexIdIt )
-		{
-			if( cancelTestCounter++ == 1000 )
-			{
-				Canceller::check( m_canceller );
-				cancelTestCounter = 0;
-			}
-			trg[ *vertexIdIt ] += *srcIt;
-			++count[ *vertexIdIt ];
-		}
-
-		std::vector<int>::const_iterator cIt = count.begin();
-		typename From::ValueType::iterator trgIt = trg.begin(), trgEnd = trg.end();
-		for( trgIt = trg.begin(); trgIt != trgEnd ; ++trgIt, ++cIt )
-		{
-			if( cancelTestCounter++ == 1000 )
-			{
-				Canceller::check( m_canceller );
-				cancelTestCounter = 0;
-			}
-			*trgIt /= *cIt;
-		}
-
-		IECoreScene::PrimitiveVariableAlgos::GeometricInterpretationCopier<From> copier;
-		copier( data, result.get() );
-
+		typename From::Ptr result = createResult( data );
+		averageToFaces( source( data ), [] ( int fv ) { return fv; }, result->writable() );
 		return result;
 	}
-
-	const MeshPrimitive *m_mesh;
-	const Canceller *m_canceller;
 };
 
-struct MeshFaceVaryingToUniform
+struct MeshUniformToVertex : public MeshResampler
 {
-	typedef DataPtr ReturnType;
+	using MeshResampler::MeshResampler;
 
-	MeshFaceVaryingToUniform( const MeshPrimitive *mesh, const Canceller *canceller )	:	m_mesh( mesh ), m_canceller( canceller )
+	template<typename From> ReturnType operator()( const From* data )
 	{
+		typename From::Ptr result = createResult( data );
+		const std::vector<int> &faceVertexFaces = m_topology->faceVertexFaces();
+		averageToVertices( source( data ), [&faceVertexFaces] ( int fv ) { return faceVertexFaces[fv]; }, result->writable() );
+		return result;
 	}
+};
+
+struct MeshFaceVaryingToVertex : public MeshResampler
+{
+	using MeshResampler::MeshResampler;
 
 	template<typename From> ReturnType operator()( const From* data )
 	{
-		typename From::Ptr result = static_cast< From* >( Object::create( data->typeId() ).get() );
-		typename From::ValueType &trg = result->writable();
-		const typename From::ValueType &src = data->readable();
-
-		trg.reserve( m_mesh->numFaces() );
-
-		typename From::ValueType::const_iterator srcIt = src.begin();
-
-		const std::vector<int> &verticesPerFace = m_mesh->verticesPerFace()->readable();
-		for( std::vector<int>::const_iterator it = verticesPerFace.begin(); it < verticesPerFace.end(); ++it )
-		{
-			Canceller::check( m_canceller );
-
-			// initialize with the first value to avoid
-			// ambiguity during default construction
-			typename From::ValueType::value_type total = *srcIt;
-			++srcIt;
-
-			for( int j = 1; j < *it; ++j, ++srcIt )
-			{
-				total += *srcIt;
-			}
-
-			trg.push_back( total / *it );
-		}
-
-		IECoreScene::PrimitiveVariableAlgos::GeometricInterpretationCopier<From> copier;
-		copier( data, result.get() );
-
+		typename From::Ptr result = createResult( data );
+		averageToVertices( source( data ), [] ( int fv ) { return fv; }, result->writable() );
 		return result;
 	}
-
-	const MeshPrimitive *m_mesh;
-	const Canceller *m_canceller;
 };
 
-struct MeshAnythingToFaceVarying
+struct MeshAnythingToFaceVarying : public MeshResampler
 {
-	typedef DataPtr ReturnType;
-
-	MeshAnythingToFaceVarying( const MeshPrimitive *mesh, PrimitiveVariable::Interpolation srcInterpolation, const Canceller *canceller )
-		: m_mesh( mesh ), m_srcInterpolation( srcInterpolation ), m_canceller( canceller )
+	MeshAnythingToFaceVarying( const MeshPrimitive *mesh, const MeshTopology *topology, PrimitiveVariable::Interpolation srcInterpolation, const Canceller *canceller )
+		:	MeshResampler( mesh, topology, nullptr, canceller ), m_srcInterpolation( srcInterpolation )
 	{
 	}
 
 	template<typename From> ReturnType operator()( const From* data )
 	{
+		typename From::Ptr result = createResult( data );
+		typename From::ValueType &trg = result->writable();
+		const typename From::ValueType &src = data->readable();
 
-		// TODO replace the call to the IECore::FaceVaryingPromotionOpPtr and include the logic in this file ( with cancellation ).
-
-		// we need to duplicate because the Op expects a primvar to manipulate..
-		MeshPrimitivePtr tmpMesh = m_mesh->copy();
-		// cast OK due to read-only access.
-		tmpMesh->variables["tmpPrimVar"] = PrimitiveVariable( m_srcInterpolation, const_cast< From * >(data) );
-		FaceVaryingPromotionOpPtr promoteOp = new FaceVaryingPromotionOp();
-		promoteOp->inputParameter()->setValue( tmpMesh );
-		IECore::StringVectorDataPtr names = new StringVectorData();
-		names->writable().push_back( "tmpPrimVar" );
-		promoteOp->primVarNamesParameter()->setValue( names );
-		ReturnType result = runTimeCast< MeshPrimitive >( promoteOp->operate() )->variables["tmpPrimVar"].data;
+		// Each face-vertex takes the value from its face or its vertex.
+		const std::vector<int> &faceVertexIndices = m_srcInterpolation == PrimitiveVariable::Uniform ? m_topology->faceVertexFaces() : m_mesh->vertexIds()->readable();
 
+		Canceller::check( m_canceller );
+		trg.resize( faceVertexIndices.size() );
+		IECoreScene::Detail::parallelForEach(
+			trg.size(), m_canceller,
+			[&] ( size_t fv ) {
+				trg[fv] = src[faceVertexIndices[fv]];
+			}
+		);
 
 		return result;
 	}
 
-	const MeshPrimitive *m_mesh;
-	PrimitiveVariable::Interpolation m_srcInterpolation;
-	const Canceller *m_canceller;
+	private :
+
+		PrimitiveVariable::Interpolation m_srcInterpolation;
 };
 
+bool isVertexLike( PrimitiveVariable::Interpolation interpolation )
+{
+	return interpolation == PrimitiveVariable::Vertex || interpolation == PrimitiveVariable::Varying;
+}
+
 } // namespace
 
 void IECoreScene::MeshAlgo::resamplePrimitiveVariable( const MeshPrimitive *mesh, PrimitiveVariable& primitiveVariable, PrimitiveVariable::Interpolation interpolation, const Canceller *canceller )
@@ -294,6 +253,7 @@ void IECoreScene::MeshAlgo::resamplePrimitiveVariable( const MeshPrimitive *mesh
 
 	DataPtr dstData = nullptr;
 	DataPtr srcData = nullptr;
+	const std::vector<int> *srcIndices = nullptr;
 
 	if( primitiveVariable.indices )
 	{
@@ -302,15 +262,22 @@ void IECoreScene::MeshAlgo::resamplePrimitiveVariable( const MeshPrimitive *mesh
 			// upsampling can be a resampling of indices
 			srcData = primitiveVariable.indices;
 		}
-		else
+		else if( interpolation == PrimitiveVariable::Constant || ( isVertexLike( srcInterpolation ) && isVertexLike( interpolation ) ) )
 		{
-			// downsampling forces index expansion to
-			// simplify the algorithms.
+			// downsampling to a single value, or between the equivalent
+			// Vertex and Varying interpolations, expands the indices.
 			// \todo: allow indices to be maintained.
 			Canceller::check( canceller );
 			srcData = primitiveVariable.expandedData();
 			primitiveVariable.indices = nullptr;
 		}
+		else
+		{
+			// other downsampling reads the data through the indices,
+			// producing unindexed results.
+			srcData = primitiveVariable.data;
+			srcIndices = &primitiveVariable.indices->readable();
+		}
 	}
 	else
 	{
@@ -338,43 +305,45 @@ void IECoreScene::MeshAlgo::resamplePrimitiveVariable( const MeshPrimitive *mesh
 		return;
 	}
 
+	ConstMeshTopologyPtr topology = MeshTopology::get( mesh, canceller );
+
 	if( interpolation == PrimitiveVariable::Uniform )
 	{
-		if( srcInterpolation == PrimitiveVariable::Varying || srcInterpolation == PrimitiveVariable::Vertex )
+		if( isVertexLike( srcInterpolation ) )
 		{
-			MeshVertexToUniform fn( mesh, canceller );
+			MeshVertexToUniform fn( mesh, topology.get(), srcIndices, canceller );
 			dstData = despatchTypedData<MeshVertexToUniform, Detail::IsArithmeticVectorTypedData>( srcData.get(), fn );
 		}
 		else if( srcInterpolation == PrimitiveVariable::FaceVarying )
 		{
-			MeshFaceVaryingToUniform fn( mesh, canceller );
+			MeshFaceVaryingToUniform fn( mesh, topology.get(), srcIndices, canceller );
 			dstData = despatchTypedData<MeshFaceVaryingToUniform, Detail::IsArithmeticVectorTypedData>( srcData.get(), fn );
 		}
 	}
-	else if( interpolation == PrimitiveVariable::Varying || interpolation == PrimitiveVariable::Vertex )
+	else if( isVertexLike( interpolation ) )
 	{
 		if( srcInterpolation == PrimitiveVariable::Uniform )
 		{
-			MeshUniformToVertex fn( mesh, canceller );
+			MeshUniformToVertex fn( mesh, topology.get(), srcIndices, canceller );
 			dstData = despatchTypedData<MeshUniformToVertex, Detail::IsArithmeticVectorTypedData>( srcData.get(), fn );
 		}
 		else if( srcInterpolation == PrimitiveVariable::FaceVarying )
 		{
-			MeshFaceVaryingToVertex fn( mesh, canceller );
+			MeshFaceVaryingToVertex fn( mesh, topology.get(), srcIndices, canceller );
 			dstData = despatchTypedData<MeshFaceVaryingToVertex, Detail::IsArithmeticVectorTypedData>( srcData.get(), fn );
 		}
-		else if( srcInterpolation == PrimitiveVariable::Varying || srcInterpolation == PrimitiveVariable::Vertex )
+		else if( isVertexLike( srcInterpolation ) )
 		{
 			dstData = srcData;
 		}
 	}
 	else if( interpolation == PrimitiveVariable::FaceVarying )
 	{
-		MeshAnythingToFaceVarying fn( mesh, srcInterpolation, canceller );
+		MeshAnythingToFaceVarying fn( mesh, topology.get(), srcInterpolation, canceller );
 		dstData = despatchTypedData<MeshAnythingToFaceVarying, Detail::IsArithmeticVectorTypedData>( srcData.get(), fn );
 	}
 
-	if( primitiveVariable.indices )
+	if( primitiveVariable.indices && !srcIndices )
 	{
 		primitiveVariable = PrimitiveVariable( interpolation, primitiveVariable.data, runTimeCast<IntVectorData>( dstData ) );
 	}
@@ -383,3 +352,29 @@ void IECoreScene::MeshAlgo::resamplePrimitiveVariable( const MeshPrimitive *mesh
 		primitiveVariable = PrimitiveVariable( interpolation, dstData );
 	}
 }
+
+void IECoreScene::MeshAlgo::resamplePrimitiveVariables( const MeshPrimitive *mesh, PrimitiveVariableMap &primitiveVariables, PrimitiveVariable::Interpolation interpolation, const Canceller *canceller )
+{
+	// Variables are independent of one another, so are resampled in
+	// parallel. Fetching the topology first means it is computed once
+	// up front, rather than by whichever variable gets to it first.
+
+	if( interpolation != PrimitiveVariable::Constant )
+	{
+		MeshTopology::get( mesh, canceller );
+	}
+
+	std::vector<PrimitiveVariable *> variables;
+	variables.reserve( primitiveVariables.size() );
+	for( auto &v : primitiveVariables )
+	{
+		variables.push_back( &v.second );
+	}
+
+	Detail::parallelForEach(
+		variables.size(), canceller,
+		[&] ( size_t i ) {
+			resamplePrimitiveVariable( mesh, *variables[i], interpolation, canceller );
+		}
+	);
+}
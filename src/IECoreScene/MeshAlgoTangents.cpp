@@ -33,8 +33,16 @@
 //////////////////////////////////////////////////////////////////////////
 
 #include "IECoreScene/MeshAlgo.h"
+#include "IECoreScene/MeshTopology.h"
+#include "IECoreScene/private/MeshAlgoUtils.h"
+
 #include "IECore/DataAlgo.h"
 
+#include "tbb/blocked_range.h"
+#include "tbb/parallel_for.h"
+
+#include <algorithm>
+
 using namespace Imath;
 using namespace IECore;
 using namespace IECoreScene;
@@ -134,13 +142,23 @@ std::pair<PrimitiveVariable, PrimitiveVariable> IECoreScene::MeshAlgo::calculate
 		if( uvIt->second.indices )
 		{
 			Canceller::check( canceller );
-			tmpIndices.reserve( mesh->vertexIds()->readable().size() );
-
-			Canceller::check( canceller );
-			for( auto vertexId : mesh->vertexIds()->readable() )
-			{
-				tmpIndices.push_back( uvIt->second.indices->readable()[vertexId] );
-			}
+			tmpIndices.resize( mesh->vertexIds()->readable().size() );
+
+			const std::vector<int> &vertexIds = mesh->vertexIds()->readable();
+			const std::vector<int> &indices = uvIt->second.indices->readable();
+			tbb::task_group_context taskGroupContext( tbb::task_group_context::isolated );
+			tbb::parallel_for(
+				tbb::blocked_range<size_t>( 0, tmpIndices.size() ),
+				[&]( const tbb::blocked_range<size_t> &r )
+				{
+					Canceller::check( canceller );
+					for( size_t i = r.begin(); i != r.end(); ++i )
+					{
+						tmpIndices[i] = indices[vertexIds[i]];
+					}
+				},
+				taskGroupContext
+			);
 
 			uvIndices = &tmpIndices;
 		}
@@ -164,102 +182,117 @@ std::pair<PrimitiveVariable, PrimitiveVariable> IECoreScene::MeshAlgo::calculate
 
 	size_t numUVs = IECore::size( uvIt->second.data.get() );
 
-	Canceller::check( canceller );
-	std::vector<V3f> uTangents( numUVs, V3f( 0 ) );
-	Canceller::check( canceller );
-	std::vector<V3f> vTangents( numUVs, V3f( 0 ) );
-	Canceller::check( canceller );
-	std::vector<V3f> normals( numUVs, V3f( 0 ) );
-
-	size_t vertStart = 0;
-	for( size_t faceIndex = 0; faceIndex < vertsPerFace.size(); faceIndex++ )
-	{
-		if( ( faceIndex % 1000 ) == 0 )
-		{
-			Canceller::check( canceller );
-		}
-
-		for ( size_t faceVertIndex = 0; faceVertIndex < (size_t)vertsPerFace[faceIndex]; ++faceVertIndex)
-		{
-			// indices into the facevarying data for this *triangle*
-			size_t fvi0 = vertStart + faceVertIndex;
-			size_t fvi1 = vertStart + (faceVertIndex + 1) % vertsPerFace[faceIndex];
-			size_t fvi2 = vertStart + (faceVertIndex + 2) % vertsPerFace[faceIndex];
-
-			assert( fvi0 < vertIds.size() );
-			assert( fvi0 < uvIndexedView.size() );
-
-			assert( fvi1 < vertIds.size() );
-			assert( fvi1 < uvIndexedView.size() );
-
-			assert( fvi2 < vertIds.size() );
-			assert( fvi2 < uvIndexedView.size() );
-
-			// positions for each vertex of this face
-			const V3f &p0 = points[vertIds[fvi0]];
-			const V3f &p1 = points[vertIds[fvi1]];
-			const V3f &p2 = points[vertIds[fvi2]];
-
-			// uv coordinates for each vertex of this face
-			const V2f &uv0 = uvIndexedView[fvi0];
-			const V2f &uv1 = uvIndexedView[fvi1];
-			const V2f &uv2 = uvIndexedView[fvi2];
+	// Each face-vertex contributes the basis of the triangle formed with
+	// the next two vertices of its face to the tangents for its UV. Rather
+	// than scatter from the face-vertices, each UV gathers from its own
+	// face-vertices in parallel, in the same order as a serial loop over
+	// the faces would, so the sums are identical.
 
-			Basis basis;
-			calculcateBasis( p0, p1, p2, uv0, uv1, uv2, basis );
+	ConstMeshTopologyPtr topology = MeshTopology::get( mesh, canceller );
+	const std::vector<int> &faceVertexOffsets = topology->faceVertexOffsets();
+	const std::vector<int> &faceVertexFaces = topology->faceVertexFaces();
+	const MeshTopology::Adjacency uvFaceVertices = Detail::groupFaceVertices(
+		vertIds.size(), numUVs, [&uvIndexedView]( size_t faceVertex ) { return uvIndexedView.index( faceVertex ); }, canceller
+	);
 
-			// and accumulate them into the computation so far
-			uTangents[uvIndexedView.index(fvi0)] += basis.tangent;
-			vTangents[uvIndexedView.index(fvi0)] += basis.bitangent;
-			normals[uvIndexedView.index(fvi0)] += basis.normal;
-		}
-
-		vertStart += vertsPerFace[faceIndex];
-	}
+	Canceller::check( canceller );
+	std::vector<V3f> uTangents( numUVs );
+	Canceller::check( canceller );
+	std::vector<V3f> vTangents( numUVs );
 
-	// normalize and orthogonalize everything
-	for( size_t i = 0; i < uTangents.size(); i++ )
-	{
-		if( ( i % 1000 ) == 0 )
+	tbb::task_group_context taskGroupContext( tbb::task_group_context::isolated );
+	tbb::parallel_for(
+		tbb::blocked_range<size_t>( 0, numUVs ),
+		[&]( const tbb::blocked_range<size_t> &r )
 		{
 			Canceller::check( canceller );
-		}
-
-		normals[i].normalize();
-
-		uTangents[i].normalize();
-		vTangents[i].normalize();
-
-		// Make uTangent/vTangent orthogonal to normal
-		uTangents[i] -= normals[i] * uTangents[i].dot( normals[i] );
-		vTangents[i] -= normals[i] * vTangents[i].dot( normals[i] );
-
-		uTangents[i].normalize();
-		vTangents[i].normalize();
-
-		if( orthoTangents )
-		{
-			vTangents[i] -= uTangents[i] * vTangents[i].dot( uTangents[i] );
-			vTangents[i].normalize();
-		}
-
-		// Ensure we have set of basis vectors (n, uT, vT) with the correct handedness.
-		if ( !leftHanded )
-		{
-			if( uTangents[i].cross( vTangents[i] ).dot( normals[i] ) < 0.0f )
-			{
-				uTangents[i] *= -1.0f;
-			}
-		}
-		else
-		{
-			if( uTangents[i].cross( vTangents[i] ).dot( normals[i] ) > 0.0f )
+			for( size_t i = r.begin(); i != r.end(); ++i )
 			{
-				uTangents[i] *= -1.0f;
+				V3f uTangent( 0 );
+				V3f vTangent( 0 );
+				V3f normal( 0 );
+
+				for( const int *fv = uvFaceVertices.begin( i ), *e = uvFaceVertices.end( i ); fv != e; ++fv )
+				{
+					const size_t fvi0 = *fv;
+					const int faceIndex = faceVertexFaces[fvi0];
+					const size_t vertStart = faceVertexOffsets[faceIndex];
+					const size_t faceVertIndex = fvi0 - vertStart;
+
+					// indices into the facevarying data for this *triangle*
+					const size_t fvi1 = vertStart + (faceVertIndex + 1) % vertsPerFace[faceIndex];
+					const size_t fvi2 = vertStart + (faceVertIndex + 2) % vertsPerFace[faceIndex];
+
+					assert( fvi0 < vertIds.size() );
+					assert( fvi0 < uvIndexedView.size() );
+
+					assert( fvi1 < vertIds.size() );
+					assert( fvi1 < uvIndexedView.size() );
+
+					assert( fvi2 < vertIds.size() );
+					assert( fvi2 < uvIndexedView.size() );
+
+					// positions for each vertex of this face
+					const V3f &p0 = points[vertIds[fvi0]];
+					const V3f &p1 = points[vertIds[fvi1]];
+					const V3f &p2 = points[vertIds[fvi2]];
+
+					// uv coordinates for each vertex of this face
+					const V2f &uv0 = uvIndexedView[fvi0];
+					const V2f &uv1 = uvIndexedView[fvi1];
+					const V2f &uv2 = uvIndexedView[fvi2];
+
+					Basis basis;
+					calculcateBasis( p0, p1, p2, uv0, uv1, uv2, basis );
+
+					// and accumulate them into the computation so far
+					uTangent += basis.tangent;
+					vTangent += basis.bitangent;
+					normal += basis.normal;
+				}
+
+				// normalize and orthogonalize everything
+
+				normal.normalize();
+
+				uTangent.normalize();
+				vTangent.normalize();
+
+				// Make uTangent/vTangent orthogonal to normal
+				uTangent -= normal * uTangent.dot( normal );
+				vTangent -= normal * vTangent.dot( normal );
+
+				uTangent.normalize();
+				vTangent.normalize();
+
+				if( orthoTangents )
+				{
+					vTangent -= uTangent * vTangent.dot( uTangent );
+					vTangent.normalize();
+				}
+
+				// Ensure we have set of basis vectors (n, uT, vT) with the correct handedness.
+				if ( !leftHanded )
+				{
+					if( uTangent.cross( vTangent ).dot( normal ) < 0.0f )
+					{
+						uTangent *= -1.0f;
+					}
+				}
+				else
+				{
+					if( uTangent.cross( vTangent ).dot( normal ) > 0.0f )
+					{
+						uTangent *= -1.0f;
+					}
+				}
+
+				uTangents[i] = uTangent;
+				vTangents[i] = vTangent;
 			}
-		}
-
-	}
+		},
+		taskGroupContext
+	);
 
 	// convert the tangents back to facevarying data and add that to the mesh
 	V3fVectorDataPtr fvUD = new V3fVectorData( uTangents );
@@ -323,54 +356,67 @@ std::pair<PrimitiveVariable, PrimitiveVariable> IECoreScene::MeshAlgo::calculate
 	const IntVectorData *vertIdsData = mesh->vertexIds();
 	const IntVectorData::ValueType &vertIds = vertIdsData->readable();
 
+	// calculate centroids
+	// TODO: generalize this to MeshAlgo::calculateCentroid
+	ConstMeshTopologyPtr topology = MeshTopology::get( mesh, canceller );
+	const std::vector<int> &faceVertexOffsets = topology->faceVertexOffsets();
+
 	Canceller::check( canceller );
 	std::vector<V3f> centroids( vertsPerFace.size(), V3f( 0 ) );
-	Canceller::check( canceller );
-	std::vector<int> faceIdPerVert( numPoints, -1 );
 
-	// calculate centroids
-	// TODO: generalize this to MeshAlgo::calculateCentroid
-	size_t vertStart = 0;
-	for( size_t faceIndex = 0; faceIndex < vertsPerFace.size(); ++faceIndex )
-	{
-		if( ( faceIndex % 1000 ) == 0 )
+	tbb::task_group_context taskGroupContext( tbb::task_group_context::isolated );
+	tbb::parallel_for(
+		tbb::blocked_range<size_t>( 0, vertsPerFace.size() ),
+		[&]( const tbb::blocked_range<size_t> &r )
 		{
 			Canceller::check( canceller );
-		}
-
-		for ( size_t faceVertIndex = 0; faceVertIndex < (size_t)vertsPerFace[faceIndex]; ++faceVertIndex)
-		{
-			size_t fvi0 = vertStart + faceVertIndex;
-			centroids[faceIndex] += points[vertIds[fvi0]];
-			faceIdPerVert[vertIds[fvi0]] = faceIndex;
-		}
-		centroids[faceIndex] /= vertsPerFace[faceIndex];
+			for( size_t faceIndex = r.begin(); faceIndex != r.end(); ++faceIndex )
+			{
+				for( int fvi0 = faceVertexOffsets[faceIndex]; fvi0 < faceVertexOffsets[faceIndex+1]; ++fvi0 )
+				{
+					centroids[faceIndex] += points[vertIds[fvi0]];
+				}
+				centroids[faceIndex] /= vertsPerFace[faceIndex];
+			}
+		},
+		taskGroupContext
+	);
 
-		vertStart += vertsPerFace[faceIndex];
-	}
+	// Each vertex uses the centroid of the last face it belongs to.
+	// Points not used by any face are given zero tangents.
+	const std::vector<int> &faceVertexFaces = topology->faceVertexFaces();
+	const MeshTopology::Adjacency &vertexFaceVertices = topology->vertexFaceVertices();
 
 	// calculate per vertex tangents from centroids
-	for ( size_t i = 0; i < (size_t)points.size(); ++i )
-	{
-		if( ( i % 1000 ) == 0 )
+	tbb::parallel_for(
+		tbb::blocked_range<size_t>( 0, std::min( points.size(), topology->numVertices() ) ),
+		[&]( const tbb::blocked_range<size_t> &r )
 		{
 			Canceller::check( canceller );
-		}
-
-		tangents[i] = ( centroids[faceIdPerVert[i]] - points[i] ).normalized();
-		biTangents[i] = normals[i].cross( tangents[i] ).normalized();
-		if ( orthoTangents )
-		{
-			if ( leftHanded )
+			for( size_t i = r.begin(); i != r.end(); ++i )
 			{
-				tangents[i] = normals[i].cross( biTangents[i] ).normalized();
+				if( !vertexFaceVertices.size( i ) )
+				{
+					continue;
+				}
+				const int faceId = faceVertexFaces[*(vertexFaceVertices.end( i ) - 1)];
+				tangents[i] = ( centroids[faceId] - points[i] ).normalized();
+				biTangents[i] = normals[i].cross( tangents[i] ).normalized();
+				if ( orthoTangents )
+				{
+					if ( leftHanded )
+					{
+						tangents[i] = normals[i].cross( biTangents[i] ).normalized();
+					}
+					else
+					{
+						tangents[i] = biTangents[i].cross( normals[i] ).normalized();
+					}
+				}
 			}
-			else
-			{
-				tangents[i] = biTangents[i].cross( normals[i] ).normalized();
-			}
-		}
-	}
+		},
+		taskGroupContext
+	);
 
 	// construct the primvars
 	Canceller::check( canceller );
@@ -434,29 +480,33 @@ std::pair<PrimitiveVariable, PrimitiveVariable> IECoreScene::MeshAlgo::calculate
 	auto &offsetsR = offsets->readable();
 
 	// calculate tangents from first neighbor and biTangents as orthogonal vectors
-	for ( unsigned int i = 0; i < points.size(); ++i )
-	{
-		if( ( i % 1000 ) == 0 )
+	tbb::task_group_context taskGroupContext( tbb::task_group_context::isolated );
+	tbb::parallel_for(
+		tbb::blocked_range<size_t>( 0, points.size() ),
+		[&]( const tbb::blocked_range<size_t> &r )
 		{
 			Canceller::check( canceller );
-		}
-
-		int firstNeighborIndex = i > 0 ? offsetsR[i - 1] : 0;
-		const V3f &firstNeighbor = points[neighborListR[firstNeighborIndex]];
-		tangents[i] = ( firstNeighbor - points[i] ).normalized();
-		biTangents[i] = normals[i].cross( tangents[i] ).normalized();
-		if ( orthoTangents )
-		{
-			if ( leftHanded )
+			for( size_t i = r.begin(); i != r.end(); ++i )
 			{
-				tangents[i] = normals[i].cross( biTangents[i] ).normalized();
+				int firstNeighborIndex = i > 0 ? offsetsR[i - 1] : 0;
+				const V3f &firstNeighbor = points[neighborListR[firstNeighborIndex]];
+				tangents[i] = ( firstNeighbor - points[i] ).normalized();
+				biTangents[i] = normals[i].cross( tangents[i] ).normalized();
+				if ( orthoTangents )
+				{
+					if ( leftHanded )
+					{
+						tangents[i] = normals[i].cross( biTangents[i] ).normalized();
+					}
+					else
+					{
+						tangents[i] = biTangents[i].cross( normals[i] ).normalized();
+					}
+				}
 			}
-			else
-			{
-				tangents[i] = biTangents[i].cross( normals[i] ).normalized();
-			}
-		}
-	}
+		},
+		taskGroupContext
+	);
 
 	// construct the primvars
 	Canceller::check( canceller );
@@ -520,32 +570,36 @@ std::pair<PrimitiveVariable, PrimitiveVariable> IECoreScene::MeshAlgo::calculate
 	auto &offsetsR = offsets->readable();
 
 	// calculate tangents from first neighbor and biTangents as orthogonal vectors
-	for ( unsigned int i = 0; i < points.size(); ++i )
-	{
-		if( ( i % 1000 ) == 0 )
+	tbb::task_group_context taskGroupContext( tbb::task_group_context::isolated );
+	tbb::parallel_for(
+		tbb::blocked_range<size_t>( 0, points.size() ),
+		[&]( const tbb::blocked_range<size_t> &r )
 		{
 			Canceller::check( canceller );
-		}
-
-		int firstNeighborIndex = i > 0 ? offsetsR[i - 1] : 0;
-		int lastIndex =  offsetsR[i] > firstNeighborIndex ? firstNeighborIndex + 1 : firstNeighborIndex;  // if we only have one neighbor use the edge, else the next neighbor
-
-		const V3f &firstNeighbor = points[neighborListR[firstNeighborIndex]];
-		const V3f &secondNeighbor = points[neighborListR[lastIndex]];
-		tangents[i] = ( ( firstNeighbor + (secondNeighbor - firstNeighbor ) * 0.5 ) - points[i] ).normalized();
-		biTangents[i] = normals[i].cross( tangents[i] ).normalized();
-		if ( orthoTangents )
-		{
-			if ( leftHanded )
-			{
-				tangents[i] = normals[i].cross( biTangents[i] ).normalized();
-			}
-			else
+			for( size_t i = r.begin(); i != r.end(); ++i )
 			{
-				tangents[i] = biTangents[i].cross( normals[i] ).normalized();
+				int firstNeighborIndex = i > 0 ? offsetsR[i - 1] : 0;
+				int lastIndex =  offsetsR[i] > firstNeighborIndex ? firstNeighborIndex + 1 : firstNeighborIndex;  // if we only have one neighbor use the edge, else the next neighbor
+
+				const V3f &firstNeighbor = points[neighborListR[firstNeighborIndex]];
+				const V3f &secondNeighbor = points[neighborListR[lastIndex]];
+				tangents[i] = ( ( firstNeighbor + (secondNeighbor - firstNeighbor ) * 0.5 ) - points[i] ).normalized();
+				biTangents[i] = normals[i].cross( tangents[i] ).normalized();
+				if ( orthoTangents )
+				{
+					if ( leftHanded )
+					{
+						tangents[i] = normals[i].cross( biTangents[i] ).normalized();
+					}
+					else
+					{
+						tangents[i] = biTangents[i].cross( normals[i] ).normalized();
+					}
+				}
 			}
-		}
-	}
+		},
+		taskGroupContext
+	);
 
 	// construct the primvars
 	Canceller::check( canceller );
@@ -49,6 +49,10 @@ IECORE_POP_DEFAULT_VISIBILITY
 #include "OpenEXR/ImathBoxAlgo.h"
 #include "OpenEXR/ImathLineAlgo.h"
 
+#include "tbb/blocked_range.h"
+#include "tbb/parallel_for.h"
+
+#include <algorithm>
 #include <cassert>
 
 using namespace IECore;
@@ -211,7 +215,7 @@ const V3i &MeshPrimitiveEvaluator::Result::vertexIds() const
 	return m_vertexIds;
 }
 
-MeshPrimitiveEvaluator::MeshPrimitiveEvaluator( ConstMeshPrimitivePtr mesh ) : m_uvTree(nullptr), m_haveMassProperties( false ), m_haveSurfaceArea( false ), m_haveAverageNormals( false )
+MeshPrimitiveEvaluator::MeshPrimitiveEvaluator( ConstMeshPrimitivePtr mesh ) : m_tree( nullptr ), m_uvTree( nullptr ), m_haveTrees( false ), m_haveMassProperties( false ), m_haveSurfaceArea( false ), m_haveAverageNormals( false )
 {
 	if (! mesh )
 	{
@@ -225,7 +229,6 @@ MeshPrimitiveEvaluator::MeshPrimitiveEvaluator( ConstMeshPrimitivePtr mesh ) : m
 
 	m_mesh = mesh->copy();
 
-
 	PrimitiveVariableMap::const_iterator primVarIt = m_mesh->variables.find("P");
 	if ( primVarIt == m_mesh->variables.end() )
 	{
@@ -249,61 +252,84 @@ MeshPrimitiveEvaluator::MeshPrimitiveEvaluator( ConstMeshPrimitivePtr mesh ) : m
 	}
 
 	const std::vector<int> &verticesPerFace = m_mesh->verticesPerFace()->readable();
-	m_triangles.reserve( verticesPerFace.size() );
-	m_uvTriangles.reserve( verticesPerFace.size() );
-	unsigned int triangleIdx = 0;
-	IntVectorData::ValueType::const_iterator vertexIdIt = m_meshVertexIds->begin();
-	for ( IntVectorData::ValueType::const_iterator it = verticesPerFace.begin();
-		it != verticesPerFace.end(); ++it, ++triangleIdx)
+	if( std::find_if( verticesPerFace.begin(), verticesPerFace.end(), []( int n ) { return n != 3; } ) != verticesPerFace.end() )
 	{
+		throw InvalidArgumentException( "Non-triangular mesh given to MeshPrimitiveEvaluator");
+	}
 
-		if (*it != 3 )
-		{
-			throw InvalidArgumentException( "Non-triangular mesh given to MeshPrimitiveEvaluator");
-		}
-
-		Imath::V3i triangleVertexIds;
+	// The triangle bounds and trees are built on demand by `buildTrees()`,
+	// as many clients only use queries which don't need them.
+}
 
-		triangleVertexIds[0] = *vertexIdIt++;
-		assert( triangleVertexIds[0] < (int)( m_verts->readable().size() ) );
-		triangleVertexIds[1] = *vertexIdIt++;
-		assert( triangleVertexIds[1] < (int)( m_verts->readable().size() ) );
-		triangleVertexIds[2] = *vertexIdIt++;
-		assert( triangleVertexIds[2] < (int)( m_verts->readable().size() ) );
+void MeshPrimitiveEvaluator::buildTrees() const
+{
+	if( m_haveTrees )
+	{
+		return;
+	}
 
-		const V3f &p0 = m_verts->readable()[ triangleVertexIds[0] ];
-		const V3f &p1 = m_verts->readable()[ triangleVertexIds[1] ];
-		const V3f &p2 = m_verts->readable()[ triangleVertexIds[2] ];
+	std::lock_guard<TreeMutex> lock( m_treeMutex );
+	if( m_haveTrees )
+	{
+		// another thread may have built the trees while we waited for the mutex
+		return;
+	}
 
-		Box3f bound( p0 );
-		bound.extendBy( p1 );
-		bound.extendBy( p2 );
+	const size_t numTriangles = m_mesh->numFaces();
+	const bool haveUVs = m_uv.interpolation != PrimitiveVariable::Invalid;
 
-		m_triangles.push_back( bound );
+	m_triangles.resize( numTriangles );
+	if( haveUVs )
+	{
+		m_uvTriangles.resize( numTriangles );
+	}
 
-		if( m_uv.interpolation != PrimitiveVariable::Invalid )
+	const std::vector<V3f> &verts = m_verts->readable();
+	tbb::task_group_context taskGroupContext( tbb::task_group_context::isolated );
+	tbb::parallel_for(
+		tbb::blocked_range<size_t>( 0, numTriangles ),
+		[this, &verts, haveUVs]( const tbb::blocked_range<size_t> &r )
 		{
-			Imath::V2f uv[3];
-			triangleUVs( triangleIdx, triangleVertexIds, uv );
-
-			Box2f uvBound( uv[0] );
-			uvBound.extendBy( uv[1] );
-			uvBound.extendBy( uv[2] );
+			for( size_t triangleIdx = r.begin(); triangleIdx != r.end(); ++triangleIdx )
+			{
+				const size_t vertIdOffset = triangleIdx * 3;
+				const Imath::V3i triangleVertexIds(
+					(*m_meshVertexIds)[vertIdOffset],
+					(*m_meshVertexIds)[vertIdOffset+1],
+					(*m_meshVertexIds)[vertIdOffset+2]
+				);
+				assert( triangleVertexIds[0] < (int)verts.size() );
+				assert( triangleVertexIds[1] < (int)verts.size() );
+				assert( triangleVertexIds[2] < (int)verts.size() );
+
+				Box3f &bound = m_triangles[triangleIdx];
+				bound = Box3f( verts[triangleVertexIds[0]] );
+				bound.extendBy( verts[triangleVertexIds[1]] );
+				bound.extendBy( verts[triangleVertexIds[2]] );
+
+				if( haveUVs )
+				{
+					Imath::V2f uv[3];
+					triangleUVs( triangleIdx, triangleVertexIds, uv );
 
-			m_uvTriangles.push_back( uvBound );
-		}
-	}
+					Box2f &uvBound = m_uvTriangles[triangleIdx];
+					uvBound = Box2f( uv[0] );
+					uvBound.extendBy( uv[1] );
+					uvBound.extendBy( uv[2] );
+				}
+			}
+		},
+		taskGroupContext
+	);
 
 	m_tree = new TriangleBoundTree( m_triangles.begin(), m_triangles.end() );
 
-	if( m_uv.interpolation != PrimitiveVariable::Invalid )
+	if( haveUVs )
 	{
 		m_uvTree = new UVBoundTree( m_uvTriangles.begin(), m_uvTriangles.end() );
 	}
-	else
-	{
-		m_uvTree = nullptr;
-	}
+
+	m_haveTrees = true;
 }
 
 PrimitiveEvaluatorPtr MeshPrimitiveEvaluator::create( ConstPrimitivePtr primitive )
@@ -316,8 +342,6 @@ PrimitiveEvaluatorPtr MeshPrimitiveEvaluator::create( ConstPrimitivePtr primitiv
 
 MeshPrimitiveEvaluator::~MeshPrimitiveEvaluator()
 {
-	assert( m_tree );
-
 	delete m_tree;
 	m_tree = nullptr;
 
@@ -759,6 +783,7 @@ bool MeshPrimitiveEvaluator::closestPoint( const V3f &p, PrimitiveEvaluator::Res
 {
 	assert( dynamic_cast<Result *>( result ) );
 
+	buildTrees();
 	if ( m_triangles.size() == 0)
 	{
 		return false;
@@ -779,6 +804,7 @@ bool MeshPrimitiveEvaluator::pointAtUV( const Imath::V2f &uv, PrimitiveEvaluator
 {
 	assert( dynamic_cast<Result *>( result ) );
 
+	buildTrees();
 	if ( ! m_uvTriangles.size() )
 	{
 		throw Exception("No uvs available for pointAtUV");
@@ -795,6 +821,7 @@ bool MeshPrimitiveEvaluator::intersectionPoint( const Imath::V3f &origin, const
 {
 	assert( dynamic_cast<Result *>( result ) );
 
+	buildTrees();
 	if ( m_triangles.size() == 0)
 	{
 		return false;
@@ -821,6 +848,7 @@ int MeshPrimitiveEvaluator::intersectionPoints( const Imath::V3f &origin, const
 {
 	results.clear();
 
+	buildTrees();
 	if ( m_triangles.size() == 0)
 	{
 		return 0;
@@ -841,7 +869,7 @@ int MeshPrimitiveEvaluator::intersectionPoints( const Imath::V3f &origin, const
 
 bool MeshPrimitiveEvaluator::barycentricPosition( unsigned int triangleIndex, const Imath::V3f &barycentricCoordinates, PrimitiveEvaluator::Result *result ) const
 {
-	if( triangleIndex >= m_triangles.size() )
+	if( triangleIndex >= m_mesh->numFaces() )
 	{
 		return false;
 	}
@@ -1272,6 +1300,7 @@ void MeshPrimitiveEvaluator::intersectionPointsWalk( TriangleBoundTree::NodeInde
 
 const Imath::Box2f MeshPrimitiveEvaluator::uvBound() const
 {
+	buildTrees();
 	if( !m_uvTree )
 	{
 		return Imath::Box2f();
@@ -1281,21 +1310,25 @@ const Imath::Box2f MeshPrimitiveEvaluator::uvBound() const
 
 const MeshPrimitiveEvaluator::TriangleBoundVector *MeshPrimitiveEvaluator::triangleBounds() const
 {
+	buildTrees();
 	return &m_triangles;
 }
 
 const MeshPrimitiveEvaluator::TriangleBoundTree *MeshPrimitiveEvaluator::triangleBoundTree() const
 {
+	buildTrees();
 	return m_tree;
 }
 
 const MeshPrimitiveEvaluator::UVBoundVector *MeshPrimitiveEvaluator::uvBounds() const
 {
+	buildTrees();
 	return m_uvTree ? &m_uvTriangles : nullptr;
 }
 
 const MeshPrimitiveEvaluator::UVBoundTree *MeshPrimitiveEvaluator::uvBoundTree() const
 {
+	buildTrees();
 	return m_uvTree;
 }
 
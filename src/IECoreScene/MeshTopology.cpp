@@ -0,0 +1,444 @@
+//////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (c) 2026, Image Engine Design Inc. All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//
+//     * Neither the name of Image Engine Design nor the names of any
+//       other contributors to this software may be used to endorse or
+//       promote products derived from this software without specific prior
+//       written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+//  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+//  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+//  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+//  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+//  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+//  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+//  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+//  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+//  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//////////////////////////////////////////////////////////////////////////
+
+
+#include "IECoreScene/MeshTopology.h"
+
+#include "IECoreScene/private/MeshAlgoUtils.h"
+
+#include "IECore/LRUCache.h"
+#include "IECore/MurmurHash.h"
+
+#include "boost/lexical_cast.hpp"
+
+#include "tbb/task_arena.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <mutex>
+#include <numeric>
+
+using namespace std;
+using namespace Imath;
+using namespace IECore;
+using namespace IECoreScene;
+
+//////////////////////////////////////////////////////////////////////////
+// Internal utilities
+//////////////////////////////////////////////////////////////////////////
+
+namespace
+{
+
+// Removes the gaps from an Adjacency whose values for item `i` were
+// written starting at `offsets[i]`, but only `counts[i]` of them were
+// kept.
+void compact( MeshTopology::Adjacency &adjacency, const vector<int> &counts, const Canceller *canceller )
+{
+	vector<int> offsets( counts.size() + 1 );
+	offsets[0] = 0;
+	std::partial_sum( counts.begin(), counts.end(), offsets.begin() + 1 );
+
+	vector<int> values( offsets.back() );
+	IECoreScene::Detail::parallelForEach(
+		counts.size(), canceller,
+		[&] ( size_t i ) {
+			std::copy( adjacency.begin( i ), adjacency.begin( i ) + counts[i], values.begin() + offsets[i] );
+		}
+	);
+
+	adjacency.offsets.swap( offsets );
+	adjacency.values.swap( values );
+}
+
+// Computes `value` on first call, serialising concurrent callers. Members
+// are computed in isolation so that a thread can't steal a task which
+// waits on the member it is itself computing. If computation is cancelled,
+// it will be attempted again by the next caller.
+template<typename T, typename F>
+const T &lazyMember( std::once_flag &flag, T &value, F &&f )
+{
+	std::call_once(
+		flag,
+		[&] {
+			tbb::this_task_arena::isolate( [&] { f( value ); } );
+		}
+	);
+	return value;
+}
+
+} // namespace
+
+//////////////////////////////////////////////////////////////////////////
+// MemberData
+//////////////////////////////////////////////////////////////////////////
+
+class MeshTopology::MemberData
+{
+
+	public :
+
+		MemberData( const MeshPrimitive *mesh, const Canceller *canceller )
+			:	vertexIds( mesh->vertexIds() ), numVertices( mesh->variableSize( PrimitiveVariable::Vertex ) )
+		{
+			const vector<int> &verticesPerFace = mesh->verticesPerFace()->readable();
+			Canceller::check( canceller );
+			faceVertexOffsets.resize( verticesPerFace.size() + 1 );
+			faceVertexOffsets[0] = 0;
+			std::partial_sum( verticesPerFace.begin(), verticesPerFace.end(), faceVertexOffsets.begin() + 1 );
+
+			faceVertexFaces.resize( faceVertexOffsets.back() );
+			Detail::parallelForEach(
+				verticesPerFace.size(), canceller,
+				[this] ( size_t f ) {
+					std::fill( faceVertexFaces.begin() + faceVertexOffsets[f], faceVertexFaces.begin() + faceVertexOffsets[f+1], (int)f );
+				}
+			);
+
+			const vector<int> &ids = vertexIds->readable();
+			vertexFaceVertices = Detail::groupFaceVertices( ids.size(), numVertices, [&ids] ( size_t fv ) { return ids[fv]; }, canceller );
+		}
+
+		int nextFaceVertex( int faceVertex ) const
+		{
+			const int next = faceVertex + 1;
+			const int face = faceVertexFaces[faceVertex];
+			return next == faceVertexOffsets[face+1] ? faceVertexOffsets[face] : next;
+		}
+
+		int previousFaceVertex( int faceVertex ) const
+		{
+			const int face = faceVertexFaces[faceVertex];
+			return faceVertex == faceVertexOffsets[face] ? faceVertexOffsets[face+1] - 1 : faceVertex - 1;
+		}
+
+		void computeVertexFaces( Adjacency &result, const Canceller *canceller ) const
+		{
+			// Faces for each vertex are already in ascending order, because
+			// the face-vertices are, so we only need to remove duplicates.
+			result.offsets = vertexFaceVertices.offsets;
+			result.values.resize( vertexFaceVertices.values.size() );
+			vector<int> counts( numVertices );
+			Detail::parallelForEach(
+				numVertices, canceller,
+				[&] ( size_t v ) {
+					int *out = result.values.data() + result.offsets[v];
+					std::transform(
+						vertexFaceVertices.begin( v ), vertexFaceVertices.end( v ), out,
+						[this] ( int fv ) { return faceVertexFaces[fv]; }
+					);
+					counts[v] = std::unique( out, out + vertexFaceVertices.size( v ) ) - out;
+				}
+			);
+			compact( result, counts, canceller );
+		}
+
+		void computeVertexNeighbours( Adjacency &result, const Canceller *canceller ) const
+		{
+			// Each face-vertex contributes the vertices either side of it
+			// in its face.
+			const vector<int> &ids = vertexIds->readable();
+			result.offsets.resize( numVertices + 1 );
+			std::transform( vertexFaceVertices.offsets.begin(), vertexFaceVertices.offsets.end(), result.offsets.begin(), [] ( int o ) { return o * 2; } );
+			result.values.resize( vertexFaceVertices.values.size() * 2 );
+			vector<int> counts( numVertices );
+			Detail::parallelForEach(
+				numVertices, canceller,
+				[&] ( size_t v ) {
+					int *begin = result.values.data() + result.offsets[v];
+					int *out = begin;
+					for( const int *fv = vertexFaceVertices.begin( v ), *e = vertexFaceVertices.end( v ); fv != e; ++fv )
+					{
+						*out++ = ids[previousFaceVertex( *fv )];
+						*out++ = ids[nextFaceVertex( *fv )];
+					}
+					std::sort( begin, out );
+					counts[v] = std::unique( begin, out ) - begin;
+				}
+			);
+			compact( result, counts, canceller );
+		}
+
+		void computeEdges( std::vector<Imath::V2i> &result, std::vector<int> &faceVertexEdges, const Adjacency &neighbours, const Canceller *canceller ) const
+		{
+			// Each edge is owned by its lowest vertex, and is stored in the
+			// order that its highest vertex appears in the owner's neighbours.
+
+			vector<int> edgeOffsets( numVertices + 1 );
+			edgeOffsets[0] = 0;
+			Canceller::check( canceller );
+			for( size_t v = 0; v < numVertices; ++v )
+			{
+				edgeOffsets[v+1] = edgeOffsets[v] + ( neighbours.end( v ) - std::lower_bound( neighbours.begin( v ), neighbours.end( v ), (int)v ) );
+			}
+
+			result.resize( edgeOffsets.back() );
+			Detail::parallelForEach(
+				numVertices, canceller,
+				[&] ( size_t v ) {
+					const int *first = std::lower_bound( neighbours.begin( v ), neighbours.end( v ), (int)v );
+					V2i *out = result.data() + edgeOffsets[v];
+					for( const int *n = first, *e = neighbours.end( v ); n != e; ++n )
+					{
+						*out++ = V2i( (int)v, *n );
+					}
+				}
+			);
+
+			const vector<int> &ids = vertexIds->readable();
+			faceVertexEdges.resize( ids.size() );
+			Detail::parallelForEach(
+				ids.size(), canceller,
+				[&] ( size_t fv ) {
+					const int a = ids[fv];
+					const int b = ids[nextFaceVertex( fv )];
+					const int lo = std::min( a, b );
+					const int hi = std::max( a, b );
+					const int *first = std::lower_bound( neighbours.begin( lo ), neighbours.end( lo ), lo );
+					faceVertexEdges[fv] = edgeOffsets[lo] + ( std::lower_bound( first, neighbours.end( lo ), hi ) - first );
+				}
+			);
+		}
+
+		ConstIntVectorDataPtr vertexIds;
+		size_t numVertices;
+
+		vector<int> faceVertexOffsets;
+		vector<int> faceVertexFaces;
+		Adjacency vertexFaceVertices;
+
+		std::once_flag vertexFacesFlag;
+		Adjacency vertexFaces;
+		std::once_flag vertexNeighboursFlag;
+		Adjacency vertexNeighbours;
+		std::once_flag edgesFlag;
+		vector<V2i> edges;
+		vector<int> faceVertexEdges;
+
+};
+
+//////////////////////////////////////////////////////////////////////////
+// Cache
+//////////////////////////////////////////////////////////////////////////
+
+namespace
+{
+
+// Converts implicitly to the hash used as the cache key, and carries the
+// mesh and canceller needed to compute the topology.
+struct CacheKey
+{
+
+	CacheKey( const MeshPrimitive *mesh, const Canceller *canceller )
+		:	mesh( mesh ), canceller( canceller )
+	{
+		// Primitive variables and interpolation don't affect the topology,
+		// so we deliberately avoid `MeshPrimitive::topologyHash()`. The
+		// number of vertices usually follows from the ids, but may be
+		// larger if the mesh has unused vertices.
+		mesh->verticesPerFace()->hash( hash );
+		mesh->vertexIds()->hash( hash );
+		hash.append( (uint64_t)mesh->variableSize( PrimitiveVariable::Vertex ) );
+	}
+
+	operator const MurmurHash & () const
+	{
+		return hash;
+	}
+
+	const MeshPrimitive *mesh;
+	const Canceller *canceller;
+	MurmurHash hash;
+
+};
+
+ConstMeshTopologyPtr cacheGetter( const CacheKey &key, size_t &cost )
+{
+	ConstMeshTopologyPtr result = new MeshTopology( key.mesh, key.canceller );
+	cost = result->memoryUsage();
+	return result;
+}
+
+typedef LRUCache<MurmurHash, ConstMeshTopologyPtr, LRUCachePolicy::TaskParallel, CacheKey> Cache;
+
+Cache &cache()
+{
+	// Deliberately leaked, to avoid destruction order problems at exit.
+	static Cache *c = [] () {
+		const char *m = getenv( "IECORE_MESHTOPOLOGY_MEMORY" );
+		size_t mi = m ? boost::lexical_cast<size_t>( m ) : 500;
+		Cache *result = new Cache( cacheGetter, 1024 * 1024 * mi );
+		result->statistics().setName( "MeshTopology" );
+		return result;
+	} ();
+	return *c;
+}
+
+} // namespace
+
+//////////////////////////////////////////////////////////////////////////
+// MeshTopology
+//////////////////////////////////////////////////////////////////////////
+
+MeshTopology::MeshTopology( const MeshPrimitive *mesh, const Canceller *canceller )
+	:	m_data( new MemberData( mesh, canceller ) )
+{
+}
+
+MeshTopology::~MeshTopology()
+{
+}
+
+ConstMeshTopologyPtr MeshTopology::get( const MeshPrimitive *mesh, const Canceller *canceller )
+{
+	const CacheKey key( mesh, canceller );
+	while( true )
+	{
+		try
+		{
+			return cache().get( key );
+		}
+		catch( const Cancelled & )
+		{
+			// The cache stores exceptions as well as results, but a
+			// cancellation doesn't mean the computation will fail for
+			// other callers. Remove it, and rethrow only if it was our
+			// own canceller that was triggered.
+			cache().erase( key );
+			Canceller::check( canceller );
+		}
+	}
+}
+
+size_t MeshTopology::numFaces() const
+{
+	return m_data->faceVertexOffsets.size() - 1;
+}
+
+size_t MeshTopology::numVertices() const
+{
+	return m_data->numVertices;
+}
+
+size_t MeshTopology::numFaceVertices() const
+{
+	return m_data->faceVertexOffsets.back();
+}
+
+const std::vector<int> &MeshTopology::faceVertexOffsets() const
+{
+	return m_data->faceVertexOffsets;
+}
+
+const std::vector<int> &MeshTopology::faceVertexFaces() const
+{
+	return m_data->faceVertexFaces;
+}
+
+int MeshTopology::nextFaceVertex( int faceVertex ) const
+{
+	return m_data->nextFaceVertex( faceVertex );
+}
+
+const MeshTopology::Adjacency &MeshTopology::vertexFaceVertices() const
+{
+	return m_data->vertexFaceVertices;
+}
+
+const MeshTopology::Adjacency &MeshTopology::vertexFaces( const IECore::Canceller *canceller ) const
+{
+	return lazyMember(
+		m_data->vertexFacesFlag, m_data->vertexFaces,
+		[this, canceller] ( Adjacency &value ) { m_data->computeVertexFaces( value, canceller ); }
+	);
+}
+
+const MeshTopology::Adjacency &MeshTopology::vertexNeighbours( const IECore::Canceller *canceller ) const
+{
+	return lazyMember(
+		m_data->vertexNeighboursFlag, m_data->vertexNeighbours,
+		[this, canceller] ( Adjacency &value ) { m_data->computeVertexNeighbours( value, canceller ); }
+	);
+}
+
+const std::vector<Imath::V2i> &MeshTopology::edges( const IECore::Canceller *canceller ) const
+{
+	const Adjacency &neighbours = vertexNeighbours( canceller );
+	return lazyMember(
+		m_data->edgesFlag, m_data->edges,
+		[this, &neighbours, canceller] ( vector<V2i> &value ) { m_data->computeEdges( value, m_data->faceVertexEdges, neighbours, canceller ); }
+	);
+}
+
+const std::vector<int> &MeshTopology::faceVertexEdges( const IECore::Canceller *canceller ) const
+{
+	edges( canceller );
+	return m_data->faceVertexEdges;
+}
+
+size_t MeshTopology::memoryUsage() const
+{
+	// Lazy members are accounted for at their maximum possible size, so that
+	// the cost reported to the cache remains valid after they are computed.
+	const size_t numFaceVertices = this->numFaceVertices();
+	const size_t numVertices = this->numVertices();
+	const size_t numInts =
+		( numFaces() + 1 ) + numFaceVertices + // faceVertexOffsets, faceVertexFaces
+		( numVertices + 1 ) + numFaceVertices + // vertexFaceVertices
+		( numVertices + 1 ) + numFaceVertices + // vertexFaces
+		( numVertices + 1 ) + numFaceVertices * 2 + // vertexNeighbours
+		numFaceVertices * 2 + numFaceVertices // edges, faceVertexEdges
+	;
+	return sizeof( MeshTopology ) + sizeof( MemberData ) + numInts * sizeof( int );
+}
+
+void MeshTopology::setMaxCacheMemoryUsage( size_t maxMemory )
+{
+	cache().setMaxCost( maxMemory );
+}
+
+size_t MeshTopology::getMaxCacheMemoryUsage()
+{
+	return cache().getMaxCost();
+}
+
+size_t MeshTopology::cacheMemoryUsage()
+{
+	return cache().currentCost();
+}
+
+void MeshTopology::clearCache()
+{
+	cache().clear();
+}
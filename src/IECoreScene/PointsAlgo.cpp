@@ -45,6 +45,10 @@
 
 #include "boost/format.hpp"
 
+#include "tbb/blocked_range.h"
+#include "tbb/parallel_for.h"
+
+#include <algorithm>
 #include <numeric>
 
 using namespace IECore;
@@ -153,58 +157,70 @@ PointsPrimitivePtr deletePoints( const PointsPrimitive *pointsPrimitive, IECoreS
 	return outPointsPrimitive;
 }
 
-struct CollectDataFn
+struct MergePrimVarFn
 {
-	CollectDataFn( size_t size ) : offset( 0 ), m_size( size )
+	typedef DataPtr ReturnType;
+
+	MergePrimVarFn( const std::vector<PrimitiveVariable> &sources, const std::vector<size_t> &offsets, const Canceller *canceller )
+		:	m_sources( sources ), m_offsets( offsets ), m_canceller( canceller )
 	{
 	}
 
-	typedef void ReturnType;
-
 	template<typename T>
 	ReturnType operator()( const T *data )
 	{
-		T *container = nullptr;
-		if( !outputData )
+		typename T::Ptr result = new T();
+		auto &resultValues = result->writable();
+		resultValues.resize( m_offsets.back() );
+
+		auto f = [this, &resultValues]( const tbb::blocked_range<size_t> &r )
 		{
-			container = new T();
-			outputData = container;
+			for( size_t i = r.begin(); i != r.end(); ++i )
+			{
+				Canceller::check( m_canceller );
+				const PrimitiveVariable &source = m_sources[i];
+				if( !source.data )
+				{
+					continue;
+				}
 
-			container->writable().resize( m_size );
+				const auto &sourceValues = static_cast<const T *>( source.data.get() )->readable();
+				auto it = resultValues.begin() + m_offsets[i];
+				if( source.indices )
+				{
+					for( auto index : source.indices->readable() )
+					{
+						*it++ = sourceValues[index];
+					}
+				}
+				else
+				{
+					std::copy( sourceValues.begin(), sourceValues.end(), it );
+				}
+			}
+		};
+
+		// Neighbouring elements of `std::vector<bool>` share storage,
+		// so can't be written concurrently.
+		if( !std::is_same<typename T::ValueType::value_type, bool>::value )
+		{
+			tbb::task_group_context taskGroupContext( tbb::task_group_context::isolated );
+			tbb::parallel_for( tbb::blocked_range<size_t>( 0, m_sources.size() ), f, taskGroupContext );
 		}
 		else
 		{
-			container = runTimeCast<T>( outputData.get() );
+			f( tbb::blocked_range<size_t>( 0, m_sources.size() ) );
 		}
 
-		std::copy( data->readable().begin(), data->readable().end(), container->writable().begin() + offset );
+		return result;
 	}
 
-	DataPtr outputData;
-	size_t offset;
-	size_t m_size;
-};
-
-DataPtr mergePrimVars( const std::vector<PointsPrimitivePtr> &pointsPrimitives, const std::string &primVarName, size_t totalCount, const Canceller *canceller )
-{
-	CollectDataFn fn( totalCount );
-
-	for( size_t i = 0; i < pointsPrimitives.size(); ++i )
-	{
-		Canceller::check( canceller );
-		PrimitiveVariableMap::const_iterator it = pointsPrimitives[i]->variables.find( primVarName );
+	private :
 
-		if( it != pointsPrimitives[i]->variables.end() )
-		{
-			PrimitiveVariable primVar = it->second;
-			despatchTypedData<CollectDataFn, TypeTraits::IsVectorTypedData>( const_cast< Data * >( primVar.data.get() ), fn );
-		}
-
-		fn.offset += pointsPrimitives[i]->getNumPoints();
-	}
-
-	return fn.outputData;
-}
+		const std::vector<PrimitiveVariable> &m_sources;
+		const std::vector<size_t> &m_offsets;
+		const Canceller *m_canceller;
+};
 
 } // anonymous namespace
 
@@ -332,24 +348,29 @@ PointsPrimitivePtr deletePoints( const PointsPrimitive *pointsPrimitive, const P
 
 PointsPrimitivePtr mergePoints( const std::vector<const PointsPrimitive *> &pointsPrimitives, const Canceller *canceller /* = nullptr */ )
 {
-	size_t totalPointCount = 0;
 	typedef std::map<std::string, IECore::TypeId> FoundPrimvars;
 	FoundPrimvars foundPrimvars;
 
 	PrimitiveVariableMap constantPrimVars;
 
-	std::vector<PointsPrimitivePtr> validatedPointsPrimitives( pointsPrimitives.size() );
+	// The vertex primvars to merge from each points primitive, indexed by
+	// primvar name and then by primitive. Missing primvars have null data.
+	std::map<std::string, std::vector<PrimitiveVariable>> vertexPrimVars;
+
+	// The offset of each points primitive in the merged primitive, followed
+	// by the total number of points.
+	std::vector<size_t> offsets( pointsPrimitives.size() + 1, 0 );
 
 	// find out which primvars can be merged
 	for( size_t i = 0; i < pointsPrimitives.size(); ++i )
 	{
-		PointsPrimitivePtr pointsPrimitive = validatedPointsPrimitives[i] = pointsPrimitives[i]->copy();
+		const PointsPrimitive *pointsPrimitive = pointsPrimitives[i];
 
-		totalPointCount += pointsPrimitive->getNumPoints();
-		PrimitiveVariableMap &variables = pointsPrimitive->variables;
-		for( PrimitiveVariableMap::iterator it = variables.begin(); it != variables.end(); ++it )
+		offsets[i+1] = offsets[i] + pointsPrimitive->getNumPoints();
+		const PrimitiveVariableMap &variables = pointsPrimitive->variables;
+		for( PrimitiveVariableMap::const_iterator it = variables.begin(); it != variables.end(); ++it )
 		{
-			DataPtr data = it->second.data;
+			ConstDataPtr data = it->second.data;
 			const IECore::TypeId typeId = data->typeId();
 			PrimitiveVariable::Interpolation interpolation = it->second.interpolation;
 			const std::string &name = it->first;
@@ -368,7 +389,7 @@ PointsPrimitivePtr mergePoints( const std::vector<const PointsPrimitive *> &poin
 
 				if( !bExistingConstant )
 				{
-					constantPrimVars[name] = it->second;
+					constantPrimVars[name] = PrimitiveVariable( it->second, /* deepCopy = */ true );
 				}
 				continue;
 			}
@@ -383,6 +404,10 @@ PointsPrimitivePtr mergePoints( const std::vector<const PointsPrimitive *> &poin
 					throw InvalidArgumentException( msg );
 				}
 
+				std::vector<PrimitiveVariable> &sources = vertexPrimVars[name];
+				sources.resize( pointsPrimitives.size() );
+				sources[i] = it->second;
+
 				if( !bExistingVertex )
 				{
 					foundPrimvars[name] = typeId;
@@ -394,12 +419,12 @@ PointsPrimitivePtr mergePoints( const std::vector<const PointsPrimitive *> &poin
 						Canceller::check( canceller );
 						DataCastOpPtr castOp = new DataCastOp();
 
-						castOp->objectParameter()->setValue( data );
+						castOp->objectParameter()->setValue( boost::const_pointer_cast<Data>( data ) );
 						castOp->targetTypeParameter()->setNumericValue( fIt->second );
 
 						try
 						{
-							it->second.data = runTimeCast<Data>( castOp->operate() );
+							sources[i].data = runTimeCast<Data>( castOp->operate() );
 						}
 						catch( const IECore::Exception &e )
 						{
@@ -413,7 +438,7 @@ PointsPrimitivePtr mergePoints( const std::vector<const PointsPrimitive *> &poin
 	}
 
 	// allocate the new points primitive and copy the primvars
-	PointsPrimitivePtr newPoints = new PointsPrimitive( totalPointCount );
+	PointsPrimitivePtr newPoints = new PointsPrimitive( offsets.back() );
 
 	// copy constant primvars
 	for( PrimitiveVariableMap::const_iterator it = constantPrimVars.begin(); it != constantPrimVars.end(); ++it )
@@ -421,11 +446,35 @@ PointsPrimitivePtr mergePoints( const std::vector<const PointsPrimitive *> &poin
 		newPoints->variables[it->first] = it->second;
 	}
 
-	// merge vertex primvars
-	for( FoundPrimvars::const_iterator it = foundPrimvars.begin(); it != foundPrimvars.end(); ++it )
+	// merge vertex primvars, with each one allocated once and filled
+	// in parallel.
+	std::vector<std::pair<const std::string *, const std::vector<PrimitiveVariable> *>> toMerge;
+	for( const auto &v : vertexPrimVars )
+	{
+		toMerge.push_back( { &v.first, &v.second } );
+	}
+	std::vector<DataPtr> mergedData( toMerge.size() );
+
+	tbb::task_group_context taskGroupContext( tbb::task_group_context::isolated );
+	tbb::parallel_for(
+		tbb::blocked_range<size_t>( 0, toMerge.size() ),
+		[&toMerge, &mergedData, &offsets, canceller]( const tbb::blocked_range<size_t> &r )
+		{
+			for( size_t i = r.begin(); i != r.end(); ++i )
+			{
+				Canceller::check( canceller );
+				const std::vector<PrimitiveVariable> &sources = *toMerge[i].second;
+				const Data *firstData = std::find_if( sources.begin(), sources.end(), []( const PrimitiveVariable &p ) { return p.data; } )->data.get();
+				MergePrimVarFn fn( sources, offsets, canceller );
+				mergedData[i] = despatchTypedData<MergePrimVarFn, TypeTraits::IsVectorTypedData>( const_cast<Data *>( firstData ), fn );
+			}
+		},
+		taskGroupContext
+	);
+
+	for( size_t i = 0; i < toMerge.size(); ++i )
 	{
-		DataPtr mergedData = mergePrimVars( validatedPointsPrimitives, it->first, totalPointCount, canceller );
-		newPoints->variables[it->first] = PrimitiveVariable( PrimitiveVariable::Vertex, mergedData );
+		newPoints->variables[*toMerge[i].first] = PrimitiveVariable( PrimitiveVariable::Vertex, mergedData[i] );
 	}
 
 	return newPoints;
@@ -157,7 +157,7 @@ half PointsPrimitiveEvaluator::Result::halfPrimVar( const PrimitiveVariable &pv
 PointsPrimitiveEvaluator::PointsPrimitiveEvaluator( ConstPointsPrimitivePtr points )
 	:	m_pointsPrimitive( points->copy() ), m_haveTree( false )
 {
-	PrimitiveVariableMap::iterator pIt = m_pointsPrimitive->variables.find( "P" );
+	PrimitiveVariableMap::const_iterator pIt = m_pointsPrimitive->variables.find( "P" );
 	if( pIt==m_pointsPrimitive->variables.end() )
 	{
 		throw InvalidArgumentException( "No PrimitiveVariable named P on PointsPrimitive." );
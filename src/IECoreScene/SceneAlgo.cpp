@@ -39,9 +39,14 @@
 #include "IECoreScene/PointsPrimitive.h"
 #include "IECoreScene/SceneInterface.h"
 
+#include "tbb/pipeline.h"
 #include "tbb/task.h"
+#include "tbb/task_arena.h"
+#include "tbb/tick_count.h"
 
 #include <atomic>
+#include <memory>
+#include <vector>
 
 using namespace IECore;
 using namespace IECoreScene;
@@ -125,7 +130,21 @@ struct CopyInfo
 	T setCount;
 };
 
-CopyInfo<size_t> handleLocation( const SceneInterface *src, SceneInterface *dst, double time, unsigned int flags )
+/// The data read from a single location, ready to be written to the destination.
+struct LocationData
+{
+	typedef std::vector<std::pair<SceneInterface::Name, ConstObjectPtr>> Attributes;
+	typedef std::vector<std::pair<SceneInterface::Name, PathMatcher>> Sets;
+
+	Imath::Box3d bound;
+	ConstDataPtr transform;
+	Attributes attributes;
+	SceneInterface::NameList tags;
+	Sets sets;
+	ConstObjectPtr object;
+};
+
+CopyInfo<size_t> readLocation( const SceneInterface *src, double time, unsigned int flags, LocationData &data )
 {
 	SceneInterface::Path path;
 	src->path( path );
@@ -134,20 +153,12 @@ CopyInfo<size_t> handleLocation( const SceneInterface *src, SceneInterface *dst,
 
 	if( flags & SceneAlgo::Bounds )
 	{
-		auto bound = src->readBound( time );
-		if( dst )
-		{
-			dst->writeBound( bound, time );
-		}
+		data.bound = src->readBound( time );
 	}
 
-	if( flags & SceneAlgo::Transforms )
+	if( flags & SceneAlgo::Transforms && !isRoot )
 	{
-		IECore::ConstDataPtr transform = src->readTransform( time );
-		if( dst && !isRoot )
-		{
-			dst->writeTransform( transform.get(), time );
-		}
+		data.transform = src->readTransform( time );
 	}
 
 	if( flags & SceneAlgo::Attributes )
@@ -156,80 +167,114 @@ CopyInfo<size_t> handleLocation( const SceneInterface *src, SceneInterface *dst,
 		src->attributeNames( attributeNames );
 
 		copyInfo.attributeCount += attributeNames.size();
+		data.attributes.reserve( attributeNames.size() );
 		for( const auto &attributeName : attributeNames )
 		{
-			IECore::ConstObjectPtr attr = src->readAttribute( attributeName, time );
-			if( dst )
-			{
-				dst->writeAttribute( attributeName, attr.get(), time );
-			}
+			data.attributes.emplace_back( attributeName, src->readAttribute( attributeName, time ) );
 		}
 	}
 
 	if( flags & SceneAlgo::Tags )
 	{
-		SceneInterface::NameList tags;
-		src->readTags( tags );
-		copyInfo.tagCount += tags.size();
-		if( dst )
-		{
-			dst->writeTags( tags );
-		}
+		src->readTags( data.tags );
+		copyInfo.tagCount += data.tags.size();
 	}
 
 	if( flags & SceneAlgo::Sets && isRoot )
 	{
 		SceneInterface::NameList setNames = src->setNames();
 		copyInfo.setCount += setNames.size();
+		data.sets.reserve( setNames.size() );
 		for( const auto &setName : setNames )
 		{
-			PathMatcher set = src->readSet( setName );
-			if( dst )
-			{
-				dst->writeSet( setName, set );
-			}
+			data.sets.emplace_back( setName, src->readSet( setName ) );
 		}
 	}
 
 	if( flags & SceneAlgo::Objects && src->hasObject() )
 	{
-		IECore::ConstObjectPtr obj = src->readObject( time );
+		data.object = src->readObject( time );
 
-		if( IECoreScene::MeshPrimitive::ConstPtr mesh = IECore::runTimeCast<const IECoreScene::MeshPrimitive>( obj ) )
+		if( const IECoreScene::MeshPrimitive *mesh = IECore::runTimeCast<const IECoreScene::MeshPrimitive>( data.object.get() ) )
 		{
 			copyInfo.polygonCount += mesh->numFaces();
 		}
-		else if( IECoreScene::CurvesPrimitive::ConstPtr curves = IECore::runTimeCast<const IECoreScene::CurvesPrimitive>( obj ) )
+		else if( const IECoreScene::CurvesPrimitive *curves = IECore::runTimeCast<const IECoreScene::CurvesPrimitive>( data.object.get() ) )
 		{
 			copyInfo.curveCount += curves->numCurves();
 		}
-		else if( IECoreScene::PointsPrimitive::ConstPtr points = IECore::runTimeCast<const IECoreScene::PointsPrimitive>( obj ) )
+		else if( const IECoreScene::PointsPrimitive *points = IECore::runTimeCast<const IECoreScene::PointsPrimitive>( data.object.get() ) )
 		{
 			copyInfo.pointCount += points->getNumPoints();
 		}
-		if( dst )
-		{
-			dst->writeObject( obj.get(), time );
-		}
 	}
 
 	return copyInfo;
-
 }
 
-template<typename LocationFn>
-void copy( const SceneInterface *src, SceneInterface *dst, double time, unsigned int flags, LocationFn &locationFn )
+void writeLocation( const LocationData &data, SceneInterface *dst, double time, unsigned int flags )
 {
-	locationFn( src, dst, time, flags );
+	if( flags & SceneAlgo::Bounds )
+	{
+		dst->writeBound( data.bound, time );
+	}
 
-	SceneInterface::NameList childNames;
-	src->childNames( childNames );
+	if( data.transform )
+	{
+		dst->writeTransform( data.transform.get(), time );
+	}
+
+	for( const auto &attribute : data.attributes )
+	{
+		dst->writeAttribute( attribute.first, attribute.second.get(), time );
+	}
 
-	for( const auto &childName : childNames )
+	if( flags & SceneAlgo::Tags )
 	{
-		SceneInterfacePtr dstChild = dst->child( childName, SceneInterface::CreateIfMissing );
-		::copy( src->child( childName ).get(), dstChild.get(), time, flags, locationFn );
+		dst->writeTags( data.tags );
 	}
+
+	for( const auto &set : data.sets )
+	{
+		dst->writeSet( set.first, set.second );
+	}
+
+	if( data.object )
+	{
+		dst->writeObject( data.object.get(), time );
+	}
+}
+
+/// A location passing through the copy pipeline.
+struct Location
+{
+	Location( ConstSceneInterfacePtr src, size_t depth ) : src( src ), depth( depth )
+	{
+	}
+
+	ConstSceneInterfacePtr src;
+	/// Depth in the hierarchy, used to find the parent
+	/// of the location when writing.
+	size_t depth;
+	LocationData data;
+};
+
+typedef std::shared_ptr<Location> LocationPtr;
+
+/// A location waiting to be visited by the copy traversal. The source
+/// location is only created from its parent when it is visited, so we
+/// don't hold a SceneInterface for every pending sibling.
+struct PendingLocation
+{
+	/// Null for the root.
+	ConstSceneInterfacePtr parent;
+	SceneInterface::Name name;
+	size_t depth;
+};
+
+size_t microseconds( const tbb::tick_count &start )
+{
+	return (size_t)( ( tbb::tick_count::now() - start ).seconds() * 1e6 );
 }
 
 } // namespace
@@ -248,10 +293,12 @@ SceneStats parallelReadAll( const SceneInterface *src, int startFrame, int endFr
 	auto locationFn = [&locationCount, &copyInfos]( const SceneInterface *src, SceneInterface *dst, double time, unsigned int flags )
 	{
 		locationCount++;
-		::CopyInfo<size_t> copyInfo = ::handleLocation( src, nullptr, time, flags );
+		::LocationData data;
+		::CopyInfo<size_t> copyInfo = ::readLocation( src, time, flags, data );
 
 		copyInfos.polygonCount += copyInfo.polygonCount;
 		copyInfos.tagCount += copyInfo.tagCount;
+		copyInfos.setCount += copyInfo.setCount;
 		copyInfos.attributeCount += copyInfo.attributeCount;
 		copyInfos.curveCount += copyInfo.curveCount;
 		copyInfos.pointCount += copyInfo.pointCount;
@@ -278,6 +325,22 @@ SceneStats parallelReadAll( const SceneInterface *src, int startFrame, int endFr
 
 void copy( const SceneInterface *src, SceneInterface *dst, int startFrame, int endFrame, float frameRate, unsigned int flags )
 {
+	copyWithStats( src, dst, startFrame, endFrame, frameRate, flags );
+}
+
+SceneStats copyWithStats( const SceneInterface *src, SceneInterface *dst, int startFrame, int endFrame, float frameRate, unsigned int flags )
+{
+	const tbb::tick_count copyStart = tbb::tick_count::now();
+
+	size_t locationCount = 0;
+	::CopyInfo<std::atomic<size_t> > copyInfos;
+	size_t traversalTime = 0;
+	std::atomic<size_t> readTime( 0 );
+	size_t writeTime = 0;
+
+	// Limits the number of locations held in memory at once.
+	const size_t maxLocations = 4 * tbb::this_task_arena::max_concurrency();
+
 	for( int f = startFrame; f <= endFrame; ++f )
 	{
 		double time = f / frameRate;
@@ -287,8 +350,111 @@ void copy( const SceneInterface *src, SceneInterface *dst, int startFrame, int e
 			flags &= ~Tags;
 		}
 
-		::copy( src, dst, time, flags, ::handleLocation );
+		// Depth first traversal of the source, so parents are visited before their children
+		std::vector<::PendingLocation> toVisit = { { nullptr, SceneInterface::Name(), 0 } };
+		// The destination locations for the current branch of the traversal, indexed by depth
+		std::vector<SceneInterfacePtr> dstLocations;
+
+		tbb::task_group_context taskGroupContext( tbb::task_group_context::isolated );
+		tbb::parallel_pipeline(
+			maxLocations,
+
+			// Traverse the source serially, in a deterministic order.
+			tbb::make_filter<void, ::LocationPtr>(
+				tbb::filter::serial_in_order,
+				[&]( tbb::flow_control &flowControl ) -> ::LocationPtr {
+
+					if( toVisit.empty() )
+					{
+						flowControl.stop();
+						return nullptr;
+					}
+
+					const tbb::tick_count start = tbb::tick_count::now();
+
+					const ::PendingLocation pending = toVisit.back();
+					toVisit.pop_back();
+
+					::LocationPtr location = std::make_shared<::Location>(
+						pending.parent ? pending.parent->child( pending.name ) : ConstSceneInterfacePtr( src ),
+						pending.depth
+					);
+
+					SceneInterface::NameList childNames;
+					location->src->childNames( childNames );
+					for( auto it = childNames.rbegin(); it != childNames.rend(); ++it )
+					{
+						toVisit.push_back( { location->src, *it, location->depth + 1 } );
+					}
+
+					locationCount++;
+					traversalTime += ::microseconds( start );
+					return location;
+				}
+			) &
+
+			// Read locations in parallel.
+			tbb::make_filter<::LocationPtr, ::LocationPtr>(
+				tbb::filter::parallel,
+				[&]( ::LocationPtr location ) -> ::LocationPtr {
+
+					const tbb::tick_count start = tbb::tick_count::now();
+
+					::CopyInfo<size_t> copyInfo = ::readLocation( location->src.get(), time, flags, location->data );
+
+					copyInfos.polygonCount += copyInfo.polygonCount;
+					copyInfos.tagCount += copyInfo.tagCount;
+					copyInfos.setCount += copyInfo.setCount;
+					copyInfos.attributeCount += copyInfo.attributeCount;
+					copyInfos.curveCount += copyInfo.curveCount;
+					copyInfos.pointCount += copyInfo.pointCount;
+
+					readTime += ::microseconds( start );
+					return location;
+				}
+			) &
+
+			// Write locations serially, in the order they were traversed, so destinations
+			// which aren't thread-safe are supported, and the output is deterministic.
+			tbb::make_filter<::LocationPtr, void>(
+				tbb::filter::serial_in_order,
+				[&]( ::LocationPtr location ) {
+
+					const tbb::tick_count start = tbb::tick_count::now();
+
+					dstLocations.resize( location->depth );
+					if( location->depth )
+					{
+						dstLocations.push_back( dstLocations.back()->child( location->src->name(), SceneInterface::CreateIfMissing ) );
+					}
+					else
+					{
+						dstLocations.push_back( dst );
+					}
+
+					::writeLocation( location->data, dstLocations.back().get(), time, flags );
+
+					writeTime += ::microseconds( start );
+				}
+			),
+
+			taskGroupContext
+		);
 	}
+
+	SceneStats stats;
+	stats["locations"] = locationCount;
+	stats["polygons"] = copyInfos.polygonCount;
+	stats["curves"] = copyInfos.curveCount;
+	stats["points"] = copyInfos.pointCount;
+	stats["tags"] = copyInfos.tagCount;
+	stats["sets"] = copyInfos.setCount;
+	stats["attributes"] = copyInfos.attributeCount;
+	stats["traversalTime"] = traversalTime;
+	stats["readTime"] = readTime;
+	stats["writeTime"] = writeTime;
+	stats["totalTime"] = ::microseconds( copyStart );
+	return stats;
 }
 
 } // SceneAlgo
@@ -41,11 +41,13 @@
 #include "IECoreScene/SharedSceneInterfaces.h"
 #include "IECoreScene/VisibleRenderable.h"
 
-#include "IECore/ComputationCache.h"
+#include "IECore/CompoundData.h"
 #include "IECore/FileIndexedIO.h"
 #include "IECore/HeaderGenerator.h"
+#include "IECore/LRUCache.h"
 #include "IECore/MessageHandler.h"
 #include "IECore/ObjectInterpolator.h"
+#include "IECore/SharedMemoryObjectCache.h"
 #include "IECore/SimpleTypedData.h"
 #include "IECore/TransformationMatrixData.h"
 #include "IECore/PathMatcherData.h"
@@ -53,9 +55,15 @@
 #include "OpenEXR/ImathBoxAlgo.h"
 
 #include "boost/core/demangle.hpp"
-#include "boost/tuple/tuple.hpp"
+#include "boost/filesystem/operations.hpp"
+#include "boost/lexical_cast.hpp"
 
 #include "tbb/concurrent_hash_map.h"
+#include "tbb/parallel_for.h"
+
+#include <atomic>
+#include <memory>
+#include <mutex>
 
 using namespace IECore;
 using namespace IECoreScene;
@@ -89,6 +97,7 @@ static InternedString ancestorTagsEntry("ancestorTags");
 static InternedString descendentTagsEntry("descendentTags");
 static InternedString setsEntry("sets");
 static InternedString childSetsEntry("childSets");
+static InternedString setIndexEntry("setIndex");
 
 const SceneInterface::Name &SceneCache::animatedObjectTopologyAttribute = InternedString( "sceneInterface:animatedObjectTopology" );
 const SceneInterface::Name &SceneCache::animatedObjectPrimVarsAttribute = InternedString( "sceneInterface:animatedObjectPrimVars" );
@@ -330,11 +339,20 @@ class SceneCache::ReaderImplementation : public SceneCache::Implementation
 			{
 				// use same map from the root
 				m_sharedData = m_parent->m_sharedData;
+				m_cacheHash = m_parent->m_cacheHash;
+				m_cacheHash.append( name() );
+				if( m_parent->m_sharedMemoryHash != MurmurHash() )
+				{
+					m_sharedMemoryHash = m_parent->m_sharedMemoryHash;
+					m_sharedMemoryHash.append( name() );
+				}
 			}
 			else
 			{
 				// only the root instance allocate the map.
 				m_sharedData = new SharedData;
+				m_cacheHash.append( m_sharedData->id );
+				m_sharedMemoryHash = fileHash( io.get() );
 			}
 		}
 
@@ -493,7 +511,7 @@ class SceneCache::ReaderImplementation : public SceneCache::Implementation
 
 		ConstDataPtr readTransformAtSample( size_t sampleIndex ) const
 		{
-			return m_sharedData->readTransformAtSample( this, sampleIndex );
+			return runTimeCast<const Data>( objectCache().get( ObjectCacheKey( this, ObjectCacheKey::TransformSample, sampleIndex ) ) );
 		}
 
 		Imath::M44d readTransformAsMatrixAtSample( size_t sampleIndex ) const
@@ -549,7 +567,7 @@ class SceneCache::ReaderImplementation : public SceneCache::Implementation
 
 		ConstObjectPtr readAttributeAtSample( const SceneCache::Name &name, size_t sampleIndex ) const
 		{
-			return m_sharedData->readAttributeAtSample( this, name, sampleIndex );
+			return objectCache().get( ObjectCacheKey( this, ObjectCacheKey::AttributeSample, sampleIndex, &name ) );
 		}
 
 		inline const SampleTimes &objectSampleTimes() const
@@ -585,7 +603,24 @@ class SceneCache::ReaderImplementation : public SceneCache::Implementation
 
 		ConstObjectPtr readObjectAtSample( size_t sampleIndex, const Canceller *canceller ) const
 		{
-			return m_sharedData->readObjectAtSample( this, sampleIndex, canceller );
+			// \todo - we should pass the Canceller through to Object::load, but
+			// we can't pass it to the cache's getter, because an exception
+			// thrown by cancellation would be cached as a failure.
+			Canceller::check( canceller );
+
+			// Objects are held in the ObjectCache by the hash of their contents, so
+			// that identical objects from different locations (as in crowd caches,
+			// for instance) are only held once. The ContentHashCache maps from the
+			// sample to that hash. Its getter loads and hashes the object, so
+			// concurrent readers of the same sample wait for a single load.
+			const ObjectCacheKey sampleKey( this, ObjectCacheKey::ObjectSample, sampleIndex );
+			const MurmurHash contentHash = contentHashCache().get( sampleKey );
+			if( sampleKey.loadedObject )
+			{
+				return sampleKey.loadedObject;
+			}
+
+			return objectCache().get( ObjectCacheKey( this, sampleIndex, contentHash ) );
 		}
 
 		static PrimitiveVariableMap readObjectPrimitiveVariablesAtSample( const IndexedIOPtr &io, const std::vector<InternedString> &primVarNames, size_t sample, const Canceller *canceller )
@@ -773,6 +808,40 @@ class SceneCache::ReaderImplementation : public SceneCache::Implementation
 			return reader;
 		}
 
+		/// Reads a set from the index written at the root of the file,
+		/// including the locations tagged with its name. Returns false
+		/// if the file was written before the index was introduced.
+		bool readIndexedSet( const Name &name, PathMatcher &set ) const
+		{
+			const ReaderImplementation *root = this;
+			while( root->m_parent )
+			{
+				root = root->m_parent.get();
+			}
+
+			IndexedIOPtr indexIO = root->m_indexedIO->subdirectory( setIndexEntry, IndexedIO::NullIfMissing );
+			if( !indexIO )
+			{
+				return false;
+			}
+
+			if( !indexIO->hasEntry( name ) )
+			{
+				return true;
+			}
+
+			ConstPathMatcherDataPtr data = runTimeCast<const PathMatcherData>( Object::load( indexIO, name ) );
+			if( !data )
+			{
+				return true;
+			}
+
+			SceneInterface::Path p;
+			path( p );
+			set.addPaths( p.empty() ? data->readable() : data->readable().subTree( p ) );
+			return true;
+		}
+
 		PathMatcher readSet( const Name &name, bool includeDescendantSets, const Canceller *canceller ) const
 		{
 			SceneInterface::Path prefix;
@@ -861,125 +930,323 @@ class SceneCache::ReaderImplementation : public SceneCache::Implementation
 		typedef std::map< IndexedIO::EntryID, const SampleTimes* > AttributeSamplesMap;
 		typedef tbb::spin_rw_mutex AttributeMapMutex;
 
-		typedef std::pair< const ReaderImplementation *, size_t > SimpleCacheKey;
-		typedef tuple< const ReaderImplementation *, const SceneCache::Name &, size_t > AttributeCacheKey;
-
-		typedef IECore::ComputationCache< SimpleCacheKey > SimpleCache;
-		typedef IECore::ComputationCache< AttributeCacheKey > AttributeCache;
-
 		/// Hold pointers to values allocated/deallocated by the root scene object (the last one to die)
 		class SharedData : public RefCounted
 		{
 			public :
 
-				SharedData() :
-					objectCache( new SimpleCache( doReadObjectAtSample, simpleHash,  10000 )  ),
-					attributeCache( new AttributeCache( doReadAttributeAtSample, attributeHash, 1000) ),
-					transformCache( new SimpleCache(  doReadTransformAtSample, simpleHash, 1000) )
+				SharedData() : id( g_nextSharedDataId++ )
 				{
 				}
 
-				/// utility function used by the ReaderImplementation to use the LRUCache for transform reading
-				IECore::ConstDataPtr readTransformAtSample( const ReaderImplementation *reader, size_t sample )
+				// Identifies the file uniquely for the lifetime of the process,
+				// so that entries in the object cache can't be confused with
+				// those from a file opened previously with the same name.
+				const uint64_t id;
+				SampleTimesMap sampleTimesMap;
+
+			private :
+
+				static std::atomic<uint64_t> g_nextSharedDataId;
+
+		};
+
+		// Key for the object cache, which holds transforms, attributes and
+		// objects for all open files. Converts implicitly to the hash used as
+		// the key proper, and carries everything the getter needs to load the
+		// item.
+		struct ObjectCacheKey
+		{
+			enum Type
+			{
+				TransformSample,
+				AttributeSample,
+				// Used only as the key for the ContentHashCache.
+				ObjectSample,
+				// A full object from an arbitrary sample, used as the basis for
+				// objects tagged with `animatedObjectPrimVarsAttribute`.
+				ObjectTemplate,
+				// An object identified by the hash of its contents, so that it
+				// may be shared by all samples which load an identical object.
+				// The reader and sample identify one such sample.
+				ObjectContent
+			};
+
+			ObjectCacheKey( const ReaderImplementation *reader, Type type, size_t sample, const SceneCache::Name *attributeName = nullptr )
+				:	reader( reader ), type( type ), sample( sample ), attributeName( attributeName ), object( nullptr ), objectCost( 0 ), hash( reader->m_cacheHash )
+			{
+				hash.append( (int)type );
+				hash.append( (uint64_t)sample );
+				if( attributeName )
 				{
-					return runTimeCast< const Data >( transformCache->get( SimpleCacheKey(reader, sample) ) );
+					hash.append( attributeName->value() );
 				}
+			}
 
-				/// utility function used by the ReaderImplementation to use the LRUCache for object reading
-				IECore::ConstObjectPtr readObjectAtSample( const ReaderImplementation *reader, size_t sample, const Canceller *canceller )
-				{
-					// \todo - we should pass the Canceller through to Object::load, but this is currently
-					// complicated by the objectCache.  We should perhaps remove the objectCache anyway, since it
-					// is redundant with Gaffer's cache?  Though caching the topology for the special
-					// "animatedObjectPrimVars" mode could still be valuable?
-					const size_t defaultSample = (size_t) - 1;
-					SimpleCacheKey currentKey( reader, sample );
-
-					// if constant topology and the object is not in the cache, we try to build it from another frame
-					if ( reader->hasAttribute(animatedObjectPrimVarsAttribute) )
-					{
-						/// Could not create the object from another time sample... so we load the entire object
-						SimpleCacheKey defaultKey( reader, defaultSample );
+			// ObjectContent key. If `object` is provided, it has already been
+			// loaded, and will be used rather than loading it again.
+			ObjectCacheKey( const ReaderImplementation *reader, size_t sample, const MurmurHash &contentHash, const Object *object = nullptr, size_t objectCost = 0 )
+				:	reader( reader ), type( ObjectContent ), sample( sample ), attributeName( nullptr ), object( object ), objectCost( objectCost )
+			{
+				hash.append( (int)type );
+				hash.append( contentHash );
+			}
 
-						Canceller::check( canceller );
-						ConstObjectPtr obj = objectCache->get( currentKey, SimpleCache::NullIfMissing );
-						if ( !obj )
-						{
-							/// ok, try to build the object from another frame...
-							Canceller::check( canceller );
-							ConstObjectPtr defaultObj = objectCache->get( defaultKey, SimpleCache::NullIfMissing );
-							if ( defaultObj )
-							{
-								IECore::ConstInternedStringVectorDataPtr varNames = runTimeCast<const InternedStringVectorData>( reader->readAttributeAtSample(animatedObjectPrimVarsAttribute, 0) );
-								if ( varNames )
-								{
-									PrimitivePtr prim= runTimeCast< Primitive >( defaultObj->copy() );
-									if ( prim )
-									{
-										// we managed to load the object from a different time sample from the cache, just have to load the changing prim vars...
-										mergeMaps( prim->variables, readObjectPrimitiveVariablesAtSample( reader->m_indexedIO, varNames->readable(), sample, canceller ) );
-										objectCache->set( currentKey, prim.get(), ObjectPool::StoreReference );
-										return prim;
-									}
-								}
-							}
-							/// ok, we don't have the object even from other times in the cache... load it from the file then.
-							Canceller::check( canceller );
-							obj = objectCache->get( currentKey );
-						}
-						/// register the object as the default, so next frames could reuse them
-						objectCache->set( defaultKey, obj.get(), ObjectPool::StoreReference );
-						return obj;
+			operator const MurmurHash & () const
+			{
+				return hash;
+			}
+
+			const ReaderImplementation *reader;
+			Type type;
+			size_t sample;
+			const SceneCache::Name *attributeName;
+			const Object *object;
+			size_t objectCost;
+			MurmurHash hash;
+			// Output from the ContentHashCache getter, holding the object it
+			// loaded to compute the hash.
+			mutable ConstObjectPtr loadedObject;
+		};
+
+	public :
+
+		// The getter re-enters the cache to fetch the ObjectTemplate, and
+		// decompression may use TBB tasks, so we must use the TaskParallel policy.
+		typedef IECore::LRUCache<MurmurHash, ConstObjectPtr, LRUCachePolicy::TaskParallel, ObjectCacheKey> ObjectCache;
+		typedef IECore::LRUCache<MurmurHash, MurmurHash, LRUCachePolicy::TaskParallel, ObjectCacheKey> ContentHashCache;
+
+		static ObjectCache &objectCache()
+		{
+			// Deliberately leaked, to avoid destruction order problems at exit.
+			static ObjectCache *cache = createObjectCache();
+			return *cache;
+		}
+
+		static ContentHashCache &contentHashCache()
+		{
+			// Deliberately leaked, like the ObjectCache. Each entry costs 1, so
+			// this limits the number of samples whose hashes we remember.
+			static ContentHashCache *cache = new ContentHashCache( contentHashCacheGetter, contentHashCacheSize( objectCache().getMaxCost() ) );
+			return *cache;
+		}
+
+		// There's no point remembering the hashes of many more samples than
+		// the ObjectCache can hold, so we scale the number of hashes with its
+		// memory limit, allowing one for every 4KB.
+		static size_t contentHashCacheSize( size_t maxObjectCacheMemory )
+		{
+			return maxObjectCacheMemory / 4096;
+		}
+
+	private :
+
+		static ObjectCache *createObjectCache()
+		{
+			const char *m = getenv( "IECORE_SCENECACHE_MEMORY" );
+			size_t mi = m ? boost::lexical_cast<size_t>( m ) : 500;
+			ObjectCache *result = new ObjectCache( objectCacheGetter, 1024 * 1024 * mi );
+			result->statistics().setName( "SceneCache" );
+			return result;
+		}
+
+		static ConstObjectPtr objectCacheGetter( const ObjectCacheKey &key, size_t &cost )
+		{
+			ConstObjectPtr result;
+			switch( key.type )
+			{
+				case ObjectCacheKey::TransformSample :
+					result = doReadTransformAtSample( key.reader, key.sample );
+					break;
+				case ObjectCacheKey::AttributeSample :
+					result = doReadAttributeAtSample( key.reader, *key.attributeName, key.sample );
+					break;
+				case ObjectCacheKey::ObjectTemplate :
+					result = doReadObjectAtSample( key.reader, 0 );
+					break;
+				case ObjectCacheKey::ObjectContent :
+					if( key.object )
+					{
+						cost = key.objectCost;
+						return key.object;
 					}
-					/// The object has animated topology... so we load the entire object
-					ConstObjectPtr obj = objectCache->get(currentKey);
-					return obj;
-				}
+					// Evicted since we hashed it, so we must load it again.
+					return loadSharedObjectAtSample( key.reader, key.sample, cost );
+				case ObjectCacheKey::ObjectSample :
+					throw Exception( "Object samples are cached by content" );
+			}
+			cost = result->memoryUsage();
+			return result;
+		}
 
-				/// utility function used by the ReaderImplementation to use the LRUCache for attribute reading
-				IECore::ConstObjectPtr readAttributeAtSample( const ReaderImplementation *reader, const SceneCache::Name &name, size_t sample )
-				{
-					return attributeCache->get( AttributeCacheKey(reader,name,sample) );
-				}
+		static MurmurHash contentHashCacheGetter( const ObjectCacheKey &key, size_t &cost )
+		{
+			size_t objectCost;
+			ConstObjectPtr object = loadSharedObjectAtSample( key.reader, key.sample, objectCost );
+			const MurmurHash contentHash = object->hash();
+			// Add the object to the ObjectCache before returning, so that
+			// callers waiting on us find it there rather than loading it again.
+			// If an identical object is already cached, this returns it rather
+			// than `object`, which is discarded.
+			key.loadedObject = objectCache().get( ObjectCacheKey( key.reader, key.sample, contentHash, object.get(), objectCost ) );
+			cost = 1;
+			return contentHash;
+		}
 
-				// \todo Consider adding "ReaderImplementation *rootScene" to optimize the scene() calls.
-				SampleTimesMap sampleTimesMap;
-				SimpleCache::Ptr objectCache;
-				AttributeCache::Ptr attributeCache;
-				SimpleCache::Ptr transformCache;
+		// Returns a hash identifying the file in a way that is stable across
+		// processes, for use as the basis of keys for the SharedMemoryObjectCache.
+		// Returns a default hash if there is no such cache, or if the file
+		// can't be identified.
+		static MurmurHash fileHash( const IndexedIO *io )
+		{
+			const FileIndexedIO *fileIndexedIO = runTimeCast<const FileIndexedIO>( io );
+			if( !fileIndexedIO || !SharedMemoryObjectCache::defaultCache() )
+			{
+				return MurmurHash();
+			}
 
-			private :
+			const boost::filesystem::path path = boost::filesystem::absolute( fileIndexedIO->fileName() );
+			boost::system::error_code timeError, sizeError;
+			const std::time_t time = boost::filesystem::last_write_time( path, timeError );
+			const uintmax_t size = boost::filesystem::file_size( path, sizeError );
+			if( timeError || sizeError )
+			{
+				return MurmurHash();
+			}
+
+			MurmurHash result;
+			result.append( "SceneCache" );
+			result.append( path.string() );
+			result.append( (uint64_t)time );
+			result.append( (uint64_t)size );
+			return result;
+		}
+
+		// Loads objects via the SharedMemoryObjectCache if there is one, so
+		// that they are only loaded from disk once per machine. We don't do
+		// the same for transforms and attributes, as they are cheap to load
+		// in comparison to the cost of serialising them.
+		// `cost` is set to the memory used by the object, excluding any data
+		// it shares with an ObjectTemplate in the cache.
+		static ConstObjectPtr loadSharedObjectAtSample( const ReaderImplementation *reader, size_t sample, size_t &cost )
+		{
+			SharedMemoryObjectCache *sharedCache = SharedMemoryObjectCache::defaultCache();
+			if( !sharedCache || reader->m_sharedMemoryHash == MurmurHash() )
+			{
+				return loadObjectAtSample( reader, sample, cost );
+			}
+
+			MurmurHash key = reader->m_sharedMemoryHash;
+			key.append( (uint64_t)sample );
+			if( ConstObjectPtr result = sharedCache->retrieve( key ) )
+			{
+				cost = result->memoryUsage();
+				return result;
+			}
+
+			ConstObjectPtr result = loadObjectAtSample( reader, sample, cost );
+			sharedCache->store( key, result.get() );
+			return result;
+		}
+
+		static ConstObjectPtr loadObjectAtSample( const ReaderImplementation *reader, size_t sample, size_t &cost )
+		{
+			IECore::ConstInternedStringVectorDataPtr varNames;
+			if( reader->hasAttribute( animatedObjectPrimVarsAttribute ) )
+			{
+				varNames = runTimeCast<const InternedStringVectorData>( reader->readAttributeAtSample( animatedObjectPrimVarsAttribute, 0 ) );
+			}
 
-			// utility function that copies all the values from the rhs dictionary to the lhs.
-			template< typename T >
-			static void mergeMaps ( T& lhs, const T& rhs)
+			if( !varNames )
 			{
-	    		typename T::iterator lhsItr = lhs.begin();
-				typename T::const_iterator rhsItr = rhs.begin();
+				// The object has animated topology, so we load the entire object.
+				ConstObjectPtr result = doReadObjectAtSample( reader, sample );
+				cost = result->memoryUsage();
+				return result;
+			}
 
-				while (lhsItr != lhs.end() && rhsItr != rhs.end())
+			// The topology is constant, so if we already have the object from
+			// another sample, we just need to load the changing primitive variables.
+			// The ObjectTemplate entry is charged for everything else.
+			ObjectCache &cache = objectCache();
+			const ObjectCacheKey templateKey( reader, ObjectCacheKey::ObjectTemplate, 0 );
+			if( cache.cached( templateKey ) )
+			{
+				PrimitivePtr prim = runTimeCast<Primitive>( cache.get( templateKey )->copy() );
+				if( prim )
 				{
-					if (rhsItr->first < lhsItr->first)
-					{
-						lhs.insert(lhsItr, *rhsItr);
-						++rhsItr;
-					}
-					else if (rhsItr->first == lhsItr->first)
-					{
-						lhsItr->second = rhsItr->second;
-						++lhsItr;
-						++rhsItr;
-					}
-					else
-						++lhsItr;
+					PrimitiveVariableMap variables = readObjectPrimitiveVariablesAtSample( reader->m_indexedIO, varNames->readable(), sample, nullptr );
+					cost = memoryUsage( variables, varNames->readable() );
+					mergeMaps( prim->variables, variables );
+					return prim;
 				}
-				lhs.insert(rhsItr, rhs.end());
 			}
 
-		};
+			// We don't have the object from any other sample, so we load it
+			// in full, and register it as the template for subsequent samples.
+			ObjectPtr result = doReadObjectAtSample( reader, sample );
+			cache.set( templateKey, result, result->memoryUsage() );
+			const Primitive *primitive = runTimeCast<const Primitive>( result.get() );
+			cost = primitive ? memoryUsage( primitive->variables, varNames->readable() ) : 0;
+			return result;
+		}
+
+		// Returns the memory used by the named primitive variables.
+		static size_t memoryUsage( const PrimitiveVariableMap &variables, const std::vector<InternedString> &names )
+		{
+			size_t result = 0;
+			for( const auto &name : names )
+			{
+				auto it = variables.find( name );
+				if( it == variables.end() )
+				{
+					continue;
+				}
+				if( it->second.data )
+				{
+					result += it->second.data->Object::memoryUsage();
+				}
+				if( it->second.indices )
+				{
+					result += it->second.indices->Object::memoryUsage();
+				}
+			}
+			return result;
+		}
+
+		// utility function that copies all the values from the rhs dictionary to the lhs.
+		template< typename T >
+		static void mergeMaps ( T& lhs, const T& rhs)
+		{
+			typename T::iterator lhsItr = lhs.begin();
+			typename T::const_iterator rhsItr = rhs.begin();
+
+			while (lhsItr != lhs.end() && rhsItr != rhs.end())
+			{
+				if (rhsItr->first < lhsItr->first)
+				{
+					lhs.insert(lhsItr, *rhsItr);
+					++rhsItr;
+				}
+				else if (rhsItr->first == lhsItr->first)
+				{
+					lhsItr->second = rhsItr->second;
+					++lhsItr;
+					++rhsItr;
+				}
+				else
+					++lhsItr;
+			}
+			lhs.insert(rhsItr, rhs.end());
+		}
 
 		ReaderImplementationPtr m_parent;
 		mutable SharedData *m_sharedData;
+		// Hash of the file and location, used as the basis for ObjectCacheKeys.
+		MurmurHash m_cacheHash;
+		// As above, but stable across processes, for use with the SharedMemoryObjectCache.
+		// Default constructed if that is not in use.
+		MurmurHash m_sharedMemoryHash;
 
 		/// pointers to values in m_sharedData->sampleTimesMap for the current scene location.
 		mutable const SampleTimes *m_boundSampleTimes;
@@ -1085,23 +1352,13 @@ class SceneCache::ReaderImplementation : public SceneCache::Implementation
 			h.append( currScene->name() );
 		}
 
-		static MurmurHash simpleHash( const SimpleCacheKey &key )
-		{
-			const ReaderImplementation *reader = key.first;
-			size_t sample = key.second;
-			MurmurHash h;
-			reader->sceneHash( h );
-			h.append( (uint64_t)sample );
-			return h;
-		}
-
 		// static function used by the cache mechanism to actually load the object data from file.
-		static ObjectPtr doReadTransformAtSample( const SimpleCacheKey &key )
+		static ObjectPtr doReadTransformAtSample( const ReaderImplementation *reader, size_t sample )
 		{
-			IndexedIOPtr io = key.first->m_indexedIO->subdirectory( transformEntry, IndexedIO::NullIfMissing );
+			IndexedIOPtr io = reader->m_indexedIO->subdirectory( transformEntry, IndexedIO::NullIfMissing );
 			if ( !io )
 			{
-				if ( key.second==0 )
+				if ( sample==0 )
 				{
 					return g_defaults.defaultTransform;
 				}
@@ -1110,35 +1367,21 @@ class SceneCache::ReaderImplementation : public SceneCache::Implementation
 					throw Exception( "Sample index out of bounds!" );
 				}
 			}
-			return Object::load( io, sampleEntry(key.second) );
+			return Object::load( io, sampleEntry(sample) );
 		}
 
 		// static function used by the cache mechanism to actually load the object data from file.
-		static ObjectPtr doReadObjectAtSample( const SimpleCacheKey &key )
+		static ObjectPtr doReadObjectAtSample( const ReaderImplementation *reader, size_t sample )
 		{
-			return Object::load( key.first->m_indexedIO->subdirectory( objectEntry ), sampleEntry(key.second) );
-		}
-
-		static MurmurHash attributeHash( const AttributeCacheKey &key )
-		{
-			const ReaderImplementation *reader = get<0>( key );
-			const SceneInterface::Name &name = get<1>( key );
-			size_t sample = get<2>( key );
-
-			MurmurHash h;
-			reader->sceneHash( h );
-			h.append(name.value());
-			h.append( (uint64_t)sample );
-			return h;
+			return Object::load( reader->m_indexedIO->subdirectory( objectEntry ), sampleEntry(sample) );
 		}
 
 		// static function used by the cache mechanism to actually load the attribute data from file.
-		static ObjectPtr doReadAttributeAtSample( const AttributeCacheKey &key )
+		static ObjectPtr doReadAttributeAtSample( const ReaderImplementation *reader, const SceneInterface::Name &name, size_t sample )
 		{
-			const SceneInterface::Name &name = get<1>( key );
 			ObjectPtr result = Object::load(
-				get<0>( key )->m_indexedIO->subdirectory( attributesEntry )->subdirectory( name ),
-				sampleEntry( get<2>( key ) )
+				reader->m_indexedIO->subdirectory( attributesEntry )->subdirectory( name ),
+				sampleEntry( sample )
 			);
 
 			if( const ObjectVector *objectVector = runTimeCast<const ObjectVector>( result.get() ) )
@@ -1180,6 +1423,7 @@ class SceneCache::ReaderImplementation : public SceneCache::Implementation
 };
 
 SceneCache::ReaderImplementation::Defaults SceneCache::ReaderImplementation::g_defaults;
+std::atomic<uint64_t> SceneCache::ReaderImplementation::SharedData::g_nextSharedDataId( 0 );
 
 /// Writer implementation for SceneCache
 /// Each location keeps refcount pointers to their child locations, so they can always return the same (unfinished child) and when the root is destroyed, it
@@ -1190,17 +1434,21 @@ class SceneCache::WriterImplementation : public SceneCache::Implementation
 
 		IE_CORE_DECLAREPTR( WriterImplementation )
 
-		WriterImplementation( IndexedIOPtr io, Implementation *parent = nullptr) : SceneCache::Implementation( io ), m_parent(static_cast< WriterImplementation* >( parent ))
+		WriterImplementation( IndexedIOPtr io, Implementation *parent = nullptr) : SceneCache::Implementation( io ), m_parent(static_cast< WriterImplementation* >( parent )), m_boundsComputed( false )
 		{
 			if ( m_parent )
 			{
-				// use same map from the root
+				// use same map, mutex and set index from the root
 				m_sampleTimesMap = m_parent->m_sampleTimesMap;
+				m_mutex = m_parent->m_mutex;
+				m_setIndex = m_parent->m_setIndex;
 			}
 			else
 			{
 				// only the root instance allocate the map.
 				m_sampleTimesMap = new SampleTimesMap;
+				m_mutex = std::make_shared<Mutex>();
+				m_setIndex = std::make_shared<SetIndex>();
 			}
 		}
 
@@ -1304,8 +1552,11 @@ class SceneCache::WriterImplementation : public SceneCache::Implementation
 			}
 			size_t sampleIndex = m_transformSampleTimes.size();
 			m_transformSampleTimes.push_back( time );
-			IndexedIOPtr io = m_indexedIO->subdirectory( transformEntry, IndexedIO::CreateIfMissing );
-			((const Object *)transform)->save( io, sampleEntry(sampleIndex) );
+			{
+				Lock lock( *m_mutex );
+				IndexedIOPtr io = m_indexedIO->subdirectory( transformEntry, IndexedIO::CreateIfMissing );
+				((const Object *)transform)->save( io, sampleEntry(sampleIndex) );
+			}
 			m_transformSamples.push_back( transform );
 		}
 
@@ -1335,6 +1586,8 @@ class SceneCache::WriterImplementation : public SceneCache::Implementation
 			}
 			size_t sampleIndex = sampleTimes.size();
 			sampleTimes.push_back( time );
+
+			Lock lock( *m_mutex );
 			IndexedIOPtr io = m_indexedIO->subdirectory( attributesEntry, IndexedIO::CreateIfMissing );
 			io = io->subdirectory( name, IndexedIO::CreateIfMissing );
 			attribute->save( io, sampleEntry(sampleIndex) );
@@ -1343,9 +1596,14 @@ class SceneCache::WriterImplementation : public SceneCache::Implementation
 		void writeLocalTag( const char *tag )
 		{
 			writable();
+			Lock lock( *m_mutex );
 			IndexedIOPtr io = m_indexedIO->subdirectory( localTagsEntry, IndexedIO::CreateIfMissing );
 			// we just create a IndexedIO::Directory
 			io->subdirectory( tag, IndexedIO::CreateIfMissing );
+
+			SceneInterface::Path p;
+			path( p );
+			(*m_setIndex)[tag].addPath( p );
 		}
 
 		void writeTags( const NameList &tags, int tagLocation = SceneInterface::LocalTag )
@@ -1355,6 +1613,7 @@ class SceneCache::WriterImplementation : public SceneCache::Implementation
 				return;
 			}
 			writable();
+			Lock lock( *m_mutex );
 			IndexedIOPtr io(nullptr);
 			if ( tagLocation == SceneInterface::LocalTag )
 			{
@@ -1377,6 +1636,18 @@ class SceneCache::WriterImplementation : public SceneCache::Implementation
 				// we just create a IndexedIO::Directory
 				io->subdirectory( *tIt, IndexedIO::CreateIfMissing );
 			}
+
+			if ( tagLocation == SceneInterface::LocalTag )
+			{
+				// Local tags are returned by SceneCache::readSet(),
+				// so must be included in the set index.
+				SceneInterface::Path p;
+				path( p );
+				for ( const auto &tag : tags )
+				{
+					(*m_setIndex)[tag].addPath( p );
+				}
+			}
 		}
 
 		void writeObject( const Object *object, double time )
@@ -1407,8 +1678,11 @@ class SceneCache::WriterImplementation : public SceneCache::Implementation
 			}
 			size_t sampleIndex = m_objectSampleTimes.size();
 			m_objectSampleTimes.push_back( time );
-			IndexedIOPtr io = m_indexedIO->subdirectory( objectEntry, IndexedIO::CreateIfMissing );
-			object->save( io, sampleEntry(sampleIndex) );
+			{
+				Lock lock( *m_mutex );
+				IndexedIOPtr io = m_indexedIO->subdirectory( objectEntry, IndexedIO::CreateIfMissing );
+				object->save( io, sampleEntry(sampleIndex) );
+			}
 
 			const VisibleRenderable *renderable = runTimeCast< const VisibleRenderable >( object );
 			if ( renderable )
@@ -1484,8 +1758,13 @@ class SceneCache::WriterImplementation : public SceneCache::Implementation
 			IECore::PathMatcherDataPtr setData = new IECore::PathMatcherData();
 			setData->writable() = set;
 
+			Lock lock( *m_mutex );
 			IndexedIOPtr setsIO = m_indexedIO->subdirectory( setsEntry, IndexedIO::CreateIfMissing );
 			setData->Object::save( setsIO, name );
+
+			SceneInterface::Path p;
+			path( p );
+			(*m_setIndex)[name].addPaths( set, p );
 		}
 
 		WriterImplementationPtr child( const Name &name, MissingBehaviour missingBehaviour )
@@ -1495,6 +1774,7 @@ class SceneCache::WriterImplementation : public SceneCache::Implementation
 				writable();
 			}
 
+			Lock lock( *m_mutex );
 			std::map< SceneCache::Name, WriterImplementationPtr >::const_iterator it = m_children.find( name );
 			if ( it != m_children.end() )
 			{
@@ -1519,6 +1799,7 @@ class SceneCache::WriterImplementation : public SceneCache::Implementation
 		SceneCache::ImplementationPtr createChild( const SceneCache::Name &name )
 		{
 			writable();
+			Lock lock( *m_mutex );
 			IndexedIOPtr children = m_indexedIO->subdirectory( childrenEntry, IndexedIO::CreateIfMissing );
 			if ( children->hasEntry( name ) )
 			{
@@ -1731,6 +2012,13 @@ class SceneCache::WriterImplementation : public SceneCache::Implementation
 		// animated bounding boxes in case they were not explicitly writen.
 		void flush()
 		{
+			if ( !m_parent )
+			{
+				// Compute all the bounds up front, in parallel, so that
+				// the serial pass below only has to write them to the file.
+				computeBounds();
+			}
+
 			// AncestorTags must be written before visiting children
 			if ( m_parent )
 			{
@@ -1746,27 +2034,7 @@ class SceneCache::WriterImplementation : public SceneCache::Implementation
 				cit->second->flush();
 			}
 
-			try
-			{
-				doFlush();
-			}
-			catch( std::exception &e )
-			{
-				SceneCache::Path p;
-				std::string stringPath;
-				path( p );
-				IECoreScene::SceneInterface::pathToString( p, stringPath );
-				std::string type = boost::core::demangle( typeid( e ).name() );
-				throw IECore::IOException( boost::str( boost::format( "%1% : %2% ( for location \"%3%\" )" ) % type % e.what() % stringPath ) );
-			}
-			catch( ... )
-			{
-				SceneCache::Path p;
-				std::string stringPath;
-				path( p );
-				IECoreScene::SceneInterface::pathToString( p, stringPath );
-				throw IECore::IOException( boost::str( boost::format( "Unknown exception while flushing data ( for location %1% )" ) % stringPath ) );
-			}
+			callWithLocation( [this] { doFlush(); } );
 		}
 
 		void doFlush()
@@ -1818,6 +2086,107 @@ class SceneCache::WriterImplementation : public SceneCache::Implementation
 				storeSampleTimes( m_objectSampleTimes, io );
 			}
 
+			if ( m_boundSampleTimes.size() )
+			{
+				// save the bound sample times
+				io = m_indexedIO->subdirectory( boundEntry, IndexedIO::CreateIfMissing );
+				storeSampleTimes( m_boundSampleTimes, io );
+
+				// store computed bounds in file
+				uint64_t sampleIndex = 0;
+				for ( BoxSamples::const_iterator bit = m_boundSamples.begin(); bit != m_boundSamples.end(); bit++, sampleIndex++ )
+				{
+					io->write( sampleEntry(sampleIndex), bit->min.getValue(), 6 );
+				}
+			}
+
+			if ( m_parent )
+			{
+				NameList tags;
+				// propagate tags to parent
+				readTags( tags, SceneInterface::LocalTag | SceneInterface::DescendantTag );
+				m_parent->writeTags( tags, SceneInterface::DescendantTag );
+
+				IndexedIOPtr setsIO = m_indexedIO->subdirectory( setsEntry, IndexedIO::NullIfMissing );
+				IndexedIO::EntryIDList setNames;
+				if ( setsIO )
+				{
+					setsIO->entryIds( setNames, IndexedIO::Directory );
+				}
+
+				m_parent->writeChildSets( readChildSets() );
+				m_parent->writeChildSets( setNames );
+			}
+
+			// deallocate children since we now computed everything from them anyways...
+			m_children.clear();
+
+			if ( !m_parent )
+			{
+				writeSetIndex();
+			}
+
+			if ( !m_parent && m_sampleTimesMap )
+			{
+				// we are at the root...
+				// deallocate samples map stored in the root object.
+				delete m_sampleTimesMap;
+				// and make sure the cache does not contain this file, forcing it to reload it.
+				if ( m_indexedIO->typeId() == FileIndexedIOTypeId )
+				{
+					SharedSceneInterfaces::erase( static_cast< FileIndexedIO * >( m_indexedIO.get() )->fileName() );
+				}
+			}
+			m_sampleTimesMap = nullptr;
+		}
+
+		// Computes the bounds for this location and all its descendants,
+		// unless they have been computed already. Children are independent
+		// of each other, so are computed in parallel, but each location
+		// accumulates its children serially in the same order as always, so
+		// the results are identical to a serial computation.
+		void computeBounds()
+		{
+			if( m_boundsComputed )
+			{
+				return;
+			}
+
+			if( m_children.size() == 1 )
+			{
+				m_children.begin()->second->computeBounds();
+			}
+			else if( m_children.size() > 1 )
+			{
+				std::vector<WriterImplementation *> children;
+				children.reserve( m_children.size() );
+				for( const auto &child : m_children )
+				{
+					children.push_back( child.second.get() );
+				}
+
+				tbb::task_group_context taskGroupContext( tbb::task_group_context::isolated );
+				tbb::parallel_for(
+					tbb::blocked_range<size_t>( 0, children.size() ),
+					[&children] ( const tbb::blocked_range<size_t> &r ) {
+						for( size_t i = r.begin(); i != r.end(); ++i )
+						{
+							children[i]->computeBounds();
+						}
+					},
+					taskGroupContext
+				);
+			}
+
+			callWithLocation( [this] { accumulateBounds(); } );
+			m_boundsComputed = true;
+		}
+
+		// Accumulates the bounds of the children and object into
+		// m_boundSamples. The children must have computed their
+		// bounds already.
+		void accumulateBounds()
+		{
 			// We have to compute the bounding box over time for the object and each child.
 			for ( std::map< SceneCache::Name, WriterImplementationPtr >::const_iterator cit = m_children.begin(); cit != m_children.end(); cit++ )
 			{
@@ -1972,58 +2341,55 @@ class SceneCache::WriterImplementation : public SceneCache::Implementation
 				// union all the bounding box samples from the child and also from the optional object stored in this location
 				accumulateBoxSamples( m_objectSampleTimes, m_objectSamples );
 			}
+		}
 
-
-			if ( m_boundSampleTimes.size() )
+		// Calls `f()`, adding this location to the message of any exception
+		// it throws.
+		template<typename F>
+		void callWithLocation( F &&f )
+		{
+			try
 			{
-				// save the bound sample times
-				io = m_indexedIO->subdirectory( boundEntry, IndexedIO::CreateIfMissing );
-				storeSampleTimes( m_boundSampleTimes, io );
-
-				// store computed bounds in file
-				uint64_t sampleIndex = 0;
-				for ( BoxSamples::const_iterator bit = m_boundSamples.begin(); bit != m_boundSamples.end(); bit++, sampleIndex++ )
-				{
-					io->write( sampleEntry(sampleIndex), bit->min.getValue(), 6 );
-				}
+				f();
 			}
-
-			if ( m_parent )
+			catch( std::exception &e )
 			{
-				NameList tags;
-				// propagate tags to parent
-				readTags( tags, SceneInterface::LocalTag | SceneInterface::DescendantTag );
-				m_parent->writeTags( tags, SceneInterface::DescendantTag );
+				SceneCache::Path p;
+				std::string stringPath;
+				path( p );
+				IECoreScene::SceneInterface::pathToString( p, stringPath );
+				std::string type = boost::core::demangle( typeid( e ).name() );
+				throw IECore::IOException( boost::str( boost::format( "%1% : %2% ( for location \"%3%\" )" ) % type % e.what() % stringPath ) );
+			}
+			catch( ... )
+			{
+				SceneCache::Path p;
+				std::string stringPath;
+				path( p );
+				IECoreScene::SceneInterface::pathToString( p, stringPath );
+				throw IECore::IOException( boost::str( boost::format( "Unknown exception while flushing data ( for location %1% )" ) % stringPath ) );
+			}
+		}
 
-				IndexedIOPtr setsIO = m_indexedIO->subdirectory( setsEntry, IndexedIO::NullIfMissing );
-				IndexedIO::EntryIDList setNames;
-				if ( setsIO )
-				{
-					setsIO->entryIds( setNames, IndexedIO::Directory );
-				}
 
-				m_parent->writeChildSets( readChildSets() );
-				m_parent->writeChildSets( setNames );
+		// Writes every set and local tag in the file to the root, so that
+		// SceneCache::readSet() can load them without visiting each location.
+		void writeSetIndex()
+		{
+			if ( !m_setIndex || m_setIndex->empty() )
+			{
+				return;
 			}
 
-			// deallocate children since we now computed everything from them anyways...
-			m_children.clear();
-
-			if ( !m_parent && m_sampleTimesMap )
+			IndexedIOPtr indexIO = m_indexedIO->subdirectory( setIndexEntry, IndexedIO::CreateIfMissing );
+			for ( const auto &set : *m_setIndex )
 			{
-				// we are at the root...
-				// deallocate samples map stored in the root object.
-				delete m_sampleTimesMap;
-				// and make sure the cache does not contain this file, forcing it to reload it.
-				if ( m_indexedIO->typeId() == FileIndexedIOTypeId )
-				{
-					SharedSceneInterfaces::erase( static_cast< FileIndexedIO * >( m_indexedIO.get() )->fileName() );
-				}
+				PathMatcherDataPtr setData = new PathMatcherData( set.second );
+				setData->Object::save( indexIO, set.first );
 			}
-			m_sampleTimesMap = nullptr;
+			m_setIndex = nullptr;
 		}
 
-
 		// walk up to the root writing the child set names at every location
 		void writeChildSets( const NameList &childSets )
 		{
@@ -2186,6 +2552,19 @@ class SceneCache::WriterImplementation : public SceneCache::Implementation
 		WriterImplementation* m_parent;
 		std::map< SceneCache::Name, WriterImplementationPtr > m_children;
 
+		// Serialises access to the IndexedIO and the children of each location, so that
+		// different threads may write to different locations concurrently. Shared by all
+		// the locations in the file.
+		typedef std::mutex Mutex;
+		typedef std::lock_guard<Mutex> Lock;
+		std::shared_ptr<Mutex> m_mutex;
+
+		// The paths in each set and local tag, accumulated while writing
+		// and saved to the root by flush(). Shared by all the locations
+		// in the file, and protected by m_mutex.
+		typedef std::map<SceneCache::Name, PathMatcher> SetIndex;
+		std::shared_ptr<SetIndex> m_setIndex;
+
 		typedef std::map< SampleTimes, uint64_t > SampleTimesMap;
 		typedef std::map< SceneCache::Name, SampleTimes > AttributeSamplesMap;
 
@@ -2200,6 +2579,8 @@ class SceneCache::WriterImplementation : public SceneCache::Implementation
 		BoxSamples m_objectSamples;
 		// overwriting bounding boxes (or used during flush to compute the final bounding boxes).
 		BoxSamples m_boundSamples;
+		// set by computeBounds(), once m_boundSamples includes the children and object.
+		bool m_boundsComputed;
 
 		typedef std::pair< MurmurHash, bool> AnimatedHashTest;
 		typedef std::map< SceneCache::Name, AnimatedHashTest > AnimatedPrimVarMap;
@@ -2212,13 +2593,24 @@ class SceneCache::WriterImplementation : public SceneCache::Implementation
 // SceneCache
 //////////////////////////////////////////////////////////////////////////
 
-SceneCache::SceneCache( const std::string &fileName, IndexedIO::OpenMode mode )
+SceneCache::SceneCache( const std::string &fileName, IndexedIO::OpenMode mode, const CompoundData *options )
 {
 	if( mode & IndexedIO::Append )
 	{
 		throw InvalidArgumentException( "Append mode not supported" );
 	}
-	IndexedIOPtr indexedIO = IndexedIO::create( fileName, IndexedIO::rootPath, mode );
+
+	// SceneCaches are written from a single thread, so we compress asynchronously
+	// by default, allowing the caller to continue producing samples in the meantime.
+	CompoundDataPtr writeOptions;
+	if( ( mode & IndexedIO::Write ) && !( options && options->readable().count( "asynchronousCompression" ) ) )
+	{
+		writeOptions = options ? options->copy() : new CompoundData;
+		writeOptions->writable()["asynchronousCompression"] = new BoolData( true );
+		options = writeOptions.get();
+	}
+
+	IndexedIOPtr indexedIO = IndexedIO::create( fileName, IndexedIO::rootPath, mode, options );
 
 	if( indexedIO->openMode() & IndexedIO::Write )
 	{
@@ -2471,6 +2863,12 @@ IECore::PathMatcher SceneCache::readSet( const Name &name, bool includeDescendan
 
 	PathMatcher set;
 
+	// use the index if the file has one
+	if( includeDescendantSets && reader->readIndexedSet( name, set ) )
+	{
+		return set;
+	}
+
 	// read the old style tags and convert to a set
 	Private::loadSetWalk( this, name, set, SceneInterface::Path(), canceller );
 
@@ -2656,3 +3054,24 @@ bool SceneCache::readOnly() const
 {
 	return dynamic_cast< const ReaderImplementation* >( m_implementation.get() ) != nullptr;
 }
+
+void SceneCache::setMaxCacheMemoryUsage( size_t maxMemory )
+{
+	ReaderImplementation::objectCache().setMaxCost( maxMemory );
+	ReaderImplementation::contentHashCache().setMaxCost( ReaderImplementation::contentHashCacheSize( maxMemory ) );
+}
+
+size_t SceneCache::getMaxCacheMemoryUsage()
+{
+	return ReaderImplementation::objectCache().getMaxCost();
+}
+
+size_t SceneCache::cacheMemoryUsage()
+{
+	return ReaderImplementation::objectCache().currentCost();
+}
+
+const CacheStatistics &SceneCache::cacheStatistics()
+{
+	return ReaderImplementation::objectCache().statistics();
+}
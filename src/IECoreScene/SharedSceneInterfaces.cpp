@@ -55,6 +55,7 @@ class Cache : public SceneLRUCache
 		Cache( SceneLRUCache::Cost maxCost )
 			: SceneLRUCache( fileCacheGetter, maxCost )
 		{
+			statistics().setName( "SharedSceneInterfaces" );
 		}
 
 	private :
@@ -108,3 +109,8 @@ size_t SharedSceneInterfaces::numScenes()
 {
 	return cache().currentCost();
 }
+
+const CacheStatistics &SharedSceneInterfaces::statistics()
+{
+	return cache().statistics();
+}
@@ -66,6 +66,7 @@
 #include "MeshPrimitiveBuilderBinding.h"
 #include "MeshPrimitiveEvaluatorBinding.h"
 #include "MeshPrimitiveShrinkWrapOpBinding.h"
+#include "MeshTopologyBinding.h"
 #include "MeshVertexReorderOpBinding.h"
 #include "MixSmoothSkinningWeightsOpBinding.h"
 #include "MotionPrimitiveBinding.h"
@@ -205,6 +206,7 @@ BOOST_PYTHON_MODULE(_IECoreScene)
 	bindExternalProcedural();
 	bindClippingPlane();
 	bindMeshAlgo();
+	bindMeshTopology();
 	bindCurvesAlgo();
 	bindPointsAlgo();
 	bindTypedObjectParameter();
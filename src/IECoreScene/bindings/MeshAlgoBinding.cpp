@@ -134,6 +134,26 @@ void resamplePrimitiveVariableWrapper( const MeshPrimitive *mesh, PrimitiveVaria
 	return MeshAlgo::resamplePrimitiveVariable( mesh, primitiveVariable, interpolation, canceller );
 }
 
+void resamplePrimitiveVariablesWrapper( const MeshPrimitive *mesh, dict primitiveVariables, PrimitiveVariable::Interpolation interpolation, const IECore::Canceller *canceller )
+{
+	PrimitiveVariableMap m;
+	boost::python::list keys = primitiveVariables.keys();
+	for( boost::python::ssize_t i = 0, n = len( keys ); i < n; ++i )
+	{
+		m[extract<std::string>( keys[i] )] = extract<PrimitiveVariable>( primitiveVariables[keys[i]] );
+	}
+
+	{
+		ScopedGILRelease gilRelease;
+		MeshAlgo::resamplePrimitiveVariables( mesh, m, interpolation, canceller );
+	}
+
+	for( const auto &v : m )
+	{
+		primitiveVariables[v.first] = v.second;
+	}
+}
+
 MeshPrimitivePtr deleteFacesWrapper( const MeshPrimitive *meshPrimitive, const PrimitiveVariable &facesToDelete, bool invert, const IECore::Canceller *canceller )
 {
 	ScopedGILRelease gilRelease;
@@ -221,6 +241,7 @@ void bindMeshAlgo()
 	def( "calculateFaceTextureArea", &calculateFaceTextureAreaWrapper, ( arg_( "mesh" ), arg_( "uvSet" ) = "uv", arg_( "position" ) = "P", arg_( "canceller" ) = object() ) );
 	def( "calculateDistortion", &calculateDistortionWrapper, ( arg_( "mesh" ), arg_( "uvSet" ) = "uv", arg_( "referencePosition" ) = "Pref", arg_( "position" ) = "P", arg_( "canceller" ) = object() ) );
 	def( "resamplePrimitiveVariable", &resamplePrimitiveVariableWrapper, ( arg_( "mesh" ), arg_( "primitiveVariable" ), arg_( "interpolation" ), arg( "canceller" ) = object() ) );
+	def( "resamplePrimitiveVariables", &resamplePrimitiveVariablesWrapper, ( arg_( "mesh" ), arg_( "primitiveVariables" ), arg_( "interpolation" ), arg( "canceller" ) = object() ) );
 	def( "deleteFaces", &deleteFacesWrapper, ( arg_( "meshPrimitive" ), arg_( "facesToDelete" ), arg_( "invert" ) = false, arg_( "canceller" ) = object() ) );
 	def( "reverseWinding", &reverseWindingWrapper, ( arg_( "meshPrimitive" ), arg_( "canceller" ) = object() ) );
 	def( "reorderVertices", &reorderVerticesWrapper, ( arg_( "mesh" ), arg_( "id0" ), arg_( "id1" ), arg_( "id2" ), arg_( "canceller" ) = object() ) );
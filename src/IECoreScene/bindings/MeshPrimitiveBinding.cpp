@@ -112,6 +112,7 @@ void IECoreSceneModule::bindMeshPrimitive()
 		.add_property( "vertexIds", &vertexIds, "A copy of the mesh's list of vertex ids." )
 		.add_property( "interpolation", make_function( &MeshPrimitive::interpolation, return_value_policy<copy_const_reference>() ), &MeshPrimitive::setInterpolation )
 		.def( "setTopology", &MeshPrimitive::setTopology )
+		.def( "setTopologyUnchecked", &MeshPrimitive::setTopologyUnchecked )
 		.def( "setInterpolation", &MeshPrimitive::setInterpolation )
 		.def( "setCorners", &MeshPrimitive::setCorners )
 		.def( "cornerIds", &cornerIds )
@@ -0,0 +1,158 @@
+//////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (c) 2026, Image Engine Design Inc. All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//
+//     * Neither the name of Image Engine Design nor the names of any
+//       other contributors to this software may be used to endorse or
+//       promote products derived from this software without specific prior
+//       written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+//  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+//  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+//  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+//  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+//  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+//  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+//  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+//  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+//  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//////////////////////////////////////////////////////////////////////////
+
+
+#include "boost/python.hpp"
+
+#include "MeshTopologyBinding.h"
+
+#include "IECoreScene/MeshTopology.h"
+
+#include "IECorePython/RefCountedBinding.h"
+#include "IECorePython/ScopedGILRelease.h"
+
+#include "IECore/VectorTypedData.h"
+
+using namespace boost::python;
+using namespace IECore;
+using namespace IECorePython;
+using namespace IECoreScene;
+
+// Avoid cluttering the global namespace.
+namespace
+{
+
+MeshTopologyPtr getWrapper( const MeshPrimitive *mesh, const Canceller *canceller )
+{
+	ConstMeshTopologyPtr topology;
+	{
+		ScopedGILRelease gilRelease;
+		topology = MeshTopology::get( mesh, canceller );
+	}
+	return const_cast<MeshTopology *>( topology.get() );
+}
+
+IntVectorDataPtr faceVertexOffsetsWrapper( const MeshTopology &topology )
+{
+	return new IntVectorData( topology.faceVertexOffsets() );
+}
+
+IntVectorDataPtr faceVertexFacesWrapper( const MeshTopology &topology )
+{
+	return new IntVectorData( topology.faceVertexFaces() );
+}
+
+// Returns a tuple of `( offsets, values )`.
+tuple adjacencyToTuple( const MeshTopology::Adjacency &adjacency )
+{
+	return boost::python::make_tuple(
+		IntVectorDataPtr( new IntVectorData( adjacency.offsets ) ),
+		IntVectorDataPtr( new IntVectorData( adjacency.values ) )
+	);
+}
+
+tuple vertexFaceVerticesWrapper( const MeshTopology &topology )
+{
+	return adjacencyToTuple( topology.vertexFaceVertices() );
+}
+
+tuple vertexFacesWrapper( const MeshTopology &topology, const Canceller *canceller )
+{
+	const MeshTopology::Adjacency *adjacency;
+	{
+		ScopedGILRelease gilRelease;
+		adjacency = &topology.vertexFaces( canceller );
+	}
+	return adjacencyToTuple( *adjacency );
+}
+
+tuple vertexNeighboursWrapper( const MeshTopology &topology, const Canceller *canceller )
+{
+	const MeshTopology::Adjacency *adjacency;
+	{
+		ScopedGILRelease gilRelease;
+		adjacency = &topology.vertexNeighbours( canceller );
+	}
+	return adjacencyToTuple( *adjacency );
+}
+
+V2iVectorDataPtr edgesWrapper( const MeshTopology &topology, const Canceller *canceller )
+{
+	const std::vector<Imath::V2i> *edges;
+	{
+		ScopedGILRelease gilRelease;
+		edges = &topology.edges( canceller );
+	}
+	return new V2iVectorData( *edges );
+}
+
+IntVectorDataPtr faceVertexEdgesWrapper( const MeshTopology &topology, const Canceller *canceller )
+{
+	const std::vector<int> *faceVertexEdges;
+	{
+		ScopedGILRelease gilRelease;
+		faceVertexEdges = &topology.faceVertexEdges( canceller );
+	}
+	return new IntVectorData( *faceVertexEdges );
+}
+
+} // namespace
+
+namespace IECoreSceneModule
+{
+
+void bindMeshTopology()
+{
+	RefCountedClass<MeshTopology, RefCounted>( "MeshTopology" )
+		.def( "get", &getWrapper, ( arg( "mesh" ), arg( "canceller" ) = object() ) ).staticmethod( "get" )
+		.def( "numFaces", &MeshTopology::numFaces )
+		.def( "numVertices", &MeshTopology::numVertices )
+		.def( "numFaceVertices", &MeshTopology::numFaceVertices )
+		.def( "faceVertexOffsets", &faceVertexOffsetsWrapper )
+		.def( "faceVertexFaces", &faceVertexFacesWrapper )
+		.def( "nextFaceVertex", &MeshTopology::nextFaceVertex )
+		.def( "vertexFaceVertices", &vertexFaceVerticesWrapper )
+		.def( "vertexFaces", &vertexFacesWrapper, ( arg( "canceller" ) = object() ) )
+		.def( "vertexNeighbours", &vertexNeighboursWrapper, ( arg( "canceller" ) = object() ) )
+		.def( "edges", &edgesWrapper, ( arg( "canceller" ) = object() ) )
+		.def( "faceVertexEdges", &faceVertexEdgesWrapper, ( arg( "canceller" ) = object() ) )
+		.def( "memoryUsage", &MeshTopology::memoryUsage )
+		.def( "setMaxCacheMemoryUsage", &MeshTopology::setMaxCacheMemoryUsage ).staticmethod( "setMaxCacheMemoryUsage" )
+		.def( "getMaxCacheMemoryUsage", &MeshTopology::getMaxCacheMemoryUsage ).staticmethod( "getMaxCacheMemoryUsage" )
+		.def( "cacheMemoryUsage", &MeshTopology::cacheMemoryUsage ).staticmethod( "cacheMemoryUsage" )
+		.def( "clearCache", &MeshTopology::clearCache ).staticmethod( "clearCache" )
+	;
+}
+
+} // namespace IECoreSceneModule
@@ -48,6 +48,17 @@ using namespace IECoreScene;
 namespace
 {
 
+dict statsToDict( const SceneAlgo::SceneStats &stats )
+{
+	dict result;
+	for (const auto &stat : stats )
+	{
+		result[stat.first] = stat.second;
+	}
+
+	return result;
+}
+
 dict parallelReadAll( const SceneInterface *src, int startFrame, int endFrame, float frameRate, unsigned int flags )
 {
 	SceneAlgo::SceneStats stats;
@@ -56,13 +67,24 @@ dict parallelReadAll( const SceneInterface *src, int startFrame, int endFrame, f
 		stats = SceneAlgo::parallelReadAll( src, startFrame, endFrame, frameRate, flags );
 	}
 
-	dict result;
-	for (const auto &stat : stats )
+	return statsToDict( stats );
+}
+
+void copy( const SceneInterface *src, SceneInterface *dst, int startFrame, int endFrame, float frameRate, unsigned int flags )
+{
+	IECorePython::ScopedGILRelease scopedGILRelease;
+	SceneAlgo::copy( src, dst, startFrame, endFrame, frameRate, flags );
+}
+
+dict copyWithStats( const SceneInterface *src, SceneInterface *dst, int startFrame, int endFrame, float frameRate, unsigned int flags )
+{
+	SceneAlgo::SceneStats stats;
 	{
-		result[stat.first] = stat.second;
+		IECorePython::ScopedGILRelease scopedGILRelease;
+		stats = SceneAlgo::copyWithStats( src, dst, startFrame, endFrame, frameRate, flags );
 	}
 
-	return result;
+	return statsToDict( stats );
 }
 
 } // namespace
@@ -92,7 +114,8 @@ void bindSceneAlgo()
 		.export_values()
 		;
 
-	def( "copy", &SceneAlgo::copy );
+	def( "copy", &::copy );
+	def( "copyWithStats", &::copyWithStats );
 
 	def( "parallelReadAll", &::parallelReadAll);
 }
@@ -38,12 +38,20 @@
 
 #include "SceneCacheBinding.h"
 
+#include "IECoreScene/MeshPrimitive.h"
+#include "IECoreScene/PointsPrimitive.h"
 #include "IECoreScene/SceneCache.h"
 #include "IECoreScene/SharedSceneInterfaces.h"
 
 #include "IECorePython/RunTimeTypedBinding.h"
 
+#include "IECore/CompoundData.h"
+#include "IECore/SimpleTypedData.h"
+
+#include "boost/lexical_cast.hpp"
+
 #include "tbb/blocked_range.h"
+#include "tbb/parallel_for.h"
 #include "tbb/parallel_reduce.h"
 
 using namespace tbb;
@@ -59,9 +67,9 @@ using namespace IECoreScene;
 namespace
 {
 
-SceneCachePtr constructor( const std::string &fileName, IndexedIO::OpenMode mode )
+SceneCachePtr constructor( const std::string &fileName, IndexedIO::OpenMode mode, IECore::CompoundDataPtr options )
 {
-	return new SceneCache( fileName, mode );
+	return new SceneCache( fileName, mode, options.get() );
 }
 
 SceneCachePtr constructor2( IECore::IndexedIOPtr indexedIO )
@@ -154,6 +162,52 @@ void testSceneCacheParallelFakeAttributeRead()
 	}
 }
 
+void writeSceneCacheChild( SceneInterface *root, size_t index )
+{
+	const std::string name = "child" + boost::lexical_cast<std::string>( index );
+	SceneInterfacePtr child = root->child( name, SceneInterface::CreateIfMissing );
+	for( int t = 0; t < 2; ++t )
+	{
+		child->writeTransform( new M44dData( Imath::M44d().translate( Imath::V3d( index, t, 0 ) ) ), t );
+		child->writeAttribute( "index", new IntData( index + t ), t );
+		child->writeObject( MeshPrimitive::createPlane( Imath::Box2f( Imath::V2f( -1.0f - t ), Imath::V2f( index ) ) ).get(), t );
+	}
+	child->writeTags( { "tag" + boost::lexical_cast<std::string>( index % 3 ) } );
+
+	SceneInterfacePtr grandChild = child->child( "grandChild", SceneInterface::CreateIfMissing );
+	grandChild->writeObject( new PointsPrimitive( new V3fVectorData( std::vector<Imath::V3f>( index + 1, Imath::V3f( index ) ) ) ), 0 );
+
+	PathMatcher set;
+	set.addPath( std::vector<InternedString>( { "grandChild" } ) );
+	child->writeSet( "set" + boost::lexical_cast<std::string>( index % 2 ), set );
+}
+
+// Writes an identical scene either serially or with the children of the root
+// written concurrently, so that the results can be compared.
+void testSceneCacheParallelWrite( const std::string &fileName, size_t numChildren, bool parallel )
+{
+	SceneInterfacePtr root = new SceneCache( fileName, IndexedIO::Write );
+	if( parallel )
+	{
+		parallel_for(
+			blocked_range<size_t>( 0, numChildren ),
+			[&root]( const blocked_range<size_t> &r ) {
+				for( size_t i = r.begin(); i != r.end(); ++i )
+				{
+					writeSceneCacheChild( root.get(), i );
+				}
+			}
+		);
+	}
+	else
+	{
+		for( size_t i = 0; i < numChildren; ++i )
+		{
+			writeSceneCacheChild( root.get(), i );
+		}
+	}
+}
+
 } // namespace
 
 //////////////////////////////////////////////////////////////////////////
@@ -166,12 +220,17 @@ namespace IECoreSceneModule
 void bindSceneCache()
 {
 	RunTimeTypedClass<SceneCache>()
-		.def( "__init__", make_constructor( &constructor ), "Opens a scene file for read or write." )
+		.def( "__init__", make_constructor( &constructor, default_call_policies(), ( arg( "fileName" ), arg( "mode" ), arg( "options" ) = object() ) ), "Opens a scene file for read or write." )
 		.def( "__init__", make_constructor( &constructor2 ), "Opens a scene from a previously opened file handle." )
+		.def( "setMaxCacheMemoryUsage", &SceneCache::setMaxCacheMemoryUsage ).staticmethod( "setMaxCacheMemoryUsage" )
+		.def( "getMaxCacheMemoryUsage", &SceneCache::getMaxCacheMemoryUsage ).staticmethod( "getMaxCacheMemoryUsage" )
+		.def( "cacheMemoryUsage", &SceneCache::cacheMemoryUsage ).staticmethod( "cacheMemoryUsage" )
+		.def( "cacheStatistics", &SceneCache::cacheStatistics, return_value_policy<reference_existing_object>() ).staticmethod( "cacheStatistics" )
 	;
 
 	def( "testSceneCacheParallelAttributeRead", &testSceneCacheParallelAttributeRead );
 	def( "testSceneCacheParallelFakeAttributeRead", &testSceneCacheParallelFakeAttributeRead );
+	def( "testSceneCacheParallelWrite", &testSceneCacheParallelWrite );
 
 }
 
@@ -59,6 +59,7 @@ void bindSharedSceneInterfaces()
 		.def( "setMaxScenes", SharedSceneInterfaces::setMaxScenes ).staticmethod( "setMaxScenes" )
 		.def( "getMaxScenes", SharedSceneInterfaces::getMaxScenes ).staticmethod( "getMaxScenes" )
 		.def( "numScenes", SharedSceneInterfaces::numScenes ).staticmethod( "numScenes" )
+		.def( "statistics", SharedSceneInterfaces::statistics, return_value_policy<reference_existing_object>() ).staticmethod( "statistics" )
 	;
 }
 
@@ -141,6 +141,8 @@ from TimeCodeDataTest import TimeCodeDataTest
 from NullObjectTest import NullObjectTest
 from StandardRadialLensModelTest import StandardRadialLensModelTest
 from ObjectPoolTest import ObjectPoolTest
+from SharedMemoryObjectCacheTest import SharedMemoryObjectCacheTest
+from DiskObjectCacheTest import DiskObjectCacheTest
 from RefCountedTest import RefCountedTest
 from DataAlgoTest import DataAlgoTest
 from PolygonAlgoTest import PolygonAlgoTest
@@ -150,6 +152,8 @@ from ReprTest import ReprTest
 from StringAlgoTest import StringAlgoTest
 from PathMatcherTest import PathMatcherTest
 from PathMatcherDataTest import PathMatcherDataTest
+from FrozenPathMatcherTest import FrozenPathMatcherTest
+from GILReleaseTest import GILReleaseTest
 from CancellerTest import CancellerTest
 
 unittest.TestProgram(
@@ -37,6 +37,8 @@
 #include "IECore/ComputationCache.h"
 #include "IECore/SimpleTypedData.h"
 
+#include "boost/filesystem/operations.hpp"
+
 #include "tbb/parallel_for.h"
 
 #include <iostream>
@@ -204,6 +206,87 @@ struct ComputationCacheTest
 		BOOST_CHECK_EQUAL( size_t(500), cache.cachedComputations() );
 	}
 
+	void testStatistics()
+	{
+		ObjectPoolPtr pool = new ObjectPool( 1024 * 1024 );
+		Cache cache( get, hash, 2, pool );
+
+		CacheStatistics::Snapshot s = cache.statistics().snapshot();
+		BOOST_CHECK_EQUAL( s.hits, 0u );
+		BOOST_CHECK_EQUAL( s.misses, 0u );
+
+		BOOST_CHECK( !cache.get( ComputationParams( 1 ), Cache::NullIfMissing ) );
+		BOOST_CHECK( cache.get( ComputationParams( 1 ) ) );
+		BOOST_CHECK( cache.get( ComputationParams( 1 ) ) );
+		s = cache.statistics().snapshot();
+		BOOST_CHECK_EQUAL( s.hits, 1u );
+		BOOST_CHECK_EQUAL( s.misses, 2u );
+		BOOST_CHECK_EQUAL( s.evictions, 0u );
+		BOOST_CHECK_EQUAL( s.currentCost, 1u );
+		BOOST_CHECK_EQUAL( s.maxCost, 2u );
+
+		cache.get( ComputationParams( 2 ) );
+		cache.get( ComputationParams( 3 ) );
+		s = cache.statistics().snapshot();
+		BOOST_CHECK_EQUAL( s.misses, 4u );
+		BOOST_CHECK_EQUAL( s.evictions, 1u );
+
+		cache.statistics().reset();
+		s = cache.statistics().snapshot();
+		BOOST_CHECK_EQUAL( s.hits, 0u );
+		BOOST_CHECK_EQUAL( s.misses, 0u );
+		BOOST_CHECK_EQUAL( s.evictions, 0u );
+		BOOST_CHECK_EQUAL( s.getterSeconds, 0.0 );
+	}
+
+	void testDiskCache()
+	{
+		const boost::filesystem::path directory = boost::filesystem::temp_directory_path() / boost::filesystem::unique_path();
+		DiskObjectCachePtr diskCache = new DiskObjectCache( directory.string(), 1024 * 1024 );
+
+		// Disk caching is opt-in.
+		Cache cache0( get, hash, 1000, new ObjectPool( 1024 * 1024 ) );
+		BOOST_CHECK( !cache0.diskCache() );
+
+		// And requires a namespace.
+		BOOST_CHECK_THROW( Cache( get, hash, 1000, new ObjectPool( 1024 * 1024 ), diskCache ), InvalidArgumentException );
+
+		Cache cache1( get, hash, 1000, new ObjectPool( 1024 * 1024 ), diskCache, "test" );
+		BOOST_CHECK_EQUAL( diskCache.get(), cache1.diskCache() );
+
+		int c1 = ComputationCacheTest::getCount;
+		ConstIntDataPtr v1 = runTimeCast<const IntData>( cache1.get( ComputationParams( 7 ) ) );
+		BOOST_CHECK_EQUAL( c1 + 1, ComputationCacheTest::getCount );
+		BOOST_CHECK_EQUAL( v1->readable(), 7 );
+		BOOST_CHECK_EQUAL( diskCache->statistics().snapshot().misses, 1u );
+
+		// A cache with a new ObjectPool, as in a new session,
+		// loads the result rather than recomputing it.
+		Cache cache2( get, hash, 1000, new ObjectPool( 1024 * 1024 ), diskCache, "test" );
+		ConstIntDataPtr v2 = runTimeCast<const IntData>( cache2.get( ComputationParams( 7 ) ) );
+		BOOST_CHECK_EQUAL( c1 + 1, ComputationCacheTest::getCount );
+		BOOST_CHECK( v2 );
+		BOOST_CHECK_EQUAL( v2->readable(), 7 );
+		BOOST_CHECK_EQUAL( diskCache->statistics().snapshot().hits, 1u );
+
+		// Without a disk cache, the result is recomputed.
+		Cache cache3( get, hash, 1000, new ObjectPool( 1024 * 1024 ), nullptr );
+		BOOST_CHECK( !cache3.diskCache() );
+		cache3.get( ComputationParams( 7 ) );
+		BOOST_CHECK_EQUAL( c1 + 2, ComputationCacheTest::getCount );
+
+		// A cache with a different namespace doesn't see
+		// the results of the first, even though the
+		// computation hashes are identical.
+		Cache cache4( get, hash, 1000, new ObjectPool( 1024 * 1024 ), diskCache, "otherTest" );
+		cache4.get( ComputationParams( 7 ) );
+		BOOST_CHECK_EQUAL( c1 + 3, ComputationCacheTest::getCount );
+		BOOST_CHECK_EQUAL( diskCache->statistics().snapshot().hits, 1u );
+
+		diskCache = nullptr;
+		boost::filesystem::remove_all( directory );
+	}
+
 };
 
 int ComputationCacheTest::getCount(0);
@@ -217,6 +300,8 @@ struct ComputationCacheTestSuite : public boost::unit_test::test_suite
 
 		add( BOOST_CLASS_TEST_CASE( &ComputationCacheTest::test, instance ) );
 		add( BOOST_CLASS_TEST_CASE( &ComputationCacheTest::testThreadedGet, instance ) );
+		add( BOOST_CLASS_TEST_CASE( &ComputationCacheTest::testStatistics, instance ) );
+		add( BOOST_CLASS_TEST_CASE( &ComputationCacheTest::testDiskCache, instance ) );
 	}
 };
 
@@ -0,0 +1,183 @@
+##########################################################################
+#
+#  Copyright (c) 2026, Image Engine Design Inc. All rights reserved.
+#
+#  Redistribution and use in source and binary forms, with or without
+#  modification, are permitted provided that the following conditions are
+#  met:
+#
+#      * Redistributions of source code must retain the above
+#        copyright notice, this list of conditions and the following
+#        disclaimer.
+#
+#      * Redistributions in binary form must reproduce the above
+#        copyright notice, this list of conditions and the following
+#        disclaimer in the documentation and/or other materials provided with
+#        the distribution.
+#
+#      * Neither the name of John Haddon nor the names of
+#        any other contributors to this software may be used to endorse or
+#        promote products derived from this software without specific prior
+#        written permission.
+#
+#  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+#  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+#  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+#  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+#  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+#  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+#  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+#  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+#  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+#  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+#  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#
+##########################################################################
+
+import os
+import shutil
+import tempfile
+import unittest
+
+import IECore
+
+class DiskObjectCacheTest( unittest.TestCase ) :
+
+	def setUp( self ) :
+
+		self.tempDir = tempfile.mkdtemp()
+
+	def tearDown( self ) :
+
+		shutil.rmtree( self.tempDir )
+
+	def testStoreAndRetrieve( self ) :
+
+		directory = os.path.join( self.tempDir, "cache" )
+		c = IECore.DiskObjectCache( directory, 1024 * 1024 )
+		self.assertTrue( os.path.isdir( directory ) )
+		self.assertEqual( c.directory(), directory )
+		self.assertEqual( c.getMaxDiskUsage(), 1024 * 1024 )
+		self.assertEqual( c.diskUsage(), 0 )
+
+		o = IECore.CompoundObject( { "a" : IECore.IntVectorData( range( 0, 1000 ) ), "b" : IECore.StringData( "b" ) } )
+		key = IECore.MurmurHash()
+		key.append( o.hash() )
+		key.append( "operation" )
+
+		self.assertFalse( c.contains( key ) )
+		self.assertIsNone( c.retrieve( key ) )
+
+		c.store( key, o )
+		self.assertTrue( c.contains( key ) )
+		self.assertGreater( c.diskUsage(), 0 )
+		self.assertEqual( c.retrieve( key ), o )
+
+		# Storing with an existing key replaces the object.
+		c.store( key, IECore.IntData( 1 ) )
+		self.assertEqual( c.retrieve( key ), IECore.IntData( 1 ) )
+
+		self.assertTrue( c.erase( key ) )
+		self.assertFalse( c.erase( key ) )
+		self.assertFalse( c.contains( key ) )
+		self.assertEqual( c.diskUsage(), 0 )
+
+	def testPersistence( self ) :
+
+		o = IECore.IntVectorData( range( 0, 100 ) )
+
+		c = IECore.DiskObjectCache( self.tempDir, 1024 * 1024 )
+		c.store( o.hash(), o )
+		diskUsage = c.diskUsage()
+		del c
+
+		c = IECore.DiskObjectCache( self.tempDir, 1024 * 1024 )
+		self.assertEqual( c.diskUsage(), diskUsage )
+		self.assertEqual( c.retrieve( o.hash() ), o )
+
+	def testLeastRecentlyUsedEviction( self ) :
+
+		objects = [ IECore.IntVectorData( [ i ] * 1000 ) for i in range( 0, 4 ) ]
+
+		c = IECore.DiskObjectCache( self.tempDir, 1024 * 1024 )
+		for o in objects[:3] :
+			c.store( o.hash(), o )
+
+		# Limit the cache to three objects, and use the
+		# first, so that the second is the least recently used.
+		c.setMaxDiskUsage( c.diskUsage() )
+		self.assertEqual( c.retrieve( objects[0].hash() ), objects[0] )
+
+		c.store( objects[3].hash(), objects[3] )
+		self.assertLessEqual( c.diskUsage(), c.getMaxDiskUsage() )
+		self.assertTrue( c.contains( objects[0].hash() ) )
+		self.assertFalse( c.contains( objects[1].hash() ) )
+		self.assertTrue( c.contains( objects[3].hash() ) )
+		self.assertEqual( c.statistics().snapshot().evictions, 1 )
+
+		c.setMaxDiskUsage( 0 )
+		self.assertEqual( c.diskUsage(), 0 )
+		for o in objects :
+			self.assertFalse( c.contains( o.hash() ) )
+
+	def testNoPartialFiles( self ) :
+
+		c = IECore.DiskObjectCache( self.tempDir, 1024 * 1024 )
+		o = IECore.StringData( "a" )
+		c.store( o.hash(), o )
+
+		files = []
+		for root, dirs, fileNames in os.walk( self.tempDir ) :
+			files.extend( fileNames )
+
+		self.assertEqual( files, [ o.hash().toString() + ".cob" ] )
+
+	def testUnreadableFilesRemoved( self ) :
+
+		c = IECore.DiskObjectCache( self.tempDir, 1024 * 1024 )
+		o = IECore.StringData( "a" )
+		c.store( o.hash(), o )
+
+		fileName = os.path.join( self.tempDir, o.hash().toString()[:2], o.hash().toString() + ".cob" )
+		self.assertTrue( os.path.exists( fileName ) )
+		with open( fileName, "w" ) as f :
+			f.write( "not an object" )
+
+		with IECore.CapturingMessageHandler() as mh :
+			self.assertIsNone( c.retrieve( o.hash() ) )
+
+		self.assertEqual( len( mh.messages ), 1 )
+		self.assertEqual( mh.messages[0].level, IECore.Msg.Level.Warning )
+		self.assertFalse( os.path.exists( fileName ) )
+		self.assertEqual( c.diskUsage(), 0 )
+
+	def testClear( self ) :
+
+		c1 = IECore.DiskObjectCache( self.tempDir, 1024 * 1024 )
+		c2 = IECore.DiskObjectCache( self.tempDir, 1024 * 1024 )
+
+		o = IECore.StringData( "a" )
+		c2.store( o.hash(), o )
+		self.assertTrue( c1.contains( o.hash() ) )
+
+		c1.clear()
+		self.assertEqual( c1.diskUsage(), 0 )
+		self.assertFalse( c1.contains( o.hash() ) )
+		self.assertIsNone( c2.retrieve( o.hash() ) )
+
+	def testStatistics( self ) :
+
+		c = IECore.DiskObjectCache( self.tempDir, 1024 * 1024 )
+		o = IECore.IntData( 1 )
+		c.store( o.hash(), o )
+
+		c.retrieve( o.hash() )
+		c.retrieve( IECore.IntData( 2 ).hash() )
+		s = c.statistics().snapshot()
+		self.assertEqual( s.hits, 1 )
+		self.assertEqual( s.misses, 1 )
+		self.assertEqual( s.currentCost, c.diskUsage() )
+		self.assertEqual( s.maxCost, 1024 * 1024 )
+
+if __name__ == "__main__":
+	unittest.main()
@@ -0,0 +1,196 @@
+##########################################################################
+#
+#  Copyright (c) 2026, Image Engine Design Inc. All rights reserved.
+#
+#  Redistribution and use in source and binary forms, with or without
+#  modification, are permitted provided that the following conditions are
+#  met:
+#
+#      * Redistributions of source code must retain the above
+#        copyright notice, this list of conditions and the following
+#        disclaimer.
+#
+#      * Redistributions in binary form must reproduce the above
+#        copyright notice, this list of conditions and the following
+#        disclaimer in the documentation and/or other materials provided with
+#        the distribution.
+#
+#      * Neither the name of John Haddon nor the names of
+#        any other contributors to this software may be used to endorse or
+#        promote products derived from this software without specific prior
+#        written permission.
+#
+#  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+#  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+#  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+#  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+#  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+#  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+#  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+#  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+#  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+#  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+#  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#
+##########################################################################
+
+import os
+import random
+import unittest
+
+import IECore
+
+class FrozenPathMatcherTest( unittest.TestCase ) :
+
+	@staticmethod
+	def generatePaths( seed, depthRange, numChildrenRange, names ) :
+
+		r = random.Random( seed )
+		paths = []
+
+		def walk( path, depth ) :
+
+			if depth >= depthRange[1] :
+				return
+			if depth >= depthRange[0] and r.random() < 0.5 :
+				paths.append( path )
+
+			for i in range( 0, r.randint( *numChildrenRange ) ) :
+				walk( path + "/" + r.choice( names ), depth + 1 )
+
+		walk( "", 0 )
+		return [ p or "/" for p in paths ]
+
+	def testEmpty( self ) :
+
+		f = IECore.FrozenPathMatcher()
+		self.assertTrue( f.isEmpty() )
+		self.assertEqual( f.size(), 0 )
+		self.assertEqual( f.paths(), [] )
+		self.assertEqual( f.match( "/a" ), IECore.PathMatcher.Result.NoMatch )
+		self.assertEqual( f, IECore.FrozenPathMatcher( IECore.PathMatcher() ) )
+		self.assertEqual( f.pathMatcher(), IECore.PathMatcher() )
+
+	def testMatchesPathMatcher( self ) :
+
+		names = [ "a", "b", "c", "d*", "*", "...", "e", "f[ab]", "g?" ]
+		queryNames = [ "a", "b", "c", "d", "dd", "e", "fa", "fc", "g", "gg", "x" ]
+
+		r = random.Random( 0 )
+		for seed in range( 0, 20 ) :
+
+			paths = self.generatePaths( seed, ( 0, 5 ), ( 0, 3 ), names )
+			m = IECore.PathMatcher( paths )
+			f = IECore.FrozenPathMatcher( m )
+
+			self.assertEqual( f.isEmpty(), m.isEmpty() )
+			self.assertEqual( f.size(), m.size() )
+			self.assertEqual( sorted( f.paths() ), sorted( m.paths() ) )
+			self.assertEqual( f.pathMatcher(), m )
+
+			for i in range( 0, 200 ) :
+				path = "/" + "/".join( r.choice( queryNames ) for j in range( 0, r.randint( 0, 6 ) ) )
+				self.assertEqual( f.match( path ), m.match( path ), path )
+
+	def testWideNodes( self ) :
+
+		# Nodes with many children use a hash table
+		# rather than a binary search.
+
+		m = IECore.PathMatcher()
+		for i in range( 0, 1000 ) :
+			m.addPath( "/a{0}/b{1}".format( i, i % 17 ) )
+		m.addPath( "/*/c" )
+
+		f = IECore.FrozenPathMatcher( m )
+		self.assertEqual( f.size(), m.size() )
+
+		for i in range( 0, 1100 ) :
+			for path in [ "/a{0}".format( i ), "/a{0}/b{1}".format( i, i % 17 ), "/a{0}/b{1}".format( i, i % 13 ), "/a{0}/c".format( i ) ] :
+				self.assertEqual( f.match( path ), m.match( path ), path )
+
+	def testSharedSubtrees( self ) :
+
+		s = IECore.PathMatcher( [ "/a/b", "/a/c" ] )
+		m = IECore.PathMatcher()
+		m.addPaths( s, "/x" )
+		m.addPaths( s, "/y/z" )
+
+		f = IECore.FrozenPathMatcher( m )
+		self.assertEqual( sorted( f.paths() ), sorted( m.paths() ) )
+		self.assertEqual( f.pathMatcher(), m )
+
+		# Editing the thawed PathMatcher must not affect
+		# the shared subtrees.
+		t = f.pathMatcher()
+		t.addPath( "/x/a/d" )
+		self.assertEqual( t.match( "/y/z/a/d" ), IECore.PathMatcher.Result.NoMatch )
+		self.assertEqual( f.match( "/x/a/d" ), IECore.PathMatcher.Result.NoMatch )
+
+	def testEquality( self ) :
+
+		f1 = IECore.FrozenPathMatcher( IECore.PathMatcher( [ "/a/b", "/c" ] ) )
+		f2 = IECore.FrozenPathMatcher( IECore.PathMatcher( [ "/c", "/a/b" ] ) )
+		f3 = IECore.FrozenPathMatcher( IECore.PathMatcher( [ "/a/b", "/d" ] ) )
+		f4 = IECore.FrozenPathMatcher( IECore.PathMatcher( [ "/a/b", "/c", "/" ] ) )
+
+		self.assertEqual( f1, f2 )
+		self.assertEqual( f1, IECore.FrozenPathMatcher( f1 ) )
+		self.assertNotEqual( f1, f3 )
+		self.assertNotEqual( f1, f4 )
+
+	def testIteration( self ) :
+
+		names = [ "a", "b", "*", "...", "c?" ]
+		for seed in range( 0, 20 ) :
+			m = IECore.PathMatcher( self.generatePaths( seed, ( 0, 5 ), ( 0, 3 ), names ) )
+			IECore.testFrozenPathMatcherIteration( m )
+
+		IECore.testFrozenPathMatcherIteration( IECore.PathMatcher() )
+		IECore.testFrozenPathMatcherIteration( IECore.PathMatcher( [ "/" ] ) )
+
+	def testSubTree( self ) :
+
+		m = IECore.PathMatcher( [ "/a/b/c", "/a/b/d", "/a/*/e", "/f", "/" ] )
+		f = IECore.FrozenPathMatcher( m )
+
+		for root in [ "/", "/a", "/a/b", "/a/*", "/a/b/c", "/f", "/g", "/a/c" ] :
+			s = f.subTree( root )
+			self.assertEqual( s.pathMatcher(), m.subTree( root ) )
+			self.assertEqual( s, IECore.FrozenPathMatcher( m.subTree( root ) ) )
+			self.assertEqual( s.size(), m.subTree( root ).size() )
+			self.assertEqual( sorted( s.paths() ), sorted( m.subTree( root ).paths() ) )
+			for path in [ "/", "/b", "/b/c", "/x/e", "/c" ] :
+				self.assertEqual( s.match( path ), m.subTree( root ).match( path ) )
+
+		self.assertTrue( f.subTree( "/g" ).isEmpty() )
+		self.assertEqual( f.subTree( "/" ), f )
+
+	def testRepr( self ) :
+
+		f = IECore.FrozenPathMatcher( IECore.PathMatcher( [ "/a/b", "/c/*" ] ) )
+		self.assertEqual( eval( repr( f ) ), f )
+
+	@unittest.skipUnless( os.environ.get("CORTEX_PERFORMANCE_TEST", False), "'CORTEX_PERFORMANCE_TEST' env var not set" )
+	def testMatchPerformance( self ) :
+
+		paths = IECore.StringVectorData()
+		for i in range( 0, 1000000 ) :
+			paths.append( "/group{0}/asset{1}/geo{2}/mesh".format( i % 100, ( i // 100 ) % 1000, i // 100000 ) )
+
+		m = IECore.PathMatcher( paths )
+		f = IECore.FrozenPathMatcher( m )
+
+		random.Random( 0 ).shuffle( paths )
+
+		# Timings are reported rather than compared, as they
+		# are too noisy to assert on reliably.
+		pathMatcherTime = IECore.testPathMatcherMatchPerformance( m, paths, 1 )
+		frozenTime = IECore.testPathMatcherMatchPerformance( f, paths, 1 )
+		print( "PathMatcher : {0:.3f}s, FrozenPathMatcher : {1:.3f}s".format( pathMatcherTime, frozenTime ) )
+
+		for path in paths[:1000] :
+			self.assertEqual( f.match( path ), m.match( path ) )
+
+if __name__ == "__main__":
+	unittest.main()
@@ -0,0 +1,114 @@
+##########################################################################
+#
+#  Copyright (c) 2026, Image Engine Design Inc. All rights reserved.
+#
+#  Redistribution and use in source and binary forms, with or without
+#  modification, are permitted provided that the following conditions are
+#  met:
+#
+#      * Redistributions of source code must retain the above
+#        copyright notice, this list of conditions and the following
+#        disclaimer.
+#
+#      * Redistributions in binary form must reproduce the above
+#        copyright notice, this list of conditions and the following
+#        disclaimer in the documentation and/or other materials provided with
+#        the distribution.
+#
+#      * Neither the name of John Haddon nor the names of
+#        any other contributors to this software may be used to endorse or
+#        promote products derived from this software without specific prior
+#        written permission.
+#
+#  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+#  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+#  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+#  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+#  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+#  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+#  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+#  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+#  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+#  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+#  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#
+##########################################################################
+
+import os
+import unittest
+
+import IECore
+
+class GILReleaseTest( unittest.TestCase ) :
+
+	__fileName = os.path.join( "test", "gilRelease.fio" )
+	__cobFileName = os.path.join( "test", "gilRelease.cob" )
+
+	def __data( self ) :
+
+		return IECore.FloatVectorData( 20 * 1024 * 1024 )
+
+	@unittest.skipIf( ( IECore.TestUtil.inMacCI() or IECore.TestUtil.inWindowsCI() ), "Mac and Windows CI are too slow for reliable timing" )
+	def testHarness( self ) :
+
+		# Sanity check that `releasesGIL()` can tell the difference
+		# between calls that do and don't release the GIL.
+		d = self.__data()
+		self.assertFalse( IECore.TestUtil.releasesGIL( d.hash ) )
+
+		f = IECore.FileIndexedIO( self.__fileName, [], IECore.IndexedIO.OpenMode.Write )
+		d.save( f, "d" )
+		del f
+
+		f = IECore.FileIndexedIO( self.__fileName, [], IECore.IndexedIO.OpenMode.Read )
+		self.assertTrue( IECore.TestUtil.releasesGIL( lambda : IECore.Object.load( f, "d" ) ) )
+
+	@unittest.skipIf( ( IECore.TestUtil.inMacCI() or IECore.TestUtil.inWindowsCI() ), "Mac and Windows CI are too slow for reliable timing" )
+	def testIndexedIO( self ) :
+
+		d = self.__data()
+
+		f = IECore.FileIndexedIO( self.__fileName, [], IECore.IndexedIO.OpenMode.Write )
+		self.assertTrue( IECore.TestUtil.releasesGIL( lambda : f.write( "array", d ) ) )
+		del f
+
+		f = IECore.FileIndexedIO( self.__fileName, [], IECore.IndexedIO.OpenMode.Read )
+		result = []
+		self.assertTrue( IECore.TestUtil.releasesGIL( lambda : result.append( f.read( "array" ) ) ) )
+		self.assertEqual( result[0], d )
+
+	@unittest.skipIf( ( IECore.TestUtil.inMacCI() or IECore.TestUtil.inWindowsCI() ), "Mac and Windows CI are too slow for reliable timing" )
+	def testObjectSaveAndLoad( self ) :
+
+		d = self.__data()
+
+		f = IECore.FileIndexedIO( self.__fileName, [], IECore.IndexedIO.OpenMode.Write )
+		self.assertTrue( IECore.TestUtil.releasesGIL( lambda : d.save( f, "d" ) ) )
+		del f
+
+		f = IECore.FileIndexedIO( self.__fileName, [], IECore.IndexedIO.OpenMode.Read )
+		result = []
+		self.assertTrue( IECore.TestUtil.releasesGIL( lambda : result.append( IECore.Object.load( f, "d" ) ) ) )
+		self.assertEqual( result[0], d )
+
+	@unittest.skipIf( ( IECore.TestUtil.inMacCI() or IECore.TestUtil.inWindowsCI() ), "Mac and Windows CI are too slow for reliable timing" )
+	def testObjectReaderAndWriter( self ) :
+
+		d = self.__data()
+
+		w = IECore.ObjectWriter( d, self.__cobFileName )
+		self.assertTrue( IECore.TestUtil.releasesGIL( w.write ) )
+
+		r = IECore.ObjectReader( self.__cobFileName )
+		result = []
+		self.assertTrue( IECore.TestUtil.releasesGIL( lambda : result.append( r.read() ) ) )
+		self.assertEqual( result[0], d )
+
+	def tearDown( self ) :
+
+		for f in ( self.__fileName, self.__cobFileName ) :
+			if os.path.isfile( f ) :
+				os.remove( f )
+
+if __name__ == "__main__":
+	unittest.main()
@@ -38,6 +38,7 @@ import os
 import unittest
 import math
 import random
+import imath
 
 import IECore
 
@@ -102,6 +103,46 @@ class TestMemoryIndexedIO(unittest.TestCase):
 		self.assertEqual( txt, IECore.Object.load( f2, "obj1" ) )
 		self.assertEqual( txt, IECore.Object.load( f2, "obj2" ) )
 
+	def testReadSharesBuffer( self ) :
+
+		f = IECore.MemoryIndexedIO( IECore.CharVectorData(), [], IECore.IndexedIO.OpenMode.Write )
+		small = IECore.IntVectorData( range( 0, 10 ) )
+		large = IECore.V3fVectorData( [ imath.V3f( i ) for i in range( 0, 1000 ) ] )
+		f.write( "small", small )
+		f.write( "large", large )
+		f.write( "string", IECore.StringData( "shared" ) )
+
+		buf = f.buffer()
+		f2 = IECore.MemoryIndexedIO( buf, [], IECore.IndexedIO.OpenMode.Read )
+
+		# Modifying the buffer must not affect the reader
+		for i in range( 0, len( buf ) ) :
+			buf[i] = 0
+
+		self.assertEqual( f2.read( "small" ), small )
+		self.assertEqual( f2.read( "large" ), large )
+		self.assertEqual( f2.read( "string" ), IECore.StringData( "shared" ) )
+
+	def testReadModeBuffer( self ) :
+
+		f = IECore.MemoryIndexedIO( IECore.CharVectorData(), [], IECore.IndexedIO.OpenMode.Write )
+		f.write( "large", IECore.V3fVectorData( [ imath.V3f( i ) for i in range( 0, 1000 ) ] ) )
+		buf = f.buffer()
+
+		f2 = IECore.MemoryIndexedIO( buf, [], IECore.IndexedIO.OpenMode.Read )
+		buf2 = f2.buffer()
+		self.assertEqual( buf2, buf )
+
+		# Modifying the returned buffer must not affect the reader
+		for i in range( 0, len( buf2 ) ) :
+			buf2[i] = 0
+
+		self.assertEqual( f2.read( "large" ), f.read( "large" ) )
+
+	def testReadModeRequiresBuffer( self ) :
+
+		self.assertRaises( Exception, IECore.MemoryIndexedIO, None, [], IECore.IndexedIO.OpenMode.Read )
+
 	@unittest.skipUnless( os.environ.get("CORTEX_PERFORMANCE_TEST", False), "'CORTEX_PERFORMANCE_TEST' env var not set" )
 	def testRmStress(self) :
 		"""Test MemoryIndexedIO rm (stress test)"""
@@ -623,6 +664,184 @@ class TestFileIndexedIO(unittest.TestCase):
 
 		self.assertEqual( d, d2 )
 
+	def testIncompressibleDataSpanningManyBlocks( self ) :
+
+		filePath = os.path.join( ".", "test", "FileIndexedIO.fio" )
+		options = IECore.CompoundData( { "compressor" : "lz4", "compressionLevel" : 9, "maxCompressedBlockSize" : IECore.UIntData( 4096 ) } )
+
+		random.seed( 0 )
+		d = IECore.UCharVectorData( [ random.randint( 0, 255 ) for i in range( 0, 1024 * 1024 ) ] )
+
+		f = IECore.IndexedIO.create( filePath, [], IECore.IndexedIO.OpenMode.Write, options = options )
+		f.write( "foo", d )
+		del f
+
+		f = IECore.IndexedIO.create( filePath, [], IECore.IndexedIO.OpenMode.Read )
+		self.assertEqual( f.read( "foo" ), d )
+
+	@unittest.skipUnless( os.environ.get("CORTEX_PERFORMANCE_TEST", False), "'CORTEX_PERFORMANCE_TEST' env var not set" )
+	def testLargeCompressedReadPerformance( self ) :
+
+		filePath = os.path.join( ".", "test", "FileIndexedIO.fio" )
+		options = IECore.CompoundData( { "compressor" : "lz4", "compressionLevel" : 5 } )
+
+		# 3GB point cloud, with enough variation to be
+		# representative of real compression ratios.
+		random.seed( 0 )
+		chunk = IECore.V3fVectorData( [ imath.V3f( random.random(), random.random(), random.random() ) for i in range( 0, 1024 * 1024 ) ] )
+		p = IECore.V3fVectorData()
+		for i in range( 0, 256 ) :
+			p.extend( chunk )
+
+		f = IECore.IndexedIO.create( filePath, [], IECore.IndexedIO.OpenMode.Write, options = options )
+		f.write( "P", p )
+		del f, p
+
+		f = IECore.IndexedIO.create( filePath, [], IECore.IndexedIO.OpenMode.Read )
+		for i in range( 0, 3 ) :
+			t = IECore.Timer( True, IECore.Timer.Mode.WallClock )
+			p = f.read( "P" )
+			elapsed = t.stop()
+			print( "read {0} bytes in {1}s ({2} MB/s)".format( len( p ) * 12, elapsed, len( p ) * 12 / ( elapsed * 1024 * 1024 ) ) )
+			del p
+
+	def testShuffleAndDataTypeCompression( self ) :
+
+		filePath = os.path.join( ".", "test", "FileIndexedIO.fio" )
+
+		random.seed( 0 )
+		data = {
+			"floats" : IECore.FloatVectorData( [ random.random() for i in range( 0, 10000 ) ] ),
+			"doubles" : IECore.DoubleVectorData( [ random.random() for i in range( 0, 10000 ) ] ),
+			"ints" : IECore.IntVectorData( range( 0, 10000 ) ),
+			"shorts" : IECore.ShortVectorData( [ i % 100 for i in range( 0, 10000 ) ] ),
+			"uchars" : IECore.UCharVectorData( [ i % 3 for i in range( 0, 10000 ) ] ),
+		}
+
+		sizes = {}
+		for shuffle in ( "auto", "none", "byte", "bit", "invalid" ) :
+
+			options = IECore.CompoundData( {
+				"compressor" : "lz4",
+				"compressionLevel" : 9,
+				"shuffle" : shuffle,
+				"dataTypeCompression" : {
+					"IntArray" : { "compressor" : "zlib", "shuffle" : "bit" },
+					"DoubleArray" : { "compressionLevel" : 0 },
+				}
+			} )
+
+			messageHandler = IECore.CapturingMessageHandler()
+			with messageHandler :
+				f = IECore.IndexedIO.create( filePath, [], IECore.IndexedIO.OpenMode.Write, options = options )
+
+			# Unknown shuffle names are ignored, but not silently.
+			if shuffle == "invalid" :
+				self.assertEqual( len( messageHandler.messages ), 1 )
+				self.assertEqual( messageHandler.messages[0].level, IECore.Msg.Level.Warning )
+				self.assertIn( "invalid", messageHandler.messages[0].message )
+			else :
+				self.assertEqual( len( messageHandler.messages ), 0 )
+
+			for name, value in data.items() :
+				f.write( name, value )
+			del f
+
+			sizes[shuffle] = os.path.getsize( filePath )
+
+			f = IECore.IndexedIO.create( filePath, [], IECore.IndexedIO.OpenMode.Read )
+			for name, value in data.items() :
+				self.assertEqual( f.read( name ), value )
+
+		self.assertEqual( sizes["invalid"], sizes["auto"] )
+		self.assertLess( sizes["byte"], sizes["none"] )
+
+	def testMinCompressionRatio( self ) :
+
+		filePath = os.path.join( ".", "test", "FileIndexedIO.fio" )
+
+		# Random floats shuffle into partially compressible data.
+		random.seed( 0 )
+		d = IECore.FloatVectorData( [ random.random() for i in range( 0, 100000 ) ] )
+
+		for ratio, expectUncompressed in ( ( 1.0, False ), ( 100.0, True ) ) :
+
+			options = IECore.CompoundData( { "compressor" : "lz4", "compressionLevel" : 9, "minCompressionRatio" : ratio } )
+			f = IECore.IndexedIO.create( filePath, [], IECore.IndexedIO.OpenMode.Write, options = options )
+			f.write( "foo", d )
+			del f
+
+			self.assertEqual( os.path.getsize( filePath ) >= len( d ) * 4, expectUncompressed )
+
+			f = IECore.IndexedIO.create( filePath, [], IECore.IndexedIO.OpenMode.Read )
+			self.assertEqual( f.read( "foo" ), d )
+
+	def testAsynchronousCompression( self ) :
+
+		filePath = os.path.join( ".", "test", "FileIndexedIO.fio" )
+
+		random.seed( 0 )
+		data = {
+			"ints" : IECore.IntVectorData( range( 0, 100000 ) ),
+			"duplicateInts" : IECore.IntVectorData( range( 0, 100000 ) ),
+			"floats" : IECore.FloatVectorData( [ random.random() for i in range( 0, 10000 ) ] ),
+			"small" : IECore.IntVectorData( [ 1, 2, 3 ] ),
+			"string" : IECore.StringData( "a" * 10000 ),
+		}
+
+		contents = []
+		for asynchronous in ( False, True ) :
+
+			options = IECore.CompoundData( { "compressor" : "lz4", "compressionLevel" : 9, "asynchronousCompression" : asynchronous } )
+			f = IECore.IndexedIO.create( filePath, [], IECore.IndexedIO.OpenMode.Write, options = options )
+			for i in range( 0, 10 ) :
+				g = f.subdirectory( str( i ), IECore.IndexedIO.MissingBehaviour.CreateIfMissing )
+				for name in sorted( data.keys() ) :
+					g.write( name, data[name] )
+			del f, g
+
+			with open( filePath, "rb" ) as fileContents :
+				contents.append( fileContents.read() )
+
+			f = IECore.IndexedIO.create( filePath, [], IECore.IndexedIO.OpenMode.Read )
+			for i in range( 0, 10 ) :
+				g = f.subdirectory( str( i ) )
+				for name, d in data.items() :
+					self.assertEqual( g.read( name ), d )
+
+		# Writes are committed in order, so the files are identical.
+		self.assertEqual( contents[0], contents[1] )
+
+	def testAsynchronousCompressionWithRemoval( self ) :
+
+		filePath = os.path.join( ".", "test", "FileIndexedIO.fio" )
+
+		first = IECore.IntVectorData( range( 0, 100000 ) )
+		second = IECore.IntVectorData( range( 100000, 0, -1 ) )
+
+		options = IECore.CompoundData( { "compressor" : "lz4", "compressionLevel" : 9, "asynchronousCompression" : True } )
+		f = IECore.IndexedIO.create( filePath, [], IECore.IndexedIO.OpenMode.Write, options = options )
+		for i in range( 0, 10 ) :
+			g = f.subdirectory( str( i ), IECore.IndexedIO.MissingBehaviour.CreateIfMissing )
+			# Overwrite and remove entries while their writes are still pending.
+			g.write( "overwritten", first )
+			g.write( "overwritten", second )
+			g.write( "removed", first )
+			g.remove( "removed" )
+			g.write( "kept", first )
+			h = g.subdirectory( "removedDirectory", IECore.IndexedIO.MissingBehaviour.CreateIfMissing )
+			h.write( "data", first )
+			del h
+			g.remove( "removedDirectory" )
+		del f, g
+
+		f = IECore.IndexedIO.create( filePath, [], IECore.IndexedIO.OpenMode.Read )
+		for i in range( 0, 10 ) :
+			g = f.subdirectory( str( i ) )
+			self.assertEqual( sorted( g.entryIds() ), [ "kept", "overwritten" ] )
+			self.assertEqual( g.read( "overwritten" ), second )
+			self.assertEqual( g.read( "kept" ), first )
+
 	def testCompressionParametersAndVersionStoredInMetaData( self ):
 
 		options = IECore.CompoundData( { "compressor" : "zlib", "compressionLevel" : 3 } )
@@ -670,6 +889,38 @@ class TestFileIndexedIO(unittest.TestCase):
 		self.assertEqual( f.metadata(),
 			IECore.CompoundData( { "compressor" : "lz4", "compressionLevel" : 0, 'version': IECore.IntData( 7 ), "compressionThreadCount" : 1, "decompressionThreadCount" : 1 } ) )
 
+	def testMemoryMappedRead( self ) :
+
+		filePath = os.path.join( ".", "test", "FileIndexedIO.fio" )
+
+		data = {
+			"small" : IECore.FloatVectorData( [ 1, 2, 3 ] ),
+			"large" : IECore.IntVectorData( range( 0, 100000 ) ),
+			"string" : IECore.StringData( "mapped" ),
+			"int" : IECore.IntData( 10 ),
+			"internedStrings" : IECore.InternedStringVectorData( [ "a", "b", "c" ] ),
+		}
+
+		for level in ( 0, 9 ) :
+
+			options = IECore.CompoundData( { "compressor" : "lz4", "compressionLevel" : level } )
+			f = IECore.IndexedIO.create( filePath, [], IECore.IndexedIO.OpenMode.Write, options = options )
+			g = f.subdirectory( "sub1", IECore.IndexedIO.MissingBehaviour.CreateIfMissing )
+			for name, value in data.items() :
+				g.write( name, value )
+			del g, f
+
+			f = IECore.IndexedIO.create( filePath, [], IECore.IndexedIO.OpenMode.Read, options = IECore.CompoundData( { "memoryMapped" : True } ) )
+			g = f.subdirectory( "sub1" )
+			for name, value in data.items() :
+				self.assertEqual( g.read( name ), value )
+
+			# Append mode never maps the file, but must still accept the option.
+			del g, f
+			f = IECore.IndexedIO.create( filePath, [], IECore.IndexedIO.OpenMode.Append, options = IECore.CompoundData( { "memoryMapped" : True } ) )
+			f.subdirectory( "sub1" ).write( "appended", IECore.IntData( 1 ) )
+			self.assertEqual( f.subdirectory( "sub1" ).read( "large" ), data["large"] )
+
 	def setUp( self ):
 
 		if os.path.isfile(os.path.join( ".", "test", "FileIndexedIO.fio" )) :
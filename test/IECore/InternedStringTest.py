@@ -33,6 +33,7 @@
 #
 ##########################################################################
 
+import os
 import unittest
 import six
 import IECore
@@ -109,6 +110,33 @@ class InternedStringTest( unittest.TestCase ) :
 		i = IECore.InternedString( s )
 		self.assertEqual( str( i ), s )
 
+	def testConcurrentConstruction( self ) :
+
+		originalSize = IECore.InternedString.numUniqueStrings()
+		IECore.testInternedStringConcurrentConstruction( "concurrentConstructionTest", 10000, 10, 0 )
+		self.assertEqual( IECore.InternedString.numUniqueStrings(), originalSize + 10000 )
+
+		# Constructing the same strings again must not add any more.
+		IECore.testInternedStringConcurrentConstruction( "concurrentConstructionTest", 10000, 10, 0 )
+		self.assertEqual( IECore.InternedString.numUniqueStrings(), originalSize + 10000 )
+
+	@unittest.skipUnless( os.environ.get("CORTEX_PERFORMANCE_TEST", False), "'CORTEX_PERFORMANCE_TEST' env var not set" )
+	def testConcurrentConstructionPerformance( self ) :
+
+		numThreads = 1
+		while True :
+			# The first run inserts new strings, and the second
+			# times lookups of existing ones, which dominate in practice.
+			prefix = "concurrentConstructionPerformance{}_".format( numThreads )
+			originalSize = IECore.InternedString.numUniqueStrings()
+			IECore.testInternedStringConcurrentConstruction( prefix, 100000, 1, numThreads )
+			self.assertEqual( IECore.InternedString.numUniqueStrings(), originalSize + 100000 )
+			IECore.testInternedStringConcurrentConstruction( prefix, 100000, 100, numThreads )
+			self.assertEqual( IECore.InternedString.numUniqueStrings(), originalSize + 100000 )
+			if numThreads >= IECore.hardwareConcurrency() :
+				break
+			numThreads = min( numThreads * 2, IECore.hardwareConcurrency() )
+
 if __name__ == "__main__":
 	unittest.main()
 
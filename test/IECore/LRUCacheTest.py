@@ -313,6 +313,17 @@ class LRUCacheTest( unittest.TestCase ) :
 		# Cache small enough that evictions are necessary
 		IECore.testParallelLRUCacheRecursion( 100000, 1000, 100 )
 
+	def testTaskParallelRecursion( self ) :
+
+		# Cache big enough that nothing will be evicted
+		IECore.testTaskParallelLRUCacheRecursion( 100000, 10000, 10000 )
+		# Cache small enough that evictions are necessary
+		IECore.testTaskParallelLRUCacheRecursion( 100000, 1000, 100 )
+
+	def testTaskParallelContention( self ) :
+
+		IECore.testTaskParallelLRUCacheContention( 10000, 4, 100000 )
+
 	def testExceptions( self ) :
 
 		calls = []
@@ -352,5 +363,76 @@ class LRUCacheTest( unittest.TestCase ) :
 		c.set( "d", "d", 1 )
 		self.assertEqual( c.currentCost(), 2 )
 
+	def testStatistics( self ) :
+
+		def getter( key ) :
+
+			return ( key, 1 )
+
+		c = IECore.LRUCache( getter, 2 )
+		s = c.statistics().snapshot()
+		self.assertEqual( s.hits, 0 )
+		self.assertEqual( s.misses, 0 )
+		self.assertEqual( s.evictions, 0 )
+
+		c.get( "a" )
+		c.get( "a" )
+		c.get( "b" )
+		s = c.statistics().snapshot()
+		self.assertEqual( s.hits, 1 )
+		self.assertEqual( s.misses, 2 )
+		self.assertEqual( s.evictions, 0 )
+		self.assertGreater( s.getterSeconds, 0 )
+		self.assertEqual( s.currentCost, 2 )
+		self.assertEqual( s.maxCost, 2 )
+
+		c.get( "c" )
+		s = c.statistics().snapshot()
+		self.assertEqual( s.misses, 3 )
+		self.assertEqual( s.evictions, 1 )
+
+		# Explicit removal isn't eviction.
+		c.clear()
+		s = c.statistics().snapshot()
+		self.assertEqual( s.evictions, 1 )
+		self.assertEqual( s.currentCost, 0 )
+
+		c.statistics().reset()
+		s = c.statistics().snapshot()
+		self.assertEqual( s.hits, 0 )
+		self.assertEqual( s.misses, 0 )
+		self.assertEqual( s.evictions, 0 )
+		self.assertEqual( s.getterSeconds, 0 )
+
+	def testStatisticsRegistry( self ) :
+
+		def names() :
+			return [ x.name for x in IECore.CacheStatistics.registered() ]
+
+		c = IECore.LRUCache( lambda key : ( key, 1 ), 10 )
+		self.assertEqual( c.statistics().getName(), "" )
+
+		c.statistics().setName( "LRUCacheTest" )
+		self.assertEqual( c.statistics().getName(), "LRUCacheTest" )
+		self.assertIn( "LRUCacheTest", names() )
+		self.assertEqual( names(), sorted( names() ) )
+
+		c.get( 1 )
+		s = [ x for x in IECore.CacheStatistics.registered() if x.name == "LRUCacheTest" ][0]
+		self.assertEqual( s.misses, 1 )
+		self.assertEqual( s.currentCost, 1 )
+		self.assertEqual( s.maxCost, 10 )
+
+		IECore.CacheStatistics.resetRegistered()
+		self.assertEqual( c.statistics().snapshot().misses, 0 )
+
+		c.statistics().setName( "" )
+		self.assertNotIn( "LRUCacheTest", names() )
+
+		c.statistics().setName( "LRUCacheTest" )
+		del s
+		del c
+		self.assertNotIn( "LRUCacheTest", names() )
+
 if __name__ == "__main__":
     unittest.main()
@@ -112,5 +112,38 @@ class ObjectPoolTest( unittest.TestCase ) :
 			p.contains( b.hash() )
 		)
 
+	def testStatistics( self ) :
+
+		p = IECore.ObjectPool( 500 )
+
+		a = p.store( IECore.IntData( 1 ), IECore.ObjectPool.StoreReference )
+		s = p.statistics().snapshot()
+		self.assertEqual( s.hits, 0 )
+		self.assertEqual( s.misses, 0 )
+
+		p.retrieve( a.hash() )
+		p.retrieve( IECore.IntData( 2 ).hash() )
+		p.retrieve( IECore.IntData( 2 ).hash() )
+		s = p.statistics().snapshot()
+		self.assertEqual( s.hits, 1 )
+		self.assertEqual( s.misses, 2 )
+		self.assertEqual( s.evictions, 0 )
+		self.assertEqual( s.currentCost, a.memoryUsage() )
+		self.assertEqual( s.maxCost, 500 )
+
+		p.setMaxMemoryUsage( 0 )
+		self.assertEqual( p.statistics().snapshot().evictions, 1 )
+
+		p.statistics().reset()
+		s = p.statistics().snapshot()
+		self.assertEqual( s.hits, 0 )
+		self.assertEqual( s.misses, 0 )
+		self.assertEqual( s.evictions, 0 )
+
+	def testDefaultPoolStatistics( self ) :
+
+		self.assertEqual( IECore.ObjectPool.defaultObjectPool().statistics().getName(), "ObjectPool" )
+		self.assertIn( "ObjectPool", [ s.name for s in IECore.CacheStatistics.registered() ] )
+
 if __name__ == "__main__":
     unittest.main()
@@ -34,6 +34,11 @@
 #
 ##########################################################################
 
+import os
+import shutil
+import subprocess
+import sys
+import tempfile
 import unittest
 
 import IECore
@@ -130,5 +135,163 @@ class PathMatcherDataTest( unittest.TestCase ) :
 
 		self.assertEqual( d, d2 )
 
+	def __saveAndLoad( self, d ) :
+
+		saveIO = IECore.MemoryIndexedIO( IECore.CharVectorData(), IECore.IndexedIO.OpenMode.Write )
+		d.save( saveIO, "d" )
+
+		loadIO = IECore.MemoryIndexedIO( saveIO.buffer(), IECore.IndexedIO.OpenMode.Read )
+		return IECore.Object.load( loadIO, "d" )
+
+	def testSaveAndLoadEdgeCases( self ) :
+
+		for paths in [
+			[],
+			[ "/" ],
+			[ "/", "/a" ],
+			[ "/a/b/c/d/e/f" ],
+			[ "/a/b", "/c/b", "/d/b/b/b" ],
+			[ "/a/*", "/a/b", "/.../c", "/*/d/..." ],
+		] :
+			d = IECore.PathMatcherData( IECore.PathMatcher( paths ) )
+			d2 = self.__saveAndLoad( d )
+			self.assertEqual( d, d2 )
+			self.assertEqual( d.hash(), d2.hash() )
+			self.assertEqual( sorted( d2.value.paths() ), sorted( paths ) )
+
+	def testLoadedWildcardsMatch( self ) :
+
+		d = IECore.PathMatcherData( IECore.PathMatcher( [ "/a/*/c", "/d/.../f", "/g" ] ) )
+		d2 = self.__saveAndLoad( d )
+
+		for path in [ "/a/b/c", "/a/x/c", "/d/f", "/d/e/e/f", "/g", "/g/h", "/a", "/a/b/d", "/h" ] :
+			self.assertEqual( d2.value.match( path ), d.value.match( path ) )
+
+	def testEditLoaded( self ) :
+
+		d = IECore.PathMatcherData( IECore.PathMatcher( [ "/a/b", "/a/c", "/d/b" ] ) )
+		d2 = self.__saveAndLoad( d )
+
+		d2.value.addPath( "/a/b/c" )
+		d2.value.removePath( "/d/b" )
+		self.assertEqual( d2.value, IECore.PathMatcher( [ "/a/b", "/a/c", "/a/b/c" ] ) )
+		self.assertEqual( d.value, IECore.PathMatcher( [ "/a/b", "/a/c", "/d/b" ] ) )
+
+	def testHashIndependentOfConstruction( self ) :
+
+		paths = [ "/a/b/c", "/a/b/d", "/a", "/e/f/g", "/a/e", "/e/*" ]
+
+		d1 = IECore.PathMatcherData( IECore.PathMatcher( paths ) )
+		d2 = IECore.PathMatcherData( IECore.PathMatcher( list( reversed( paths ) ) ) )
+		self.assertEqual( d1.hash(), d2.hash() )
+
+		d3 = IECore.PathMatcherData()
+		for path in paths :
+			d3.value.addPaths( IECore.PathMatcher( [ path ] ) )
+		self.assertEqual( d1.hash(), d3.hash() )
+
+	def testHashAfterEdits( self ) :
+
+		# Hashes are cached on the internal nodes of the PathMatcher, so here
+		# we make edits which modify shared and unshared nodes in place, and
+		# check that the hash always matches a freshly built equivalent.
+
+		d1 = IECore.PathMatcherData( IECore.PathMatcher( [ "/a/b/c", "/a/b/d", "/e/f" ] ) )
+		d1.hash()
+		d2 = d1.copy()
+
+		def assertHashValid( d ) :
+			self.assertEqual( d.hash(), IECore.PathMatcherData( IECore.PathMatcher( d.value.paths() ) ).hash() )
+
+		for edit in [
+			lambda m : m.addPath( "/a/b/c/g" ),
+			lambda m : m.addPath( "/a/b/h" ),
+			lambda m : m.removePath( "/a/b/d" ),
+			lambda m : m.prune( "/a/b/c" ),
+			lambda m : m.addPaths( IECore.PathMatcher( [ "/e/f/g", "/i" ] ) ),
+			lambda m : m.addPaths( IECore.PathMatcher( [ "/j", "/k" ] ), "/a/b" ),
+			lambda m : m.removePaths( IECore.PathMatcher( [ "/e/f/g", "/a/b/j" ] ) ),
+		] :
+			h = d2.hash()
+			edit( d2.value )
+			self.assertNotEqual( d2.hash(), h )
+			assertHashValid( d2 )
+			assertHashValid( d1 )
+
+		self.assertEqual( d1.value, IECore.PathMatcher( [ "/a/b/c", "/a/b/d", "/e/f" ] ) )
+
+	def __entryNames( self, io ) :
+
+		result = set()
+		for name in io.entryIds() :
+			result.add( name )
+			if io.entry( name ).entryType() == IECore.IndexedIO.EntryType.Directory :
+				result |= self.__entryNames( io.subdirectory( name ) )
+
+		return result
+
+	def testSaveVersions( self ) :
+
+		paths = [ "/a/b", "/a/c", "/d/*/e", "/" ]
+
+		# By default we write the original format, so files
+		# can still be read by previous versions.
+
+		saveIO = IECore.MemoryIndexedIO( IECore.CharVectorData(), IECore.IndexedIO.OpenMode.Write )
+		IECore.PathMatcherData( IECore.PathMatcher( paths ) ).save( saveIO, "d" )
+		entryNames = self.__entryNames( saveIO )
+		self.assertIn( "strings", entryNames )
+		self.assertNotIn( "nodeNames", entryNames )
+
+		# The compact format is opt-in, and must also be loadable.
+
+		tempDir = tempfile.mkdtemp()
+		try :
+			fileName = os.path.join( tempDir, "pathMatcher.fio" )
+			script = "import IECore; IECore.PathMatcherData( IECore.PathMatcher( {paths} ) ).save( IECore.FileIndexedIO( {fileName}, [], IECore.IndexedIO.OpenMode.Write ), 'd' )".format(
+				paths = repr( paths ), fileName = repr( fileName )
+			)
+			env = os.environ.copy()
+			env["IECORE_PATHMATCHERDATA_IOVERSION"] = "1"
+			subprocess.check_call( [ sys.executable, "-c", script ], env = env )
+
+			loadIO = IECore.FileIndexedIO( fileName, [], IECore.IndexedIO.OpenMode.Read )
+			entryNames = self.__entryNames( loadIO )
+			self.assertIn( "nodeNames", entryNames )
+			self.assertNotIn( "strings", entryNames )
+
+			d = IECore.Object.load( loadIO, "d" )
+			self.assertEqual( d, IECore.PathMatcherData( IECore.PathMatcher( paths ) ) )
+			del loadIO
+		finally :
+			shutil.rmtree( tempDir )
+
+	@unittest.skipUnless( os.environ.get("CORTEX_PERFORMANCE_TEST", False), "'CORTEX_PERFORMANCE_TEST' env var not set" )
+	def testLargeHashAndSaveLoadPerformance( self ) :
+
+		m = IECore.PathMatcher()
+		for i in range( 0, 100 ) :
+			for j in range( 0, 100 ) :
+				for k in range( 0, 100 ) :
+					m.addPath( "/a{}/b{}/c{}".format( i, j, k ) )
+
+		d = IECore.PathMatcherData( m )
+
+		t = IECore.Timer()
+		d.hash()
+		print( "Initial hash : {}".format( t.stop() ) )
+
+		t = IECore.Timer()
+		for i in range( 0, 100 ) :
+			d.value.addPath( "/a{}/new".format( i ) )
+			d.hash()
+		print( "Incremental hashes : {}".format( t.stop() ) )
+
+		t = IECore.Timer()
+		d2 = self.__saveAndLoad( d )
+		print( "Save and load : {}".format( t.stop() ) )
+
+		self.assertEqual( d, d2 )
+
 if __name__ == "__main__":
 	unittest.main()
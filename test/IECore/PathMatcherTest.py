@@ -35,6 +35,7 @@
 #
 ##########################################################################
 
+import os
 import unittest
 import random
 
@@ -976,5 +977,89 @@ class PathMatcherTest( unittest.TestCase ) :
 		m.clear()
 		self.assertEqual( m.size(), 0 )
 
+	@staticmethod
+	def __wideSets( seed, numPaths = 5000 ) :
+
+		# Wide enough that the set operations are done in parallel.
+
+		r = random.Random( seed )
+		def randomPaths() :
+			result = set()
+			for i in range( 0, numPaths ) :
+				result.add( "/" + "/".join( "n{}".format( r.randint( 0, 40 ) ) for j in range( 0, r.randint( 1, 4 ) ) ) )
+			return result
+
+		return randomPaths(), randomPaths()
+
+	def testWideIntersection( self ) :
+
+		for seed in range( 0, 4 ) :
+
+			p1, p2 = self.__wideSets( seed )
+			m1 = IECore.PathMatcher( list( p1 ) )
+			m2 = IECore.PathMatcher( list( p2 ) )
+
+			i = m1.intersection( m2 )
+			self.assertEqual( set( i.paths() ), p1 & p2 )
+			self.assertEqual( i, IECore.PathMatcher( list( p1 & p2 ) ) )
+			self.assertEqual( m1.intersection( m1 ), m1 )
+			self.assertEqual( m1.intersection( IECore.PathMatcher() ), IECore.PathMatcher() )
+
+			# Edits to the result must not affect the sources,
+			# with which it may share nodes.
+			i.addPaths( m2 )
+			self.assertEqual( set( m1.paths() ), p1 )
+			self.assertEqual( set( m2.paths() ), p2 )
+
+	def testWideAddAndRemovePaths( self ) :
+
+		for seed in range( 0, 4 ) :
+
+			p1, p2 = self.__wideSets( seed )
+			m1 = IECore.PathMatcher( list( p1 ) )
+			m2 = IECore.PathMatcher( list( p2 ) )
+
+			u = IECore.PathMatcher( m1 )
+			self.assertTrue( u.addPaths( m2 ) )
+			self.assertFalse( u.addPaths( m2 ) )
+			self.assertEqual( set( u.paths() ), p1 | p2 )
+			self.assertEqual( u, IECore.PathMatcher( list( p1 | p2 ) ) )
+
+			d = IECore.PathMatcher( m1 )
+			self.assertTrue( d.removePaths( m2 ) )
+			self.assertFalse( d.removePaths( m2 ) )
+			self.assertEqual( set( d.paths() ), p1 - p2 )
+			self.assertEqual( d, IECore.PathMatcher( list( p1 - p2 ) ) )
+
+			self.assertTrue( u.removePaths( m1 ) )
+			self.assertEqual( set( u.paths() ), p2 - p1 )
+
+			p = IECore.PathMatcher( m1 )
+			p.addPaths( m2, "/prefix" )
+			self.assertEqual( set( p.paths() ), p1 | { "/prefix" + x for x in p2 } )
+
+			self.assertEqual( set( m1.paths() ), p1 )
+			self.assertEqual( set( m2.paths() ), p2 )
+
+	@unittest.skipUnless( os.environ.get("CORTEX_PERFORMANCE_TEST", False), "'CORTEX_PERFORMANCE_TEST' env var not set" )
+	def testWideSetOperationPerformance( self ) :
+
+		p1, p2 = self.__wideSets( 0, numPaths = 1000000 )
+		m1 = IECore.PathMatcher( list( p1 ) )
+		m2 = IECore.PathMatcher( list( p2 ) )
+
+		# The sets are wide enough for the operations to be performed in
+		# parallel, so we check the results against those built serially,
+		# one path at a time.
+
+		u = IECore.PathMatcher( m1 )
+		u.addPaths( m2 )
+		self.assertEqual( u, IECore.PathMatcher( list( p1 | p2 ) ) )
+
+		u.removePaths( m2 )
+		self.assertEqual( u, IECore.PathMatcher( list( p1 - p2 ) ) )
+
+		self.assertEqual( m1.intersection( m2 ), IECore.PathMatcher( list( p1 & p2 ) ) )
+
 if __name__ == "__main__":
 	unittest.main()
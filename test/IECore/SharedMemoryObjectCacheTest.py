@@ -0,0 +1,164 @@
+##########################################################################
+#
+#  Copyright (c) 2026, Image Engine Design Inc. All rights reserved.
+#
+#  Redistribution and use in source and binary forms, with or without
+#  modification, are permitted provided that the following conditions are
+#  met:
+#
+#      * Redistributions of source code must retain the above
+#        copyright notice, this list of conditions and the following
+#        disclaimer.
+#
+#      * Redistributions in binary form must reproduce the above
+#        copyright notice, this list of conditions and the following
+#        disclaimer in the documentation and/or other materials provided with
+#        the distribution.
+#
+#      * Neither the name of John Haddon nor the names of
+#        any other contributors to this software may be used to endorse or
+#        promote products derived from this software without specific prior
+#        written permission.
+#
+#  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+#  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+#  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+#  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+#  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+#  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+#  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+#  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+#  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+#  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+#  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#
+##########################################################################
+
+import os
+import subprocess
+import sys
+import unittest
+import uuid
+
+import imath
+
+import IECore
+
+@unittest.skipIf( os.name == "nt", "Shared memory is not supported on Windows" )
+class SharedMemoryObjectCacheTest( unittest.TestCase ) :
+
+	def setUp( self ) :
+
+		self.__name = "cortexTest{}".format( uuid.uuid4().hex )
+		self.addCleanup( IECore.SharedMemoryObjectCache.remove, self.__name )
+
+	def testStoreAndRetrieve( self ) :
+
+		c = IECore.SharedMemoryObjectCache( self.__name, 1024 * 1024 )
+		self.assertEqual( c.name(), self.__name )
+		self.assertGreater( c.getMaxMemoryUsage(), 0 )
+		self.assertLessEqual( c.getMaxMemoryUsage(), 1024 * 1024 )
+		self.assertEqual( c.memoryUsage(), 0 )
+
+		o = IECore.CompoundObject( { "a" : IECore.IntVectorData( range( 0, 1000 ) ), "b" : IECore.StringData( "b" ) } )
+		self.assertFalse( c.contains( o.hash() ) )
+		self.assertIsNone( c.retrieve( o.hash() ) )
+
+		self.assertTrue( c.store( o.hash(), o ) )
+		self.assertTrue( c.contains( o.hash() ) )
+		self.assertGreater( c.memoryUsage(), 0 )
+
+		o2 = c.retrieve( o.hash() )
+		self.assertEqual( o2, o )
+		self.assertFalse( o2.isSame( o ) )
+
+		# Storing with an existing key replaces the object.
+		i = IECore.IntData( 10 )
+		self.assertTrue( c.store( o.hash(), i ) )
+		self.assertEqual( c.retrieve( o.hash() ), i )
+
+		c.clear()
+		self.assertEqual( c.memoryUsage(), 0 )
+		self.assertFalse( c.contains( o.hash() ) )
+
+	def testSharedBetweenInstances( self ) :
+
+		c1 = IECore.SharedMemoryObjectCache( self.__name, 1024 * 1024 )
+		c2 = IECore.SharedMemoryObjectCache( self.__name, 2 * 1024 * 1024 )
+		# The size is determined by the first instance.
+		self.assertEqual( c2.getMaxMemoryUsage(), c1.getMaxMemoryUsage() )
+
+		o = IECore.StringData( "hello" )
+		c1.store( o.hash(), o )
+		self.assertEqual( c2.retrieve( o.hash() ), o )
+
+	def testSharedBetweenProcesses( self ) :
+
+		c = IECore.SharedMemoryObjectCache( self.__name, 1024 * 1024 )
+		o = IECore.V3fVectorData( [ imath.V3f( x ) for x in range( 0, 100 ) ] )
+		c.store( o.hash(), o )
+
+		script = "import IECore; c = IECore.SharedMemoryObjectCache( '{name}', 0 ); o = c.retrieve( IECore.MurmurHash( '{hash}' ) ); c.store( IECore.MurmurHash(), IECore.IntData( len( o ) ) )".format(
+			name = self.__name, hash = o.hash().toString()
+		)
+		subprocess.check_call( [ sys.executable, "-c", script ] )
+
+		self.assertEqual( c.retrieve( IECore.MurmurHash() ), IECore.IntData( 100 ) )
+
+	def testTooLarge( self ) :
+
+		c = IECore.SharedMemoryObjectCache( self.__name, 1024 * 1024 )
+		o = IECore.CharVectorData( bytes( 2 * 1024 * 1024 ) )
+		self.assertFalse( c.store( o.hash(), o ) )
+		self.assertFalse( c.contains( o.hash() ) )
+
+	def testOldestObjectsDiscarded( self ) :
+
+		c = IECore.SharedMemoryObjectCache( self.__name, 1024 * 1024 )
+
+		hashes = []
+		for i in range( 0, 100 ) :
+			o = IECore.IntVectorData( [ i ] * 10000 )
+			self.assertTrue( c.store( o.hash(), o ) )
+			hashes.append( o.hash() )
+
+		self.assertLessEqual( c.memoryUsage(), c.getMaxMemoryUsage() )
+		self.assertFalse( c.contains( hashes[0] ) )
+		self.assertEqual( c.retrieve( hashes[-1] ), IECore.IntVectorData( [ 99 ] * 10000 ) )
+
+	def testStatistics( self ) :
+
+		c = IECore.SharedMemoryObjectCache( self.__name, 1024 * 1024 )
+		o = IECore.IntData( 1 )
+		c.store( o.hash(), o )
+
+		c.retrieve( o.hash() )
+		c.retrieve( IECore.IntData( 2 ).hash() )
+		s = c.statistics().snapshot()
+		self.assertEqual( s.hits, 1 )
+		self.assertEqual( s.misses, 1 )
+		self.assertEqual( s.currentCost, c.memoryUsage() )
+		self.assertEqual( s.maxCost, c.getMaxMemoryUsage() )
+
+	def testObjectPool( self ) :
+
+		c = IECore.SharedMemoryObjectCache( self.__name, 1024 * 1024 )
+		p1 = IECore.ObjectPool( 1024 * 1024 )
+		p1.setSharedMemoryCache( c )
+		self.assertTrue( p1.getSharedMemoryCache().isSame( c ) )
+
+		o = IECore.StringVectorData( [ "a", "b", "c" ] )
+		p1.store( o, IECore.ObjectPool.StoreReference )
+		self.assertTrue( c.contains( o.hash() ) )
+
+		p2 = IECore.ObjectPool( 1024 * 1024 )
+		self.assertIsNone( p2.retrieve( o.hash() ) )
+		p2.setSharedMemoryCache( c )
+		self.assertEqual( p2.retrieve( o.hash() ), o )
+		self.assertTrue( p2.contains( o.hash() ) )
+
+		p2.setSharedMemoryCache( None )
+		self.assertIsNone( p2.getSharedMemoryCache() )
+
+if __name__ == "__main__":
+	unittest.main()
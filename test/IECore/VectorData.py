@@ -1268,6 +1268,200 @@ class TestVectorDataToString( unittest.TestCase ) :
 		for i in range( 0, 255 ) :
 			self.assertEqual( six.indexbytes( s, i ), i )
 
+@unittest.skipIf( not six.PY3, "Skipping Python 3 test" )
+class TestVectorDataBuffer( unittest.TestCase ) :
+
+	def testReadOnly( self ) :
+
+		d = IECore.IntVectorData( [ 1, 2, 3 ] )
+		m = memoryview( d.asReadOnlyBuffer() )
+
+		self.assertTrue( m.readonly )
+		self.assertEqual( m.format, "i" )
+		self.assertEqual( m.shape, ( 3, ) )
+		self.assertEqual( m.tolist(), [ 1, 2, 3 ] )
+
+		with self.assertRaises( TypeError ) :
+			m[0] = 10
+
+		# Modifications to the data must trigger copy-on-write,
+		# leaving the buffer unchanged.
+		d[0] = 10
+		d.append( 4 )
+		self.assertEqual( m.tolist(), [ 1, 2, 3 ] )
+
+	def testWritable( self ) :
+
+		d = IECore.FloatVectorData( [ 1, 2, 3 ] )
+		c = d.copy()
+		m = memoryview( d.asWritableBuffer() )
+
+		self.assertFalse( m.readonly )
+		self.assertEqual( m.format, "f" )
+
+		m[1] = 20
+		self.assertEqual( d, IECore.FloatVectorData( [ 1, 20, 3 ] ) )
+		# The copy shared its data with `d`, so must be unaffected.
+		self.assertEqual( c, IECore.FloatVectorData( [ 1, 2, 3 ] ) )
+
+	def testWritableBufferExports( self ) :
+
+		d = IECore.IntVectorData( [ 1, 2, 3 ] )
+		b = d.asWritableBuffer()
+		m = memoryview( b )
+
+		# Copies made while the buffer exists must not
+		# see subsequent writes to it.
+		c = d.copy()
+		r = memoryview( d.asReadOnlyBuffer() )
+		m[0] = 10
+		self.assertEqual( d, IECore.IntVectorData( [ 10, 2, 3 ] ) )
+		self.assertEqual( c, IECore.IntVectorData( [ 1, 2, 3 ] ) )
+		self.assertEqual( r.tolist(), [ 1, 2, 3 ] )
+
+		# Resizing would leave the buffer dangling, so
+		# is not allowed.
+		for f in [
+			lambda : d.append( 4 ),
+			lambda : d.extend( [ 4 ] ),
+			lambda : d.insert( 0, 4 ),
+			lambda : d.resize( 10 ),
+			lambda : d.resize( 10, 4 ),
+			lambda : d.__delitem__( 0 ),
+			lambda : d.__delitem__( slice( 0, 2 ) ),
+			lambda : d.__setitem__( slice( 0, 2 ), IECore.IntVectorData( [ 4 ] ) ),
+		] :
+			six.assertRaisesRegex( self, BufferError, "Cannot resize", f )
+
+		# But modifying elements in place is fine.
+		d[1] = 20
+		self.assertEqual( m.tolist(), [ 10, 20, 3 ] )
+
+		# And resizing is allowed again once the buffer
+		# has been released.
+		del m, b
+		d.append( 4 )
+		self.assertEqual( d, IECore.IntVectorData( [ 10, 20, 3, 4 ] ) )
+
+	def testWritableBufferWithIndirectCopies( self ) :
+
+		d = IECore.IntVectorData( [ 1, 2, 3 ] )
+		m = memoryview( d.asWritableBuffer() )
+
+		# Copies made by C++, rather than via the `d.copy()`
+		# binding, must not share the buffer's elements either.
+		c = IECore.CompoundData( { "d" : d } ).copy()
+		h = d.hash()
+
+		# Modifying `d` must not move it away from the buffer.
+		d[0] = 10
+		m[1] = 20
+		self.assertEqual( d, IECore.IntVectorData( [ 10, 20, 3 ] ) )
+		self.assertEqual( c["d"], IECore.IntVectorData( [ 1, 2, 3 ] ) )
+		self.assertNotEqual( d.hash(), h )
+
+		# And deleting the copy mustn't affect the buffer.
+		del c
+		m[2] = 30
+		self.assertEqual( d, IECore.IntVectorData( [ 10, 20, 30 ] ) )
+		self.assertEqual( m.tolist(), [ 10, 20, 30 ] )
+
+		# Reassigning `d` moves it to different storage,
+		# but the buffer keeps the original alive.
+		d.copyFrom( IECore.IntVectorData( [ 4, 5, 6 ] ) )
+		m[0] = 40
+		self.assertEqual( m.tolist(), [ 40, 20, 30 ] )
+		self.assertEqual( d, IECore.IntVectorData( [ 4, 5, 6 ] ) )
+
+		# Writes are reflected in the hash.
+		h = d.hash()
+		d2 = IECore.IntVectorData( [ 1, 2, 3 ] )
+		m2 = memoryview( d2.asWritableBuffer() )
+		h2 = d2.hash()
+		m2[0] = 5
+		self.assertNotEqual( d2.hash(), h2 )
+		self.assertEqual( d.hash(), h )
+
+	def testBufferKeepsDataAlive( self ) :
+
+		m = memoryview( IECore.IntVectorData( [ 1, 2, 3 ] ).asReadOnlyBuffer() )
+		self.assertEqual( m.tolist(), [ 1, 2, 3 ] )
+
+		m = memoryview( IECore.IntVectorData( [ 1, 2, 3 ] ).asWritableBuffer() )
+		m[0] = 4
+		self.assertEqual( m.tolist(), [ 4, 2, 3 ] )
+
+	def testEmpty( self ) :
+
+		m = memoryview( IECore.IntVectorData().asReadOnlyBuffer() )
+		self.assertEqual( m.shape, ( 0, ) )
+		self.assertEqual( m.tolist(), [] )
+
+		m = memoryview( IECore.V3fVectorData().asWritableBuffer() )
+		self.assertEqual( m.shape, ( 0, 3 ) )
+		self.assertEqual( m.nbytes, 0 )
+
+	def testFormats( self ) :
+
+		for dataType, format in [
+			( IECore.HalfVectorData, "e" ),
+			( IECore.FloatVectorData, "f" ),
+			( IECore.DoubleVectorData, "d" ),
+			( IECore.IntVectorData, "i" ),
+			( IECore.UIntVectorData, "I" ),
+			( IECore.CharVectorData, "b" ),
+			( IECore.UCharVectorData, "B" ),
+			( IECore.ShortVectorData, "h" ),
+			( IECore.UShortVectorData, "H" ),
+			( IECore.Int64VectorData, "q" ),
+			( IECore.UInt64VectorData, "Q" ),
+		] :
+			d = dataType( 3 )
+			m = memoryview( d.asReadOnlyBuffer() )
+			self.assertEqual( m.format, format )
+			self.assertEqual( m.itemsize, len( d.toString() ) // 3 )
+			self.assertEqual( m.tobytes(), d.toString() )
+
+	def testCompoundElements( self ) :
+
+		d = IECore.V3fVectorData( [ imath.V3f( 1, 2, 3 ), imath.V3f( 4, 5, 6 ) ], IECore.GeometricData.Interpretation.Point )
+		m = memoryview( d.asWritableBuffer() )
+		self.assertEqual( m.format, "f" )
+		self.assertEqual( m.shape, ( 2, 3 ) )
+		self.assertEqual( m.strides, ( 12, 4 ) )
+		self.assertEqual( m.tolist(), [ [ 1, 2, 3 ], [ 4, 5, 6 ] ] )
+
+		m[1,2] = 10
+		self.assertEqual( d[1], imath.V3f( 4, 5, 10 ) )
+		self.assertEqual( d.getInterpretation(), IECore.GeometricData.Interpretation.Point )
+
+		d = IECore.Color4fVectorData( [ imath.Color4f( 1, 2, 3, 4 ) ] )
+		self.assertEqual( memoryview( d.asReadOnlyBuffer() ).tolist(), [ [ 1, 2, 3, 4 ] ] )
+
+		d = IECore.QuatdVectorData( [ imath.Quatd( 1, 2, 3, 4 ) ] )
+		m = memoryview( d.asReadOnlyBuffer() )
+		self.assertEqual( m.format, "d" )
+		self.assertEqual( m.tolist(), [ [ 1, 2, 3, 4 ] ] )
+
+		matrix = imath.M44f( *range( 0, 16 ) )
+		d = IECore.M44fVectorData( [ imath.M44f(), matrix ] )
+		m = memoryview( d.asReadOnlyBuffer() )
+		self.assertEqual( m.shape, ( 2, 4, 4 ) )
+		for i in range( 0, 4 ) :
+			for j in range( 0, 4 ) :
+				self.assertEqual( m[1,i,j], matrix[i][j] )
+
+		d = IECore.Box3iVectorData( [ imath.Box3i( imath.V3i( 1, 2, 3 ), imath.V3i( 4, 5, 6 ) ) ] )
+		m = memoryview( d.asReadOnlyBuffer() )
+		self.assertEqual( m.format, "i" )
+		self.assertEqual( m.tolist(), [ [ [ 1, 2, 3 ], [ 4, 5, 6 ] ] ] )
+
+	def testNoBufferForNonNumericTypes( self ) :
+
+		self.assertFalse( hasattr( IECore.StringVectorData(), "asReadOnlyBuffer" ) )
+		self.assertFalse( hasattr( IECore.BoolVectorData(), "asReadOnlyBuffer" ) )
+		self.assertFalse( hasattr( IECore.InternedStringVectorData(), "asReadOnlyBuffer" ) )
+
 class TestVectorDataHashOptimisation( unittest.TestCase ) :
 
 	@unittest.skipIf( os.environ.get("TRAVIS", False), "'TRAVIS' env var defined - skipping unreliable test" )
@@ -843,6 +843,22 @@ class ImageWriterTest( unittest.TestCase ) :
 
 		self.__verifyImageRGB( imgNew, imgOrig )
 
+	@unittest.skipIf( ( IECore.TestUtil.inMacCI() or IECore.TestUtil.inWindowsCI() ), "Mac and Windows CI are too slow for reliable timing" )
+	def testReleasesGIL( self ) :
+
+		window = imath.Box2i( imath.V2i( 0 ), imath.V2i( 2047 ) )
+		img = IECoreImage.ImagePrimitive( window, window )
+		for channel in "RGB" :
+			img[channel] = IECore.FloatVectorData( 2048 * 2048 )
+
+		fileName = os.path.join( "test", "IECoreImage", "data", "exr", "output.exr" )
+		w = IECoreImage.ImageWriter( img, fileName )
+		self.assertTrue( IECore.TestUtil.releasesGIL( w.write ) )
+
+		r = IECoreImage.ImageReader( fileName )
+		self.assertTrue( IECore.TestUtil.releasesGIL( r.read ) )
+		self.assertTrue( IECore.TestUtil.releasesGIL( lambda : r.readChannel( "R" ) ) )
+
 	def tearDown( self ) :
 
 		## \todo: replace with self.temporaryDirectory() once that is available
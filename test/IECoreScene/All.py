@@ -100,6 +100,7 @@ from LinkedSceneTest import LinkedSceneTest
 from ExternalProceduralTest import ExternalProceduralTest
 from ClippingPlaneTest import ClippingPlaneTest
 from MeshAlgoTest import *
+from MeshTopologyTest import MeshTopologyTest
 from CurvesAlgoTest import *
 from PointsAlgoTest import *
 from ObjectInterpolationTest import ObjectInterpolationTest
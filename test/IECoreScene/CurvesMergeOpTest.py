@@ -59,5 +59,29 @@ class CurvesMergeOpTest( unittest.TestCase ) :
 		pMerged.extend( p2 )
 		self.assertEqual( merged["P"].data, pMerged )
 
+	def testIndexedPrimitiveVariables( self ) :
+
+		v = imath.V3f
+		c1 = IECoreScene.CurvesPrimitive( IECore.IntVectorData( [ 4 ] ), IECore.CubicBasisf.linear(), False, IECore.V3fVectorData( [ v( x ) for x in range( 0, 4 ) ] ) )
+		c2 = IECoreScene.CurvesPrimitive( IECore.IntVectorData( [ 4 ] ), IECore.CubicBasisf.linear(), False, IECore.V3fVectorData( [ v( x ) for x in range( 4, 8 ) ] ) )
+
+		c1["a"] = IECoreScene.PrimitiveVariable( IECoreScene.PrimitiveVariable.Interpolation.Vertex, IECore.IntVectorData( [ 0, 1 ] ), IECore.IntVectorData( [ 0, 1, 1, 0 ] ) )
+		c2["a"] = IECoreScene.PrimitiveVariable( IECoreScene.PrimitiveVariable.Interpolation.Vertex, IECore.IntVectorData( [ 2, 3 ] ), IECore.IntVectorData( [ 1, 1, 0, 0 ] ) )
+
+		c1["b"] = IECoreScene.PrimitiveVariable( IECoreScene.PrimitiveVariable.Interpolation.Vertex, IECore.IntVectorData( [ 0, 1, 2, 3 ] ) )
+		c2["b"] = IECoreScene.PrimitiveVariable( IECoreScene.PrimitiveVariable.Interpolation.Vertex, IECore.IntVectorData( [ 4, 5 ] ), IECore.IntVectorData( [ 0, 1, 0, 1 ] ) )
+
+		c1["c"] = IECoreScene.PrimitiveVariable( IECoreScene.PrimitiveVariable.Interpolation.Vertex, IECore.IntVectorData( [ 0, 1 ] ), IECore.IntVectorData( [ 1, 1, 0, 0 ] ) )
+		c2["c"] = IECoreScene.PrimitiveVariable( IECoreScene.PrimitiveVariable.Interpolation.Vertex, IECore.IntVectorData( [ 4, 5, 6, 7 ] ) )
+
+		merged = IECoreScene.CurvesMergeOp()( input=c1, curves=c2 )
+		self.assertTrue( merged.arePrimitiveVariablesValid() )
+
+		for name in [ "a", "b", "c" ] :
+			self.assertEqual( list( merged[name].expandedData() ), list( c1[name].expandedData() ) + list( c2[name].expandedData() ) )
+
+		self.assertEqual( merged["a"].data, IECore.IntVectorData( [ 0, 1, 2, 3 ] ) )
+		self.assertIsNone( merged["b"].indices )
+
 if __name__ == "__main__":
     unittest.main()
@@ -230,5 +230,41 @@ class MeshAlgoMergeTest( unittest.TestCase ) :
 		self.assertEqual( merged.creaseIds(), IECore.IntVectorData( [ 1, 2, 3, 4, 5, 9, 10, 11, 12, 13, 14, 15 ] ) )
 		self.assertEqual( merged.creaseSharpnesses(), IECore.FloatVectorData( [ 1, 5, 3, 2, 0.5 ] ) )
 
+	def testManyMeshes( self ) :
+
+		meshes = []
+		for i in range( 0, 200 ) :
+			m = IECoreScene.MeshPrimitive.createPlane( imath.Box2f( imath.V2f( i ), imath.V2f( i + 1 ) ) )
+			if i % 2 :
+				m["uv"] = IECoreScene.PrimitiveVariable( m["uv"].interpolation, m["uv"].expandedData() )
+			elif i % 4 :
+				m["uv"] = IECoreScene.PrimitiveVariable( m["uv"].interpolation, m["uv"].data, IECore.IntVectorData( [ 3 - x for x in m["uv"].indices ] ) )
+			if i % 5 == 0 :
+				del m["N"]
+			if i % 7 == 3 :
+				m["id"] = IECoreScene.PrimitiveVariable( IECoreScene.PrimitiveVariable.Interpolation.Uniform, IECore.IntVectorData( [ i ] * m.numFaces() ) )
+			if i % 11 == 0 :
+				m.setCorners( IECore.IntVectorData( [ 0 ] ), IECore.FloatVectorData( [ i ] ) )
+			meshes.append( m )
+
+		merged = IECoreScene.MeshAlgo.merge( meshes )
+		self.verifyMerge( merged, meshes )
+
+		self.assertEqual( merged.numFaces(), sum( [ m.numFaces() for m in meshes ] ) )
+		self.assertEqual(
+			merged.cornerIds(),
+			IECore.IntVectorData( [ sum( [ m.variableSize( IECoreScene.PrimitiveVariable.Interpolation.Vertex ) for m in meshes[:i] ] ) for i in range( 0, 200, 11 ) ] )
+		)
+		self.assertEqual( merged.cornerSharpnesses(), IECore.FloatVectorData( range( 0, 200, 11 ) ) )
+
+		# "id" first appears in the fourth mesh, so it is filled
+		# with defaults for the meshes without it.
+		self.assertIsNone( merged["id"].indices )
+		offset = 0
+		for i, m in enumerate( meshes ) :
+			expected = i if i % 7 == 3 else 0
+			self.assertEqual( list( merged["id"].data )[offset:offset+m.numFaces()], [ expected ] * m.numFaces() )
+			offset += m.numFaces()
+
 if __name__ == "__main__" :
 	unittest.main()
@@ -94,6 +94,35 @@ class MeshAlgoNormalsTest( unittest.TestCase ) :
 		for n in normals.data :
 			self.assertEqual( n, imath.V3f( 0, 0, 1 ) )
 
+	def testMatchesSerialAccumulation( self ) :
+
+		s = IECore.Reader.create( os.path.join( "test", "IECore", "data", "cobFiles", "pSphereShape1.cob" ) ).read()
+		del s["N"]
+
+		# Normals are accumulated in parallel, but must still match
+		# a serial accumulation over the faces exactly.
+
+		points = s["P"].data
+		expectedVertexNormals = [ imath.V3f( 0 ) ] * len( points )
+		expectedUniformNormals = []
+		vertexIds = s.vertexIds
+		offset = 0
+		for numVertices in s.verticesPerFace :
+			p0 = points[vertexIds[offset]]
+			p1 = points[vertexIds[offset+1]]
+			p2 = points[vertexIds[offset+2]]
+			n = ( p2 - p1 ).cross( p0 - p1 ).normalized()
+			expectedUniformNormals.append( n )
+			for i in range( offset, offset + numVertices ) :
+				expectedVertexNormals[vertexIds[i]] = expectedVertexNormals[vertexIds[i]] + n
+			offset += numVertices
+
+		normals = IECoreScene.MeshAlgo.calculateNormals( s )
+		self.assertEqual( list( normals.data ), [ n.normalized() for n in expectedVertexNormals ] )
+
+		normals = IECoreScene.MeshAlgo.calculateNormals( s, interpolation = IECoreScene.PrimitiveVariable.Interpolation.Uniform )
+		self.assertEqual( list( normals.data ), expectedUniformNormals )
+
 	@unittest.skipIf( ( IECore.TestUtil.inMacCI() or IECore.TestUtil.inWindowsCI() ), "Mac and Windows CI are too slow for reliable timing" )
 	def testCancel( self ) :
 		canceller = IECore.Canceller()
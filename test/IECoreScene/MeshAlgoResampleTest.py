@@ -36,6 +36,7 @@ import IECore
 import IECoreScene
 
 import imath
+import random
 import unittest
 
 class MeshAlgoResampleTest( unittest.TestCase ) :
@@ -423,5 +424,76 @@ class MeshAlgoResampleTest( unittest.TestCase ) :
 				for v in pv.data :
 					self.assertEqual( v, imath.V2f( 0 ) )
 
+	def testUnusedVertices( self ) :
+
+		# A single quad, with two unused vertices on the end.
+
+		m = IECoreScene.MeshPrimitive.createPlane( imath.Box2f( imath.V2f( -1 ), imath.V2f( 1 ) ) )
+		m.setTopologyUnchecked( m.verticesPerFace, m.vertexIds, 6, m.interpolation )
+
+		for interpolation in ( IECoreScene.PrimitiveVariable.Interpolation.Uniform, IECoreScene.PrimitiveVariable.Interpolation.FaceVarying ) :
+
+			pv = IECoreScene.PrimitiveVariable( interpolation, IECore.IntVectorData( [ 2 ] * m.variableSize( interpolation ) ) )
+			IECoreScene.MeshAlgo.resamplePrimitiveVariable( m, pv, IECoreScene.PrimitiveVariable.Interpolation.Vertex )
+			self.assertEqual( pv.data, IECore.IntVectorData( [ 2, 2, 2, 2, 0, 0 ] ) )
+
+	def testResamplePrimitiveVariables( self ) :
+
+		for interpolation in (
+			IECoreScene.PrimitiveVariable.Interpolation.Constant,
+			IECoreScene.PrimitiveVariable.Interpolation.Uniform,
+			IECoreScene.PrimitiveVariable.Interpolation.Vertex,
+			IECoreScene.PrimitiveVariable.Interpolation.Varying,
+			IECoreScene.PrimitiveVariable.Interpolation.FaceVarying,
+		) :
+
+			names = [ n for n in self.mesh.keys() if n not in ( "j", "k" ) ]
+			variables = { n : self.mesh[n] for n in names }
+			IECoreScene.MeshAlgo.resamplePrimitiveVariables( self.mesh, variables, interpolation )
+
+			self.assertEqual( sorted( variables.keys() ), sorted( names ) )
+			for n in names :
+				p = self.mesh[n]
+				IECoreScene.MeshAlgo.resamplePrimitiveVariable( self.mesh, p, interpolation )
+				self.assertEqual( variables[n], p )
+
+			# The originals are untouched.
+			self.assertEqual( self.mesh["b"], self.makeMesh()["b"] )
+
+	def testIndexedDownsamplingMatchesExpanded( self ) :
+
+		m = IECoreScene.MeshPrimitive.createSphere( 1, divisions = imath.V2i( 30, 60 ) )
+
+		r = random.Random( 0 )
+		for interpolation, size in (
+			( IECoreScene.PrimitiveVariable.Interpolation.FaceVarying, m.variableSize( IECoreScene.PrimitiveVariable.Interpolation.FaceVarying ) ),
+			( IECoreScene.PrimitiveVariable.Interpolation.Vertex, m.variableSize( IECoreScene.PrimitiveVariable.Interpolation.Vertex ) ),
+			( IECoreScene.PrimitiveVariable.Interpolation.Uniform, m.variableSize( IECoreScene.PrimitiveVariable.Interpolation.Uniform ) ),
+		) :
+
+			indexed = IECoreScene.PrimitiveVariable(
+				interpolation,
+				IECore.V3fVectorData( [ imath.V3f( r.random(), r.random(), r.random() ) for i in range( 0, 10 ) ] ),
+				IECore.IntVectorData( [ r.randint( 0, 9 ) for i in range( 0, size ) ] )
+			)
+			expanded = IECoreScene.PrimitiveVariable( interpolation, indexed.expandedData() )
+
+			for targetInterpolation in (
+				IECoreScene.PrimitiveVariable.Interpolation.Uniform,
+				IECoreScene.PrimitiveVariable.Interpolation.Vertex,
+			) :
+
+				if targetInterpolation >= interpolation :
+					continue
+
+				p1 = IECoreScene.PrimitiveVariable( indexed )
+				IECoreScene.MeshAlgo.resamplePrimitiveVariable( m, p1, targetInterpolation )
+				p2 = IECoreScene.PrimitiveVariable( expanded )
+				IECoreScene.MeshAlgo.resamplePrimitiveVariable( m, p2, targetInterpolation )
+
+				self.assertEqual( p1.indices, None )
+				self.assertEqual( p1.data, p2.data )
+				self.assertTrue( m.isPrimitiveVariableValid( p1 ) )
+
 if __name__ == "__main__":
 	unittest.main()
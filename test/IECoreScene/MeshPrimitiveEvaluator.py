@@ -37,6 +37,7 @@ import unittest
 import random
 import imath
 import os
+import six
 import IECore
 import IECoreScene
 
@@ -437,6 +438,67 @@ class TestMeshPrimitiveEvaluator( unittest.TestCase ) :
 					m["faceVarying"].data[m["faceVarying"].indices[triangleIndex*3+corner]]
 				)
 
+	def testNonTriangularMesh( self ) :
+
+		m = IECoreScene.MeshPrimitive.createPlane( imath.Box2f( imath.V2f( -1 ), imath.V2f( 1 ) ) )
+		six.assertRaisesRegex( self, Exception, "Non-triangular", IECoreScene.MeshPrimitiveEvaluator, m )
+
+	def testQueriesAfterLazyTreeConstruction( self ) :
+
+		m = IECoreScene.MeshPrimitive.createPlane( imath.Box2f( imath.V2f( -1 ), imath.V2f( 1 ) ), imath.V2i( 10 ) )
+		m = IECoreScene.MeshAlgo.triangulate( m )
+
+		# `barycentricPosition()` doesn't need the trees, so test
+		# it before anything causes them to be built.
+		e = IECoreScene.MeshPrimitiveEvaluator( m )
+		r = e.createResult()
+		self.assertTrue( e.barycentricPosition( m.numFaces() - 1, imath.V3f( 1 / 3.0 ), r ) )
+		self.assertFalse( e.barycentricPosition( m.numFaces(), imath.V3f( 1 / 3.0 ), r ) )
+
+		self.assertEqual( e.uvBound(), imath.Box2f( imath.V2f( 0 ), imath.V2f( 1 ) ) )
+		self.assertTrue( e.closestPoint( imath.V3f( 0.25, 0.5, 1 ), r ) )
+		self.assertTrue( r.point().equalWithAbsError( imath.V3f( 0.25, 0.5, 0 ), 1e-6 ) )
+		self.assertTrue( e.pointAtUV( imath.V2f( 0.5 ), r ) )
+		self.assertTrue( r.point().equalWithAbsError( imath.V3f( 0 ), 1e-6 ) )
+
+	def testSubsequentMeshModificationsIgnored( self ) :
+
+		m = IECoreScene.MeshPrimitive.createPlane( imath.Box2f( imath.V2f( -1 ), imath.V2f( 1 ) ), imath.V2i( 10 ) )
+		m = IECoreScene.MeshAlgo.triangulate( m )
+		e = IECoreScene.MeshPrimitiveEvaluator( m )
+
+		# Modifying the mesh must not affect the evaluator,
+		# even though its trees are only built on demand.
+		m.setTopology( IECore.IntVectorData( [ 3 ] ), IECore.IntVectorData( [ 0, 1, 2 ] ), "linear" )
+		m["P"].data.resize( 3 )
+		m["P"].data[0] = imath.V3f( 10 )
+
+		r = e.createResult()
+		self.assertTrue( e.closestPoint( imath.V3f( 0.25, 0.5, 1 ), r ) )
+		self.assertTrue( r.point().equalWithAbsError( imath.V3f( 0.25, 0.5, 0 ), 1e-6 ) )
+		self.assertEqual( e.primitive().numFaces(), 200 )
+
+	@unittest.skipUnless( os.environ.get("CORTEX_PERFORMANCE_TEST", False), "'CORTEX_PERFORMANCE_TEST' env var not set" )
+	def testConstructionPerformance( self ) :
+
+		import resource
+
+		m = IECoreScene.MeshPrimitive.createPlane( imath.Box2f( imath.V2f( -1 ), imath.V2f( 1 ) ), imath.V2i( 2000 ) )
+		m = IECoreScene.MeshAlgo.triangulate( m )
+
+		rssBefore = resource.getrusage( resource.RUSAGE_SELF ).ru_maxrss
+
+		timer = IECore.Timer( True, IECore.Timer.Mode.WallClock )
+		evaluators = [ IECoreScene.MeshPrimitiveEvaluator( m ) for i in range( 0, 10 ) ]
+		print( "construction time / evaluator: {0} milliseconds".format( 100.0 * timer.stop() ) )
+
+		timer = IECore.Timer( True, IECore.Timer.Mode.WallClock )
+		evaluators[0].closestPoint( imath.V3f( 0 ), evaluators[0].createResult() )
+		print( "first query time: {0} milliseconds".format( 1000.0 * timer.stop() ) )
+
+		rssAfter = resource.getrusage( resource.RUSAGE_SELF ).ru_maxrss
+		print( "peak RSS increase: {0} MB".format( ( rssAfter - rssBefore ) / 1024.0 ) )
+
 if __name__ == "__main__":
 	unittest.main()
 
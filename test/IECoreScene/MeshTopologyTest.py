@@ -0,0 +1,194 @@
+##########################################################################
+#
+#  Copyright (c) 2026, Image Engine Design Inc. All rights reserved.
+#
+#  Redistribution and use in source and binary forms, with or without
+#  modification, are permitted provided that the following conditions are
+#  met:
+#
+#     * Redistributions of source code must retain the above copyright
+#       notice, this list of conditions and the following disclaimer.
+#
+#     * Redistributions in binary form must reproduce the above copyright
+#       notice, this list of conditions and the following disclaimer in the
+#       documentation and/or other materials provided with the distribution.
+#
+#     * Neither the name of Image Engine Design nor the names of any
+#       other contributors to this software may be used to endorse or
+#       promote products derived from this software without specific prior
+#       written permission.
+#
+#  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+#  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+#  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+#  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+#  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+#  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+#  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+#  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+#  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+#  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+#  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#
+##########################################################################
+
+import unittest
+import imath
+import IECore
+import IECoreScene
+
+class MeshTopologyTest( unittest.TestCase ) :
+
+	def __mesh( self ) :
+
+		# p
+		#  3_ _2 _5
+		#  |   |\ |
+		#  |_ _|_\|
+		#  0   1  4
+
+		v = imath.V3f
+		p = IECore.V3fVectorData( [ v( 0, 0, 0 ), v( 2, 0, 0 ), v( 2, 2, 0 ), v( 0, 2, 0 ), v( 3, 0, 0 ), v( 3, 2, 0 ) ] )
+		return IECoreScene.MeshPrimitive( IECore.IntVectorData( [ 4, 3, 3 ] ), IECore.IntVectorData( [ 0, 1, 2, 3, 1, 4, 2, 4, 5, 2 ] ), "linear", p )
+
+	def __adjacencyLists( self, adjacency ) :
+
+		offsets, values = adjacency
+		return [ list( values[offsets[i]:offsets[i+1]] ) for i in range( 0, len( offsets ) - 1 ) ]
+
+	def testFaces( self ) :
+
+		t = IECoreScene.MeshTopology.get( self.__mesh() )
+
+		self.assertEqual( t.numFaces(), 3 )
+		self.assertEqual( t.numVertices(), 6 )
+		self.assertEqual( t.numFaceVertices(), 10 )
+
+		self.assertEqual( t.faceVertexOffsets(), IECore.IntVectorData( [ 0, 4, 7, 10 ] ) )
+		self.assertEqual( t.faceVertexFaces(), IECore.IntVectorData( [ 0, 0, 0, 0, 1, 1, 1, 2, 2, 2 ] ) )
+		self.assertEqual( [ t.nextFaceVertex( i ) for i in range( 0, 10 ) ], [ 1, 2, 3, 0, 5, 6, 4, 8, 9, 7 ] )
+
+	def testVertices( self ) :
+
+		t = IECoreScene.MeshTopology.get( self.__mesh() )
+
+		self.assertEqual(
+			self.__adjacencyLists( t.vertexFaceVertices() ),
+			[ [ 0 ], [ 1, 4 ], [ 2, 6, 9 ], [ 3 ], [ 5, 7 ], [ 8 ] ]
+		)
+
+		self.assertEqual(
+			self.__adjacencyLists( t.vertexFaces() ),
+			[ [ 0 ], [ 0, 1 ], [ 0, 1, 2 ], [ 0 ], [ 1, 2 ], [ 2 ] ]
+		)
+
+		self.assertEqual(
+			self.__adjacencyLists( t.vertexNeighbours() ),
+			[ [ 1, 3 ], [ 0, 2, 4 ], [ 1, 3, 4, 5 ], [ 0, 2 ], [ 1, 2, 5 ], [ 2, 4 ] ]
+		)
+
+	def testEdges( self ) :
+
+		t = IECoreScene.MeshTopology.get( self.__mesh() )
+
+		v = imath.V2i
+		edges = t.edges()
+		self.assertEqual(
+			edges,
+			IECore.V2iVectorData( [ v( 0, 1 ), v( 0, 3 ), v( 1, 2 ), v( 1, 4 ), v( 2, 3 ), v( 2, 4 ), v( 2, 5 ), v( 4, 5 ) ] )
+		)
+
+		vertexIds = self.__mesh().vertexIds
+		faceVertexEdges = t.faceVertexEdges()
+		self.assertEqual( len( faceVertexEdges ), 10 )
+		for fv, e in enumerate( faceVertexEdges ) :
+			a = vertexIds[fv]
+			b = vertexIds[t.nextFaceVertex( fv )]
+			self.assertEqual( edges[e], v( min( a, b ), max( a, b ) ) )
+
+	def testCaching( self ) :
+
+		IECoreScene.MeshTopology.clearCache()
+		self.assertEqual( IECoreScene.MeshTopology.cacheMemoryUsage(), 0 )
+
+		m = self.__mesh()
+		t = IECoreScene.MeshTopology.get( m )
+		self.assertTrue( IECoreScene.MeshTopology.get( m ).isSame( t ) )
+		self.assertEqual( IECoreScene.MeshTopology.cacheMemoryUsage(), t.memoryUsage() )
+
+		# Primitive variables and interpolation don't affect the topology.
+
+		m2 = m.copy()
+		m2["P"] = IECoreScene.PrimitiveVariable( IECoreScene.PrimitiveVariable.Interpolation.Vertex, IECore.V3fVectorData( [ imath.V3f( 1 ) ] * 6 ) )
+		m2.interpolation = "catmullClark"
+		self.assertTrue( IECoreScene.MeshTopology.get( m2 ).isSame( t ) )
+
+		m3 = IECoreScene.MeshPrimitive.createPlane( imath.Box2f( imath.V2f( -1 ), imath.V2f( 1 ) ) )
+		t3 = IECoreScene.MeshTopology.get( m3 )
+		self.assertFalse( t3.isSame( t ) )
+		self.assertEqual( t3.numFaces(), 1 )
+
+		IECoreScene.MeshTopology.clearCache()
+		self.assertEqual( IECoreScene.MeshTopology.cacheMemoryUsage(), 0 )
+		self.assertFalse( IECoreScene.MeshTopology.get( m ).isSame( t ) )
+
+	def testMaxCacheMemoryUsage( self ) :
+
+		m = IECoreScene.MeshPrimitive.createPlane( imath.Box2f( imath.V2f( -1 ), imath.V2f( 1 ) ), imath.V2i( 100 ) )
+
+		oldLimit = IECoreScene.MeshTopology.getMaxCacheMemoryUsage()
+		try :
+			IECoreScene.MeshTopology.clearCache()
+			IECoreScene.MeshTopology.setMaxCacheMemoryUsage( 0 )
+			self.assertEqual( IECoreScene.MeshTopology.getMaxCacheMemoryUsage(), 0 )
+			t = IECoreScene.MeshTopology.get( m )
+			self.assertEqual( t.numFaces(), 10000 )
+			self.assertEqual( IECoreScene.MeshTopology.cacheMemoryUsage(), 0 )
+			self.assertFalse( IECoreScene.MeshTopology.get( m ).isSame( t ) )
+		finally :
+			IECoreScene.MeshTopology.setMaxCacheMemoryUsage( oldLimit )
+
+	def testUnusedVertices( self ) :
+
+		m = self.__mesh()
+		m["P"] = IECoreScene.PrimitiveVariable( IECoreScene.PrimitiveVariable.Interpolation.Vertex, IECore.V3fVectorData( [ imath.V3f( 0 ) ] * 8 ) )
+
+		neighbours, offsets = IECoreScene.MeshAlgo.connectedVertices( m )
+		self.assertEqual( len( offsets ), 8 )
+		self.assertEqual( offsets[5], offsets[6] )
+		self.assertEqual( offsets[6], offsets[7] )
+		self.assertEqual( offsets[7], len( neighbours ) )
+
+	def testCachingWithUnusedVertices( self ) :
+
+		m = self.__mesh()
+		t = IECoreScene.MeshTopology.get( m )
+		self.assertEqual( t.numVertices(), 6 )
+
+		# Same ids, but with two unused vertices on the end.
+
+		m2 = m.copy()
+		m2.setTopologyUnchecked( m.verticesPerFace, m.vertexIds, 8, m.interpolation )
+		self.assertEqual( m2.variableSize( IECoreScene.PrimitiveVariable.Interpolation.Vertex ), 8 )
+
+		t2 = IECoreScene.MeshTopology.get( m2 )
+		self.assertFalse( t2.isSame( t ) )
+		self.assertEqual( t2.numVertices(), 8 )
+		self.assertEqual( len( t2.vertexFaces()[0] ), 9 )
+		self.assertEqual( len( t2.vertexNeighbours()[0] ), 9 )
+
+		self.assertTrue( IECoreScene.MeshTopology.get( m ).isSame( t ) )
+		self.assertEqual( len( t.vertexNeighbours()[0] ), 7 )
+
+	def testConnectedVerticesMatchesTopology( self ) :
+
+		m = IECoreScene.MeshPrimitive.createSphere( 1, divisions = imath.V2i( 20, 40 ) )
+		neighbours, offsets = IECoreScene.MeshAlgo.connectedVertices( m )
+		t = IECoreScene.MeshTopology.get( m )
+		tOffsets, tNeighbours = t.vertexNeighbours()
+
+		self.assertEqual( neighbours, tNeighbours )
+		self.assertEqual( offsets, IECore.IntVectorData( list( tOffsets )[1:] ) )
+
+if __name__ == "__main__":
+	unittest.main()
@@ -604,6 +604,41 @@ class MergePointsTest( unittest.TestCase ) :
 		self.assertRaises( RuntimeError, lambda : IECoreScene.PointsAlgo.mergePoints( [pointsA, pointsB] ) )
 
 
+	def testIndexedPrimvarsAreExpanded( self ) :
+		pointsA = IECoreScene.PointsPrimitive( IECore.V3fVectorData( [imath.V3f( x ) for x in range( 0, 4 )] ) )
+		pointsB = IECoreScene.PointsPrimitive( IECore.V3fVectorData( [imath.V3f( x ) for x in range( 0, 3 )] ) )
+
+		pointsA["foo"] = IECoreScene.PrimitiveVariable( IECoreScene.PrimitiveVariable.Interpolation.Vertex, IECore.IntVectorData( [4, 5] ), IECore.IntVectorData( [1, 0, 0, 1] ) )
+		pointsB["foo"] = IECoreScene.PrimitiveVariable( IECoreScene.PrimitiveVariable.Interpolation.Vertex, IECore.IntVectorData( [6, 7, 8] ) )
+
+		mergedPoints = IECoreScene.PointsAlgo.mergePoints( [pointsA, pointsB] )
+
+		self.assertTrue( mergedPoints.arePrimitiveVariablesValid() )
+		self.assertIsNone( mergedPoints["foo"].indices )
+		self.assertEqual( mergedPoints["foo"].data, IECore.IntVectorData( [5, 4, 4, 5, 6, 7, 8] ) )
+
+	def testManyPointsPrimitives( self ) :
+		points = []
+		for i in range( 0, 500 ) :
+			p = IECoreScene.PointsPrimitive( IECore.V3fVectorData( [imath.V3f( i, x, 0 ) for x in range( 0, i % 10 )] ) )
+			p["id"] = IECoreScene.PrimitiveVariable( IECoreScene.PrimitiveVariable.Interpolation.Vertex, IECore.IntVectorData( [i] * ( i % 10 ) ) )
+			points.append( p )
+
+		mergedPoints = IECoreScene.PointsAlgo.mergePoints( points )
+
+		self.assertTrue( mergedPoints.arePrimitiveVariablesValid() )
+		self.assertEqual( mergedPoints.numPoints, sum( [ p.numPoints for p in points ] ) )
+
+		expectedP = IECore.V3fVectorData()
+		expectedIds = IECore.IntVectorData()
+		for p in points :
+			expectedP.extend( p["P"].data )
+			expectedIds.extend( p["id"].data )
+
+		self.assertEqual( list( mergedPoints["P"].data ), list( expectedP ) )
+		self.assertEqual( mergedPoints["id"].data, expectedIds )
+
+
 class SegmentPointsTest( unittest.TestCase ) :
 
 	def testCanSegmentUsingIntegerPrimvar( self ) :
@@ -34,6 +34,7 @@
 
 from __future__ import with_statement
 
+import os
 import unittest
 import imath
 
@@ -77,6 +78,27 @@ class PointsPrimitiveEvaluatorTest( unittest.TestCase ) :
 		self.assertEqual( r.colorPrimVar( p["Cs"] ), imath.Color3f( 5, 0, 0 ) )
 		self.assertEqual( r.stringPrimVar( p["names"] ), "a" )
 
+	@unittest.skipUnless( os.environ.get("CORTEX_PERFORMANCE_TEST", False), "'CORTEX_PERFORMANCE_TEST' env var not set" )
+	def testConstructionPerformance( self ) :
+
+		import resource
+
+		numPoints = 1000000
+		p = IECoreScene.PointsPrimitive( IECore.V3fVectorData( [ imath.V3f( x, 0, 0 ) for x in range( 0, numPoints ) ] ) )
+
+		rssBefore = resource.getrusage( resource.RUSAGE_SELF ).ru_maxrss
+
+		timer = IECore.Timer( True, IECore.Timer.Mode.WallClock )
+		evaluators = [ IECoreScene.PointsPrimitiveEvaluator( p ) for i in range( 0, 10 ) ]
+		print( "construction time / evaluator: {0} milliseconds".format( 100.0 * timer.stop() ) )
+
+		timer = IECore.Timer( True, IECore.Timer.Mode.WallClock )
+		evaluators[0].closestPoint( imath.V3f( 0 ), evaluators[0].createResult() )
+		print( "first query time: {0} milliseconds".format( 1000.0 * timer.stop() ) )
+
+		rssAfter = resource.getrusage( resource.RUSAGE_SELF ).ru_maxrss
+		print( "peak RSS increase: {0} MB".format( ( rssAfter - rssBefore ) / 1024.0 ) )
+
 if __name__ == "__main__":
 	unittest.main()
 
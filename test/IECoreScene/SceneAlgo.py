@@ -150,6 +150,51 @@ class SceneAlgoTest( unittest.TestCase ) :
 		self.assertEqual( len( t.childNames()), 4096 )
 
 
+	def testCopyStats( self ):
+
+		self.writeBigSCC()
+		src = IECoreScene.SceneCache( self.__testFile, IECore.IndexedIO.OpenMode.Read )
+		dst = IECoreScene.SceneCache( self.__testFile2, IECore.IndexedIO.OpenMode.Write )
+
+		stats = IECoreScene.SceneAlgo.copyWithStats( src, dst, 1, 1, 1.0, IECoreScene.SceneAlgo.ProcessFlags.All )
+		del dst
+
+		self.assertEqual( stats["locations"], 4096 + 2 )
+		self.assertEqual( stats["polygons"], 4096 * 6 )
+		self.assertEqual( stats["attributes"], 4096 * 2 )
+		for stage in ( "traversalTime", "readTime", "writeTime", "totalTime" ) :
+			self.assertIn( stage, stats )
+
+		dst = IECoreScene.SceneCache( self.__testFile2, IECore.IndexedIO.OpenMode.Read )
+		srcT = src.child( "t" )
+		dstT = dst.child( "t" )
+		self.assertEqual( sorted( dstT.childNames() ), sorted( srcT.childNames() ) )
+		for name in [ "t0", "t100", "t4095" ] :
+			self.assertEqual( dstT.child( name ).readObject( 1.0 ), srcT.child( name ).readObject( 1.0 ) )
+			self.assertEqual( dstT.child( name ).readAttribute( "foo", 1.0 ), IECore.IntData( 1 ) )
+
+	def testCopyAnimation( self ):
+
+		m = IECoreScene.SceneCache( self.__testFile, IECore.IndexedIO.OpenMode.Write )
+		for i in range( 0, 10 ) :
+			c = m.createChild( str( i ) )
+			for f in range( 1, 4 ) :
+				c.writeTransform( IECore.M44dData( imath.M44d().translate( imath.V3d( i, f, 0 ) ) ), f )
+				c.writeObject( IECoreScene.MeshPrimitive.createBox( imath.Box3f( imath.V3f( 0 ), imath.V3f( f ) ) ), f )
+		del m, c
+
+		src = IECoreScene.SceneCache( self.__testFile, IECore.IndexedIO.OpenMode.Read )
+		dst = IECoreScene.SceneCache( self.__testFile2, IECore.IndexedIO.OpenMode.Write )
+		IECoreScene.SceneAlgo.copy( src, dst, 1, 3, 1.0, IECoreScene.SceneAlgo.ProcessFlags.All )
+		del dst
+
+		dst = IECoreScene.SceneCache( self.__testFile2, IECore.IndexedIO.OpenMode.Read )
+		self.assertEqual( dst.childNames(), src.childNames() )
+		for i in range( 0, 10 ) :
+			for f in range( 1, 4 ) :
+				self.assertEqual( dst.child( str( i ) ).readTransform( f ), src.child( str( i ) ).readTransform( f ) )
+				self.assertEqual( dst.child( str( i ) ).readObject( f ), src.child( str( i ) ).readObject( f ) )
+
 	def testMultithreadedRead( self ):
 
 		self.writeBigSCC()
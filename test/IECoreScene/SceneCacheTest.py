@@ -39,6 +39,8 @@ import unittest
 import shutil
 import os
 import tempfile
+import subprocess
+import uuid
 
 import IECore
 import IECoreScene
@@ -359,6 +361,48 @@ class SceneCacheTest( unittest.TestCase ) :
 		self.assertEqual( p3.readBound(  2.5 ), imath.Box3d( imath.V3d( -2 ), imath.V3d( 3 ) ) )
 
 
+	def testWideHierarchyBoundPropagation( self ) :
+
+		fileName = os.path.join( self.tempDir, "wideHierarchyBounds.scc" )
+
+		# Many groups each containing many translated spheres with
+		# animated radii, so that bounds are computed for lots of
+		# sibling locations at once.
+
+		def groupTranslation( i ) :
+			return imath.V3d( i, 0, 0 )
+
+		def sphereTranslation( j ) :
+			return imath.V3d( 0, 0, j * 2 )
+
+		def sphereRadius( j, time ) :
+			return 1 + j + time
+
+		m = IECoreScene.SceneCache( fileName, IECore.IndexedIO.OpenMode.Write )
+		for i in range( 0, 50 ) :
+			group = m.createChild( "group{}".format( i ) )
+			group.writeTransform( IECore.M44dData( imath.M44d().translate( groupTranslation( i ) ) ), 0 )
+			for j in range( 0, 20 ) :
+				sphere = group.createChild( "sphere{}".format( j ) )
+				sphere.writeTransform( IECore.M44dData( imath.M44d().translate( sphereTranslation( j ) ) ), 0 )
+				for time in ( 0, 1 ) :
+					sphere.writeObject( IECoreScene.SpherePrimitive( sphereRadius( j, time ) ), time )
+		del m, group, sphere
+
+		m = IECoreScene.SceneCache( fileName, IECore.IndexedIO.OpenMode.Read )
+		for time in ( 0, 1 ) :
+			expectedRootBound = imath.Box3d()
+			for i in range( 0, 50 ) :
+				expectedGroupBound = imath.Box3d()
+				for j in range( 0, 20 ) :
+					r = imath.V3d( sphereRadius( j, time ) )
+					t = sphereTranslation( j )
+					expectedGroupBound.extendBy( imath.Box3d( t - r, t + r ) )
+				self.assertEqual( m.child( "group{}".format( i ) ).readBound( time ), expectedGroupBound )
+				t = groupTranslation( i )
+				expectedRootBound.extendBy( imath.Box3d( expectedGroupBound.min() + t, expectedGroupBound.max() + t ) )
+			self.assertEqual( m.readBound( time ), expectedRootBound )
+
 	def testExplicitBoundPropagatesToImplicitBound( self ) :
 
 		m = IECoreScene.SceneCache( os.path.join( self.tempDir, "test.scc" ), IECore.IndexedIO.OpenMode.Write )
@@ -887,6 +931,62 @@ class SceneCacheTest( unittest.TestCase ) :
 		A3 = readRoot3.child('A')
 		self.assertEqual( A.hashSet("dummySetA"), A3.hashSet("dummySetA") )
 
+	def testSetIndex( self ) :
+
+		fileName = os.path.join( self.tempDir, "setIndex.scc" )
+
+		writeRoot = IECoreScene.SceneCache( fileName, IECore.IndexedIO.OpenMode.Write )
+		A = writeRoot.createChild( "A" )
+		B = A.createChild( "B" )
+		C = B.createChild( "C" )
+		D = writeRoot.createChild( "D" )
+		E = D.createChild( "E" )
+
+		A.writeSet( "don", IECore.PathMatcher( [ "/B/C" ] ) )
+		D.writeSet( "don", IECore.PathMatcher( [ "/", "/E" ] ) )
+		B.writeSet( "empty", IECore.PathMatcher() )
+		C.writeTags( [ "john" ] )
+		E.writeTags( [ "don", "john" ] )
+		E.writeObject( IECoreScene.SpherePrimitive(), 0 )
+
+		del E, D, C, B, A, writeRoot
+
+		def readSets() :
+
+			result = {}
+			root = IECoreScene.SceneCache( fileName, IECore.IndexedIO.OpenMode.Read )
+			for path in ( [], [ "A" ], [ "A", "B" ], [ "D" ] ) :
+				scene = root.scene( path )
+				for name in root.setNames() :
+					for includeDescendantSets in ( True, False ) :
+						result[( "/".join( path ), name, includeDescendantSets )] = scene.readSet( name, includeDescendantSets ).paths()
+
+			return result
+
+		withIndex = readSets()
+
+		self.assertEqual( set( withIndex[( "", "don", True )] ), { "/A/B/C", "/D", "/D/E" } )
+		self.assertEqual( set( withIndex[( "", "john", True )] ), { "/A/B/C", "/D/E" } )
+		self.assertEqual( set( withIndex[( "A", "john", True )] ), { "/B/C" } )
+		self.assertEqual( set( withIndex[( "D", "don", True )] ), { "/", "/E" } )
+		self.assertEqual( withIndex[( "", "empty", True )], [] )
+		self.assertEqual( set( withIndex[( "", "ObjectType:SpherePrimitive", True )] ), { "/D/E" } )
+
+		# Remove the index, so that sets are read by visiting each location, as
+		# they are for files written before the index was introduced. The results
+		# should be identical.
+
+		io = IECore.FileIndexedIO( fileName, [], IECore.IndexedIO.OpenMode.Append )
+		self.assertIn( "setIndex", io.entryIds() )
+		io.remove( "setIndex" )
+		del io
+
+		withoutIndex = readSets()
+
+		self.assertEqual( withIndex.keys(), withoutIndex.keys() )
+		for key in withIndex.keys() :
+			self.assertEqual( set( withIndex[key] ), set( withoutIndex[key] ), key )
+
 	def testTagsConvertedToSets( self ) :
 
 		# A
@@ -1127,6 +1227,54 @@ class SceneCacheTest( unittest.TestCase ) :
 
 		IECoreScene.testSceneCacheParallelFakeAttributeRead()
 
+	def testParallelWrite( self ) :
+
+		serialFileName = os.path.join( self.tempDir, "serial.scc" )
+		parallelFileName = os.path.join( self.tempDir, "parallel.scc" )
+
+		IECoreScene.testSceneCacheParallelWrite( serialFileName, 200, False )
+		IECoreScene.testSceneCacheParallelWrite( parallelFileName, 200, True )
+
+		serial = IECoreScene.SceneCache( serialFileName, IECore.IndexedIO.OpenMode.Read )
+		parallel = IECoreScene.SceneCache( parallelFileName, IECore.IndexedIO.OpenMode.Read )
+
+		self.assertEqual( sorted( parallel.childNames() ), sorted( serial.childNames() ) )
+		self.assertEqual( len( serial.childNames() ), 200 )
+		self.assertEqual( parallel.readSet( "set0" ).size(), 100 )
+		self.assertEqual( parallel.readSet( "set1" ).size(), 100 )
+
+		def assertLocationsEqual( a, b ) :
+
+			self.assertEqual( a.path(), b.path() )
+			self.assertEqual( sorted( a.childNames() ), sorted( b.childNames() ) )
+			self.assertEqual( a.numBoundSamples(), b.numBoundSamples() )
+			for i in range( 0, a.numBoundSamples() ) :
+				self.assertEqual( a.readBoundAtSample( i ), b.readBoundAtSample( i ) )
+			self.assertEqual( a.numTransformSamples(), b.numTransformSamples() )
+			for i in range( 0, a.numTransformSamples() ) :
+				self.assertEqual( a.readTransformAtSample( i ), b.readTransformAtSample( i ) )
+			self.assertEqual( a.hasObject(), b.hasObject() )
+			if a.hasObject() :
+				self.assertEqual( a.numObjectSamples(), b.numObjectSamples() )
+				for i in range( 0, a.numObjectSamples() ) :
+					self.assertEqual( a.readObjectAtSample( i ), b.readObjectAtSample( i ) )
+			self.assertEqual( sorted( a.attributeNames() ), sorted( b.attributeNames() ) )
+			for name in a.attributeNames() :
+				self.assertEqual( a.numAttributeSamples( name ), b.numAttributeSamples( name ) )
+				for i in range( 0, a.numAttributeSamples( name ) ) :
+					self.assertEqual( a.readAttributeAtSample( name, i ), b.readAttributeAtSample( name, i ) )
+			self.assertEqual( sorted( a.readTags() ), sorted( b.readTags() ) )
+			self.assertEqual( sorted( a.readTags( IECoreScene.SceneInterface.TagFilter.EveryTag ) ), sorted( b.readTags( IECoreScene.SceneInterface.TagFilter.EveryTag ) ) )
+			self.assertEqual( sorted( a.setNames( includeDescendantSets = False ) ), sorted( b.setNames( includeDescendantSets = False ) ) )
+			self.assertEqual( sorted( a.setNames() ), sorted( b.setNames() ) )
+			for name in a.setNames() :
+				self.assertEqual( a.readSet( name ), b.readSet( name ) )
+
+			for childName in a.childNames() :
+				assertLocationsEqual( a.child( childName ), b.child( childName ) )
+
+		assertLocationsEqual( serial, parallel )
+
 	def testCanReadV6SceneCache( self ):
 
 		r = IECore.IndexedIO.create( os.path.join( "test", "IECore", "data", "sccFiles", "cube_v6.scc" ), IECore.IndexedIO.OpenMode.Read)
@@ -1146,6 +1294,228 @@ class SceneCacheTest( unittest.TestCase ) :
 		self.assertEqual( m[0][0], 1.0 )
 		self.assertAlmostEqual( m[1][1], 0.74005603790283203 )
 
+	def testCompressionOptions( self ) :
+
+		mesh = IECoreScene.MeshPrimitive.createPlane( imath.Box2f( imath.V2f( -1 ), imath.V2f( 1 ) ), imath.V2i( 100 ) )
+
+		sizes = []
+		for options in (
+			None,
+			IECore.CompoundData( { "compressor" : "lz4", "compressionLevel" : 9 } ),
+			IECore.CompoundData( { "compressionLevel" : 9, "dataTypeCompression" : { "FloatArray" : { "shuffle" : "bit" } } } ),
+		) :
+
+			fileName = os.path.join( self.tempDir, "compressed.scc" )
+			m = IECoreScene.SceneCache( fileName, IECore.IndexedIO.OpenMode.Write, options = options )
+			m.createChild( "plane" ).writeObject( mesh, 0 )
+			del m
+
+			sizes.append( os.path.getsize( fileName ) )
+
+			m = IECoreScene.SceneCache( fileName, IECore.IndexedIO.OpenMode.Read )
+			self.assertEqual( m.child( "plane" ).readObject( 0 ), mesh )
+
+		self.assertLess( sizes[1], sizes[0] )
+		self.assertLess( sizes[2], sizes[0] )
+
+	def testAsynchronousCompression( self ) :
+
+		mesh = IECoreScene.MeshPrimitive.createPlane( imath.Box2f( imath.V2f( -1 ), imath.V2f( 1 ) ), imath.V2i( 100 ) )
+
+		contents = []
+		for asynchronous in ( False, True ) :
+
+			fileName = os.path.join( self.tempDir, "asynchronous.scc" )
+			options = IECore.CompoundData( { "compressionLevel" : 9, "asynchronousCompression" : asynchronous } )
+			m = IECoreScene.SceneCache( fileName, IECore.IndexedIO.OpenMode.Write, options = options )
+			for i in range( 0, 10 ) :
+				c = m.createChild( str( i ) )
+				for f in range( 0, 3 ) :
+					mesh["P"].data[0] = imath.V3f( i, f, 0 )
+					c.writeObject( mesh, f )
+					c.writeTransform( IECore.M44dData( imath.M44d().translate( imath.V3d( i, f, 0 ) ) ), f )
+			del m, c
+
+			with open( fileName, "rb" ) as f :
+				contents.append( f.read() )
+
+			m = IECoreScene.SceneCache( fileName, IECore.IndexedIO.OpenMode.Read )
+			for i in range( 0, 10 ) :
+				mesh["P"].data[0] = imath.V3f( i, 2, 0 )
+				self.assertEqual( m.child( str( i ) ).readObject( 2 ), mesh )
+
+		# Compressed data is committed in the order it was written, so the
+		# file is the same as when compressing synchronously.
+		self.assertEqual( contents[0], contents[1] )
+
+	def testCacheMemoryUsage( self ) :
+
+		fileName = os.path.join( self.tempDir, "cacheMemoryUsage.scc" )
+
+		m = IECoreScene.SceneCache( fileName, IECore.IndexedIO.OpenMode.Write )
+		mesh = IECoreScene.MeshPrimitive.createPlane( imath.Box2f( imath.V2f( -1 ), imath.V2f( 1 ) ), imath.V2i( 20 ) )
+		for i in range( 0, 10 ) :
+			mesh["P"].data[0] = imath.V3f( i, 0, 0 )
+			m.createChild( str( i ) ).writeObject( mesh, 0 )
+		del m
+
+		originalMaxMemory = IECoreScene.SceneCache.getMaxCacheMemoryUsage()
+		self.addCleanup( IECoreScene.SceneCache.setMaxCacheMemoryUsage, originalMaxMemory )
+
+		# Only enough room for a few meshes.
+		maxMemory = mesh.memoryUsage() * 3
+		IECoreScene.SceneCache.setMaxCacheMemoryUsage( maxMemory )
+		self.assertEqual( IECoreScene.SceneCache.getMaxCacheMemoryUsage(), maxMemory )
+
+		IECoreScene.SceneCache.cacheStatistics().reset()
+
+		m = IECoreScene.SceneCache( fileName, IECore.IndexedIO.OpenMode.Read )
+		for i in range( 0, 10 ) :
+			mesh["P"].data[0] = imath.V3f( i, 0, 0 )
+			self.assertEqual( m.child( str( i ) ).readObject( 0 ), mesh )
+			self.assertLessEqual( IECoreScene.SceneCache.cacheMemoryUsage(), maxMemory )
+
+		s = IECoreScene.SceneCache.cacheStatistics().snapshot()
+		self.assertEqual( s.name, "SceneCache" )
+		self.assertEqual( s.misses, 10 )
+		self.assertGreater( s.evictions, 0 )
+		self.assertEqual( s.maxCost, maxMemory )
+
+		# The most recent object is still cached.
+		m.child( "9" ).readObject( 0 )
+		self.assertEqual( IECoreScene.SceneCache.cacheStatistics().snapshot().hits, 1 )
+
+	def testIdenticalObjectsShareCacheMemory( self ) :
+
+		fileName = os.path.join( self.tempDir, "identicalObjects.scc" )
+
+		m = IECoreScene.SceneCache( fileName, IECore.IndexedIO.OpenMode.Write )
+		mesh = IECoreScene.MeshPrimitive.createPlane( imath.Box2f( imath.V2f( -1 ), imath.V2f( 1 ) ), imath.V2i( 20 ) )
+		for i in range( 0, 10 ) :
+			m.createChild( str( i ) ).writeObject( mesh, 0 )
+		del m
+
+		# Empty the cache.
+		originalMaxMemory = IECoreScene.SceneCache.getMaxCacheMemoryUsage()
+		IECoreScene.SceneCache.setMaxCacheMemoryUsage( 0 )
+		IECoreScene.SceneCache.setMaxCacheMemoryUsage( originalMaxMemory )
+		IECoreScene.SceneCache.cacheStatistics().reset()
+
+		m = IECoreScene.SceneCache( fileName, IECore.IndexedIO.OpenMode.Read )
+		for i in range( 0, 10 ) :
+			self.assertEqual( m.child( str( i ) ).readObject( 0 ), mesh )
+
+		# The objects are identical, so only one is held by the cache.
+		s = IECoreScene.SceneCache.cacheStatistics().snapshot()
+		self.assertEqual( s.misses, 1 )
+		self.assertEqual( s.hits, 9 )
+		self.assertLess( IECoreScene.SceneCache.cacheMemoryUsage(), mesh.memoryUsage() * 2 )
+
+	def testCacheDoesntOutliveFile( self ) :
+
+		fileName = os.path.join( self.tempDir, "cacheDoesntOutliveFile.scc" )
+
+		for i in range( 0, 2 ) :
+
+			m = IECoreScene.SceneCache( fileName, IECore.IndexedIO.OpenMode.Write )
+			m.createChild( "a" ).writeObject( IECore.IntData( i ), 0 )
+			del m
+
+			m = IECoreScene.SceneCache( fileName, IECore.IndexedIO.OpenMode.Read )
+			self.assertEqual( m.child( "a" ).readObject( 0 ), IECore.IntData( i ) )
+			del m
+
+	@unittest.skipIf( os.name == "nt", "Shared memory is not supported on Windows" )
+	def testSharedMemoryObjectCache( self ) :
+
+		fileName = os.path.join( self.tempDir, "sharedMemoryObjectCache.scc" )
+
+		m = IECoreScene.SceneCache( fileName, IECore.IndexedIO.OpenMode.Write )
+		mesh = IECoreScene.MeshPrimitive.createPlane( imath.Box2f( imath.V2f( -1 ), imath.V2f( 1 ) ), imath.V2i( 20 ) )
+		for i in range( 0, 10 ) :
+			mesh["P"].data[0] = imath.V3f( i, 0, 0 )
+			m.createChild( str( i ) ).writeObject( mesh, 0 )
+		del m
+
+		name = "cortexTest{}".format( uuid.uuid4().hex )
+		self.addCleanup( IECore.SharedMemoryObjectCache.remove, name )
+
+		env = os.environ.copy()
+		env["IECORE_SHAREDMEMORYOBJECTCACHE_NAME"] = name
+		env["IECORE_SHAREDMEMORYOBJECTCACHE_MEMORY"] = "16"
+
+		script = "; ".join( [
+			"import IECore, IECoreScene",
+			"m = IECoreScene.SceneCache( '{}', IECore.IndexedIO.OpenMode.Read )".format( fileName ),
+			"hashes = [ m.child( str( i ) ).readObject( 0 ).hash().toString() for i in range( 0, 10 ) ]",
+			"print( ' '.join( [ str( IECore.SharedMemoryObjectCache.defaultCache().statistics().snapshot().hits ) ] + hashes ) )"
+		] )
+
+		# The first process loads the objects from the file, and
+		# the second gets them from shared memory.
+		outputs = [
+			subprocess.check_output( [ sys.executable, "-c", script ], env = env, universal_newlines = True ).split()
+			for i in range( 0, 2 )
+		]
+
+		self.assertEqual( outputs[0][0], "0" )
+		self.assertEqual( outputs[1][0], "10" )
+		self.assertEqual( outputs[0][1:], outputs[1][1:] )
+
+		expectedHashes = []
+		for i in range( 0, 10 ) :
+			mesh["P"].data[0] = imath.V3f( i, 0, 0 )
+			expectedHashes.append( mesh.hash().toString() )
+		self.assertEqual( outputs[1][1:], expectedHashes )
+
+	@unittest.skipUnless( os.environ.get("CORTEX_PERFORMANCE_TEST", False), "'CORTEX_PERFORMANCE_TEST' env var not set" )
+	def testMemoryMappedReadPerformance( self ) :
+
+		fileName = os.path.join( self.tempDir, "memoryMapped.scc" )
+
+		m = IECoreScene.SceneCache( fileName, IECore.IndexedIO.OpenMode.Write )
+		mesh = IECoreScene.MeshPrimitive.createPlane( imath.Box2f( imath.V2f( -1 ), imath.V2f( 1 ) ), imath.V2i( 500 ) )
+		for i in range( 0, 200 ) :
+			c = m.createChild( str( i ) )
+			for f in range( 0, 5 ) :
+				mesh["P"].data[0] = imath.V3f( i, f, 0 )
+				c.writeObject( mesh, f )
+		del m, c
+
+		def evictFromPageCache() :
+
+			fd = os.open( fileName, os.O_RDONLY )
+			os.posix_fadvise( fd, 0, 0, os.POSIX_FADV_DONTNEED )
+			os.close( fd )
+
+		def clearObjectCache() :
+
+			maxMemory = IECoreScene.SceneCache.getMaxCacheMemoryUsage()
+			IECoreScene.SceneCache.setMaxCacheMemoryUsage( 0 )
+			IECoreScene.SceneCache.setMaxCacheMemoryUsage( maxMemory )
+
+		def readAll() :
+
+			# Make sure we measure reading from the file, rather
+			# than retrieving objects cached by a previous read.
+			clearObjectCache()
+			m = IECoreScene.SceneCache( fileName, IECore.IndexedIO.OpenMode.Read )
+			timer = IECore.Timer( True, IECore.Timer.Mode.WallClock )
+			IECoreScene.SceneAlgo.parallelReadAll( m, 0, 4, 1.0, IECoreScene.SceneAlgo.ProcessFlags.Objects )
+			return timer.stop()
+
+		for mmap in ( "0", "1" ) :
+
+			os.environ["IECORE_STREAMINDEXEDIO_MMAP"] = mmap
+			try :
+				evictFromPageCache()
+				cold = readAll()
+				warm = readAll()
+			finally :
+				del os.environ["IECORE_STREAMINDEXEDIO_MMAP"]
+
+			print( "mmap {0} : cold {1}s, warm {2}s".format( mmap, cold, warm ) )
+
 	def testObjectVectorShaderCompatibility( self ) :
 
 		# Write a file using ObjectVectors to represent shaders.